@@ -0,0 +1,32 @@
+#include <Mlib/Arg_Parser.hpp>
+#include <Mlib/Geography/Heightmaps/Tiled_Heightmap.hpp>
+#include <Mlib/Os/Os.hpp>
+#include <Mlib/Strings/To_Number.hpp>
+
+using namespace Mlib;
+
+int main(int argc, char** argv) {
+    const ArgParser parser(
+        "Usage: convert_heightmap"
+        " --src <heightmap.png|heightmap.pgm>"
+        " --dest <heightmap.thm>"
+        " [--tile_size <tile_size>]",
+        {},
+        {"--src",
+         "--dest",
+         "--tile_size"});
+
+    try {
+        const auto args = parser.parsed(argc, argv);
+
+        args.assert_num_unnamed(0);
+        TiledHeightmap::convert(
+            args.named_value("--src"),
+            args.named_value("--dest"),
+            safe_stoz(args.named_value("--tile_size", "256")));
+    } catch (const std::runtime_error& e) {
+        lerr() << e.what();
+        return 1;
+    }
+    return 0;
+}
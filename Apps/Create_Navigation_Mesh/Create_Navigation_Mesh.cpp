@@ -33,8 +33,8 @@ int main(int argc, char** argv) {
         // NavigationMeshBuilder nmb{indexed_face_set};
         
         linfo() << "Point on navmesh";
-        auto start = nmb.ssm.closest_point_on_navmesh(FixedArray<float, 3>{ -1534.788086f, 159.749268f, 756.568665f });
-        auto end = nmb.ssm.closest_point_on_navmesh(FixedArray<float, 3>{ -1386.703369f, 164.245132f, 734.361694f });
+        auto start = nmb.navigation_mesh().closest_point_on_navmesh(FixedArray<float, 3>{ -1534.788086f, 159.749268f, 756.568665f });
+        auto end = nmb.navigation_mesh().closest_point_on_navmesh(FixedArray<float, 3>{ -1386.703369f, 164.245132f, 734.361694f });
         if (!start.has_value()) {
             THROW_OR_ABORT("Could not localize start");
         }
@@ -44,7 +44,7 @@ int main(int argc, char** argv) {
         linfo() << "Start " << start->position;
         linfo() << "End " << end->position;
         linfo() << "Shortest path";
-        for (const auto& p : nmb.ssm.shortest_path(*start, *end, 2.f)) {
+        for (const auto& p : nmb.navigation_mesh().shortest_path(*start, *end, 2.f)) {
             linfo() << p;
         }
     } catch (const std::runtime_error& e) {
@@ -14,6 +14,7 @@
 #include <Mlib/Sfm/Rigid_Motion/Projection_To_TR_Ransac.hpp>
 #include <Mlib/Stats/RansacOptions.hpp>
 #include <Mlib/Strings/To_Number.hpp>
+#include <chrono>
 
 #ifndef WITHOUT_OPENCV
 #include <opencv2/features2d.hpp>
@@ -29,6 +30,16 @@ enum class SiftImpl {
     CV
 };
 
+static void print_elapsed(
+    bool benchmark,
+    const char* name,
+    const std::chrono::steady_clock::time_point& start_time)
+{
+    if (benchmark) {
+        lerr() << name << ": " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count() << " ms";
+    }
+}
+
 SiftImpl parse_sift_impl(const std::string& impl_str) {
     if (impl_str == "1") {
         return SiftImpl::ONE;
@@ -57,8 +68,9 @@ int main(int argc, char** argv) {
         "[--clip-min <clip-min>] "
         "[--clip-max <clip-max>] "
         "[--impl {1,2,cv}] "
-        "[--intrinsic_matrix <ki>]",
-        { "--multi-scale" },
+        "[--intrinsic_matrix <ki>] "
+        "[--benchmark]",
+        { "--multi-scale", "--benchmark" },
         { "--source1",
           "--impl",
           "--k",
@@ -73,6 +85,7 @@ int main(int argc, char** argv) {
         const auto args = parser.parsed(argc, argv);
         args.assert_num_unnamed(3);
         auto bitmap0 = StbImage3::load_from_file(args.unnamed_value(0));
+        bool benchmark = args.has_named("--benchmark");
         if (false) {
             SiftFeatures response0 = computeKeypointsAndDescriptors(bitmap0.to_float_grayscale());
             Array<FixedArray<float, 2>> corners0 = Array<KeyPointWithOrientation>(response0.keypoints).applied<FixedArray<float, 2>>([](const KeyPointWithOrientation& v){return v.kp.pt;});
@@ -89,6 +102,7 @@ int main(int argc, char** argv) {
         Array<FixedArray<float, 2>> corners0;
         SiftImpl impl = parse_sift_impl(args.named_value("--impl", "cv"));
         {
+            auto start_time = std::chrono::steady_clock::now();
             if (impl == SiftImpl::ONE) {
                 ocv::SIFT sift{ safe_stoi(args.unnamed_value(2)) };
                 std::vector<ocv::KeyPoint> keypoints;
@@ -118,6 +132,7 @@ int main(int argc, char** argv) {
                 throw std::runtime_error("Compiled without OpenCV");
 #endif
             }
+            print_elapsed(benchmark, "Features of source", start_time);
             {
                 StbImage3 bmp{bitmap0.copy()};
                 highlight_features(
@@ -131,6 +146,7 @@ int main(int argc, char** argv) {
         Array<FixedArray<float, 2>> corners1;
         if (args.has_named_value("--source1")) {
             auto bitmap1 = StbImage3::load_from_file(args.named_value("--source1"));
+            auto start_time = std::chrono::steady_clock::now();
             if (impl == SiftImpl::ONE) {
                 ocv::SIFT sift{ safe_stoi(args.unnamed_value(2)) };
                 std::vector<ocv::KeyPoint> keypoints;
@@ -176,7 +192,13 @@ int main(int argc, char** argv) {
                 throw std::runtime_error("Compiled without OpenCV");
 #endif
             }
+            print_elapsed(benchmark, "Features of source1", start_time);
+            start_time = std::chrono::steady_clock::now();
             CorrespondingDescriptorsInCandidateList cf{corners0, corners1, descriptors0, descriptors1};
+            print_elapsed(benchmark, "Matching", start_time);
+            if (benchmark) {
+                lerr() << "#features: " << corners0.length() << ", " << corners1.length() << ", #matches: " << cf.y0.length();
+            }
             {
                 StbImage3 bmp = StbImage3::from_float_rgb((bitmap0.to_float_rgb() + bitmap1.to_float_rgb()) / 2.f);
                 highlight_features(cf.y0, bmp, 2, Rgb24::red());
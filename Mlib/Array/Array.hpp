@@ -49,6 +49,9 @@ Array<TData> full(const ArrayShape& shape, const TData& value);
 template <typename TData, size_t... tshape>
 class FixedArray;
 
+template <class TDerived>
+class LazyArrayExpression;
+
 template <class TData>
 class ArrayIterator {
 public:
@@ -413,6 +416,11 @@ public:
         }
         return *this;
     }
+    template <class TDerived>
+    Array& operator = (const LazyArrayExpression<TDerived>& rhs) {
+        rhs.eval_into(*this);
+        return *this;
+    }
     Array& operator = (const Array& rhs) {
         const BaseDenseArray<Array<TData>, TData>& b_rhs = rhs;
         *this = b_rhs;
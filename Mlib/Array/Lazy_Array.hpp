@@ -0,0 +1,221 @@
+#pragma once
+#include <Mlib/Array/Array.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <algorithm>
+#include <climits>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Mlib {
+
+inline void assert_lazy_shapes_equal(const ArrayShape& a, const ArrayShape& b) {
+    bool equal = (a.ndim() == b.ndim());
+    for (size_t i = 0; equal && (i < a.ndim()); ++i) {
+        equal = (a(i) == b(i));
+    }
+    if (!equal) {
+        THROW_OR_ABORT("Lazy array expression shape mismatch");
+    }
+}
+
+/**
+ * Lazily evaluated elementwise array expressions.
+ *
+ * The operators of "Array" allocate a temporary for every intermediate result.
+ * Wrapping the operands with "lazy" instead builds an expression tree that is
+ * evaluated in a single pass, either explicitly with "eval()" or by assigning
+ * it to an existing array, e.g.
+ *
+ *   a = (lazy(b) + sigma * lazy(c)) / (1 + sigma);
+ *
+ * Expressions hold the raw data pointers of their operands,
+ * so they must not outlive the arrays they were created from.
+ */
+template <class TDerived>
+class LazyArrayExpression {
+public:
+    const TDerived& derived() const {
+        return *static_cast<const TDerived*>(this);
+    }
+    template <class TOperation>
+    auto applied(const TOperation& operation) const;
+    auto eval() const {
+        Array<typename TDerived::value_type> result{ derived().shape() };
+        eval_into(result);
+        return result;
+    }
+    template <class TResultData>
+    void eval_into(Array<TResultData>& result) const {
+        const auto& d = derived();
+        if (!result.initialized()) {
+            result.resize(d.shape());
+        } else {
+            assert_lazy_shapes_equal(result.shape(), d.shape());
+        }
+        if (result.nelements() > INT_MAX) {
+            THROW_OR_ABORT("Vector too long");
+        }
+        TResultData* r = result.flat_begin();
+        int len = (int)result.nelements();
+        #pragma omp parallel for if (len > 4096)
+        for (int i = 0; i < len; ++i) {
+            r[i] = d[(size_t)i];
+        }
+    }
+    // The blocks do not depend on the number of threads,
+    // so the rounding of the result does not either.
+    auto sum() const {
+        using T = typename TDerived::value_type;
+        static const size_t BLOCK_SIZE = 4096;
+        const auto& d = derived();
+        size_t len = d.shape().nelements();
+        size_t nblocks = (len + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        if (nblocks > INT_MAX) {
+            THROW_OR_ABORT("Vector too long");
+        }
+        std::vector<T> block_sums(nblocks);
+        #pragma omp parallel for if (nblocks > 1)
+        for (int b = 0; b < (int)nblocks; ++b) {
+            size_t i0 = (size_t)b * BLOCK_SIZE;
+            size_t i1 = std::min(len, i0 + BLOCK_SIZE);
+            T block_sum = 0;
+            for (size_t i = i0; i < i1; ++i) {
+                block_sum += d[i];
+            }
+            block_sums[(size_t)b] = block_sum;
+        }
+        T result = 0;
+        for (const auto& s : block_sums) {
+            result += s;
+        }
+        return result;
+    }
+};
+
+template <class TData>
+class LazyArrayLeaf: public LazyArrayExpression<LazyArrayLeaf<TData>> {
+public:
+    using value_type = TData;
+    explicit LazyArrayLeaf(const Array<TData>& a)
+        : shape_{ a.shape() }
+        , data_{ a.flat_begin() }
+    {}
+    const ArrayShape& shape() const {
+        return shape_;
+    }
+    TData operator [] (size_t i) const {
+        return data_[i];
+    }
+private:
+    ArrayShape shape_;
+    const TData* data_;
+};
+
+template <class TOperation, class TA>
+class LazyArrayUnary: public LazyArrayExpression<LazyArrayUnary<TOperation, TA>> {
+public:
+    using value_type = std::decay_t<std::invoke_result_t<TOperation, typename TA::value_type>>;
+    LazyArrayUnary(const TA& a, const TOperation& operation)
+        : a_{ a }
+        , operation_{ operation }
+    {}
+    const ArrayShape& shape() const {
+        return a_.shape();
+    }
+    value_type operator [] (size_t i) const {
+        return operation_(a_[i]);
+    }
+private:
+    TA a_;
+    TOperation operation_;
+};
+
+template <class TOperation, class TA, class TB>
+class LazyArrayBinary: public LazyArrayExpression<LazyArrayBinary<TOperation, TA, TB>> {
+public:
+    using value_type = std::decay_t<std::invoke_result_t<TOperation, typename TA::value_type, typename TB::value_type>>;
+    LazyArrayBinary(const TA& a, const TB& b, const TOperation& operation)
+        : a_{ a }
+        , b_{ b }
+        , operation_{ operation }
+    {
+        assert_lazy_shapes_equal(a.shape(), b.shape());
+    }
+    const ArrayShape& shape() const {
+        return a_.shape();
+    }
+    value_type operator [] (size_t i) const {
+        return operation_(a_[i], b_[i]);
+    }
+private:
+    TA a_;
+    TB b_;
+    TOperation operation_;
+};
+
+template <class TDerived>
+template <class TOperation>
+auto LazyArrayExpression<TDerived>::applied(const TOperation& operation) const {
+    return LazyArrayUnary<TOperation, TDerived>{ derived(), operation };
+}
+
+template <class TData>
+LazyArrayLeaf<TData> lazy(const Array<TData>& a) {
+    return LazyArrayLeaf<TData>{ a };
+}
+
+template <class T>
+concept LazyArrayNode = std::derived_from<T, LazyArrayExpression<T>>;
+
+// Lazy expressions can be combined with other lazy expressions,
+// with arrays and with scalars.
+template <class T>
+concept LazyArrayOperand = LazyArrayNode<T> || requires (const T& a) { lazy(a); };
+
+template <LazyArrayNode T>
+const T& lazy_operand(const T& a) {
+    return a;
+}
+
+template <class TData>
+LazyArrayLeaf<TData> lazy_operand(const Array<TData>& a) {
+    return lazy(a);
+}
+
+template <LazyArrayNode TA>
+auto operator - (const TA& a) {
+    return a.applied([](const auto& x) { return -x; });
+}
+
+#define MLIB_LAZY_ARRAY_OPERATOR(OP)                                                                              \
+template <LazyArrayOperand TA, LazyArrayOperand TB>                                                               \
+    requires (LazyArrayNode<TA> || LazyArrayNode<TB>)                                                             \
+auto operator OP (const TA& a, const TB& b) {                                                                     \
+    auto la = lazy_operand(a);                                                                                    \
+    auto lb = lazy_operand(b);                                                                                    \
+    auto op = [](const auto& x, const auto& y) { return x OP y; };                                                \
+    return LazyArrayBinary<decltype(op), decltype(la), decltype(lb)>{ la, lb, op };                               \
+}                                                                                                                 \
+template <LazyArrayNode TA, class TScalar>                                                                        \
+    requires std::convertible_to<TScalar, typename TA::value_type> && (!LazyArrayOperand<TScalar>)                \
+auto operator OP (const TA& a, const TScalar& b) {                                                                \
+    typename TA::value_type bv = (typename TA::value_type)b;                                                      \
+    return a.applied([bv](const auto& x) { return x OP bv; });                                                    \
+}                                                                                                                 \
+template <class TScalar, LazyArrayNode TB>                                                                        \
+    requires std::convertible_to<TScalar, typename TB::value_type> && (!LazyArrayOperand<TScalar>)                \
+auto operator OP (const TScalar& a, const TB& b) {                                                                \
+    typename TB::value_type av = (typename TB::value_type)a;                                                      \
+    return b.applied([av](const auto& y) { return av OP y; });                                                    \
+}
+
+MLIB_LAZY_ARRAY_OPERATOR(+)
+MLIB_LAZY_ARRAY_OPERATOR(-)
+MLIB_LAZY_ARRAY_OPERATOR(*)
+MLIB_LAZY_ARRAY_OPERATOR(/)
+
+#undef MLIB_LAZY_ARRAY_OPERATOR
+
+}
@@ -222,6 +222,14 @@ Array<TData> dot2d(const SparseArrayCcs<TData>& a, const SparseArrayCcs<TData>&
     return result;
 }
 
+/*
+ * Symmetric rank-k product, syrk(a) = dot(a.H(), a).
+ */
+template <class TData>
+Array<TData> syrk(const SparseArrayCcs<TData>& a) {
+    return dot2d(a.vH(), a);
+}
+
 template <class TData>
 Array<TData> operator , (const SparseArrayCcs<TData>& a, const Array<TData>& b) {
     THROW_OR_ABORT("Sparse: please use outer or dot");
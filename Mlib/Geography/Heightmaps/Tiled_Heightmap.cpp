@@ -0,0 +1,249 @@
+#include "Tiled_Heightmap.hpp"
+#include <Mlib/Array/Array.hpp>
+#include <Mlib/Geography/Heightmaps/Load_Heightmap_From_File.hpp>
+#include <Mlib/Images/Bilinear_Interpolation.hpp>
+#include <Mlib/Memory/Integral_Cast.hpp>
+#include <Mlib/Os/Os.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace Mlib;
+
+static const char MAGIC[8] = { 'M', 'L', 'I', 'B', 'T', 'H', 'M', '1' };
+
+struct TiledHeightmapHeader {
+    char magic[8];
+    uint64_t nrows;
+    uint64_t ncols;
+    uint64_t tile_size;
+};
+
+static size_t ntiles(size_t n, size_t tile_size) {
+    return std::max<size_t>(1, (n - 1 + tile_size - 1) / tile_size);
+}
+
+TiledHeightmap::TiledHeightmap(
+    const std::filesystem::path& filename,
+    double height_scale,
+    size_t max_cached_tiles)
+    : file_{ filename }
+    , height_scale_{ height_scale }
+    , max_cached_tiles_{ max_cached_tiles }
+{
+    if (max_cached_tiles == 0) {
+        THROW_OR_ABORT("Tiled heightmap requires at least one cached tile");
+    }
+    TiledHeightmapHeader header;
+    if (file_.size() < sizeof(header)) {
+        THROW_OR_ABORT("Tiled heightmap \"" + filename.string() + "\" is too small");
+    }
+    std::memcpy(&header, file_.data().data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        THROW_OR_ABORT("File \"" + filename.string() + "\" is not a tiled heightmap");
+    }
+    shape_[0] = integral_cast<size_t>(header.nrows);
+    shape_[1] = integral_cast<size_t>(header.ncols);
+    tile_size_ = integral_cast<size_t>(header.tile_size);
+    if ((shape_[0] < 2) || (shape_[1] < 2) || (tile_size_ == 0)) {
+        THROW_OR_ABORT("Tiled heightmap \"" + filename.string() + "\" has an invalid shape");
+    }
+    ntiles_[0] = ntiles(shape_[0], tile_size_);
+    ntiles_[1] = ntiles(shape_[1], tile_size_);
+    size_t expected_size = sizeof(header) +
+        ntiles_[0] * ntiles_[1] * squared(tile_size_ + 1) * sizeof(float);
+    if (file_.size() != expected_size) {
+        THROW_OR_ABORT("Tiled heightmap \"" + filename.string() + "\" has an unexpected size");
+    }
+}
+
+TiledHeightmap::~TiledHeightmap() = default;
+
+bool TiledHeightmap::is_tiled_heightmap(const std::filesystem::path& filename) {
+    return filename.extension() == ".thm";
+}
+
+void TiledHeightmap::save(
+    const std::filesystem::path& filename,
+    const Array<float>& heightmap,
+    size_t tile_size)
+{
+    if (heightmap.ndim() != 2) {
+        THROW_OR_ABORT("Heightmap is not a 2D image");
+    }
+    if ((heightmap.shape(0) < 2) || (heightmap.shape(1) < 2)) {
+        THROW_OR_ABORT("Heightmap requires at least 2x2 pixels");
+    }
+    if (tile_size == 0) {
+        THROW_OR_ABORT("Tile size is zero");
+    }
+    auto ofstr = create_ofstream(filename, std::ios::binary);
+    if (ofstr->fail()) {
+        THROW_OR_ABORT("Could not open file \"" + filename.string() + '"');
+    }
+    TiledHeightmapHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.nrows = heightmap.shape(0);
+    header.ncols = heightmap.shape(1);
+    header.tile_size = tile_size;
+    ofstr->write((const char*)&header, sizeof(header));
+    size_t nt0 = ntiles(heightmap.shape(0), tile_size);
+    size_t nt1 = ntiles(heightmap.shape(1), tile_size);
+    std::vector<float> buffer(squared(tile_size + 1));
+    for (size_t ti = 0; ti < nt0; ++ti) {
+        for (size_t tj = 0; tj < nt1; ++tj) {
+            std::fill(buffer.begin(), buffer.end(), 0.f);
+            size_t nr = std::min(tile_size + 1, heightmap.shape(0) - ti * tile_size);
+            size_t nc = std::min(tile_size + 1, heightmap.shape(1) - tj * tile_size);
+            for (size_t r = 0; r < nr; ++r) {
+                for (size_t c = 0; c < nc; ++c) {
+                    buffer[r * (tile_size + 1) + c] = heightmap(ti * tile_size + r, tj * tile_size + c);
+                }
+            }
+            ofstr->write((const char*)buffer.data(), integral_cast<std::streamsize>(buffer.size() * sizeof(float)));
+        }
+    }
+    ofstr->flush();
+    if (ofstr->fail()) {
+        THROW_OR_ABORT("Could not save to file \"" + filename.string() + '"');
+    }
+}
+
+void TiledHeightmap::convert(
+    const std::filesystem::path& source,
+    const std::filesystem::path& destination,
+    size_t tile_size)
+{
+    if (is_tiled_heightmap(source)) {
+        THROW_OR_ABORT("Heightmap \"" + source.string() + "\" is already tiled");
+    }
+    if (!is_tiled_heightmap(destination)) {
+        THROW_OR_ABORT("Tiled heightmap \"" + destination.string() + "\" does not have the extension \".thm\"");
+    }
+    save(destination, load_heightmap_from_file<float>(source.string()), tile_size);
+}
+
+size_t TiledHeightmap::tile_index(double r, double c) const {
+    size_t ti = std::min((size_t)r / tile_size_, ntiles_[0] - 1);
+    size_t tj = std::min((size_t)c / tile_size_, ntiles_[1] - 1);
+    return ti * ntiles_[1] + tj;
+}
+
+std::shared_ptr<const Array<double>> TiledHeightmap::load_tile(size_t index) const {
+    size_t ti = index / ntiles_[1];
+    size_t tj = index % ntiles_[1];
+    size_t nr = std::min(tile_size_ + 1, shape_[0] - ti * tile_size_);
+    size_t nc = std::min(tile_size_ + 1, shape_[1] - tj * tile_size_);
+    const char* data = file_.data().data() +
+        sizeof(TiledHeightmapHeader) +
+        index * squared(tile_size_ + 1) * sizeof(float);
+    auto result = std::make_shared<Array<double>>(ArrayShape{ nr, nc });
+    for (size_t r = 0; r < nr; ++r) {
+        for (size_t c = 0; c < nc; ++c) {
+            float v;
+            std::memcpy(&v, data + (r * (tile_size_ + 1) + c) * sizeof(float), sizeof(float));
+            (*result)(r, c) = height_scale_ * v;
+        }
+    }
+    return result;
+}
+
+std::shared_ptr<const Array<double>> TiledHeightmap::tile(size_t index) const {
+    {
+        std::scoped_lock lock{ mutex_ };
+        if (auto it = cache_.find(index); it != cache_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.second);
+            return it->second.first;
+        }
+    }
+    // Decode outside of the lock, so that other threads can sample cached tiles.
+    auto result = load_tile(index);
+    std::scoped_lock lock{ mutex_ };
+    if (auto it = cache_.find(index); it != cache_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.second);
+        return it->second.first;
+    }
+    lru_.push_front(index);
+    cache_.try_emplace(index, result, lru_.begin());
+    while (cache_.size() > max_cached_tiles_) {
+        cache_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    return result;
+}
+
+bool TiledHeightmap::operator () (double r, double c, double& value) const {
+    if (!(r >= 0) || !(c >= 0) || !(r < (double)shape_[0]) || !(c < (double)shape_[1])) {
+        return false;
+    }
+    size_t index = tile_index(r, c);
+    auto t = tile(index);
+    return bilinear_grayscale_interpolation(
+        r - (double)((index / ntiles_[1]) * tile_size_),
+        c - (double)((index % ntiles_[1]) * tile_size_),
+        *t,
+        value);
+}
+
+void TiledHeightmap::operator () (
+    std::span<const double> r,
+    std::span<const double> c,
+    std::span<double> values,
+    std::span<uint8_t> valid) const
+{
+    if ((r.size() != c.size()) ||
+        (r.size() != values.size()) ||
+        (r.size() != valid.size()))
+    {
+        THROW_OR_ABORT("Heightmap sample size mismatch");
+    }
+    // Sort the queries by tile, so that every tile is fetched only once.
+    std::vector<std::pair<size_t, size_t>> order;
+    order.reserve(r.size());
+    for (size_t i = 0; i < r.size(); ++i) {
+        if (!(r[i] >= 0) || !(c[i] >= 0) || !(r[i] < (double)shape_[0]) || !(c[i] < (double)shape_[1])) {
+            values[i] = NAN;
+            valid[i] = 0;
+        } else {
+            order.emplace_back(tile_index(r[i], c[i]), i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+    std::vector<size_t> group_begins;
+    for (size_t i = 0; i < order.size(); ++i) {
+        if ((i == 0) || (order[i].first != order[i - 1].first)) {
+            group_begins.push_back(i);
+        }
+    }
+    group_begins.push_back(order.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (int g = 0; g < (int)group_begins.size() - 1; ++g) {
+        size_t begin = group_begins[(size_t)g];
+        size_t end = group_begins[(size_t)g + 1];
+        size_t index = order[begin].first;
+        auto t = tile(index);
+        double r0 = (double)((index / ntiles_[1]) * tile_size_);
+        double c0 = (double)((index % ntiles_[1]) * tile_size_);
+        std::vector<double> rl(end - begin);
+        std::vector<double> cl(end - begin);
+        std::vector<double> vl(end - begin);
+        std::vector<uint8_t> ok(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            rl[i - begin] = r[order[i].second] - r0;
+            cl[i - begin] = c[order[i].second] - c0;
+        }
+        bilinear_grayscale_interpolation<double>(rl, cl, *t, vl, ok);
+        for (size_t i = begin; i < end; ++i) {
+            values[order[i].second] = vl[i - begin];
+            valid[order[i].second] = ok[i - begin];
+        }
+    }
+}
+
+size_t TiledHeightmap::ncached_tiles() const {
+    std::scoped_lock lock{ mutex_ };
+    return cache_.size();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <Mlib/Io/Mapped_File.hpp>
+#include <Mlib/Threads/Fast_Mutex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <span>
+#include <unordered_map>
+
+namespace Mlib {
+
+template <class TData>
+class Array;
+
+/**
+ * Heightmap stored in square tiles of 32-bit floats in a memory-mapped file,
+ * so that only the tiles that are sampled are read.
+ * Neighboring tiles overlap by one pixel, so every bilinear
+ * interpolation reads a single tile.
+ * The decoded tiles are kept in an LRU cache.
+ *
+ * Files are created with "TiledHeightmap::save", or converted from
+ * the image formats of "load_heightmap_from_file" with
+ * "TiledHeightmap::convert" (see the "convert_heightmap" app).
+ * The file extension is ".thm".
+ */
+class TiledHeightmap {
+    TiledHeightmap(const TiledHeightmap&) = delete;
+    TiledHeightmap& operator = (const TiledHeightmap&) = delete;
+public:
+    TiledHeightmap(
+        const std::filesystem::path& filename,
+        double height_scale,
+        size_t max_cached_tiles);
+    ~TiledHeightmap();
+    static bool is_tiled_heightmap(const std::filesystem::path& filename);
+    static void save(
+        const std::filesystem::path& filename,
+        const Array<float>& heightmap,
+        size_t tile_size);
+    static void convert(
+        const std::filesystem::path& source,
+        const std::filesystem::path& destination,
+        size_t tile_size);
+    inline size_t shape(size_t i) const {
+        return shape_[i];
+    }
+    bool operator () (double r, double c, double& value) const;
+    /**
+     * Samples all positions, grouped by tile.
+     * "valid[i]" is 0 for positions outside of the heightmap.
+     */
+    void operator () (
+        std::span<const double> r,
+        std::span<const double> c,
+        std::span<double> values,
+        std::span<uint8_t> valid) const;
+    size_t ncached_tiles() const;
+private:
+    size_t tile_index(double r, double c) const;
+    std::shared_ptr<const Array<double>> tile(size_t index) const;
+    std::shared_ptr<const Array<double>> load_tile(size_t index) const;
+    MappedFile file_;
+    double height_scale_;
+    size_t max_cached_tiles_;
+    size_t shape_[2];
+    size_t tile_size_;
+    size_t ntiles_[2];
+    mutable FastMutex mutex_;
+    mutable std::list<size_t> lru_;
+    mutable std::unordered_map<size_t, std::pair<std::shared_ptr<const Array<double>>, std::list<size_t>::iterator>> cache_;
+};
+
+}
@@ -0,0 +1,322 @@
+#pragma once
+#include <Mlib/Geometry/Intersection/Axis_Aligned_Bounding_Box.hpp>
+#include <Mlib/Math/Funpack.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Mlib {
+
+/**
+ * Bounding volume hierarchy for moving objects.
+ *
+ * In contrast to "Bvh", the tree is persistent. Moving a leaf refits
+ * its ancestors, and "rebalance" applies tree rotations
+ * (Kopta et al., "Fast, Effective BVH Updates for Animated Scenes")
+ * instead of rebuilding the hierarchy.
+ */
+template <class TPosition, size_t tndim, class TPayload>
+class DynamicBvh {
+    using F = decltype(funpack(std::declval<TPosition>()));
+    static const size_t NO_NODE = SIZE_MAX;
+    struct Node {
+        AxisAlignedBoundingBox<TPosition, tndim> aabb = uninitialized;
+        size_t parent;
+        size_t children[2];
+        size_t height;
+        TPayload payload;
+        bool is_leaf() const {
+            return children[0] == NO_NODE;
+        }
+    };
+public:
+    DynamicBvh()
+        : root_{ NO_NODE }
+        , free_{ NO_NODE }
+        , nleaves_{ 0 }
+    {}
+
+    size_t insert(const AxisAlignedBoundingBox<TPosition, tndim>& aabb, const TPayload& payload) {
+        auto leaf = allocate();
+        auto& n = nodes_[leaf];
+        n.aabb = aabb;
+        n.payload = payload;
+        n.height = 0;
+        insert_leaf(leaf);
+        ++nleaves_;
+        return leaf;
+    }
+
+    void remove(size_t leaf) {
+        assert_leaf(leaf);
+        remove_leaf(leaf);
+        deallocate(leaf);
+        --nleaves_;
+    }
+
+    /**
+     * Sets the new bounding box and refits all ancestors.
+     */
+    void move(size_t leaf, const AxisAlignedBoundingBox<TPosition, tndim>& aabb) {
+        assert_leaf(leaf);
+        nodes_[leaf].aabb = aabb;
+        refit(nodes_[leaf].parent);
+    }
+
+    TPayload& payload(size_t leaf) {
+        assert_leaf(leaf);
+        return nodes_[leaf].payload;
+    }
+
+    const AxisAlignedBoundingBox<TPosition, tndim>& aabb(size_t leaf) const {
+        assert_leaf(leaf);
+        return nodes_[leaf].aabb;
+    }
+
+    /**
+     * Applies tree rotations to all internal nodes, bottom-up.
+     * Intended to be called occasionally, e.g. once per frame.
+     */
+    void rebalance() {
+        if (root_ == NO_NODE) {
+            return;
+        }
+        std::vector<size_t> order;
+        order.reserve(nodes_.size());
+        order.push_back(root_);
+        for (size_t i = 0; i < order.size(); ++i) {
+            const auto& n = nodes_[order[i]];
+            if (!n.is_leaf()) {
+                order.push_back(n.children[0]);
+                order.push_back(n.children[1]);
+            }
+        }
+        for (auto it = order.rbegin(); it != order.rend(); ++it) {
+            if (!nodes_[*it].is_leaf()) {
+                rotate(*it);
+                update_node(*it);
+            }
+        }
+    }
+
+    template <class TVisitor>
+    bool visit(const AxisAlignedBoundingBox<TPosition, tndim>& aabb, const TVisitor& visitor) const {
+        if (root_ == NO_NODE) {
+            return true;
+        }
+        std::vector<size_t> stack;
+        stack.reserve(2 * height() + 2);
+        stack.push_back(root_);
+        while (!stack.empty()) {
+            const auto& n = nodes_[stack.back()];
+            stack.pop_back();
+            if (!n.aabb.intersects(aabb)) {
+                continue;
+            }
+            if (n.is_leaf()) {
+                if (!visitor(n.payload)) {
+                    return false;
+                }
+            } else {
+                stack.push_back(n.children[0]);
+                stack.push_back(n.children[1]);
+            }
+        }
+        return true;
+    }
+
+    size_t size() const {
+        return nleaves_;
+    }
+
+    bool empty() const {
+        return nleaves_ == 0;
+    }
+
+    size_t height() const {
+        return (root_ == NO_NODE) ? 0 : nodes_[root_].height;
+    }
+
+    void clear() {
+        nodes_.clear();
+        root_ = NO_NODE;
+        free_ = NO_NODE;
+        nleaves_ = 0;
+    }
+private:
+    static F cost(const AxisAlignedBoundingBox<TPosition, tndim>& aabb) {
+        auto s = funpack(aabb.size());
+        F result = 0;
+        for (size_t i = 0; i < tndim; ++i) {
+            result += s(i) * s((i + 1) % tndim);
+        }
+        return result;
+    }
+
+    static AxisAlignedBoundingBox<TPosition, tndim> merged(
+        const AxisAlignedBoundingBox<TPosition, tndim>& a,
+        const AxisAlignedBoundingBox<TPosition, tndim>& b)
+    {
+        auto result = a;
+        result.extend(b);
+        return result;
+    }
+
+    void assert_leaf(size_t leaf) const {
+        if ((leaf >= nodes_.size()) || !nodes_[leaf].is_leaf() || (nodes_[leaf].height == SIZE_MAX)) {
+            THROW_OR_ABORT("Invalid dynamic BVH leaf");
+        }
+    }
+
+    size_t allocate() {
+        size_t result;
+        if (free_ != NO_NODE) {
+            result = free_;
+            free_ = nodes_[free_].parent;
+        } else {
+            result = nodes_.size();
+            nodes_.emplace_back();
+        }
+        auto& n = nodes_[result];
+        n.parent = NO_NODE;
+        n.children[0] = NO_NODE;
+        n.children[1] = NO_NODE;
+        n.height = 0;
+        return result;
+    }
+
+    void deallocate(size_t i) {
+        auto& n = nodes_[i];
+        n.parent = free_;
+        n.children[0] = NO_NODE;
+        n.height = SIZE_MAX;
+        n.payload = TPayload{};
+        free_ = i;
+    }
+
+    void update_node(size_t i) {
+        auto& n = nodes_[i];
+        const auto& c0 = nodes_[n.children[0]];
+        const auto& c1 = nodes_[n.children[1]];
+        n.aabb = merged(c0.aabb, c1.aabb);
+        n.height = 1 + std::max(c0.height, c1.height);
+    }
+
+    void replace_child(size_t parent, size_t old_child, size_t new_child) {
+        if (parent == NO_NODE) {
+            root_ = new_child;
+        } else {
+            auto& p = nodes_[parent];
+            p.children[(p.children[0] == old_child) ? 0 : 1] = new_child;
+        }
+        nodes_[new_child].parent = parent;
+    }
+
+    // Swaps the child "c" of "node" with the grandchild "g",
+    // which is a child of the other child of "node",
+    // if this reduces the cost of the other child.
+    bool try_swap(size_t node, size_t c_index) {
+        auto& n = nodes_[node];
+        size_t c = n.children[c_index];
+        size_t o = n.children[1 - c_index];
+        if (nodes_[o].is_leaf()) {
+            return false;
+        }
+        const auto& on = nodes_[o];
+        F best_cost = cost(on.aabb);
+        size_t best_g = NO_NODE;
+        for (size_t gi = 0; gi < 2; ++gi) {
+            size_t g_other = on.children[1 - gi];
+            F new_cost = cost(merged(nodes_[c].aabb, nodes_[g_other].aabb));
+            if (new_cost < best_cost) {
+                best_cost = new_cost;
+                best_g = on.children[gi];
+            }
+        }
+        if (best_g == NO_NODE) {
+            return false;
+        }
+        auto& o_node = nodes_[o];
+        o_node.children[(o_node.children[0] == best_g) ? 0 : 1] = c;
+        nodes_[c].parent = o;
+        nodes_[node].children[c_index] = best_g;
+        nodes_[best_g].parent = node;
+        update_node(o);
+        return true;
+    }
+
+    void rotate(size_t node) {
+        if (!try_swap(node, 0)) {
+            try_swap(node, 1);
+        }
+    }
+
+    void refit(size_t i) {
+        while (i != NO_NODE) {
+            update_node(i);
+            i = nodes_[i].parent;
+        }
+    }
+
+    void insert_leaf(size_t leaf) {
+        if (root_ == NO_NODE) {
+            root_ = leaf;
+            nodes_[leaf].parent = NO_NODE;
+            return;
+        }
+        // Descend towards the sibling with the smallest cost increase.
+        const auto aabb = nodes_[leaf].aabb;
+        size_t sibling = root_;
+        while (!nodes_[sibling].is_leaf()) {
+            const auto& n = nodes_[sibling];
+            F combined = cost(merged(n.aabb, aabb));
+            F inheritance = combined - cost(n.aabb);
+            F c_cost[2];
+            for (size_t ci = 0; ci < 2; ++ci) {
+                const auto& c = nodes_[n.children[ci]];
+                c_cost[ci] = cost(merged(c.aabb, aabb)) + inheritance;
+                if (!c.is_leaf()) {
+                    c_cost[ci] -= cost(c.aabb);
+                }
+            }
+            if ((combined < c_cost[0]) && (combined < c_cost[1])) {
+                break;
+            }
+            sibling = n.children[(c_cost[0] < c_cost[1]) ? 0 : 1];
+        }
+        size_t old_parent = nodes_[sibling].parent;
+        size_t new_parent = allocate();
+        replace_child(old_parent, sibling, new_parent);
+        auto& np = nodes_[new_parent];
+        np.children[0] = sibling;
+        np.children[1] = leaf;
+        nodes_[sibling].parent = new_parent;
+        nodes_[leaf].parent = new_parent;
+        for (size_t i = new_parent; i != NO_NODE; i = nodes_[i].parent) {
+            rotate(i);
+            update_node(i);
+        }
+    }
+
+    void remove_leaf(size_t leaf) {
+        if (leaf == root_) {
+            root_ = NO_NODE;
+            return;
+        }
+        size_t parent = nodes_[leaf].parent;
+        size_t grand_parent = nodes_[parent].parent;
+        const auto& p = nodes_[parent];
+        size_t sibling = p.children[(p.children[0] == leaf) ? 1 : 0];
+        replace_child(grand_parent, parent, sibling);
+        deallocate(parent);
+        refit(grand_parent);
+    }
+
+    std::vector<Node> nodes_;
+    size_t root_;
+    size_t free_;
+    size_t nleaves_;
+};
+
+}
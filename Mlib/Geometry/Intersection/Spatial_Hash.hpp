@@ -0,0 +1,76 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Math/Math.hpp>
+#include <Mlib/Math/Orderable_Fixed_Array.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace Mlib {
+
+/**
+ * Uniform grid over the xz-plane, storing payloads at 3D positions.
+ * Radius queries visit the cells overlapping the query square
+ * and filter by the 3D distance.
+ */
+template <class TPosition, class TPayload>
+class SpatialHash {
+public:
+    explicit SpatialHash(TPosition cell_size)
+        : cell_size_{ cell_size }
+    {
+        if (!(cell_size > 0)) {
+            THROW_OR_ABORT("Spatial hash cell size must be positive");
+        }
+    }
+    void clear() {
+        cells_.clear();
+    }
+    bool empty() const {
+        return cells_.empty();
+    }
+    OrderableFixedArray<int, 2> cell(TPosition x, TPosition z) const {
+        return {
+            (int)std::floor(x / cell_size_),
+            (int)std::floor(z / cell_size_) };
+    }
+    void insert(const FixedArray<TPosition, 3>& position, const TPayload& payload) {
+        cells_[cell(position(0), position(2))].push_back({ payload, position });
+    }
+    template <class TVisitor>
+    bool visit(
+        const FixedArray<TPosition, 3>& center,
+        TPosition radius,
+        const TVisitor& visitor) const
+    {
+        auto lo = cell(center(0) - radius, center(2) - radius);
+        auto hi = cell(center(0) + radius, center(2) + radius);
+        for (int x = lo(0); x <= hi(0); ++x) {
+            for (int z = lo(1); z <= hi(1); ++z) {
+                auto it = cells_.find(OrderableFixedArray<int, 2>{ x, z });
+                if (it == cells_.end()) {
+                    continue;
+                }
+                for (const auto& e : it->second) {
+                    if (sum(squared(e.position - center)) > squared(radius)) {
+                        continue;
+                    }
+                    if (!visitor(e.payload, e.position)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+private:
+    struct Entry {
+        TPayload payload;
+        FixedArray<TPosition, 3> position;
+    };
+    TPosition cell_size_;
+    std::unordered_map<OrderableFixedArray<int, 2>, std::vector<Entry>> cells_;
+};
+
+}
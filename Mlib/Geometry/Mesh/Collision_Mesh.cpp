@@ -18,6 +18,8 @@ CollisionMesh::CollisionMesh(const ColoredVertexArray<TData>& mesh)
     mesh.triangles_sphere(triangles);
 
     lines = mesh.lines_sphere();
+
+    convex_hitbox = ConvexHitboxVariant::from_polygons(quads, triangles);
 }
 
 CollisionMesh::CollisionMesh(
@@ -1,6 +1,7 @@
 #pragma once
 #include <Mlib/Geometry/Intersection/Collision_Line.hpp>
 #include <Mlib/Geometry/Intersection/Collision_Polygon.hpp>
+#include <Mlib/Geometry/Mesh/Convex_Hitbox.hpp>
 #include <Mlib/Geometry/Mesh/Typed_Mesh.hpp>
 #include <memory>
 #include <string>
@@ -29,6 +30,7 @@ public:
     std::vector<CollisionPolygonSphere<CompressedScenePos, 3>> triangles;
     std::vector<CollisionLineSphere<CompressedScenePos>> lines;
     TypedMesh<std::shared_ptr<IIntersectable>> intersectable;
+    ConvexHitboxVariant convex_hitbox;
 };
 
 }
@@ -0,0 +1,153 @@
+#include "Convex_Hitbox.hpp"
+#include <Mlib/Geometry/Intersection/Collision_Polygon.hpp>
+#include <Mlib/Math/Fixed_Math.hpp>
+#include <Mlib/Math/Orderable_Fixed_Array.hpp>
+#include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
+#include <set>
+
+using namespace Mlib;
+
+static const SceneDir DIRECTION_TOLERANCE = 1e-3f;
+
+namespace {
+
+struct HitboxFeatures {
+    std::set<OrderableFixedArray<CompressedScenePos, 3>> vertices;
+    std::vector<FixedArray<SceneDir, 3>> normals;
+    std::vector<FixedArray<SceneDir, 3>> edges;
+};
+
+}
+
+// Inserts "d" unless it is parallel or anti-parallel to an existing direction.
+static bool insert_direction(
+    std::vector<FixedArray<SceneDir, 3>>& directions,
+    const FixedArray<SceneDir, 3>& d,
+    size_t max_size)
+{
+    for (const auto& e : directions) {
+        if (std::abs(dot0d(e, d)) > 1 - DIRECTION_TOLERANCE) {
+            return true;
+        }
+    }
+    if (directions.size() == max_size) {
+        return false;
+    }
+    directions.push_back(d);
+    return true;
+}
+
+template <size_t tnvertices>
+static bool insert_vertices_and_normal(
+    HitboxFeatures& features,
+    const CollisionPolygonSphere<CompressedScenePos, tnvertices>& p)
+{
+    for (const auto& c : p.corners.row_iterable()) {
+        features.vertices.insert(OrderableFixedArray{ c });
+        if (features.vertices.size() > 8) {
+            return false;
+        }
+    }
+    return insert_direction(features.normals, p.polygon.plane.normal, 4);
+}
+
+// Only edges between two non-parallel faces are features of the polytope,
+// diagonals of triangulated faces are perpendicular to a single face normal.
+template <size_t tnvertices>
+static bool insert_edges(
+    HitboxFeatures& features,
+    const CollisionPolygonSphere<CompressedScenePos, tnvertices>& p)
+{
+    for (size_t i = 0; i < tnvertices; ++i) {
+        auto d = funpack(p.corners[(i + 1) % tnvertices] - p.corners[i]);
+        auto l2 = sum(squared(d));
+        if (l2 < 1e-12) {
+            return false;
+        }
+        auto dn = (d / std::sqrt(l2)).template casted<SceneDir>();
+        size_t nperpendicular = 0;
+        for (const auto& n : features.normals) {
+            nperpendicular += (std::abs(dot0d(n, dn)) < DIRECTION_TOLERANCE);
+        }
+        if ((nperpendicular >= 2) && !insert_direction(features.edges, dn, 4)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t tnvertices, size_t tnnormals, size_t tnedges>
+static ConvexHitbox<tnvertices, tnnormals, tnedges> make_hitbox(const HitboxFeatures& features) {
+    ConvexHitbox<tnvertices, tnnormals, tnedges> result{ uninitialized, uninitialized, uninitialized };
+    std::copy(features.vertices.begin(), features.vertices.end(), result.vertices.row_begin());
+    std::copy(features.normals.begin(), features.normals.end(), result.normals.row_begin());
+    std::copy(features.edges.begin(), features.edges.end(), result.edges.row_begin());
+    return result;
+}
+
+template <size_t tnvertices, size_t tnnormals, size_t tnedges>
+ConvexHitbox<tnvertices, tnnormals, tnedges> ConvexHitbox<tnvertices, tnnormals, tnedges>::transformed(
+    const TransformationMatrix<SceneDir, ScenePos, 3>& trafo) const
+{
+    return {
+        .vertices = trafo.transform(vertices.template casted<ScenePos>()).template casted<CompressedScenePos>(),
+        .normals = trafo.rotate(normals),
+        .edges = trafo.rotate(edges) };
+}
+
+ConvexHitboxVariant ConvexHitboxVariant::transformed(const TransformationMatrix<SceneDir, ScenePos, 3>& trafo) const {
+    return std::visit([&](const auto& h) -> ConvexHitboxVariant {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(h)>, std::monostate>) {
+            return {};
+        } else {
+            return { h.transformed(trafo) };
+        }
+    }, hitbox);
+}
+
+ConvexHitboxVariant ConvexHitboxVariant::from_polygons(
+    const std::vector<CollisionPolygonSphere<CompressedScenePos, 4>>& quads,
+    const std::vector<CollisionPolygonSphere<CompressedScenePos, 3>>& triangles)
+{
+    if (quads.size() + triangles.size() > 12) {
+        return {};
+    }
+    HitboxFeatures features;
+    for (const auto& q : quads) {
+        if (!insert_vertices_and_normal(features, q)) {
+            return {};
+        }
+    }
+    for (const auto& t : triangles) {
+        if (!insert_vertices_and_normal(features, t)) {
+            return {};
+        }
+    }
+    for (const auto& q : quads) {
+        if (!insert_edges(features, q)) {
+            return {};
+        }
+    }
+    for (const auto& t : triangles) {
+        if (!insert_edges(features, t)) {
+            return {};
+        }
+    }
+    auto nv = features.vertices.size();
+    auto nn = features.normals.size();
+    auto ne = features.edges.size();
+    if ((nv == 8) && (nn == 3) && (ne == 3)) {
+        return { make_hitbox<8, 3, 3>(features) };
+    }
+    if ((nv == 6) && (nn == 4) && (ne == 4)) {
+        return { make_hitbox<6, 4, 4>(features) };
+    }
+    return {};
+}
+
+namespace Mlib {
+
+template struct ConvexHitbox<8, 3, 3>;
+template struct ConvexHitbox<6, 4, 4>;
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+namespace Mlib {
+
+template <class TPosition, size_t tnvertices>
+struct CollisionPolygonSphere;
+template <class TDir, class TPos, size_t n>
+class TransformationMatrix;
+
+/**
+ * Small convex polytope with a fixed number of vertices,
+ * face normals and edge directions. Normals and edge directions
+ * are stored up to their sign.
+ */
+template <size_t tnvertices, size_t tnnormals, size_t tnedges>
+struct ConvexHitbox {
+    FixedArray<CompressedScenePos, tnvertices, 3> vertices;
+    FixedArray<SceneDir, tnnormals, 3> normals;
+    FixedArray<SceneDir, tnedges, 3> edges;
+    ConvexHitbox transformed(const TransformationMatrix<SceneDir, ScenePos, 3>& trafo) const;
+};
+
+using BoxHitbox = ConvexHitbox<8, 3, 3>;
+using PrismHitbox = ConvexHitbox<6, 4, 4>;
+
+/**
+ * Hitbox shape, detected once when the collision mesh is created,
+ * so the SAT kernel of a mesh pair can be selected without
+ * inspecting the polygons again.
+ */
+struct ConvexHitboxVariant {
+    std::variant<std::monostate, BoxHitbox, PrismHitbox> hitbox;
+    inline bool has_value() const {
+        return !std::holds_alternative<std::monostate>(hitbox);
+    }
+    ConvexHitboxVariant transformed(const TransformationMatrix<SceneDir, ScenePos, 3>& trafo) const;
+    static ConvexHitboxVariant from_polygons(
+        const std::vector<CollisionPolygonSphere<CompressedScenePos, 4>>& quads,
+        const std::vector<CollisionPolygonSphere<CompressedScenePos, 3>>& triangles);
+};
+
+}
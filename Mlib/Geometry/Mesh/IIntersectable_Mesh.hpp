@@ -2,6 +2,7 @@
 #include <Mlib/Scene_Precision.hpp>
 #include <Mlib/Threads/Safe_Atomic_Shared_Mutex.hpp>
 #include <cstddef>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@ class OrderableFixedArray;
 class IIntersectable;
 template <class T>
 struct TypedMesh;
+struct ConvexHitboxVariant;
 
 class IIntersectableMesh {
 public:
@@ -52,6 +54,7 @@ public:
     virtual const std::vector<CollisionLineSphere<CompressedScenePos>>& get_edges_sphere() const = 0;
     virtual const std::vector<CollisionRidgeSphere<CompressedScenePos>>& get_ridges_sphere() const = 0;
     virtual const std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>& get_intersectables() const = 0;
+    virtual const ConvexHitboxVariant& get_convex_hitbox() const = 0;
     const std::set<OrderableFixedArray<CompressedScenePos, 3>>& get_vertices() const;
     virtual BoundingSphere<CompressedScenePos, 3> bounding_sphere() const = 0;
     virtual AxisAlignedBoundingBox<CompressedScenePos, 3> aabb() const = 0;
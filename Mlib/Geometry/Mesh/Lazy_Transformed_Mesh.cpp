@@ -31,6 +31,7 @@ LazyTransformedMesh::LazyTransformedMesh(
     , transformation_matrix_{ transformation_matrix }
     , transformed_bounding_sphere_{ bounding_sphere.transformed(transformation_matrix) }
     , mesh_{ collision_mesh }
+    , transformed_convex_hitbox_{ collision_mesh->convex_hitbox.transformed(transformation_matrix) }
 {}
 
 LazyTransformedMesh::~LazyTransformedMesh() = default;
@@ -163,6 +164,10 @@ const std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>& LazyTransformedMe
     return transformed_intersectables_;
 }
 
+const ConvexHitboxVariant& LazyTransformedMesh::get_convex_hitbox() const {
+    return transformed_convex_hitbox_;
+}
+
 BoundingSphere<CompressedScenePos, 3> LazyTransformedMesh::bounding_sphere() const {
     return transformed_bounding_sphere_;
 }
@@ -2,6 +2,7 @@
 #include <Mlib/Array/Array_Forward.hpp>
 #include <Mlib/Array/Fixed_Array.hpp>
 #include <Mlib/Geometry/Intersection/Bounding_Sphere.hpp>
+#include <Mlib/Geometry/Mesh/Convex_Hitbox.hpp>
 #include <Mlib/Geometry/Mesh/IIntersectable_Mesh.hpp>
 #include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
 #include <Mlib/Threads/Fast_Mutex.hpp>
@@ -39,6 +40,7 @@ public:
     virtual const std::vector<CollisionLineSphere<CompressedScenePos>>& get_edges_sphere() const override;
     virtual const std::vector<CollisionRidgeSphere<CompressedScenePos>>& get_ridges_sphere() const override;
     virtual const std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>& get_intersectables() const override;
+    virtual const ConvexHitboxVariant& get_convex_hitbox() const override;
     virtual BoundingSphere<CompressedScenePos, 3> bounding_sphere() const override;
     virtual AxisAlignedBoundingBox<CompressedScenePos, 3> aabb() const override;
     void print_info() const;
@@ -47,6 +49,7 @@ private:
     const TransformationMatrix<float, ScenePos, 3> transformation_matrix_;
     BoundingSphere<CompressedScenePos, 3> transformed_bounding_sphere_;
     std::shared_ptr<CollisionMesh> mesh_;
+    ConvexHitboxVariant transformed_convex_hitbox_;
     mutable std::vector<TypedMesh<std::shared_ptr<IIntersectable>>> intersectables_;
     mutable std::vector<CollisionPolygonSphere<CompressedScenePos, 4>> transformed_quads_;
     mutable std::vector<CollisionPolygonSphere<CompressedScenePos, 3>> transformed_triangles_;
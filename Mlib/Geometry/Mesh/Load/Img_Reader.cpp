@@ -1,6 +1,8 @@
 #include "Img_Reader.hpp"
 #include <Mlib/Io/Binary.hpp>
 #include <Mlib/Io/Cleanup.hpp>
+#include <Mlib/Io/Mapped_File.hpp>
+#include <Mlib/Io/Mapped_IStream_Dictionary.hpp>
 #include <Mlib/Io/Stream_And_Lock.hpp>
 #include <Mlib/Io/Stream_Segment.hpp>
 #include <Mlib/Os/Os.hpp>
@@ -17,18 +19,23 @@ struct DirectoryInfo {
 static_assert(sizeof(DirectoryInfo) == 32);
 
 ImgReader::ImgReader(std::istream& directory, std::unique_ptr<std::istream>&& data)
-    : reading_{ false }
-{
+    : directory_{ read_directory(directory) }
+    , data_{ std::move(data) }
+    , reading_{ false }
+{}
+
+Map<std::string, StreamSegment> ImgReader::read_directory(std::istream& directory) {
+    Map<std::string, StreamSegment> result;
     while (directory.peek() != EOF) {
         auto h = read_binary<DirectoryInfo>(directory, "directory entry", IoVerbosity::SILENT);
         auto entry_name = remove_trailing_zeros(std::string(h.name, sizeof(h.name)));
         // linfo() << "Entry name: " << entry_name;
-        directory_.add(
+        result.add(
             entry_name,
             std::streamoff{ h.offset } << 11,
             integral_cast<std::streamsize>(h.size) << 11);
     }
-    data_ = std::move(data);
+    return result;
 }
 
 std::shared_ptr<IIStreamDictionary> ImgReader::load_from_file(const std::string& img_filename) {
@@ -42,11 +49,9 @@ std::shared_ptr<IIStreamDictionary> ImgReader::load_from_file(const std::string&
         THROW_OR_ABORT("Could not open \"" + dir_filename + '"');
     }
 
-    auto img = create_ifstream(img_filename, std::ios::binary);
-    if (img->fail()) {
-        THROW_OR_ABORT("Could not open \"" + img_filename + '"');
-    }
-    return std::make_shared<ImgReader>(*dir, std::move(img));
+    return std::make_shared<MappedIStreamDictionary>(
+        std::make_shared<MappedFile>(img_filename),
+        read_directory(*dir));
 }
 
 ImgReader::~ImgReader() = default;
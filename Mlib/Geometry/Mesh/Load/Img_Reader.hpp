@@ -1,5 +1,6 @@
 #pragma once
 #include <Mlib/Io/IIStream_Dictionary.hpp>
+#include <Mlib/Io/Stream_Segment.hpp>
 #include <Mlib/Map/Map.hpp>
 #include <Mlib/Memory/Dangling_Base_Class.hpp>
 #include <memory>
@@ -8,8 +9,6 @@
 
 namespace Mlib {
 
-struct StreamSegment;
-
 template <class TStreamOwner>
 class IStreamAndLock;
 
@@ -19,7 +18,11 @@ class ImgReader: public IIStreamDictionary, public virtual DanglingBaseClass {
     friend IStreamAndLock<DanglingBaseClassRef<ImgReader>>;
 public:
     ImgReader(std::istream& directory, std::unique_ptr<std::istream>&& data);
+    /**
+     * Memory-maps the archive, allowing concurrent reads.
+     */
     static std::shared_ptr<IIStreamDictionary> load_from_file(const std::string& img_filename);
+    static Map<std::string, StreamSegment> read_directory(std::istream& directory);
     virtual ~ImgReader() override;
     virtual std::vector<std::string> names() const override;
     virtual StreamAndSize read(
@@ -1,11 +1,14 @@
 #include "Jpk_Reader.hpp"
 #include <Mlib/Io/Binary.hpp>
 #include <Mlib/Io/Endian.hpp>
+#include <Mlib/Io/Mapped_File.hpp>
+#include <Mlib/Io/Mapped_IStream_Dictionary.hpp>
 #include <Mlib/Io/Stream_And_Lock.hpp>
 #include <Mlib/Io/Stream_Segment.hpp>
 #include <Mlib/Os/Os.hpp>
 #include <Mlib/Throw_Or_Abort.hpp>
 #include <istream>
+#include <spanstream>
 
 using namespace Mlib;
 
@@ -22,9 +25,14 @@ struct JpkHeader {
 static_assert(sizeof(JpkHeader) == 32);
 
 JpkReader::JpkReader(std::unique_ptr<std::istream>&& data, IoVerbosity verbosity)
-    : reading_{ false }
-{
-    auto header = read_binary<JpkHeader>(*data, "JPK header", verbosity);
+    : directory_{ read_directory(*data, verbosity) }
+    , data_{ std::move(data) }
+    , reading_{ false }
+{}
+
+Map<std::string, StreamSegment> JpkReader::read_directory(std::istream& data, IoVerbosity verbosity) {
+    Map<std::string, StreamSegment> result;
+    auto header = read_binary<JpkHeader>(data, "JPK header", verbosity);
     if (header.magic != 0x4B41504A) {
         THROW_OR_ABORT("Wrong JPK header");
     }
@@ -37,21 +45,21 @@ JpkReader::JpkReader(std::unique_ptr<std::istream>&& data, IoVerbosity verbosity
         if (any(verbosity & IoVerbosity::METADATA)) {
             linfo() << "Entry index: " << i;
         }
-        data->seekg(integral_cast<std::streamoff>(32 + i * 32));
+        data.seekg(integral_cast<std::streamoff>(32 + i * 32));
         
-        auto name_offset = read_binary<uint32_t>(*data, "name offset", verbosity);
-        auto data_size = read_binary<uint32_t>(*data, "data size", verbosity);
-        auto file_offset = read_binary<uint32_t>(*data, "file offset", verbosity);
+        auto name_offset = read_binary<uint32_t>(data, "name offset", verbosity);
+        auto data_size = read_binary<uint32_t>(data, "data size", verbosity);
+        auto file_offset = read_binary<uint32_t>(data, "file offset", verbosity);
 
         if (any(verbosity & IoVerbosity::METADATA)) {
             linfo() << "Name offset: " << name_offset;
             linfo() << "Data size: " << data_size;
             linfo() << "File offset: " << file_offset;
         }
-        data->seekg(name_offset);
-        while (read_binary<char>(*data, "name character", verbosity) != 0);
-        auto end = data->tellg();
-        data->seekg(name_offset);
+        data.seekg(name_offset);
+        while (read_binary<char>(data, "name character", verbosity) != 0);
+        auto end = data.tellg();
+        data.seekg(name_offset);
         auto name_length = end - integral_cast<std::streamoff>(name_offset);
         if (name_length == 0) {
             THROW_OR_ABORT("Raw null-terminated string is empty");
@@ -60,28 +68,27 @@ JpkReader::JpkReader(std::unique_ptr<std::istream>&& data, IoVerbosity verbosity
             THROW_OR_ABORT("Name too long");
         }
         std::string name = read_string(
-            *data,
+            data,
             integral_cast<size_t>((std::streamoff)name_length - integral_cast<std::streamoff>(1)),
             "name",
             verbosity);
-        data->seekg(file_offset);
-        directory_.add(name, file_offset, data_size);
+        data.seekg(file_offset);
+        result.add(name, file_offset, data_size);
         if (any(verbosity & IoVerbosity::METADATA)) {
             linfo() << "Name: " << name;
         }
     }
-    data_ = std::move(data);
+    return result;
 }
 
 std::shared_ptr<IIStreamDictionary> JpkReader::load_from_file(
     const std::string& filename,
     IoVerbosity verbosity)
 {
-    auto f = create_ifstream(filename, std::ios::binary);
-    if (f->fail()) {
-        THROW_OR_ABORT("Could not open \"" + filename + '"');
-    }
-    return std::make_shared<JpkReader>(std::move(f), verbosity);
+    auto file = std::make_shared<MappedFile>(filename);
+    std::ispanstream data{ file->data() };
+    auto directory = read_directory(data, verbosity);
+    return std::make_shared<MappedIStreamDictionary>(std::move(file), std::move(directory));
 }
 
 JpkReader::~JpkReader() = default;
@@ -1,5 +1,6 @@
 #pragma once
 #include <Mlib/Io/IIStream_Dictionary.hpp>
+#include <Mlib/Io/Stream_Segment.hpp>
 #include <Mlib/Map/Map.hpp>
 #include <Mlib/Memory/Dangling_Base_Class.hpp>
 #include <memory>
@@ -9,7 +10,6 @@
 namespace Mlib {
 
 enum class IoVerbosity;
-struct StreamSegment;
 template <class TStreamOwner>
 class IStreamAndLock;
 
@@ -19,9 +19,13 @@ class JpkReader: public IIStreamDictionary, public virtual DanglingBaseClass {
     friend IStreamAndLock<DanglingBaseClassRef<JpkReader>>;
 public:
     JpkReader(std::unique_ptr<std::istream>&& data, IoVerbosity verbosity);
+    /**
+     * Memory-maps the archive, allowing concurrent reads.
+     */
     static std::shared_ptr<IIStreamDictionary> load_from_file(
         const std::string& filename,
         IoVerbosity verbosity);
+    static Map<std::string, StreamSegment> read_directory(std::istream& data, IoVerbosity verbosity);
     virtual ~JpkReader() override;
     virtual std::vector<std::string> names() const override;
     virtual StreamAndSize read(
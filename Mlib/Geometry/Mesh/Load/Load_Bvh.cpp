@@ -7,6 +7,7 @@
 #include <Mlib/Strings/String.hpp>
 #include <Mlib/Strings/To_Number.hpp>
 #include <algorithm>
+#include <functional>
 #include <istream>
 
 using namespace Mlib;
@@ -206,6 +207,7 @@ BvhLoader::BvhLoader(
     if (cfg.periodic && !raw_frames.empty()) {
         transformed_frames_[transformed_frames_.size() - 1] = transformed_frames_[0];
     }
+    build_joint_index();
     if (!file->eof() && file->fail()) {
         THROW_OR_ABORT("Error reading from file: \"" + filename + '"');
     }
@@ -218,14 +220,14 @@ const Map<std::string, OffsetAndQuaternion<float, float>>& BvhLoader::get_frame(
     return transformed_frames_[id];
 }
 
-Map<std::string, OffsetAndQuaternion<float, float>> BvhLoader::get_relative_interpolated_frame(float time) const {
+void BvhLoader::interpolation_frames(float time, size_t& i0, size_t& i1, float& a0) const {
     if (transformed_frames_.empty()) {
         THROW_OR_ABORT("No frames to interpolate from");
     }
     float i = time / frame_time_;
     i = std::clamp(i, float{0}, float(transformed_frames_.size() - 1));
-    auto i0 = size_t(i);
-    auto i1 = i0 + 1;
+    i0 = size_t(i);
+    i1 = i0 + 1;
     if (i1 > transformed_frames_.size()) {
         THROW_OR_ABORT("Frame interpolation internal error");
     }
@@ -233,7 +235,14 @@ Map<std::string, OffsetAndQuaternion<float, float>> BvhLoader::get_relative_inte
         --i1;
         --i0;
     }
-    float a0 = i - float(i0);
+    a0 = i - float(i0);
+}
+
+Map<std::string, OffsetAndQuaternion<float, float>> BvhLoader::get_relative_interpolated_frame(float time) const {
+    size_t i0;
+    size_t i1;
+    float a0;
+    interpolation_frames(time, i0, i1, a0);
     const auto& f0 = get_frame(i0);
     const auto& f1 = get_frame(i1);
     Map<std::string, OffsetAndQuaternion<float, float>> result;
@@ -286,6 +295,117 @@ Map<std::string, OffsetAndQuaternion<float, float>> BvhLoader::get_absolute_inte
     return result;
 }
 
+void BvhLoader::build_joint_index() {
+    if (transformed_frames_.empty()) {
+        return;
+    }
+    const auto& frame0 = transformed_frames_[0];
+    std::function<void(const std::string&, size_t)> add_joint = [&](const std::string& name, size_t ncalls) {
+        if (joint_indices_.contains(name)) {
+            return;
+        }
+        size_t parent = SIZE_MAX;
+        auto it = parents_.find(name);
+        if (it != parents_.end()) {
+            if (ncalls > 100) {
+                THROW_OR_ABORT("Recursion depth exceeded, probably loop in parents mapping");
+            }
+            add_joint(it->second, ncalls + 1);
+            parent = joint_indices_.at(it->second);
+        }
+        joint_indices_.try_emplace(name, joint_names_.size());
+        joint_names_.push_back(name);
+        joint_parents_.push_back(parent);
+    };
+    for (const auto& [name, _] : frame0) {
+        add_joint(name, 0);
+    }
+    size_t n = joint_names_.size();
+    indexed_frames_.resize(transformed_frames_.size() * 7 * n);
+    for (size_t f = 0; f < transformed_frames_.size(); ++f) {
+        float* d = &indexed_frames_[f * 7 * n];
+        for (size_t j = 0; j < n; ++j) {
+            const auto& p = transformed_frames_[f].get(joint_names_[j]);
+            d[0 * n + j] = p.t(0);
+            d[1 * n + j] = p.t(1);
+            d[2 * n + j] = p.t(2);
+            d[3 * n + j] = p.q.s;
+            d[4 * n + j] = p.q.v(0);
+            d[5 * n + j] = p.q.v(1);
+            d[6 * n + j] = p.q.v(2);
+        }
+    }
+}
+
+size_t BvhLoader::joint_index(const std::string& name) const {
+    auto it = joint_indices_.find(name);
+    if (it == joint_indices_.end()) {
+        THROW_OR_ABORT("Could not find joint with name \"" + name + '"');
+    }
+    return it->second;
+}
+
+std::vector<OffsetAndQuaternion<float, float>> BvhLoader::get_indexed_absolute_interpolated_frame(float time) const {
+    size_t i0;
+    size_t i1;
+    float a0;
+    interpolation_frames(time, i0, i1, a0);
+    size_t n = joint_names_.size();
+    const float* f0 = &indexed_frames_[i0 * 7 * n];
+    const float* f1 = &indexed_frames_[i1 * 7 * n];
+    // Relative poses, same layout as a frame of "indexed_frames_".
+    std::vector<float> rel(7 * n);
+    float* r = rel.data();
+    // Branch-free version of "OffsetAndQuaternion::slerp",
+    // interpolating all joints at once.
+    #pragma omp simd
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t k = 0; k < 3; ++k) {
+            r[k * n + j] = f0[k * n + j] * (1 - a0) + f1[k * n + j] * a0;
+        }
+        float s0 = f0[3 * n + j];
+        float x0 = f0[4 * n + j];
+        float y0 = f0[5 * n + j];
+        float z0 = f0[6 * n + j];
+        float s1 = f1[3 * n + j];
+        float x1 = f1[4 * n + j];
+        float y1 = f1[5 * n + j];
+        float z1 = f1[6 * n + j];
+        float dot = s0 * s1 + x0 * x1 + y0 * y1 + z0 * z1;
+        float sign = (dot < 0.f) ? -1.f : 1.f;
+        dot *= sign;
+        bool linear = (dot > 0.9995f);
+        float theta_0 = std::acos(std::min(dot, 0.9995f));
+        float theta = theta_0 * a0;
+        float sin_theta = std::sin(theta);
+        float sin_theta_0 = std::sin(theta_0);
+        float w0 = linear ? 1 - a0 : std::cos(theta) - dot * sin_theta / sin_theta_0;
+        float w1 = sign * (linear ? a0 : sin_theta / sin_theta_0);
+        float s = w0 * s0 + w1 * s1;
+        float x = w0 * x0 + w1 * x1;
+        float y = w0 * y0 + w1 * y1;
+        float z = w0 * z0 + w1 * z1;
+        float scale = linear ? 1 / std::sqrt(s * s + x * x + y * y + z * z) : 1.f;
+        r[3 * n + j] = s * scale;
+        r[4 * n + j] = x * scale;
+        r[5 * n + j] = y * scale;
+        r[6 * n + j] = z * scale;
+    }
+    std::vector<OffsetAndQuaternion<float, float>> result;
+    result.reserve(n);
+    for (size_t j = 0; j < n; ++j) {
+        OffsetAndQuaternion<float, float> p{
+            FixedArray<float, 3>{ r[0 * n + j], r[1 * n + j], r[2 * n + j] },
+            Quaternion<float>{ r[3 * n + j], FixedArray<float, 3>{ r[4 * n + j], r[5 * n + j], r[6 * n + j] } } };
+        if (joint_parents_[j] == SIZE_MAX) {
+            result.push_back(p);
+        } else {
+            result.push_back(result[joint_parents_[j]] * p);
+        }
+    }
+    return result;
+}
+
 static int mod(int x, int n) {
     return (x % n + n) % n;
 }
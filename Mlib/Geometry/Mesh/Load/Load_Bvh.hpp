@@ -5,6 +5,8 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace Mlib {
 
@@ -51,9 +53,15 @@ public:
     const Map<std::string, OffsetAndQuaternion<float, float>>& get_frame(size_t id) const;
     Map<std::string, OffsetAndQuaternion<float, float>> get_relative_interpolated_frame(float time) const;
     Map<std::string, OffsetAndQuaternion<float, float>> get_absolute_interpolated_frame(float time) const;
+    // Index of the joint in the result of "get_indexed_absolute_interpolated_frame".
+    size_t joint_index(const std::string& name) const;
+    // Equivalent to "get_absolute_interpolated_frame", but indexed by "joint_index".
+    std::vector<OffsetAndQuaternion<float, float>> get_indexed_absolute_interpolated_frame(float time) const;
     float duration() const;
 private:
     void smoothen();
+    void build_joint_index();
+    void interpolation_frames(float time, size_t& i0, size_t& i1, float& a0) const;
     void compute_absolute_transformation(
         const std::string& name,
         const Map<std::string, OffsetAndQuaternion<float, float>>& relative_transformations,
@@ -63,6 +71,13 @@ private:
     Map<std::string, FixedArray<float, 3>> offsets_;
     Map<std::string, std::string> parents_;
     std::list<ColumnDescription> columns_;
+    // Joints sorted such that parents precede their children.
+    std::vector<std::string> joint_names_;
+    std::vector<size_t> joint_parents_;
+    std::unordered_map<std::string, size_t> joint_indices_;
+    // Per frame the components t(0), t(1), t(2), q.s, q.v(0), q.v(1), q.v(2),
+    // each stored contiguously for all joints.
+    std::vector<float> indexed_frames_;
     BvhConfig cfg_;
     float frame_time_;
 };
@@ -0,0 +1,72 @@
+#include "Sat_Convex_Hitbox.hpp"
+#include <Mlib/Geometry/Fixed_Cross.hpp>
+#include <Mlib/Geometry/Mesh/Convex_Hitbox.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Overlap_Combiner.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Overlap_Combiner.impl.hpp>
+
+using namespace Mlib;
+
+#ifdef __GNUC__
+    #pragma GCC push_options
+    #pragma GCC optimize ("O3")
+#endif
+
+template <
+    size_t tnvertices0, size_t tnnormals0, size_t tnedges0,
+    size_t tnvertices1, size_t tnnormals1, size_t tnedges1>
+static void get_overlap(
+    const ConvexHitbox<tnvertices0, tnnormals0, tnedges0>& h0,
+    const ConvexHitbox<tnvertices1, tnnormals1, tnedges1>& h1,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal)
+{
+    BasicSatOverlapCombiner<
+        FixedArray<CompressedScenePos, tnvertices0, 3>,
+        FixedArray<CompressedScenePos, tnvertices1, 3>> sac{
+        h0.vertices,
+        h1.vertices
+    };
+    for (size_t i = 0; i < tnnormals0; ++i) {
+        sac.combine_axis(h0.normals[i]);
+    }
+    for (size_t i = 0; i < tnnormals1; ++i) {
+        sac.combine_axis(h1.normals[i]);
+    }
+    for (size_t i = 0; i < tnedges0; ++i) {
+        for (size_t j = 0; j < tnedges1; ++j) {
+            auto n = cross(h0.edges[i], h1.edges[j]);
+            auto l2 = sum(squared(n));
+            if (l2 < 1e-6) {
+                continue;
+            }
+            sac.combine_axis(n / std::sqrt(l2));
+        }
+    }
+    min_overlap = sac.best_min_overlap();
+    normal = sac.best_normal();
+}
+
+bool Mlib::get_overlap_convex_hitboxes(
+    const ConvexHitboxVariant& hitbox0,
+    const ConvexHitboxVariant& hitbox1,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal)
+{
+    return std::visit([&](const auto& h0, const auto& h1) {
+        using H0 = std::remove_cvref_t<decltype(h0)>;
+        using H1 = std::remove_cvref_t<decltype(h1)>;
+        if constexpr (
+            std::is_same_v<H0, std::monostate> ||
+            std::is_same_v<H1, std::monostate>)
+        {
+            return false;
+        } else {
+            get_overlap(h0, h1, min_overlap, normal);
+            return true;
+        }
+    }, hitbox0.hitbox, hitbox1.hitbox);
+}
+
+#ifdef __GNUC__
+    #pragma GCC pop_options
+#endif
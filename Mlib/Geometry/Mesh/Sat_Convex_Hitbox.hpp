@@ -0,0 +1,24 @@
+#pragma once
+#include <Mlib/Scene_Precision.hpp>
+#include <cstddef>
+
+namespace Mlib {
+
+template <typename TData, size_t... tshape>
+class FixedArray;
+struct ConvexHitboxVariant;
+
+/**
+ * SAT overlap of two convex hitboxes, e.g. box-box or box-prism.
+ * The axis set of each shape pair is known at compile time,
+ * and no memory is allocated.
+ * Returns false if one of the meshes has no hitbox, in which case
+ * the generic polygon- and ridge-based SAT must be used.
+ */
+bool get_overlap_convex_hitboxes(
+    const ConvexHitboxVariant& hitbox0,
+    const ConvexHitboxVariant& hitbox1,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal);
+
+}
@@ -1,7 +1,9 @@
 #include "Sat_Normals.hpp"
 #include <Mlib/Geometry/Intersection/Collision_Polygon.hpp>
 #include <Mlib/Geometry/Intersection/Collision_Ridge.hpp>
+#include <Mlib/Geometry/Mesh/Convex_Hitbox.hpp>
 #include <Mlib/Geometry/Mesh/IIntersectable_Mesh.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Convex_Hitbox.hpp>
 #include <Mlib/Geometry/Mesh/Sat_Overlap_Combiner.hpp>
 #include <Mlib/Math/Orderable_Fixed_Array.hpp>
 
@@ -49,6 +51,27 @@ void Mlib::get_overlap(
     const IIntersectableMesh& mesh1,
     ScenePos& min_overlap,
     FixedArray<SceneDir, 3>& normal)
+{
+    // The hitbox kernels test all face and edge-edge axes, without the
+    // relevance filters of "get_overlap_polygons". For convex polytopes,
+    // the overlap along any axis is at least the penetration depth, so both
+    // paths find the same minimum unless the filters drop its axis.
+    if (get_overlap_convex_hitboxes(
+        mesh0.get_convex_hitbox(),
+        mesh1.get_convex_hitbox(),
+        min_overlap,
+        normal))
+    {
+        return;
+    }
+    get_overlap_polygons(mesh0, mesh1, min_overlap, normal);
+}
+
+void Mlib::get_overlap_polygons(
+    const IIntersectableMesh& mesh0,
+    const IIntersectableMesh& mesh1,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal)
 {
     std::vector<const CollisionRidgeSphere<CompressedScenePos>*> relevant_edges0;
     std::vector<const CollisionRidgeSphere<CompressedScenePos>*> relevant_edges1;
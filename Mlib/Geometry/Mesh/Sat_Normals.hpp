@@ -18,6 +18,14 @@ void get_overlap(
     ScenePos& min_overlap,
     FixedArray<SceneDir, 3>& normal);
 
+// Generic SAT over the relevant polygons and ridges,
+// without the fixed-size kernels of the convex hitboxes.
+void get_overlap_polygons(
+    const IIntersectableMesh& mesh0,
+    const IIntersectableMesh& mesh1,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal);
+
 class SatTracker {
 public:
     void get_collision_plane(
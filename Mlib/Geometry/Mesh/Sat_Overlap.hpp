@@ -1,29 +1,84 @@
 #pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Math/Fixed_Math.hpp>
 #include <Mlib/Scene_Precision.hpp>
+#include <cmath>
 #include <cstddef>
-#include <set>
 
 namespace Mlib {
 
-template <class TData, size_t... tshape>
-class FixedArray;
-template <class TData, size_t... tshape>
-class OrderableFixedArray;
-
 // ScenePos get_overlap(
 //     const CollisionTriangleSphere& t0,
 //     const IIntersectableMesh& mesh1);
 
+/**
+ * "TVertices" is either a range of 3D points, e.g. the
+ * "std::set" returned by "IIntersectableMesh::get_vertices",
+ * or an N x 3 array, e.g. the vertices of a convex hitbox.
+ */
+template <class TVertices>
+const TVertices& sat_vertex_rows(const TVertices& vertices) {
+    return vertices;
+}
+
+template <class TData, size_t tnvertices>
+auto sat_vertex_rows(const FixedArray<TData, tnvertices, 3>& vertices) {
+    return vertices.row_iterable();
+}
+
+template <class TVertices0, class TVertices1>
 ScenePos sat_overlap_signed(
     const FixedArray<SceneDir, 3>& n,
-    const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices0,
-    const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices1);
+    const TVertices0& vertices0,
+    const TVertices1& vertices1)
+{
+    ScenePos max0 = -INFINITY;
+    ScenePos min1 = INFINITY;
+    for (const auto& v : sat_vertex_rows(vertices0)) {
+        ScenePos s = dot0d(v.template casted<ScenePos>(), n.casted<ScenePos>());
+        max0 = std::max(max0, s);
+    }
+    for (const auto& v : sat_vertex_rows(vertices1)) {
+        ScenePos s = dot0d(v.template casted<ScenePos>(), n.casted<ScenePos>());
+        min1 = std::min(min1, s);
+    }
+    // o0 -> normal | o1
+    // o0_min .. o1_min .. o0_max .. o1_max
+    // => o0_max - o1_min > 0 => intersection
 
+
+    // normal <- o0 | o1
+    // o0_max .. o1_max ... o0_min .. o1_min
+    return max0 - min1;
+}
+
+/*  From: https://docs.godotengine.org/en/stable/tutorials/math/vectors_advanced.html#collision-detection-in-3d
+ */
+template <class TVertices0, class TVertices1>
 void sat_overlap_unsigned(
     const FixedArray<SceneDir, 3>& l,
-    const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices0,
-    const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices1,
+    const TVertices0& vertices0,
+    const TVertices1& vertices1,
     ScenePos& overlap0,
-    ScenePos& overlap1);
+    ScenePos& overlap1)
+{
+    ScenePos max0 = -INFINITY;
+    ScenePos max1 = -INFINITY;
+    ScenePos min0 = INFINITY;
+    ScenePos min1 = INFINITY;
+    for (const auto& v : sat_vertex_rows(vertices0)) {
+        ScenePos s = dot0d(v.template casted<ScenePos>(), l.casted<ScenePos>());
+        max0 = std::max(max0, s);
+        min0 = std::min(min0, s);
+    }
+    for (const auto& v : sat_vertex_rows(vertices1)) {
+        ScenePos s = dot0d(v.template casted<ScenePos>(), l.casted<ScenePos>());
+        max1 = std::max(max1, s);
+        min1 = std::min(min1, s);
+    }
+
+    overlap0 = max1 - min0;
+    overlap1 = max0 - min1;
+}
 
 }
@@ -5,6 +5,7 @@
 #include <Mlib/Geometry/Mesh/Collision_Vertices.hpp>
 #include <Mlib/Geometry/Mesh/IIntersectable_Mesh.hpp>
 #include <Mlib/Geometry/Mesh/Sat_Overlap_Combiner.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Overlap_Combiner.impl.hpp>
 #include <Mlib/Math/Orderable_Fixed_Array.hpp>
 
 using namespace Mlib;
@@ -82,3 +83,59 @@ void Mlib::get_overlap2(
     min_overlap = sac.best_min_overlap();
     normal = sac.best_normal();
 }
+
+template <size_t tnvertices>
+void Mlib::get_overlap2(
+    const CollisionPolygonSphere<CompressedScenePos, tnvertices>& p0,
+    const std::array<const CollisionRidgeSphere<CompressedScenePos>*, tnvertices>& ridges0,
+    size_t nridges0,
+    const CollisionRidgeSphere<CompressedScenePos>& e1,
+    ScenePos max_keep_normal,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal)
+{
+    // The ridges lie on the polygon edges, so the
+    // polygon corners are the vertices of the mesh.
+    BasicSatOverlapCombiner<
+        FixedArray<CompressedScenePos, tnvertices, 3>,
+        FixedArray<CompressedScenePos, 2, 3>> sac{
+        p0.corners,
+        e1.edge
+    };
+
+    sac.combine_sticky_ridge(e1, max_keep_normal);
+
+    if (e1.bounding_sphere.intersects(p0.bounding_sphere) &&
+        e1.bounding_sphere.intersects(p0.polygon.plane))
+    {
+        sac.combine_plane(p0.polygon.plane.normal);
+    }
+    for (size_t i = 0; i < nridges0; ++i) {
+        if (e1.bounding_sphere.intersects(ridges0[i]->bounding_sphere)) {
+            sac.combine_ridges(*ridges0[i], e1);
+        }
+    }
+    min_overlap = sac.best_min_overlap();
+    normal = sac.best_normal();
+}
+
+namespace Mlib {
+
+template void get_overlap2(
+    const CollisionPolygonSphere<CompressedScenePos, 3>& p0,
+    const std::array<const CollisionRidgeSphere<CompressedScenePos>*, 3>& ridges0,
+    size_t nridges0,
+    const CollisionRidgeSphere<CompressedScenePos>& e1,
+    ScenePos max_keep_normal,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal);
+template void get_overlap2(
+    const CollisionPolygonSphere<CompressedScenePos, 4>& p0,
+    const std::array<const CollisionRidgeSphere<CompressedScenePos>*, 4>& ridges0,
+    size_t nridges0,
+    const CollisionRidgeSphere<CompressedScenePos>& e1,
+    ScenePos max_keep_normal,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal);
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <Mlib/Scene_Precision.hpp>
+#include <array>
 #include <cstddef>
 
 namespace Mlib {
@@ -8,6 +9,8 @@ template <typename TData, size_t... tshape>
 class FixedArray;
 template <class TPosition>
 struct CollisionRidgeSphere;
+template <class TPosition, size_t tnvertices>
+struct CollisionPolygonSphere;
 class IIntersectableMesh;
 
 void get_overlap2(
@@ -17,4 +20,19 @@ void get_overlap2(
     ScenePos& min_overlap,
     FixedArray<SceneDir, 3>& normal);
 
+/**
+ * Same as above, for a mesh that consists of a single polygon
+ * and the ridges along its edges. Uses fixed-size vertex sets
+ * instead of a temporary "StaticTransformedMesh".
+ */
+template <size_t tnvertices>
+void get_overlap2(
+    const CollisionPolygonSphere<CompressedScenePos, tnvertices>& p0,
+    const std::array<const CollisionRidgeSphere<CompressedScenePos>*, tnvertices>& ridges0,
+    size_t nridges0,
+    const CollisionRidgeSphere<CompressedScenePos>& e1,
+    ScenePos max_keep_normal,
+    ScenePos& min_overlap,
+    FixedArray<SceneDir, 3>& normal);
+
 }
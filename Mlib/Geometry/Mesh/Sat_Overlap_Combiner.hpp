@@ -11,14 +11,16 @@ struct CollisionRidgeSphere;
 template <class TData, size_t... tshape>
 class OrderableFixedArray;
 
-class SatOverlapCombiner {
+template <class TVertices0, class TVertices1>
+class BasicSatOverlapCombiner {
 public:
-    SatOverlapCombiner(
-        const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices0,
-        const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices1);
+    BasicSatOverlapCombiner(
+        const TVertices0& vertices0,
+        const TVertices1& vertices1);
     void combine_sticky_ridge(const CollisionRidgeSphere<CompressedScenePos>& e1, ScenePos max_keep_normal);
     void combine_ridges(const CollisionRidgeSphere<CompressedScenePos>& e0, const CollisionRidgeSphere<CompressedScenePos>& e1);
     void combine_plane(const FixedArray<SceneDir, 3>& normal);
+    void combine_axis(const FixedArray<SceneDir, 3>& axis);
     inline const FixedArray<SceneDir, 3>& best_normal() const {
         return best_normal_;
     }
@@ -35,8 +37,12 @@ private:
     FixedArray<SceneDir, 3> best_normal_;
     ScenePos best_min_overlap_;
 
-    const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices0_;
-    const std::set<OrderableFixedArray<CompressedScenePos, 3>>& vertices1_;
+    const TVertices0& vertices0_;
+    const TVertices1& vertices1_;
 };
 
-}
\ No newline at end of file
+using SatOverlapCombiner = BasicSatOverlapCombiner<
+    std::set<OrderableFixedArray<CompressedScenePos, 3>>,
+    std::set<OrderableFixedArray<CompressedScenePos, 3>>>;
+
+}
@@ -32,6 +32,7 @@ StaticTransformedMesh::StaticTransformedMesh(
     , edges_{ std::move(edges) }
     , ridges_{ std::move(ridges) }
     , intersectables_{ std::move(intersectables) }
+    , convex_hitbox_{ ConvexHitboxVariant::from_polygons(quads_, triangles_) }
 {}
 
 StaticTransformedMesh::~StaticTransformedMesh() = default;
@@ -69,6 +70,10 @@ const std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>& StaticTransformed
     return intersectables_;
 }
 
+const ConvexHitboxVariant& StaticTransformedMesh::get_convex_hitbox() const {
+    return convex_hitbox_;
+}
+
 BoundingSphere<CompressedScenePos, 3> StaticTransformedMesh::bounding_sphere() const {
     return bounding_sphere_;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <Mlib/Geometry/Intersection/Axis_Aligned_Bounding_Box.hpp>
 #include <Mlib/Geometry/Intersection/Bounding_Sphere.hpp>
+#include <Mlib/Geometry/Mesh/Convex_Hitbox.hpp>
 #include <Mlib/Geometry/Mesh/IIntersectable_Mesh.hpp>
 #include <vector>
 
@@ -41,6 +42,7 @@ public:
     virtual const std::vector<CollisionLineSphere<CompressedScenePos>>& get_edges_sphere() const override;
     virtual const std::vector<CollisionRidgeSphere<CompressedScenePos>>& get_ridges_sphere() const override;
     virtual const std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>& get_intersectables() const override;
+    virtual const ConvexHitboxVariant& get_convex_hitbox() const override;
     virtual BoundingSphere<CompressedScenePos, 3> bounding_sphere() const override;
     virtual AxisAlignedBoundingBox<CompressedScenePos, 3> aabb() const override;
 private:
@@ -53,6 +55,7 @@ private:
     std::vector<CollisionLineSphere<CompressedScenePos>> edges_;
     std::vector<CollisionRidgeSphere<CompressedScenePos>> ridges_;
     std::vector<TypedMesh<std::shared_ptr<IIntersectable>>> intersectables_;
+    ConvexHitboxVariant convex_hitbox_;
 };
 
 }
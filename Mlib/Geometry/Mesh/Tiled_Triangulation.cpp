@@ -0,0 +1,681 @@
+#include "Tiled_Triangulation.hpp"
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Geometry/Exceptions/Point_Exception.hpp>
+#include <Mlib/Geometry/Mesh/P2t_Point_Set.hpp>
+#include <Mlib/Math/Funpack.hpp>
+#include <Mlib/Math/Orderable_Fixed_Array.hpp>
+#include <Mlib/Os/Os.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <poly2tri/poly2tri.h>
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace Mlib;
+
+using P2 = FixedArray<CompressedScenePos, 2>;
+using Triangle2 = FixedArray<CompressedScenePos, 3, 2>;
+
+// Maximum number of times a tile boundary is moved before giving up.
+static const size_t MAX_TILE_LINE_NUDGES = 1000;
+
+namespace {
+
+struct Crossing {
+    P2 point;
+    size_t edge;
+    size_t arc_before;
+    size_t arc_after;
+};
+
+// Part of a contour inside a single tile,
+// starting and ending at a crossing with the tile boundary.
+struct Arc {
+    size_t contour;
+    size_t tile;
+    size_t first_crossing;
+    size_t last_crossing;
+    std::vector<P2> vertices;
+};
+
+struct EdgeVertex {
+    P2 point;
+    size_t crossing;
+};
+
+// Tile boundary between two adjacent tiles (or one tile at the border),
+// with vertices sorted in the direction of the increasing coordinate.
+struct Edge {
+    std::vector<EdgeVertex> vertices;
+    size_t first_piece;
+};
+
+struct PerimeterVertex {
+    P2 point;
+    size_t crossing;
+    size_t piece;
+};
+
+// Face of a tile, or the inside of a contour that
+// does not cross a tile boundary ("ring").
+struct TilePolygon {
+    size_t label;
+    std::vector<P2> outer;
+    FixedArray<double, 2, 2> aabb = uninitialized;
+    std::vector<size_t> pieces;
+    std::vector<size_t> forward_contours;
+    std::vector<size_t> holes;
+    std::list<P2> steiner_points;
+};
+
+// Tile boundary that must be moved, because contours cross
+// it at a tile corner or at the same point.
+struct TileLineConflict {
+    size_t axis;
+    size_t line;
+    P2 point;
+    const char* message;
+};
+
+class UnionFind {
+public:
+    explicit UnionFind(size_t n)
+        : parents_(n)
+    {
+        std::iota(parents_.begin(), parents_.end(), 0);
+    }
+    size_t find(size_t i) {
+        while (parents_[i] != i) {
+            parents_[i] = parents_[parents_[i]];
+            i = parents_[i];
+        }
+        return i;
+    }
+    void merge(size_t a, size_t b) {
+        parents_[find(a)] = find(b);
+    }
+private:
+    std::vector<size_t> parents_;
+};
+
+}
+
+// Positions of the tile boundaries along one axis. The boundaries are moved
+// by the smallest representable distance until they do not contain a vertex.
+static std::vector<CompressedScenePos> tile_lines(
+    const std::vector<CompressedScenePos>& sorted_coords,
+    CompressedScenePos tile_size)
+{
+    auto quantum = CompressedScenePos::from_count(1);
+    auto next_free = [&sorted_coords, &quantum](CompressedScenePos c){
+        while (std::binary_search(sorted_coords.begin(), sorted_coords.end(), c)) {
+            c += quantum;
+        }
+        return c;
+    };
+    std::vector<CompressedScenePos> result{ sorted_coords.front() - quantum };
+    while (!(result.back() > sorted_coords.back())) {
+        result.push_back(next_free(result.back() + tile_size));
+    }
+    return result;
+}
+
+// Moves an inner tile boundary by at least "distance",
+// without placing it on a vertex.
+static void nudge_tile_line(
+    std::vector<CompressedScenePos>& lines,
+    size_t line,
+    CompressedScenePos distance,
+    const std::vector<CompressedScenePos>& sorted_coords)
+{
+    if ((line == 0) || (line + 1 >= lines.size())) {
+        THROW_OR_ABORT("Cannot move the outer tile boundaries");
+    }
+    auto quantum = CompressedScenePos::from_count(1);
+    auto c = lines[line] + distance;
+    while (std::binary_search(sorted_coords.begin(), sorted_coords.end(), c)) {
+        c += quantum;
+    }
+    if (!(c < lines[line + 1])) {
+        THROW_OR_ABORT("Tile boundaries are too close to each other");
+    }
+    lines[line] = c;
+}
+
+static size_t cell_index(const std::vector<CompressedScenePos>& lines, double v) {
+    auto it = std::upper_bound(
+        lines.begin(),
+        lines.end(),
+        v,
+        [](double v, const CompressedScenePos& l){ return v < funpack(l); });
+    if ((it == lines.begin()) || (it == lines.end())) {
+        THROW_OR_ABORT("Coordinate is outside of the tiles");
+    }
+    return (size_t)(it - lines.begin()) - 1;
+}
+
+static FixedArray<double, 2, 2> polygon_aabb(const std::vector<P2>& polygon) {
+    FixedArray<double, 2, 2> result{
+        FixedArray<double, 2>{ INFINITY, INFINITY },
+        FixedArray<double, 2>{ -INFINITY, -INFINITY } };
+    for (const auto& p : polygon) {
+        for (size_t d = 0; d < 2; ++d) {
+            result(0, d) = std::min(result(0, d), funpack(p(d)));
+            result(1, d) = std::max(result(1, d), funpack(p(d)));
+        }
+    }
+    return result;
+}
+
+static bool polygon_contains(const TilePolygon& polygon, const FixedArray<double, 2>& p) {
+    if ((p(0) < polygon.aabb(0, 0)) || (p(0) > polygon.aabb(1, 0)) ||
+        (p(1) < polygon.aabb(0, 1)) || (p(1) > polygon.aabb(1, 1)))
+    {
+        return false;
+    }
+    // Crossing number
+    bool inside = false;
+    const auto& o = polygon.outer;
+    for (size_t i = 0, j = o.size() - 1; i < o.size(); j = i++) {
+        auto a = funpack(o[i]);
+        auto b = funpack(o[j]);
+        if ((a(1) > p(1)) != (b(1) > p(1))) {
+            double x = a(0) + (p(1) - a(1)) / (b(1) - a(1)) * (b(0) - a(0));
+            if (p(0) < x) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+static double polygon_area(const std::vector<P2>& polygon) {
+    double area2 = 0;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        auto a = funpack(polygon[j]);
+        auto b = funpack(polygon[i]);
+        area2 += a(0) * b(1) - a(1) * b(0);
+    }
+    return area2 / 2;
+}
+
+static std::list<Triangle2> triangulate_polygon(
+    const TilePolygon& polygon,
+    const std::vector<TilePolygon>& polygons,
+    bool with_steiner_points,
+    double triangulation_scale)
+{
+    P2tPointSet points{
+        with_steiner_points ? polygon.steiner_points : std::list<P2>{},
+        triangulation_scale };
+    auto to_p2t = [&points](const std::vector<P2>& contour){
+        std::vector<p2t::Point*> result;
+        result.reserve(contour.size());
+        for (const auto& p : contour) {
+            result.push_back(points(p));
+        }
+        return result;
+    };
+    p2t::CDT cdt{ to_p2t(polygon.outer) };
+    for (size_t h : polygon.holes) {
+        cdt.AddHole(to_p2t(polygons[h].outer));
+    }
+    for (const auto& p : points.remaining_steiner_points()) {
+        cdt.AddPoint(p);
+    }
+    cdt.Triangulate();
+    std::list<Triangle2> result;
+    for (const auto& t : cdt.GetTriangles()) {
+        const auto* c0 = points.try_get_coords(t->GetPoint(0));
+        const auto* c1 = points.try_get_coords(t->GetPoint(1));
+        const auto* c2 = points.try_get_coords(t->GetPoint(2));
+        if ((c0 == nullptr) ||
+            (c1 == nullptr) ||
+            (c2 == nullptr))
+        {
+            lwarn() << "Received unknown point";
+            continue;
+        }
+        result.emplace_back(*c0, *c1, *c2);
+    }
+    return result;
+}
+
+std::vector<std::list<Triangle2>> Mlib::triangulate_tiled(
+    const std::vector<std::vector<P2>>& contours,
+    const std::list<P2>& steiner_points,
+    CompressedScenePos tile_size,
+    CompressedScenePos boundary_vertex_distance,
+    double triangulation_scale)
+{
+    if (!(tile_size > (CompressedScenePos)0.)) {
+        THROW_OR_ABORT("Tile size is not positive");
+    }
+    if (!(boundary_vertex_distance > (CompressedScenePos)0.)) {
+        THROW_OR_ABORT("Boundary vertex distance is not positive");
+    }
+    std::vector<std::list<Triangle2>> result(contours.size());
+    if (contours.empty()) {
+        return result;
+    }
+    // Tile boundaries
+    std::vector<CompressedScenePos> coords[2];
+    std::vector<CompressedScenePos> lines[2];
+    for (const auto& c : contours) {
+        if (c.size() < 3) {
+            THROW_OR_ABORT("Contour has less than 3 vertices");
+        }
+        for (const auto& p : c) {
+            coords[0].push_back(p(0));
+            coords[1].push_back(p(1));
+        }
+    }
+    for (size_t axis = 0; axis < 2; ++axis) {
+        std::sort(coords[axis].begin(), coords[axis].end());
+        lines[axis] = tile_lines(coords[axis], tile_size);
+    }
+    size_t ncells[2] = { lines[0].size() - 1, lines[1].size() - 1 };
+    // Vertical edges are indexed by (x-line, y-cell), horizontal edges by (y-line, x-cell).
+    auto edge_index = [&](size_t axis, size_t line, size_t cell){
+        return (axis == 0)
+            ? line * ncells[1] + cell
+            : (ncells[0] + 1) * ncells[1] + line * ncells[0] + cell;
+    };
+    auto tile_index = [&](size_t ix, size_t iy){
+        return iy * ncells[0] + ix;
+    };
+    size_t nedges = edge_index(1, ncells[1] + 1, 0);
+    size_t ntiles = ncells[0] * ncells[1];
+
+    std::vector<Crossing> crossings;
+    std::vector<Arc> arcs;
+    std::vector<std::vector<size_t>> tile_arcs;
+    std::vector<std::vector<size_t>> tile_rings;
+    std::vector<std::vector<size_t>> edge_crossings;
+    std::vector<Edge> edges;
+    size_t npieces = 0;
+    double min_corner_distance = funpack(boundary_vertex_distance) / 4;
+    auto split_contours = [&]() -> std::optional<TileLineConflict> {
+        crossings.clear();
+        arcs.clear();
+        tile_arcs.assign(ntiles, {});
+        tile_rings.assign(ntiles, {});
+        edge_crossings.assign(nedges, {});
+        // Split the contours at the tile boundaries.
+        for (size_t contour_id = 0; contour_id < contours.size(); ++contour_id) {
+            const auto& contour = contours[contour_id];
+            struct Item {
+                P2 point;
+                size_t crossing;
+            };
+            std::vector<Item> items;
+            items.reserve(contour.size());
+            size_t first_crossing_item = SIZE_MAX;
+            for (size_t i = 0; i < contour.size(); ++i) {
+                const auto& a = contour[i];
+                const auto& b = contour[(i + 1) % contour.size()];
+                items.push_back({ a, SIZE_MAX });
+                struct SegmentCrossing {
+                    double t;
+                    size_t axis;
+                    size_t line;
+                };
+                std::vector<SegmentCrossing> segment_crossings;
+                auto fa = funpack(a);
+                auto fb = funpack(b);
+                for (size_t axis = 0; axis < 2; ++axis) {
+                    size_t ca = cell_index(lines[axis], fa(axis));
+                    size_t cb = cell_index(lines[axis], fb(axis));
+                    for (size_t l = std::min(ca, cb) + 1; l <= std::max(ca, cb); ++l) {
+                        segment_crossings.push_back({
+                            .t = (funpack(lines[axis][l]) - fa(axis)) / (fb(axis) - fa(axis)),
+                            .axis = axis,
+                            .line = l });
+                    }
+                }
+                std::sort(segment_crossings.begin(), segment_crossings.end(), [](const auto& u, const auto& v){
+                    return u.t < v.t;
+                });
+                for (const auto& s : segment_crossings) {
+                    size_t other = 1 - s.axis;
+                    P2 point = uninitialized;
+                    point(s.axis) = lines[s.axis][s.line];
+                    point(other) = (CompressedScenePos)(fa(other) + s.t * (fb(other) - fa(other)));
+                    size_t cell = cell_index(lines[other], funpack(point(other)));
+                    // The rounding error is at most half a quantum, so a crossing that is
+                    // not on a tile line is on the correct side of it.
+                    // Crossings close to an inner tile corner would create sliver faces,
+                    // that poly2tri can not triangulate reliably.
+                    if ((point(other) == lines[other][cell]) ||
+                        ((cell != 0) && (funpack(point(other) - lines[other][cell]) < min_corner_distance)))
+                    {
+                        return TileLineConflict{ other, cell, point, "Contour passes too close to a tile corner" };
+                    }
+                    if ((point(other) == lines[other][cell + 1]) ||
+                        ((cell + 2 != lines[other].size()) && (funpack(lines[other][cell + 1] - point(other)) < min_corner_distance)))
+                    {
+                        return TileLineConflict{ other, cell + 1, point, "Contour passes too close to a tile corner" };
+                    }
+                    if (first_crossing_item == SIZE_MAX) {
+                        first_crossing_item = items.size();
+                    }
+                    size_t edge = edge_index(s.axis, s.line, cell);
+                    edge_crossings[edge].push_back(crossings.size());
+                    items.push_back({ point, crossings.size() });
+                    crossings.push_back({ .point = point, .edge = edge, .arc_before = SIZE_MAX, .arc_after = SIZE_MAX });
+                }
+            }
+            if (first_crossing_item == SIZE_MAX) {
+                auto p = funpack(contour.front());
+                tile_rings[tile_index(cell_index(lines[0], p(0)), cell_index(lines[1], p(1)))].push_back(contour_id);
+                continue;
+            }
+            size_t current_arc = SIZE_MAX;
+            for (size_t k = 0; k <= items.size(); ++k) {
+                const auto& item = items[(first_crossing_item + k) % items.size()];
+                if (current_arc != SIZE_MAX) {
+                    arcs[current_arc].vertices.push_back(item.point);
+                }
+                if (item.crossing == SIZE_MAX) {
+                    continue;
+                }
+                if (current_arc != SIZE_MAX) {
+                    arcs[current_arc].last_crossing = item.crossing;
+                    crossings[item.crossing].arc_before = current_arc;
+                }
+                if (k == items.size()) {
+                    break;
+                }
+                current_arc = arcs.size();
+                crossings[item.crossing].arc_after = current_arc;
+                arcs.push_back(Arc{
+                    .contour = contour_id,
+                    .tile = SIZE_MAX,
+                    .first_crossing = item.crossing,
+                    .last_crossing = SIZE_MAX,
+                    .vertices = { item.point } });
+            }
+        }
+        for (size_t arc_id = 0; arc_id < arcs.size(); ++arc_id) {
+            auto& arc = arcs[arc_id];
+            auto m = (funpack(arc.vertices[0]) + funpack(arc.vertices[1])) / 2.;
+            arc.tile = tile_index(cell_index(lines[0], m(0)), cell_index(lines[1], m(1)));
+            tile_arcs[arc.tile].push_back(arc_id);
+        }
+
+        // Vertices of the tile boundaries, shared by the adjacent tiles.
+        edges.assign(nedges, {});
+        npieces = 0;
+        for (size_t axis = 0; axis < 2; ++axis) {
+            size_t other = 1 - axis;
+            for (size_t line = 0; line < lines[axis].size(); ++line) {
+                for (size_t cell = 0; cell < ncells[other]; ++cell) {
+                    size_t edge_id = edge_index(axis, line, cell);
+                    auto& edge = edges[edge_id];
+                    auto make_point = [&](CompressedScenePos c){
+                        P2 p = uninitialized;
+                        p(axis) = lines[axis][line];
+                        p(other) = c;
+                        return p;
+                    };
+                    const auto& ec = edge_crossings[edge_id];
+                    CompressedScenePos c0 = lines[other][cell];
+                    CompressedScenePos c1 = lines[other][cell + 1];
+                    edge.vertices.push_back({ make_point(c0), SIZE_MAX });
+                    edge.vertices.push_back({ make_point(c1), SIZE_MAX });
+                    for (size_t c : ec) {
+                        edge.vertices.push_back({ crossings[c].point, c });
+                    }
+                    for (auto c = c0 + boundary_vertex_distance;
+                         funpack(c1 - c) > funpack(boundary_vertex_distance) / 2;
+                         c += boundary_vertex_distance)
+                    {
+                        bool too_close = std::any_of(ec.begin(), ec.end(), [&](size_t i){
+                            return std::abs(funpack(crossings[i].point(other) - c)) < funpack(boundary_vertex_distance) / 4;
+                        });
+                        if (!too_close) {
+                            edge.vertices.push_back({ make_point(c), SIZE_MAX });
+                        }
+                    }
+                    std::sort(edge.vertices.begin(), edge.vertices.end(), [other](const auto& u, const auto& v){
+                        return u.point(other) < v.point(other);
+                    });
+                    for (size_t i = 1; i < edge.vertices.size(); ++i) {
+                        if (edge.vertices[i].point(other) == edge.vertices[i - 1].point(other)) {
+                            return TileLineConflict{ axis, line, edge.vertices[i].point, "Contours cross a tile boundary at the same point" };
+                        }
+                    }
+                    edge.first_piece = npieces;
+                    npieces += edge.vertices.size() - 1;
+                }
+            }
+        }
+        return std::nullopt;
+    };
+    // Move the conflicting tile boundaries, instead of failing for the whole map.
+    for (size_t nnudges = 0;; ++nnudges) {
+        auto conflict = split_contours();
+        if (!conflict.has_value()) {
+            break;
+        }
+        if (nnudges == MAX_TILE_LINE_NUDGES) {
+            THROW_OR_ABORT2((PointException<CompressedScenePos, 2>{ conflict->point, conflict->message }));
+        }
+        nudge_tile_line(lines[conflict->axis], conflict->line, boundary_vertex_distance / 2, coords[conflict->axis]);
+    }
+
+    // Trace the faces of every tile, and assign rings and Steiner points.
+    std::vector<TilePolygon> polygons;
+    std::vector<std::vector<size_t>> tile_polygons(ntiles);
+    for (size_t iy = 0; iy < ncells[1]; ++iy) {
+        for (size_t ix = 0; ix < ncells[0]; ++ix) {
+            size_t tile = tile_index(ix, iy);
+            std::vector<PerimeterVertex> perimeter;
+            auto add_edge = [&](size_t edge_id, bool reverse){
+                const auto& e = edges[edge_id];
+                size_t n = e.vertices.size();
+                for (size_t q = 0; q < n - 1; ++q) {
+                    const auto& v = e.vertices[reverse ? n - 1 - q : q];
+                    perimeter.push_back({
+                        .point = v.point,
+                        .crossing = v.crossing,
+                        .piece = e.first_piece + (reverse ? n - 2 - q : q) });
+                }
+            };
+            // Counterclockwise
+            add_edge(edge_index(1, iy, ix), false);
+            add_edge(edge_index(0, ix + 1, iy), false);
+            add_edge(edge_index(1, iy + 1, ix), true);
+            add_edge(edge_index(0, ix, iy), true);
+            std::unordered_map<size_t, size_t> crossing_to_perimeter;
+            for (size_t k = 0; k < perimeter.size(); ++k) {
+                if (perimeter[k].crossing != SIZE_MAX) {
+                    crossing_to_perimeter.try_emplace(perimeter[k].crossing, k);
+                }
+            }
+            std::vector<bool> visited(perimeter.size(), false);
+            for (size_t k0 = 0; k0 < perimeter.size(); ++k0) {
+                if (visited[k0]) {
+                    continue;
+                }
+                TilePolygon face{ .label = SIZE_MAX };
+                size_t k = k0;
+                do {
+                    if (visited[k]) {
+                        THROW_OR_ABORT2((PointException<CompressedScenePos, 2>{ perimeter[k].point, "Could not trace tile face" }));
+                    }
+                    visited[k] = true;
+                    face.outer.push_back(perimeter[k].point);
+                    face.pieces.push_back(perimeter[k].piece);
+                    size_t k1 = (k + 1) % perimeter.size();
+                    size_t c = perimeter[k1].crossing;
+                    if (c == SIZE_MAX) {
+                        k = k1;
+                        continue;
+                    }
+                    // Follow the contour into the tile.
+                    if (arcs[crossings[c].arc_after].tile == tile) {
+                        const auto& arc = arcs[crossings[c].arc_after];
+                        face.outer.insert(face.outer.end(), arc.vertices.begin(), arc.vertices.end() - 1);
+                        face.forward_contours.push_back(arc.contour);
+                        k = crossing_to_perimeter.at(arc.last_crossing);
+                    } else {
+                        const auto& arc = arcs[crossings[c].arc_before];
+                        face.outer.insert(face.outer.end(), arc.vertices.rbegin(), arc.vertices.rend() - 1);
+                        k = crossing_to_perimeter.at(arc.first_crossing);
+                    }
+                } while (k != k0);
+                face.aabb = polygon_aabb(face.outer);
+                tile_polygons[tile].push_back(polygons.size());
+                polygons.push_back(std::move(face));
+            }
+            size_t nfaces = tile_polygons[tile].size();
+            for (size_t contour_id : tile_rings[tile]) {
+                TilePolygon ring{ .label = contour_id, .outer = contours[contour_id] };
+                ring.aabb = polygon_aabb(ring.outer);
+                tile_polygons[tile].push_back(polygons.size());
+                polygons.push_back(std::move(ring));
+            }
+            // Sort the rings by decreasing area, so that the last ring
+            // containing a point is the innermost one.
+            std::sort(
+                tile_polygons[tile].begin() + (std::ptrdiff_t)nfaces,
+                tile_polygons[tile].end(),
+                [&polygons](size_t a, size_t b){
+                    return polygon_area(polygons[a].outer) > polygon_area(polygons[b].outer);
+                });
+        }
+    }
+    // Innermost polygon of a tile containing a point, excluding "excluded".
+    auto find_parent = [&](size_t tile, const P2& p, size_t excluded) -> size_t {
+        auto fp = funpack(p);
+        const auto& tp = tile_polygons[tile];
+        for (auto it = tp.rbegin(); it != tp.rend(); ++it) {
+            if (polygons[*it].label == SIZE_MAX) {
+                break;
+            }
+            if ((*it != excluded) && polygon_contains(polygons[*it], fp)) {
+                return *it;
+            }
+        }
+        for (size_t i : tp) {
+            if (polygons[i].label != SIZE_MAX) {
+                break;
+            }
+            if (polygon_contains(polygons[i], fp)) {
+                return i;
+            }
+        }
+        THROW_OR_ABORT2((PointException<CompressedScenePos, 2>{ p, "Could not find tile face containing point" }));
+    };
+    for (size_t tile = 0; tile < ntiles; ++tile) {
+        for (size_t contour_id : tile_rings[tile]) {
+            size_t ring = SIZE_MAX;
+            for (size_t i : tile_polygons[tile]) {
+                if (polygons[i].label == contour_id) {
+                    ring = i;
+                }
+            }
+            polygons[find_parent(tile, contours[contour_id].front(), ring)].holes.push_back(ring);
+        }
+    }
+    // Steiner points on a contour vertex could be assigned to a face
+    // that does not contain that vertex.
+    std::unordered_set<OrderableFixedArray<CompressedScenePos, 2>> contour_vertices;
+    for (const auto& c : contours) {
+        for (const auto& p : c) {
+            contour_vertices.insert(OrderableFixedArray{ p });
+        }
+    }
+    for (const auto& p : steiner_points) {
+        if (contour_vertices.contains(OrderableFixedArray{ p })) {
+            continue;
+        }
+        auto fp = funpack(p);
+        if ((fp(0) <= funpack(lines[0].front())) || (fp(0) >= funpack(lines[0].back())) ||
+            (fp(1) <= funpack(lines[1].front())) || (fp(1) >= funpack(lines[1].back())))
+        {
+            continue;
+        }
+        size_t ix = cell_index(lines[0], fp(0));
+        size_t iy = cell_index(lines[1], fp(1));
+        double dist = std::min({
+            fp(0) - funpack(lines[0][ix]),
+            funpack(lines[0][ix + 1]) - fp(0),
+            fp(1) - funpack(lines[1][iy]),
+            funpack(lines[1][iy + 1]) - fp(1) });
+        if (dist < funpack(boundary_vertex_distance) / 2) {
+            continue;
+        }
+        size_t tile = tile_index(ix, iy);
+        polygons[find_parent(tile, p, SIZE_MAX)].steiner_points.push_back(p);
+    }
+
+    // Faces that are connected across tile boundaries belong to the same contour.
+    {
+        UnionFind uf{ polygons.size() };
+        std::vector<size_t> piece_faces(npieces, SIZE_MAX);
+        for (size_t i = 0; i < polygons.size(); ++i) {
+            for (size_t piece : polygons[i].pieces) {
+                if (piece_faces[piece] == SIZE_MAX) {
+                    piece_faces[piece] = i;
+                } else {
+                    uf.merge(piece_faces[piece], i);
+                }
+            }
+        }
+        std::vector<size_t> labels(polygons.size(), SIZE_MAX);
+        for (size_t i = 0; i < polygons.size(); ++i) {
+            for (size_t c : polygons[i].forward_contours) {
+                auto& l = labels[uf.find(i)];
+                if (l == SIZE_MAX) {
+                    l = c;
+                } else if (l != c) {
+                    THROW_OR_ABORT2((PointException<CompressedScenePos, 2>{
+                        polygons[i].outer.front(),
+                        "Could not determine contour ID (" + std::to_string(l) + " vs. " + std::to_string(c) + ')' }));
+                }
+            }
+        }
+        for (size_t i = 0; i < polygons.size(); ++i) {
+            if (!polygons[i].pieces.empty()) {
+                polygons[i].label = labels[uf.find(i)];
+            }
+        }
+    }
+
+    // Triangulate the polygons in parallel. Steiner points too close to
+    // the boundary of a face can make poly2tri fail, so a failing face
+    // is triangulated again without them.
+    std::vector<std::list<Triangle2>> polygon_triangles(polygons.size());
+    // A face that still fails would leave a hole, so the whole
+    // triangulation fails.
+    parallel_for(polygons.size(), [&](size_t i){
+        const auto& polygon = polygons[i];
+        if (polygon.label == SIZE_MAX) {
+            return;
+        }
+        for (bool with_steiner_points : { true, false }) {
+            try {
+                polygon_triangles[i] = triangulate_polygon(polygon, polygons, with_steiner_points, triangulation_scale);
+                return;
+            } catch (const std::exception& e) {
+                if (!with_steiner_points) {
+                    THROW_OR_ABORT2((PointException<CompressedScenePos, 2>{
+                        polygon.outer.front(),
+                        "Could not triangulate tile face: " + std::string(e.what()) }));
+                }
+            }
+        }
+    });
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        if (polygons[i].label != SIZE_MAX) {
+            result[polygons[i].label].splice(result[polygons[i].label].end(), polygon_triangles[i]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <Mlib/Scene_Precision.hpp>
+#include <cstddef>
+#include <list>
+#include <vector>
+
+namespace Mlib {
+
+template <typename TData, size_t... tshape>
+class FixedArray;
+
+/**
+ * Constrained triangulation of the area enclosed by a set of contours,
+ * split into square tiles that are triangulated in parallel.
+ *
+ * The contours must be counterclockwise, implicitly closed and must not
+ * intersect each other. The area to the left of a contour is assigned
+ * to that contour, unless it is separated from the contour by another
+ * contour, which corresponds to the flood-fill of
+ * "extract_triangles_inside_contours". Area that is not to the left of
+ * any contour is not triangulated.
+ *
+ * Contours are split at the tile boundaries, which are subdivided by
+ * vertices every "boundary_vertex_distance" that are shared by both
+ * adjacent tiles, so the tiles can be stitched without T-junctions.
+ * Steiner points closer than half of that distance to a tile boundary
+ * are ignored. Tile boundaries that contours cross close to a tile
+ * corner, or at the same point, are moved.
+ *
+ * A face of a tile that poly2tri fails to triangulate is triangulated
+ * again without Steiner points. If that fails, too, a PointException
+ * is thrown, so the caller can fall back to a single triangulation
+ * instead of leaving a hole.
+ *
+ * The result contains the triangles of every contour,
+ * in the order of "contours".
+ */
+std::vector<std::list<FixedArray<CompressedScenePos, 3, 2>>> triangulate_tiled(
+    const std::vector<std::vector<FixedArray<CompressedScenePos, 2>>>& contours,
+    const std::list<FixedArray<CompressedScenePos, 2>>& steiner_points,
+    CompressedScenePos tile_size,
+    CompressedScenePos boundary_vertex_distance,
+    double triangulation_scale);
+
+}
@@ -1,5 +1,8 @@
 #pragma once
 #include <Mlib/Math/Math.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cstdint>
+#include <span>
 
 namespace Mlib {
 
@@ -57,4 +60,49 @@ bool bilinear_grayscale_interpolation(TData rf, TData cf, const Array<TData>& im
     }
 }
 
+/**
+ * Batch version of "bilinear_grayscale_interpolation".
+ * The positions are sorted by the caller for memory locality,
+ * the loop is branch-free so that it can be vectorized.
+ * "valid[i]" is 0 for positions outside of the image.
+ */
+template <class TData>
+void bilinear_grayscale_interpolation(
+    std::span<const TData> rf,
+    std::span<const TData> cf,
+    const Array<TData>& im,
+    std::span<TData> intensities,
+    std::span<uint8_t> valid)
+{
+    assert(im.ndim() == 2);
+    if ((rf.size() != cf.size()) ||
+        (rf.size() != intensities.size()) ||
+        (rf.size() != valid.size()))
+    {
+        THROW_OR_ABORT("Bilinear interpolation size mismatch");
+    }
+    size_t nrows = im.shape(0);
+    size_t ncols = im.shape(1);
+    if ((nrows < 2) || (ncols < 2)) {
+        THROW_OR_ABORT("Bilinear interpolation requires at least 2x2 pixels");
+    }
+    const TData* data = im.flat_begin();
+    #pragma omp simd
+    for (size_t i = 0; i < rf.size(); ++i) {
+        bool ok = (rf[i] >= 0) && (cf[i] >= 0) && (rf[i] < (TData)nrows) && (cf[i] < (TData)ncols);
+        TData r = ok ? rf[i] : 0;
+        TData c = ok ? cf[i] : 0;
+        size_t r0 = std::min((size_t)r, nrows - 2);
+        size_t c0 = std::min((size_t)c, ncols - 2);
+        TData a0 = r - (TData)r0;
+        TData a1 = c - (TData)c0;
+        const TData* p0 = data + r0 * ncols + c0;
+        const TData* p1 = p0 + ncols;
+        TData v00 = (1 - a0) * p0[0] + a0 * p1[0];
+        TData v01 = (1 - a0) * p0[1] + a0 * p1[1];
+        intensities[i] = (1 - a1) * v00 + a1 * v01;
+        valid[i] = ok;
+    }
+}
+
 }
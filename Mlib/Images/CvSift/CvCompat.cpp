@@ -98,6 +98,7 @@ void Mlib::ocv::GaussianBlur(const Mat<TData>& src, Mat<TData>& dest, float sigm
 
 template <class TData>
 void Mlib::ocv::exp(const TData* src, TData* dst, int len) {
+    #pragma omp simd
     for (int i = 0; i < len; ++i) {
         dst[i] = std::exp(src[i]);
     }
@@ -105,6 +106,7 @@ void Mlib::ocv::exp(const TData* src, TData* dst, int len) {
 
 template <class TData>
 void Mlib::ocv::fastAtan2(const TData* Y, const TData* X, TData* Ori, int len) {
+    #pragma omp simd
     for (int i = 0; i < len; ++i) {
         Ori[i] = std::atan2(Y[i], X[i]) * 180.f / float(M_PI);
         if (Ori[i] < 0.f) {
@@ -118,6 +120,7 @@ void Mlib::ocv::fastAtan2(const TData* Y, const TData* X, TData* Ori, int len) {
 
 template <class TData>
 void Mlib::ocv::magnitude(const TData* X, const TData* Y, TData* Mag, int len) {
+    #pragma omp simd
     for (int i = 0; i < len; ++i) {
         Mag[i] = std::sqrt(squared(X[i]) + squared(Y[i]));
     }
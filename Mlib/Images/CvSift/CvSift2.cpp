@@ -249,6 +249,7 @@ void SIFT2::buildDoGPyramid( const std::vector<Mat<float>>& gpyr, std::vector<Ma
     int nOctaves = (int)gpyr.size()/(nOctaveLayers + 3);
     dogpyr.resize( size_t(nOctaves*(nOctaveLayers + 2)) );
 
+    #pragma omp parallel for
     for (int i = 0; i < nOctaves * (nOctaveLayers + 2); ++i) {
         buildDoGPyramidComputer(nOctaveLayers, gpyr, dogpyr)(XRange<int>{ i, i + 1});
     }
@@ -329,27 +330,46 @@ void SIFT2::findScaleSpaceExtrema( const std::vector<Mat<float>>& gauss_pyr, con
 
     keypoints.clear();
 
+    // One task per (octave, layer, row), processed in parallel.
+    // Every task writes to its own list, which are concatenated
+    // in the serial order to keep the result deterministic.
+    struct RowTask {
+        int o;
+        int i;
+        int r;
+    };
+    std::vector<RowTask> tasks;
     for( int o = 0; o < nOctaves; o++ ) {
         for( int i = 1; i <= nOctaveLayers; i++ )
         {
             const int idx = o*(nOctaveLayers+2)+i;
-            const Mat<float>& img = dog_pyr[(size_t)idx];
-            const int step = (int)img.step1();
-            const int rows = img.rows(), cols = img.cols();
-
+            const int rows = dog_pyr[(size_t)idx].rows();
             for (int r = SIFT_IMG_BORDER; r < rows-SIFT_IMG_BORDER; ++r) {
-                findScaleSpaceExtremaComputer(
-                    o, i, threshold, idx, step, cols,
-                    nOctaveLayers,
-                    contrastThreshold,
-                    edgeThreshold,
-                    sigma,
-                    gauss_pyr,
-                    dog_pyr,
-                    keypoints)(XRange<int>{ r, r + 1 });
+                tasks.push_back({ o, i, r });
             }
         }
     }
+    std::vector<std::vector<KeyPoint>> task_keypoints(tasks.size());
+    #pragma omp parallel for schedule(dynamic, 8)
+    for (int t = 0; t < (int)tasks.size(); ++t) {
+        const RowTask& task = tasks[(size_t)t];
+        const int idx = task.o*(nOctaveLayers+2)+task.i;
+        const Mat<float>& img = dog_pyr[(size_t)idx];
+        const int step = (int)img.step1();
+        const int cols = img.cols();
+        findScaleSpaceExtremaComputer(
+            task.o, task.i, threshold, idx, step, cols,
+            nOctaveLayers,
+            contrastThreshold,
+            edgeThreshold,
+            sigma,
+            gauss_pyr,
+            dog_pyr,
+            task_keypoints[(size_t)t])(XRange<int>{ task.r, task.r + 1 });
+    }
+    for (const auto& kpts : task_keypoints) {
+        keypoints.insert(keypoints.end(), kpts.begin(), kpts.end());
+    }
 }
 
 void calcSIFTDescriptor(
@@ -1180,6 +1200,7 @@ private:
 static void calcDescriptors(const std::vector<Mat<float>>& gpyr, const std::vector<KeyPoint>& keypoints,
                             Mat<float>& descriptors, int nOctaveLayers, int firstOctave )
 {
+    #pragma omp parallel for schedule(dynamic, 16)
     for (int i = 0; i < (int)keypoints.size(); ++i) {
         calcDescriptorsComputer(gpyr, keypoints, descriptors, nOctaveLayers, firstOctave)(XRange<int>{ i, i + 1 });
     }
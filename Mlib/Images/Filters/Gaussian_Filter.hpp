@@ -6,6 +6,9 @@
 
 namespace Mlib {
 
+// Above this sigma, the explicit kernel is replaced by a recursive filter.
+static const float RECURSIVE_GAUSSIAN_MIN_SIGMA = 8.f;
+
 template <class TData, class TSigma>
 Array<TData> gaussian_filter_1d_NWE(
     const Array<TData>& image,
@@ -19,6 +22,20 @@ Array<TData> gaussian_filter_1d_NWE(
     if (sigma == 0) {
         return image.copy();
     }
+    if constexpr (std::is_floating_point_v<TData>) {
+        if ((sigma >= RECURSIVE_GAUSSIAN_MIN_SIGMA) &&
+            (poly_degree < 2) &&
+            !any(fc & FilterExtension::PERIODIC))
+        {
+            return recursive_gaussian_filter_1d<TData>(
+                image,
+                (TData)sigma,
+                boundary_value,
+                axis,
+                any(fc & FilterExtension::NWE),
+                truncate);
+        }
+    }
     Array<TSigma> coeffs{ArrayShape{1 + 2 * size_t(truncate * sigma)}};
     size_t cdist = coeffs.length() / 2;
     for (size_t i = cdist; i < coeffs.length(); ++i) {
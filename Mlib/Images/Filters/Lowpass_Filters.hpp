@@ -1,4 +1,5 @@
 #pragma once
+#include <Mlib/Images/Filters/Tiled_Separable_Filter.hpp>
 #include <Mlib/Math/Math.hpp>
 #include <Mlib/Math/Positive_Modulo.hpp>
 
@@ -23,7 +24,7 @@ inline bool any(FilterExtension c) {
 }
 
 template <class TData, class TCoeffs>
-Array<TData> lowpass_filter_1d_NWE(const Array<TData>& image, const Array<TCoeffs>& coeffs, const TData& boundary_value, size_t axis, FilterExtension fc = FilterExtension::NWE) {
+Array<TData> lowpass_filter_1d_NWE_naive(const Array<TData>& image, const Array<TCoeffs>& coeffs, const TData& boundary_value, size_t axis, FilterExtension fc = FilterExtension::NWE) {
     assert(coeffs.ndim() == 1);
 
     if (coeffs.length() <= 1) {
@@ -69,6 +70,25 @@ Array<TData> lowpass_filter_1d_NWE(const Array<TData>& image, const Array<TCoeff
     return result;
 }
 
+template <class TData, class TCoeffs>
+Array<TData> lowpass_filter_1d_NWE(const Array<TData>& image, const Array<TCoeffs>& coeffs, const TData& boundary_value, size_t axis, FilterExtension fc = FilterExtension::NWE) {
+    if constexpr (std::is_floating_point_v<TData> && std::is_floating_point_v<TCoeffs>) {
+        assert(coeffs.ndim() == 1);
+        if (coeffs.length() <= 1) {
+            return image.copy();
+        }
+        return tiled_separable_filter_1d(
+            image,
+            coeffs,
+            boundary_value,
+            axis,
+            any(fc & FilterExtension::NWE),
+            any(fc & FilterExtension::PERIODIC));
+    } else {
+        return lowpass_filter_1d_NWE_naive(image, coeffs, boundary_value, axis, fc);
+    }
+}
+
 template <class TData>
 Array<TData> lowpass_filter_NWE(
     const Array<TData>& image,
@@ -1,17 +1,28 @@
 #pragma once
 #include <Mlib/Array/Array.hpp>
 #include <Mlib/Stats/Robust.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
 #include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Mlib {
 
+/*
+ * Reference implementation of "rank_filter_2d",
+ * sorts the window of every pixel.
+ */
 template <class TData>
-Array<TData> median_filter_2d(
+Array<TData> rank_filter_2d_naive(
     const Array<TData>& im,
     size_t window_size,
-    size_t minelements = 1,
-    TData boundary_value = NAN)
+    double rank,
+    size_t minelements,
+    TData boundary_value)
 {
     assert(im.ndim() == 2);
     assert(minelements > 0);
@@ -36,7 +47,7 @@ Array<TData> median_filter_2d(
                 }
                 if (nvals >= minelements) {
                     std::sort(values.begin(), values.begin() + (std::ptrdiff_t)nvals);
-                    result((size_t)r, c) = values[nvals / 2];
+                    result((size_t)r, c) = values[std::min(nvals - 1, (size_t)(rank * (double)nvals))];
                 } else {
                     result((size_t)r, c) = boundary_value;
                 }
@@ -46,4 +57,347 @@ Array<TData> median_filter_2d(
     return result;
 }
 
+namespace RankFilterDetail {
+
+/*
+ * Two-level histogram of "tnbits"-bit integers,
+ * the coarse level speeds up rank queries.
+ */
+template <size_t tnbits>
+struct Histogram {
+    static const size_t NBINS = size_t(1) << tnbits;
+    static const size_t FINE_BITS = tnbits / 2;
+    static const size_t NCOARSE = NBINS >> FINE_BITS;
+    Histogram()
+        : coarse(NCOARSE, 0)
+        , fine(NBINS, 0)
+    {}
+    void add(size_t v) {
+        ++coarse[v >> FINE_BITS];
+        ++fine[v];
+    }
+    void remove(size_t v) {
+        --coarse[v >> FINE_BITS];
+        --fine[v];
+    }
+    void add(const Histogram& other) {
+        #pragma omp simd
+        for (size_t i = 0; i < NCOARSE; ++i) {
+            coarse[i] += other.coarse[i];
+        }
+        #pragma omp simd
+        for (size_t i = 0; i < NBINS; ++i) {
+            fine[i] += other.fine[i];
+        }
+    }
+    void remove(const Histogram& other) {
+        #pragma omp simd
+        for (size_t i = 0; i < NCOARSE; ++i) {
+            coarse[i] -= other.coarse[i];
+        }
+        #pragma omp simd
+        for (size_t i = 0; i < NBINS; ++i) {
+            fine[i] -= other.fine[i];
+        }
+    }
+    // Value of the element with 0-based index "k" in sorted order.
+    size_t kth(uint32_t k) const {
+        size_t cb = 0;
+        while (k >= coarse[cb]) {
+            k -= coarse[cb++];
+        }
+        size_t fb = cb << FINE_BITS;
+        while (k >= fine[fb]) {
+            k -= fine[fb++];
+        }
+        return fb;
+    }
+    std::vector<uint32_t> coarse;
+    std::vector<uint32_t> fine;
+};
+
+inline uint32_t rank_index(size_t nvals, double rank) {
+    return (uint32_t)std::min(nvals - 1, (size_t)(rank * (double)nvals));
+}
+
+/*
+ * Source: Perreault, Hebert, "Median Filtering in Constant Time",
+ *         IEEE Transactions on Image Processing 16 (2007)
+ *
+ * The rows are processed in parallel bands, keeping one histogram per column.
+ * Moving one pixel to the right adds and removes a column histogram,
+ * independent of the window size.
+ */
+template <class TData>
+void rank_filter_2d_constant_time(
+    const Array<TData>& im,
+    size_t window_size,
+    double rank,
+    Array<TData>& result)
+{
+    using H = Histogram<8 * sizeof(TData)>;
+    size_t w = window_size;
+    size_t nrows = im.shape(0);
+    size_t ncols = im.shape(1);
+    size_t r0 = w;
+    size_t r1 = nrows - w;
+    uint32_t k = rank_index((2 * w + 1) * (2 * w + 1), rank);
+    static const size_t BAND_HEIGHT = 64;
+    size_t nbands = (r1 - r0 + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    #pragma omp parallel for schedule(dynamic)
+    for (int band = 0; band < (int)nbands; ++band) {
+        size_t b0 = r0 + (size_t)band * BAND_HEIGHT;
+        size_t b1 = std::min(r1, b0 + BAND_HEIGHT);
+        std::vector<H> columns(ncols);
+        for (size_t c = 0; c < ncols; ++c) {
+            for (size_t r = b0 - w; r < b0 + w; ++r) {
+                columns[c].add(im(r, c));
+            }
+        }
+        H kernel;
+        for (size_t r = b0; r < b1; ++r) {
+            for (size_t c = 0; c < ncols; ++c) {
+                if (r != b0) {
+                    columns[c].remove(im(r - w - 1, c));
+                }
+                columns[c].add(im(r + w, c));
+            }
+            kernel = H{};
+            for (size_t c = 0; c < 2 * w + 1; ++c) {
+                kernel.add(columns[c]);
+            }
+            result(r, w) = (TData)kernel.kth(k);
+            for (size_t c = w + 1; c < ncols - w; ++c) {
+                kernel.add(columns[c + w]);
+                kernel.remove(columns[c - w - 1]);
+                result(r, c) = (TData)kernel.kth(k);
+            }
+        }
+    }
+}
+
+/*
+ * Source: Huang, Yang, Tang, "A fast two-dimensional median filtering algorithm",
+ *         IEEE Transactions on Acoustics, Speech, and Signal Processing 27 (1979)
+ *
+ * One histogram per row, moving one pixel to the right
+ * adds and removes one window column.
+ * Used for 16-bit images, where one histogram per column
+ * would not fit into the cache.
+ */
+template <class TData>
+void rank_filter_2d_sliding_histogram(
+    const Array<TData>& im,
+    size_t window_size,
+    double rank,
+    Array<TData>& result)
+{
+    using H = Histogram<8 * sizeof(TData)>;
+    size_t w = window_size;
+    size_t ncols = im.shape(1);
+    uint32_t k = rank_index((2 * w + 1) * (2 * w + 1), rank);
+    #pragma omp parallel
+    {
+        H kernel;
+        #pragma omp for
+        for (int ri = (int)w; ri < (int)(im.shape(0) - w); ++ri) {
+            size_t r = (size_t)ri;
+            for (size_t rr = r - w; rr <= r + w; ++rr) {
+                for (size_t c = 0; c < 2 * w + 1; ++c) {
+                    kernel.add(im(rr, c));
+                }
+            }
+            result(r, w) = (TData)kernel.kth(k);
+            for (size_t c = w + 1; c < ncols - w; ++c) {
+                for (size_t rr = r - w; rr <= r + w; ++rr) {
+                    kernel.add(im(rr, c + w));
+                    kernel.remove(im(rr, c - w - 1));
+                }
+                result(r, c) = (TData)kernel.kth(k);
+            }
+            for (size_t rr = r - w; rr <= r + w; ++rr) {
+                for (size_t c = ncols - 2 * w - 1; c < ncols; ++c) {
+                    kernel.remove(im(rr, c));
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Fenwick tree of counts, "kth" finds the element with
+ * 0-based index "k" in sorted order in O(log n).
+ */
+class FenwickCounts {
+public:
+    void reset(size_t n) {
+        tree_.assign(n + 1, 0);
+        top_ = (n == 0) ? 0 : std::bit_floor(n);
+    }
+    void add(size_t i) {
+        for (++i; i < tree_.size(); i += i & (~i + 1)) {
+            ++tree_[i];
+        }
+    }
+    void remove(size_t i) {
+        for (++i; i < tree_.size(); i += i & (~i + 1)) {
+            --tree_[i];
+        }
+    }
+    size_t kth(uint32_t k) const {
+        size_t pos = 0;
+        for (size_t step = top_; step != 0; step >>= 1) {
+            if ((pos + step < tree_.size()) && (tree_[pos + step] <= k)) {
+                pos += step;
+                k -= tree_[pos];
+            }
+        }
+        return pos;
+    }
+private:
+    std::vector<uint32_t> tree_;
+    size_t top_ = 0;
+};
+
+/*
+ * NaN-values are skipped.
+ * The values of the (2 * w + 1) rows around each row are sorted once,
+ * and the window is a Fenwick tree over their positions in sorted order.
+ * Moving one pixel to the right adds and removes one window column
+ * in O(w * log(w * ncols)).
+ */
+template <class TData>
+void rank_filter_2d_fenwick(
+    const Array<TData>& im,
+    size_t window_size,
+    double rank,
+    size_t minelements,
+    TData boundary_value,
+    Array<TData>& result)
+{
+    static const uint32_t INVALID = UINT32_MAX;
+    size_t w = window_size;
+    size_t h = 2 * w + 1;
+    size_t ncols = im.shape(1);
+    #pragma omp parallel
+    {
+        std::vector<std::pair<TData, uint32_t>> sorted;
+        sorted.reserve(h * ncols);
+        // Position in "sorted" of each pixel of the rows, or INVALID for NaN.
+        std::vector<uint32_t> ids(h * ncols);
+        FenwickCounts counts;
+        size_t nvals = 0;
+        auto add_column = [&](size_t c) {
+            for (size_t rr = 0; rr < h; ++rr) {
+                if (uint32_t id = ids[rr * ncols + c]; id != INVALID) {
+                    counts.add(id);
+                    ++nvals;
+                }
+            }
+        };
+        auto remove_column = [&](size_t c) {
+            for (size_t rr = 0; rr < h; ++rr) {
+                if (uint32_t id = ids[rr * ncols + c]; id != INVALID) {
+                    counts.remove(id);
+                    --nvals;
+                }
+            }
+        };
+        auto set_result = [&](size_t r, size_t c) {
+            result(r, c) = (nvals >= minelements)
+                ? sorted[counts.kth(rank_index(nvals, rank))].first
+                : boundary_value;
+        };
+        #pragma omp for
+        for (int ri = (int)w; ri < (int)(im.shape(0) - w); ++ri) {
+            size_t r = (size_t)ri;
+            sorted.clear();
+            for (size_t rr = 0; rr < h; ++rr) {
+                for (size_t c = 0; c < ncols; ++c) {
+                    const TData& v = im(r - w + rr, c);
+                    if (std::isnan(v)) {
+                        ids[rr * ncols + c] = INVALID;
+                    } else {
+                        sorted.emplace_back(v, (uint32_t)(rr * ncols + c));
+                    }
+                }
+            }
+            std::sort(sorted.begin(), sorted.end());
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                ids[sorted[i].second] = (uint32_t)i;
+            }
+            counts.reset(sorted.size());
+            nvals = 0;
+            for (size_t c = 0; c < h; ++c) {
+                add_column(c);
+            }
+            set_result(r, w);
+            for (size_t c = w + 1; c < ncols - w; ++c) {
+                add_column(c + w);
+                remove_column(c - w - 1);
+                set_result(r, c);
+            }
+        }
+    }
+}
+
+}
+
+/*
+ * Rank (percentile) filter over a (2 * window_size + 1)^2 window.
+ * The result is the element with index "rank * nvals" of the sorted window,
+ * or "boundary_value" within "window_size" pixels of the image border and
+ * if fewer than "minelements" non-NaN values are in the window.
+ *
+ * 8-bit images use constant-time column histograms, 16-bit images a
+ * sliding histogram, and floating point images a Fenwick tree
+ * over the sorted values of the rows around each row.
+ */
+template <class TData>
+Array<TData> rank_filter_2d(
+    const Array<TData>& im,
+    size_t window_size,
+    double rank,
+    size_t minelements,
+    TData boundary_value)
+{
+    assert(im.ndim() == 2);
+    assert(minelements > 0);
+    if ((rank < 0) || (rank > 1)) {
+        THROW_OR_ABORT("Rank is not in the range [0, 1]");
+    }
+    Array<TData> result = full(im.shape(), boundary_value);
+    if (any(im.shape() < window_size) ||
+        (im.shape(0) < 2 * window_size + 1) ||
+        (im.shape(1) < 2 * window_size + 1))
+    {
+        return result;
+    }
+    if ((minelements > (2 * window_size + 1) * (2 * window_size + 1)) &&
+        std::is_integral_v<TData>)
+    {
+        return result;
+    }
+    if constexpr (std::is_same_v<TData, uint8_t>) {
+        RankFilterDetail::rank_filter_2d_constant_time(im, window_size, rank, result);
+    } else if constexpr (std::is_same_v<TData, uint16_t>) {
+        RankFilterDetail::rank_filter_2d_sliding_histogram(im, window_size, rank, result);
+    } else if constexpr (std::is_floating_point_v<TData>) {
+        RankFilterDetail::rank_filter_2d_fenwick(im, window_size, rank, minelements, boundary_value, result);
+    } else {
+        return rank_filter_2d_naive(im, window_size, rank, minelements, boundary_value);
+    }
+    return result;
+}
+
+template <class TData>
+Array<TData> median_filter_2d(
+    const Array<TData>& im,
+    size_t window_size,
+    size_t minelements = 1,
+    TData boundary_value = NAN)
+{
+    return rank_filter_2d(im, window_size, 0.5, minelements, boundary_value);
+}
+
 }
@@ -0,0 +1,283 @@
+#pragma once
+#include <Mlib/Array/Array.hpp>
+#include <Mlib/Math/Pi.hpp>
+#include <Mlib/Math/Positive_Modulo.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <climits>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+namespace Mlib {
+
+namespace SeparableFilterDetail {
+
+static const size_t TILE_WIDTH = 16;
+
+template <std::floating_point TData>
+struct Lines {
+    Lines(const Array<TData>& image, size_t axis) {
+        if (axis >= image.ndim()) {
+            THROW_OR_ABORT("Filter axis out of bounds");
+        }
+        n = image.shape(axis);
+        outer = 1;
+        for (size_t i = 0; i < axis; ++i) {
+            outer *= image.shape(i);
+        }
+        inner = 1;
+        for (size_t i = axis + 1; i < image.ndim(); ++i) {
+            inner *= image.shape(i);
+        }
+        nlines = outer * inner;
+        ntiles = (nlines + TILE_WIDTH - 1) / TILE_WIDTH;
+        if (ntiles > INT_MAX) {
+            THROW_OR_ABORT("Too many filter tiles");
+        }
+    }
+    // Index of element "i" of line "l".
+    size_t index(size_t l, size_t i) const {
+        return ((l / inner) * n + i) * inner + (l % inner);
+    }
+    size_t n;
+    size_t outer;
+    size_t inner;
+    size_t nlines;
+    size_t ntiles;
+};
+
+// Gathers the lines [l0, l0 + TILE_WIDTH) into the buffers,
+// with "pad" samples on both sides.
+template <std::floating_point TData, class TAcc>
+void gather(
+    const Lines<TData>& lines,
+    const TData* src,
+    size_t l0,
+    size_t pad,
+    bool periodic,
+    TAcc* values,
+    TAcc* weights)
+{
+    size_t nl = std::min(TILE_WIDTH, lines.nlines - l0);
+    for (size_t p = 0; p < lines.n + 2 * pad; ++p) {
+        size_t i = p - pad;
+        if (periodic) {
+            i = (size_t)positive_modulo((int)p - (int)pad, (int)lines.n);
+        }
+        TAcc* v = values + p * TILE_WIDTH;
+        TAcc* w = weights + p * TILE_WIDTH;
+        for (size_t l = 0; l < TILE_WIDTH; ++l) {
+            if ((l < nl) && (i < lines.n)) {
+                TData x = src[lines.index(l0 + l, i)];
+                bool valid = !std::isnan(x);
+                v[l] = valid ? (TAcc)x : 0;
+                w[l] = valid ? 1 : 0;
+            } else {
+                v[l] = 0;
+                w[l] = 0;
+            }
+        }
+    }
+}
+
+template <std::floating_point TData, class TAcc>
+void scatter(
+    const Lines<TData>& lines,
+    TData* dst,
+    size_t l0,
+    size_t i,
+    const TAcc* v,
+    const TAcc* w,
+    const TData& boundary_value,
+    bool nwe,
+    TAcc min_weight)
+{
+    size_t nl = std::min(TILE_WIDTH, lines.nlines - l0);
+    for (size_t l = 0; l < nl; ++l) {
+        TData& r = dst[lines.index(l0 + l, i)];
+        // "min_weight" is -INFINITY for explicit kernels, whose weights
+        // may be negative, so only exactly zero weights are empty.
+        if ((w[l] == 0) || (w[l] <= min_weight)) {
+            r = boundary_value;
+        } else if (nwe) {
+            r = (TData)(v[l] / w[l]);
+        } else {
+            r = (TData)v[l];
+        }
+    }
+}
+
+}
+
+/*
+ * Convolution along one axis with an explicit kernel,
+ * centered at "coeffs.length() / 2".
+ *
+ * The array is viewed as (outer, n, inner), where "n" is the length
+ * of the filtered axis. TILE_WIDTH neighboring lines, i.e. consecutive
+ * (outer, inner) pairs, are gathered into a padded, lane-interleaved
+ * buffer of values and validity weights (NaN -> 0), filtered
+ * with the inner loop running over the lanes, and scattered back.
+ * Tiles are processed in parallel.
+ *
+ * The result is "boundary_value" where no valid sample contributes,
+ * "value / weight" if "nwe" is set, and "value" otherwise.
+ */
+template <std::floating_point TData, class TCoeffs>
+Array<TData> tiled_separable_filter_1d(
+    const Array<TData>& image,
+    const Array<TCoeffs>& coeffs,
+    const TData& boundary_value,
+    size_t axis,
+    bool nwe,
+    bool periodic)
+{
+    using namespace SeparableFilterDetail;
+    using TAcc = decltype(TCoeffs() * TData());
+    assert(coeffs.ndim() == 1);
+    Lines<TData> lines{ image, axis };
+    Array<TData> result{ image.shape() };
+    if ((lines.n == 0) || (lines.nlines == 0)) {
+        return result;
+    }
+    size_t pad = coeffs.length() / 2;
+    size_t nd = coeffs.length();
+    std::vector<TAcc> c(nd);
+    for (size_t d = 0; d < nd; ++d) {
+        c[d] = (TAcc)coeffs(d);
+    }
+    const TData* src = image.flat_begin();
+    TData* dst = result.flat_begin();
+    #pragma omp parallel if (lines.n * lines.nlines * nd > 64 * 64 * 16)
+    {
+        std::vector<TAcc> values((lines.n + 2 * pad) * TILE_WIDTH);
+        std::vector<TAcc> weights(values.size());
+        #pragma omp for
+        for (int t = 0; t < (int)lines.ntiles; ++t) {
+            size_t l0 = (size_t)t * TILE_WIDTH;
+            gather(lines, src, l0, pad, periodic, values.data(), weights.data());
+            for (size_t i = 0; i < lines.n; ++i) {
+                TAcc v[TILE_WIDTH] = {};
+                TAcc w[TILE_WIDTH] = {};
+                for (size_t d = 0; d < nd; ++d) {
+                    TAcc cd = c[d];
+                    const TAcc* vi = &values[(i + d) * TILE_WIDTH];
+                    const TAcc* wi = &weights[(i + d) * TILE_WIDTH];
+                    #pragma omp simd
+                    for (size_t l = 0; l < TILE_WIDTH; ++l) {
+                        v[l] += cd * vi[l];
+                        w[l] += cd * wi[l];
+                    }
+                }
+                scatter(lines, dst, l0, i, v, w, boundary_value, nwe, -TAcc(INFINITY));
+            }
+        }
+    }
+    return result;
+}
+
+/*
+ * Recursive Gaussian filter, the cost per sample does not depend on sigma.
+ *
+ * Source: Young, van Vliet, "Recursive implementation of the Gaussian filter",
+ *         Signal Processing 44 (1995)
+ *
+ * The signal is zero-padded by "truncate * sigma" samples on both sides,
+ * NaN-values are handled like in "tiled_separable_filter_1d".
+ * Periodic extension is not supported.
+ */
+template <std::floating_point TData>
+Array<TData> recursive_gaussian_filter_1d(
+    const Array<TData>& image,
+    const TData& sigma,
+    const TData& boundary_value,
+    size_t axis,
+    bool nwe,
+    const TData& truncate = 4)
+{
+    using namespace SeparableFilterDetail;
+    using TAcc = TData;
+    if (sigma < TData(0.5)) {
+        THROW_OR_ABORT("Recursive Gaussian filter requires sigma >= 0.5");
+    }
+    Lines<TData> lines{ image, axis };
+    Array<TData> result{ image.shape() };
+    if ((lines.n == 0) || (lines.nlines == 0)) {
+        return result;
+    }
+    double q = (sigma >= 2.5)
+        ? 0.98711 * sigma - 0.96330
+        : 3.97156 - 4.14554 * std::sqrt(1 - 0.26891 * sigma);
+    double q2 = q * q;
+    double q3 = q2 * q;
+    double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    TAcc b1 = TAcc((2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0);
+    TAcc b2 = TAcc(-(1.4281 * q2 + 1.26661 * q3) / b0);
+    TAcc b3 = TAcc(0.422205 * q3 / b0);
+    TAcc B = 1 - (b1 + b2 + b3);
+    size_t pad = (size_t)std::ceil(truncate * sigma);
+    size_t np = lines.n + 2 * pad;
+    const TData* src = image.flat_begin();
+    TData* dst = result.flat_begin();
+    // Weights below this threshold stem from samples further away than
+    // the truncation radius (or from rounding), so they count as "no sample".
+    TAcc min_weight = TAcc(std::exp(-0.5 * truncate * truncate) / (std::sqrt(2 * M_PI) * sigma));
+    #pragma omp parallel if (np * lines.nlines > 64 * 64 * 16)
+    {
+        std::vector<TAcc> values((np + 3) * TILE_WIDTH);
+        std::vector<TAcc> weights(values.size());
+        #pragma omp for
+        for (int t = 0; t < (int)lines.ntiles; ++t) {
+            size_t l0 = (size_t)t * TILE_WIDTH;
+            // Three leading zero samples hold the initial filter state.
+            std::fill(values.begin(), values.begin() + 3 * TILE_WIDTH, TAcc(0));
+            std::fill(weights.begin(), weights.begin() + 3 * TILE_WIDTH, TAcc(0));
+            gather(lines, src, l0, pad, false, &values[3 * TILE_WIDTH], &weights[3 * TILE_WIDTH]);
+            for (TAcc* x : { values.data(), weights.data() }) {
+                // Causal pass
+                for (size_t p = 3; p < np + 3; ++p) {
+                    TAcc* y = x + p * TILE_WIDTH;
+                    #pragma omp simd
+                    for (size_t l = 0; l < TILE_WIDTH; ++l) {
+                        y[l] = B * y[l]
+                            + b1 * y[l - TILE_WIDTH]
+                            + b2 * y[l - 2 * TILE_WIDTH]
+                            + b3 * y[l - 3 * TILE_WIDTH];
+                    }
+                }
+                // Anti-causal pass, the padding absorbs the initial state.
+                TAcc y1[TILE_WIDTH] = {};
+                TAcc y2[TILE_WIDTH] = {};
+                TAcc y3[TILE_WIDTH] = {};
+                for (size_t p = np + 2; p >= 3; --p) {
+                    TAcc* y = x + p * TILE_WIDTH;
+                    #pragma omp simd
+                    for (size_t l = 0; l < TILE_WIDTH; ++l) {
+                        TAcc r = B * y[l] + b1 * y1[l] + b2 * y2[l] + b3 * y3[l];
+                        y3[l] = y2[l];
+                        y2[l] = y1[l];
+                        y1[l] = r;
+                        y[l] = r;
+                    }
+                }
+            }
+            for (size_t i = 0; i < lines.n; ++i) {
+                size_t p = 3 + pad + i;
+                scatter(
+                    lines,
+                    dst,
+                    l0,
+                    i,
+                    &values[p * TILE_WIDTH],
+                    &weights[p * TILE_WIDTH],
+                    boundary_value,
+                    nwe,
+                    min_weight);
+            }
+        }
+    }
+    return result;
+}
+
+}
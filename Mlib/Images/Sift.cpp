@@ -406,7 +406,12 @@ std::list<KeyPointWithOrientation> findScaleSpaceExtrema(
             const auto& second_image = dog_images_in_octave[image_index + 1];
             const auto& third_image = dog_images_in_octave[image_index + 2];
             // (i, j) is the center of the 3x3 array
-            for (size_t i = image_border_width; i + image_border_width < first_image.shape(0); ++i) {
+            // Rows are processed in parallel, every row collects its keypoints
+            // separately, and the rows are concatenated in order.
+            std::vector<std::list<KeyPointWithOrientation>> row_keypoints(first_image.shape(0));
+            #pragma omp parallel for schedule(dynamic, 4)
+            for (int ii = (int)image_border_width; ii < (int)first_image.shape(0) - (int)image_border_width; ++ii) {
+                size_t i = (size_t)ii;
                 for (size_t j = image_border_width; j + image_border_width < first_image.shape(1); ++j) {
                     if (isPixelAnExtremum(i, j, first_image, second_image, third_image, threshold)) {
                         KeyPoint keypoint;
@@ -414,13 +419,14 @@ std::list<KeyPointWithOrientation> findScaleSpaceExtrema(
                         if (localizeExtremumViaQuadraticFit(i, j, localized_image_index, keypoint, octave_index, num_intervals, dog_images_in_octave, sigma, contrast_threshold, image_border_width))
                         {
                             std::list<KeyPointWithOrientation> keypoints_with_orientations = computeKeypointsWithOrientations(keypoint, octave_index, gaussian_images[octave_index][localized_image_index]);
-                            for (const auto& keypoint_with_orientation : keypoints_with_orientations) {
-                                keypoints.push_back(keypoint_with_orientation);
-                            }
+                            row_keypoints[i].splice(row_keypoints[i].end(), keypoints_with_orientations);
                         }
                     }
                 }
             }
+            for (auto& r : row_keypoints) {
+                keypoints.splice(keypoints.end(), r);
+            }
         }
     }
     return keypoints;
@@ -487,9 +493,17 @@ std::list<Array<float>> generateDescriptors(
     // Generate descriptors for each keypoint
     //
     // logger.debug('Generating descriptors...')
-    std::list<Array<float>> descriptors;
-
+    // The descriptors are independent of each other and computed in parallel.
+    std::vector<const KeyPointWithOrientation*> keypoint_list;
+    keypoint_list.reserve(keypoints.size());
     for (const KeyPointWithOrientation& keypoint : keypoints) {
+        keypoint_list.push_back(&keypoint);
+    }
+    std::vector<Array<float>> descriptor_list(keypoint_list.size());
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int k = 0; k < (int)keypoint_list.size(); ++k) {
+        const KeyPointWithOrientation& keypoint = *keypoint_list[(size_t)k];
         UnpackedKeypoint u = unpackOctave(keypoint.kp);
         const Array<float>& gaussian_image = gaussian_images[u.octave_plus_1][u.layer];
         FixedArray<size_t, 2> gshape = gaussian_image.fixed_shape<2>();
@@ -600,9 +614,9 @@ std::list<Array<float>> generateDescriptors(
             descriptor_vector = (2.f * fac * descriptor_vector).applied([](float v){return std::round(v);});
             descriptor_vector = clipped(descriptor_vector, 0.f, fac);
         }
-        descriptors.push_back(descriptor_vector);
+        descriptor_list[(size_t)k] = descriptor_vector;
     }
-    return descriptors;
+    return std::list<Array<float>>(descriptor_list.begin(), descriptor_list.end());
 }
 
 // #################
@@ -1,4 +1,5 @@
 #include "Huber_Rof.hpp"
+#include <Mlib/Array/Lazy_Array.hpp>
 #include <Mlib/Images/Draw_Bmp.hpp>
 #include <Mlib/Images/Filters/Backward_Differences_Pad_Zeros.hpp>
 #include <Mlib/Images/Filters/Central_Differences.hpp>
@@ -397,9 +398,10 @@ void compute_sigmas_ravich2(float& sigma_d, float& sigma_q, float theta, float e
 }
 
 Array<float> update_q(const Array<float>& g, const Array<float>& q, const Array<float>& d, float epsilon, float sigma_q) {
+    Array<float> AGd_ = AGd(g, d);
     return saturate(
-        (q + sigma_q * AGd(g, d)) /
-        (1 + sigma_q * epsilon));
+        ((lazy(q) + sigma_q * lazy(AGd_)) /
+        (1 + sigma_q * epsilon)).eval());
 }
 
 Array<float> update_d(
@@ -412,8 +414,11 @@ Array<float> update_d(
     float d_min,
     float d_max)
 {
-    return clipped((d + sigma_d * (-AGaq(g, q) + 1 / theta * a)) /
-        (1 + sigma_d / theta), d_min, d_max);
+    Array<float> AGaq_ = AGaq(g, q);
+    return ((lazy(d) + sigma_d * (1 / theta * lazy(a) - lazy(AGaq_))) /
+        (1 + sigma_d / theta))
+        .applied([d_min, d_max](float v){ return clipped_element(v, d_min, d_max); })
+        .eval();
 }
 
 Array<float> Mlib::HuberRof::g_from_grayscale(
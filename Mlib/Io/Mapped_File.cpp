@@ -0,0 +1,113 @@
+#include "Mapped_File.hpp"
+#include <Mlib/Os/Os.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+
+#if defined(__ANDROID__)
+#elif defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Mlib;
+
+#if defined(__ANDROID__)
+
+MappedFile::MappedFile(const std::filesystem::path& filename)
+    : buffer_{ read_file_bytes(filename) }
+{
+    data_ = reinterpret_cast<const char*>(buffer_.data());
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#elif defined(_WIN32)
+
+MappedFile::MappedFile(const std::filesystem::path& filename)
+    : data_{ nullptr }
+    , size_{ 0 }
+    , file_{ INVALID_HANDLE_VALUE }
+    , mapping_{ nullptr }
+{
+    file_ = CreateFileW(
+        filename.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        THROW_OR_ABORT("Could not open \"" + filename.string() + '"');
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size)) {
+        CloseHandle(file_);
+        THROW_OR_ABORT("Could not get size of \"" + filename.string() + '"');
+    }
+    size_ = (size_t)size.QuadPart;
+    if (size_ == 0) {
+        return;
+    }
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr) {
+        CloseHandle(file_);
+        THROW_OR_ABORT("Could not map \"" + filename.string() + '"');
+    }
+    data_ = (const char*)MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (data_ == nullptr) {
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+        THROW_OR_ABORT("Could not map view of \"" + filename.string() + '"');
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    CloseHandle(file_);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& filename)
+    : data_{ nullptr }
+    , size_{ 0 }
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        THROW_OR_ABORT("Could not open \"" + filename.string() + '"');
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        THROW_OR_ABORT("Could not get size of \"" + filename.string() + '"');
+    }
+    size_ = (size_t)st.st_size;
+    if (size_ == 0) {
+        close(fd);
+        return;
+    }
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        THROW_OR_ABORT("Could not map \"" + filename.string() + '"');
+    }
+    data_ = (const char*)data;
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+#endif
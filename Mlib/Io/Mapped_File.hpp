@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace Mlib {
+
+/**
+ * Read-only view of an entire file.
+ * Uses mmap (MapViewOfFile on Windows); on Android,
+ * where files are served by the asset manager, the file is read into memory.
+ * The data can be read concurrently by any number of threads.
+ */
+class MappedFile {
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+public:
+    explicit MappedFile(const std::filesystem::path& filename);
+    ~MappedFile();
+    std::span<const char> data() const {
+        return { data_, size_ };
+    }
+    size_t size() const {
+        return size_;
+    }
+private:
+    const char* data_;
+    size_t size_;
+#if defined(__ANDROID__)
+    std::vector<uint8_t> buffer_;
+#elif defined(_WIN32)
+    void* file_;
+    void* mapping_;
+#endif
+};
+
+}
@@ -0,0 +1,55 @@
+#include "Mapped_IStream_Dictionary.hpp"
+#include <Mlib/Io/Mapped_File.hpp>
+#include <Mlib/Memory/Integral_Cast.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <spanstream>
+
+using namespace Mlib;
+
+namespace {
+
+// Keeps the mapping alive while the stream is in use.
+class MappedIStream: public std::ispanstream {
+public:
+    MappedIStream(std::span<const char> span, std::shared_ptr<const MappedFile> file)
+        : std::ispanstream{ span }
+        , file_{ std::move(file) }
+    {}
+private:
+    std::shared_ptr<const MappedFile> file_;
+};
+
+}
+
+MappedIStreamDictionary::MappedIStreamDictionary(
+    std::shared_ptr<const MappedFile> file,
+    Map<std::string, StreamSegment> directory)
+    : file_{ std::move(file) }
+    , directory_{ std::move(directory) }
+{}
+
+MappedIStreamDictionary::~MappedIStreamDictionary() = default;
+
+std::vector<std::string> MappedIStreamDictionary::names() const {
+    return directory_.keys();
+}
+
+StreamAndSize MappedIStreamDictionary::read(
+    const std::string& name,
+    std::ios::openmode openmode,
+    SourceLocation loc)
+{
+    if (openmode != std::ios::binary) {
+        THROW_OR_ABORT("Open-mode is not binary");
+    }
+    const auto& v = directory_.get(name);
+    auto offset = integral_cast<size_t>(v.offset);
+    if (offset > file_->size()) {
+        THROW_OR_ABORT("Entry \"" + name + "\" starts beyond the end of the archive");
+    }
+    // Entry sizes may be rounded up to the sector size.
+    auto size = std::min(integral_cast<size_t>(v.size), file_->size() - offset);
+    return {
+        std::make_unique<MappedIStream>(file_->data().subspan(offset, size), file_),
+        integral_cast<std::streamsize>(size) };
+}
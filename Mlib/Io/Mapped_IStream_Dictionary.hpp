@@ -0,0 +1,33 @@
+#pragma once
+#include <Mlib/Io/IIStream_Dictionary.hpp>
+#include <Mlib/Io/Stream_Segment.hpp>
+#include <Mlib/Map/Map.hpp>
+#include <memory>
+#include <string>
+
+namespace Mlib {
+
+class MappedFile;
+
+/**
+ * Archive whose entries are segments of a memory-mapped file.
+ * Each call to "read" returns an independent stream over its segment,
+ * so entries can be read concurrently and without locks.
+ */
+class MappedIStreamDictionary: public IIStreamDictionary {
+public:
+    MappedIStreamDictionary(
+        std::shared_ptr<const MappedFile> file,
+        Map<std::string, StreamSegment> directory);
+    virtual ~MappedIStreamDictionary() override;
+    virtual std::vector<std::string> names() const override;
+    virtual StreamAndSize read(
+        const std::string& name,
+        std::ios::openmode openmode,
+        SourceLocation loc) override;
+private:
+    std::shared_ptr<const MappedFile> file_;
+    Map<std::string, StreamSegment> directory_;
+};
+
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 namespace Mlib {
 
@@ -31,6 +32,11 @@ public:
     {
         return container_.rend();
     }
+
+    size_t size() const
+    {
+        return container_.size();
+    }
 private:
     TContainer& container_;
 };
@@ -8,6 +8,13 @@
 #include <Mlib/Regex/Template_Regex.hpp>
 #include <Mlib/Strings/String.hpp>
 #include <Mlib/Strings/String_View_To_Number.hpp>
+#include <Mlib/Threads/Safe_Atomic_Shared_Mutex.hpp>
+#include <memory>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace DbQueryGroups {
 BEGIN_MATCH_COUNTER;
@@ -26,25 +33,6 @@ DECLARE_MATCH_COUNTER(key);
 using namespace Mlib;
 using namespace Mlib::TemplateRegex;
 
-template <class T>
-struct FalseJsonEval {
-    static const bool value = false;
-};
-
-template <class T>
-static T get(
-    const std::string& var,
-    const JsonView& globals,
-    const JsonView& locals)
-{
-    auto g = globals.try_at<T>(var);
-    if (g.has_value()) {
-        return g.value();
-    } else {
-        return locals.at<T>(var);
-    }
-}
-
 static const nlohmann::json& at(
     const std::string_view& s,
     const nlohmann::json& globals,
@@ -65,61 +53,320 @@ static const auto NSL = group(plus(CharPredicate([](char c){ return c != '/'; })
 static const auto W = group(plus(CharPredicate(is_word)));
 static const auto NC = group(plus(CharPredicate([](char c){ return c != ','; })));
 
-static nlohmann::json eval_recursion(
+namespace {
+
+struct EvalContext {
+    const nlohmann::json& globals;
+    const nlohmann::json& locals;
+    const AssetReferences& asset_references;
+};
+
+struct DbQuery;
+
+// Parsed form of a string with "$variable" substitutions.
+class DollarTemplate {
+public:
+    explicit DollarTemplate(std::string_view s);
+    std::string eval(const EvalContext& ctx) const;
+private:
+    struct Segment {
+        std::string text;
+        bool is_variable;
+        std::unique_ptr<DbQuery> query;
+    };
+    std::vector<Segment> segments_;
+};
+
+// Parsed form of "group/asset_id/value[/key]".
+struct DbQuery {
+    DollarTemplate group;
+    DollarTemplate asset_id;
+    std::string value;
+    std::optional<DollarTemplate> key;
+    std::string source;
+
+    template <size_t tngroups>
+    DbQuery(const SMatch<tngroups>& match, std::string_view source)
+        : group{ match[DbQueryGroups::group].str() }
+        , asset_id{ match[DbQueryGroups::asset_id].str() }
+        , value{ match[DbQueryGroups::value].str() }
+        , key{ match[DbQueryGroups::key].matched
+            ? std::optional<DollarTemplate>{ std::in_place, match[DbQueryGroups::key].str() }
+            : std::nullopt }
+        , source{ source }
+    {}
+
+    nlohmann::json eval(const EvalContext& ctx) const {
+        const auto& db = ctx.asset_references[group.eval(ctx)]
+            .at(asset_id.eval(ctx))
+            .rp
+            .database;
+        if (!key.has_value()) {
+            return db.at(value);
+        }
+        auto res = db.at(value);
+        if (res.type() != nlohmann::detail::value_t::object) {
+            THROW_OR_ABORT("Database value is not of type object: \"" + source + '"');
+        }
+        auto k = key->eval(ctx);
+        auto it = res.find(k);
+        if (it == res.end()) {
+            THROW_OR_ABORT("Could not find database key \"" + k + "\": \"" + source + '"');
+        }
+        return *it;
+    }
+};
+
+DollarTemplate::DollarTemplate(std::string_view s) {
+    split_dollar(
+        s,
+        [this](std::string_view literal) {
+            if (!segments_.empty() && !segments_.back().is_variable) {
+                segments_.back().text += literal;
+            } else {
+                segments_.emplace_back(std::string{ literal }, false, nullptr);
+            }
+        },
+        [this](std::string_view variable) {
+            if (variable.empty()) {
+                THROW_OR_ABORT("Received empty substitution variable");
+            }
+            if (variable[0] == '$') {
+                static const auto query_re = seq(adot, NSL, sl, NSL, sl, W, opt(seq(sl, NSL)), eof);
+                SMatch<5> match;
+                if (!regex_match(variable, match, query_re)) {
+                    THROW_OR_ABORT("Could not parse asset path: \"" + std::string{ variable } + '"');
+                }
+                segments_.emplace_back(std::string{ variable }, true, std::make_unique<DbQuery>(match, variable));
+            } else {
+                segments_.emplace_back(std::string{ variable }, true, nullptr);
+            }
+        });
+}
+
+std::string DollarTemplate::eval(const EvalContext& ctx) const {
+    if ((segments_.size() == 1) && !segments_[0].is_variable) {
+        return segments_[0].text;
+    }
+    std::string result;
+    for (const auto& s : segments_) {
+        if (!s.is_variable) {
+            result += s.text;
+            continue;
+        }
+        if (s.query != nullptr) {
+            auto v = s.query->eval(ctx);
+            if (v.type() != nlohmann::detail::value_t::string) {
+                THROW_OR_ABORT("Database value is not of type string: \"" + s.text + '"');
+            }
+            result += v.get_ref<const std::string&>();
+        } else {
+            const auto& v = at(s.text, ctx.globals, ctx.locals);
+            if (v.type() != nlohmann::detail::value_t::string) {
+                std::stringstream sstr;
+                sstr << "Variable \"" << s.text << "\" is not of type string. Value: \"" << v << '"';
+                THROW_OR_ABORT(sstr.str());
+            }
+            result += v.get_ref<const std::string&>();
+        }
+    }
+    return result;
+}
+
+// Node of the compiled expression tree.
+class JsonExpression {
+public:
+    virtual ~JsonExpression() = default;
+    virtual nlohmann::json eval(const EvalContext& ctx) const = 0;
+    virtual const nlohmann::json* constant() const {
+        return nullptr;
+    }
+};
+
+class ConstantExpression: public JsonExpression {
+public:
+    explicit ConstantExpression(nlohmann::json value)
+        : value_(std::move(value))
+    {}
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        return value_;
+    }
+    virtual const nlohmann::json* constant() const override {
+        return &value_;
+    }
+private:
+    nlohmann::json value_;
+};
+
+class SubstitutionExpression: public JsonExpression {
+public:
+    explicit SubstitutionExpression(std::string_view s)
+        : template_{ s }
+    {}
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        return template_.eval(ctx);
+    }
+private:
+    DollarTemplate template_;
+};
+
+enum class ComparisonOperator {
+    EQUAL,
+    NOT_EQUAL,
+    IN,
+    NOT_IN
+};
+
+class ComparisonExpression: public JsonExpression {
+public:
+    ComparisonExpression(
+        ComparisonOperator op,
+        std::unique_ptr<JsonExpression> left,
+        std::unique_ptr<JsonExpression> right)
+        : op_{ op }
+        , left_{ std::move(left) }
+        , right_{ std::move(right) }
+    {
+        if (((op_ == ComparisonOperator::IN) || (op_ == ComparisonOperator::NOT_IN)) &&
+            (right_->constant() != nullptr))
+        {
+            constant_elements_ = right_->constant()->get<std::set<nlohmann::json>>();
+        }
+    }
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        switch (op_) {
+        case ComparisonOperator::EQUAL:
+            return left_->eval(ctx) == right_->eval(ctx);
+        case ComparisonOperator::NOT_EQUAL:
+            return left_->eval(ctx) != right_->eval(ctx);
+        case ComparisonOperator::IN:
+            return contains(ctx);
+        case ComparisonOperator::NOT_IN:
+            return !contains(ctx);
+        }
+        THROW_OR_ABORT("Unknown comparison operator");
+    }
+private:
+    bool contains(const EvalContext& ctx) const {
+        if (constant_elements_.has_value()) {
+            return constant_elements_->contains(left_->eval(ctx));
+        }
+        auto elems = right_->eval(ctx).get<std::set<nlohmann::json>>();
+        return elems.contains(left_->eval(ctx));
+    }
+    ComparisonOperator op_;
+    std::unique_ptr<JsonExpression> left_;
+    std::unique_ptr<JsonExpression> right_;
+    std::optional<std::set<nlohmann::json>> constant_elements_;
+};
+
+class SetExpression: public JsonExpression {
+public:
+    void add(std::unique_ptr<JsonExpression> element, std::string_view source) {
+        elements_.emplace_back(std::move(element), std::string{ source });
+    }
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        std::set<nlohmann::json> result;
+        for (const auto& [e, source] : elements_) {
+            if (!result.insert(e->eval(ctx)).second) {
+                THROW_OR_ABORT("Duplicate element: \"" + source + '"');
+            }
+        }
+        return result;
+    }
+    bool is_constant() const {
+        for (const auto& [e, _] : elements_) {
+            if (e->constant() == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    }
+private:
+    std::vector<std::pair<std::unique_ptr<JsonExpression>, std::string>> elements_;
+};
+
+class VariableExpression: public JsonExpression {
+public:
+    explicit VariableExpression(std::string_view name)
+        : name_{ name }
+    {}
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        return at(name_, ctx.globals, ctx.locals);
+    }
+private:
+    std::string name_;
+};
+
+class DictQueryExpression: public JsonExpression {
+public:
+    DictQueryExpression(std::string_view dict, std::string_view key)
+        : dict_{ dict }
+        , key_{ key }
+    {}
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        auto dict_name = dict_.eval(ctx);
+        const auto& dict = at(dict_name, ctx.globals, ctx.locals);
+        if (dict.type() != nlohmann::detail::value_t::object) {
+            THROW_OR_ABORT("Variable \"" + dict_name + "\" is not a dictionary");
+        }
+        return JsonView{ dict }.at(key_.eval(ctx));
+    }
+private:
+    DollarTemplate dict_;
+    DollarTemplate key_;
+};
+
+class DbQueryExpression: public JsonExpression {
+public:
+    template <size_t tngroups>
+    DbQueryExpression(const SMatch<tngroups>& match, std::string_view source)
+        : query_{ match, source }
+    {}
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        return query_.eval(ctx);
+    }
+private:
+    DbQuery query_;
+};
+
+class NegationExpression: public JsonExpression {
+public:
+    NegationExpression(std::unique_ptr<JsonExpression> child, std::string_view source)
+        : child_{ std::move(child) }
+        , source_{ source }
+    {}
+    virtual nlohmann::json eval(const EvalContext& ctx) const override {
+        auto var = child_->eval(ctx);
+        if (var.type() != nlohmann::detail::value_t::boolean) {
+            THROW_OR_ABORT("Variable is not of type bool: \"" + source_ + '"');
+        }
+        return !var.get<bool>();
+    }
+private:
+    std::unique_ptr<JsonExpression> child_;
+    std::string source_;
+};
+
+struct StringHash {
+    using is_transparent = void;
+    size_t operator () (std::string_view s) const {
+        return std::hash<std::string_view>()(s);
+    }
+};
+
+}
+
+static std::unique_ptr<JsonExpression> compile_recursion(
     std::string_view expression,
-    const JsonView& globals,
-    const JsonView& locals,
-    const AssetReferences& asset_references,
     size_t recursion)
 {
     if (recursion > 100) {
         THROW_OR_ABORT("Detected possibly infinite recursion");
     }
     if (expression.empty()) {
-        return "";
+        return std::make_unique<ConstantExpression>("");
     }
-    std::function<std::string(const std::string_view&)> subst;
-    auto subst_ = [&globals, &locals, &asset_references, &subst](const std::string_view& s) {
-        if (s.empty()) {
-            THROW_OR_ABORT("Received empty substitution variable");
-        }
-        if (s[0] == '$') {
-            static const auto query_re = seq(adot, NSL, sl, NSL, sl, W, opt(seq(sl, NSL)), eof);
-            SMatch<5> match;
-            if (!regex_match(s, match, query_re)) {
-                THROW_OR_ABORT("Could not parse asset path: \"" + std::string{ s } + '"');
-            }
-            const auto& db = asset_references[subst(match[DbQueryGroups::group].str())]
-                .at(subst(match[DbQueryGroups::asset_id].str()))
-                .rp
-                .database;
-            if (match[DbQueryGroups::key].matched) {
-                auto res = db.at(match[DbQueryGroups::value].str());
-                if (res.type() != nlohmann::detail::value_t::object) {
-                    THROW_OR_ABORT("Database value is not of type object: \"" + std::string{ s } + '"');
-                }
-                auto key = subst(match[DbQueryGroups::key].str());
-                auto it = res.find(key);
-                if (it == res.end()) {
-                    THROW_OR_ABORT("Could not find database key \"" + std::string{ key } + "\": \"" + std::string{ s } + '"');
-                }
-                if (it->type() != nlohmann::detail::value_t::string) {
-                    THROW_OR_ABORT("Database value is not of type string: \"" + std::string{ s } + '"');
-                }
-                return it->get<std::string>();
-            } else {
-                return db.at<std::string>(match[DbQueryGroups::value].str());
-            }
-        }
-        const auto& v = at(s, globals.json(), locals.json());
-        if (v.type() != nlohmann::detail::value_t::string) {
-            std::stringstream sstr;
-            sstr << "Variable \"" << s << "\" is not of type string. Value: \"" << v << '"';
-            THROW_OR_ABORT(sstr.str());
-        }
-        return v.get<std::string>();
-    };
-    subst = [&subst_](const std::string_view& s){return Mlib::substitute_dollar(s, subst_);};
     if (recursion == 0) {
         if (std::isalpha(expression[0]) ||
             (expression[0] == '.')  ||
@@ -131,7 +378,7 @@ static nlohmann::json eval_recursion(
             (expression[0] == '\\') ||
             (expression[0] == '/'))
         {
-            return subst(expression);
+            return std::make_unique<SubstitutionExpression>(expression);
         }
     }
     {
@@ -144,40 +391,41 @@ static nlohmann::json eval_recursion(
             group(plus(adot)),
             eof);
         if (SMatch<4> match; regex_match(expression, match, comparison_re)) {
-            std::string_view left = match[1].str();
             std::string_view op = match[2].str();
-            std::string_view right = match[3].str();
+            ComparisonOperator cop;
             if (op == "==") {
-                return eval_recursion(left, globals, locals, asset_references, recursion + 1) ==
-                       eval_recursion(right, globals, locals, asset_references, recursion + 1);
-            }
-            if (op == "!=") {
-                return eval_recursion(left, globals, locals, asset_references, recursion + 1) !=
-                       eval_recursion(right, globals, locals, asset_references, recursion + 1);
-            }
-            if (op == "in") {
-                auto elems = eval_recursion(right, globals, locals, asset_references, recursion + 1).get<std::set<nlohmann::json>>();
-                return elems.contains(eval_recursion(left, globals, locals, asset_references, recursion + 1));
-            }
-            if (op == "not in") {
-                auto elems = eval_recursion(right, globals, locals, asset_references, recursion + 1).get<std::set<nlohmann::json>>();
-                return !elems.contains(eval_recursion(left, globals, locals, asset_references, recursion + 1));
+                cop = ComparisonOperator::EQUAL;
+            } else if (op == "!=") {
+                cop = ComparisonOperator::NOT_EQUAL;
+            } else if (op == "in") {
+                cop = ComparisonOperator::IN;
+            } else if (op == "not in") {
+                cop = ComparisonOperator::NOT_IN;
+            } else {
+                THROW_OR_ABORT("Unknown operator: \"" + std::string{ op } + '"');
             }
-            THROW_OR_ABORT("Unknown operator: \"" + std::string{ op } + '"');
+            return std::make_unique<ComparisonExpression>(
+                cop,
+                compile_recursion(match[1].str(), recursion + 1),
+                compile_recursion(match[3].str(), recursion + 1));
         }
     }
     if ((expression.size() >= 2) && (expression[0] == '{') && (expression[expression.size() - 1] == '}')) {
         // static const DECLARE_REGEX(set_re, "^\\{(.*)\\}$");
         // static const DECLARE_REGEX(comma_re, ", ");
         static const auto comma_re = par(str(", "), NC);
-        std::set<nlohmann::json> result;
+        auto result = std::make_unique<SetExpression>();
         find_all_templated(expression.substr(1, expression.size() - 2), comma_re, [&](const SMatch<2>& match2b) {
             if (match2b[1].matched) {
-                if (!result.insert(eval_recursion(match2b[1].str(), globals, locals, asset_references, recursion + 1)).second) {
-                    THROW_OR_ABORT("Duplicate element: \"" + std::string{ match2b[1].str() } + '"');
-                }
+                result->add(compile_recursion(match2b[1].str(), recursion + 1), match2b[1].str());
             }
             });
+        if (result->is_constant()) {
+            return std::make_unique<ConstantExpression>(result->eval(EvalContext{
+                nlohmann::json::object(),
+                nlohmann::json::object(),
+                AssetReferences{} }));
+        }
         return result;
     }
     {
@@ -188,35 +436,35 @@ static nlohmann::json eval_recursion(
         //     return match[1].str();
         // }
         if ((expression.size() >= 2) && (expression[0] == '\'') && (expression[expression.size() - 1] == '\'')) {
-            return expression.substr(1, expression.size() - 2);
+            return std::make_unique<ConstantExpression>(expression.substr(1, expression.size() - 2));
         }
     }
     {
         // static const DECLARE_REGEX(int_re, "^(\\d+)$");
         static const auto int_re = seq(plus(digit), eof);
         if (SMatch<1> match; regex_match(expression, match, int_re)) {
-            return safe_stoi(match[0].str());
+            return std::make_unique<ConstantExpression>(safe_stoi(match[0].str()));
         }
     }
     {
         // static const DECLARE_REGEX(float_re, "^(\\d+\\.\\d+f)$");
         static const auto float_re = seq(plus(digit), chr('.'), plus(digit), chr('f'), eof);
         if (SMatch<1> match; regex_match(expression, match, float_re)) {
-            return safe_stof(match[0].str());
+            return std::make_unique<ConstantExpression>(safe_stof(match[0].str()));
         }
     }
     {
         // static const DECLARE_REGEX(double_re, "^(\\d+\\.\\d+)$");
         static const auto double_re = seq(plus(digit), chr('.'), plus(digit), eof);
         if (SMatch<1> match; regex_match(expression, match, double_re)) {
-            return safe_stod(match[0].str());
+            return std::make_unique<ConstantExpression>(safe_stod(match[0].str()));
         }
     }
     if ((expression[0] == '%') || (expression[0] == '!')) {
         if (expression == "%null") {
-            return nlohmann::json();
+            return std::make_unique<ConstantExpression>(nlohmann::json());
         }
-        nlohmann::json var;
+        std::unique_ptr<JsonExpression> var;
         if ((expression.length() > 1) && (expression[1] == '%')) {
             // static const DECLARE_REGEX(query_re, "^..([^/]+)/([^/]+)/(\\w+)$");
             static const auto query_re = seq(adot, adot, NSL, sl, NSL, sl, W, opt(seq(sl, NSL)), eof);
@@ -224,24 +472,7 @@ static nlohmann::json eval_recursion(
             if (!regex_match(expression, match, query_re)) {
                 THROW_OR_ABORT("Could not parse asset path: \"" + std::string{ expression } + '"');
             }
-            const auto& db = asset_references[subst(match[DbQueryGroups::group].str())]
-                .at(subst(match[DbQueryGroups::asset_id].str()))
-                .rp
-                .database;
-            if (match[DbQueryGroups::key].matched) {
-                auto res = db.at(match[DbQueryGroups::value].str());
-                if (res.type() != nlohmann::detail::value_t::object) {
-                    THROW_OR_ABORT("Database value is not of type object: \"" + std::string{ expression } + '"');
-                }
-                auto key = subst(match[DbQueryGroups::key].str());
-                auto it = res.find(key);
-                if (it == res.end()) {
-                    THROW_OR_ABORT("Could not find database key \"" + std::string{ key } + "\": \"" + std::string{ expression } + '"');
-                }
-                var = *it;
-            } else {
-                var = db.at(match[DbQueryGroups::value].str());
-            }
+            var = std::make_unique<DbQueryExpression>(match, expression);
         } else if ((expression.length() > 1) && (expression[1] == '/')) {
             // static const DECLARE_REGEX(query_re, "^..([^/]+)/([^/]+)$");
             static const auto query_re = seq(adot, adot, NSL, sl, NSL, eof);
@@ -249,21 +480,14 @@ static nlohmann::json eval_recursion(
             if (!regex_match(expression, match, query_re)) {
                 THROW_OR_ABORT("Could not parse asset path: \"" + std::string{ expression } + '"');
             }
-            auto dict_name = subst(match[DictQueryGroups::dict].str());
-            const auto& dict = at(dict_name, globals.json(), locals.json());
-            if (dict.type() != nlohmann::detail::value_t::object) {
-                THROW_OR_ABORT("Variable \"" + dict_name + "\" is not a dictionary");
-            }
-            auto key_name = subst(match[DictQueryGroups::key].str());
-            var = JsonView{ dict }.at(key_name);
+            var = std::make_unique<DictQueryExpression>(
+                match[DictQueryGroups::dict].str(),
+                match[DictQueryGroups::key].str());
         } else {
-            var = at(expression.substr(1), globals.json(), locals.json());
+            var = std::make_unique<VariableExpression>(expression.substr(1));
         }
         if (expression[0] == '!') {
-            if (var.type() != nlohmann::detail::value_t::boolean) {
-                THROW_OR_ABORT("Variable is not of type bool: \"" + std::string{ expression } + '"');
-            }
-            return !var.get<bool>();
+            return std::make_unique<NegationExpression>(std::move(var), expression);
         } else {
             return var;
         }
@@ -271,13 +495,33 @@ static nlohmann::json eval_recursion(
     THROW_OR_ABORT("Could not interpret \"" + std::string{ expression } + '"');
 }
 
+// Scene scripts evaluate the same expressions many times,
+// so each expression string is parsed only once.
+static std::shared_ptr<const JsonExpression> compiled(std::string_view expression) {
+    static const size_t MAX_CACHED_EXPRESSIONS = 100'000;
+    static std::unordered_map<std::string, std::shared_ptr<const JsonExpression>, StringHash, std::equal_to<>> cache;
+    static SafeAtomicSharedMutex mutex;
+    {
+        std::shared_lock lock{ mutex };
+        if (auto it = cache.find(expression); it != cache.end()) {
+            return it->second;
+        }
+    }
+    std::shared_ptr<const JsonExpression> result = compile_recursion(expression, 0);
+    std::scoped_lock lock{ mutex };
+    if (cache.size() >= MAX_CACHED_EXPRESSIONS) {
+        cache.clear();
+    }
+    return cache.try_emplace(std::string{ expression }, std::move(result)).first->second;
+}
+
 nlohmann::json Mlib::eval(
     std::string_view expression,
     const JsonView& globals,
     const JsonView& locals,
     const AssetReferences& asset_references)
 {
-    return eval_recursion(expression, globals, locals, asset_references, 0);
+    return compiled(expression)->eval(EvalContext{ globals.json(), locals.json(), asset_references });
 }
 
 nlohmann::json Mlib::eval(
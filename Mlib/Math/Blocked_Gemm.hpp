@@ -0,0 +1,237 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+namespace Mlib {
+
+template <class TData>
+concept BlockedGemmScalar = std::same_as<TData, float> || std::same_as<TData, double>;
+
+enum class GemmUpdate {
+    ASSIGN,     // C = A * B
+    SUBTRACT    // C -= A * B
+};
+
+/*
+ * Block sizes of the packed panels
+ * (Goto, van de Geijn, "Anatomy of High-Performance Matrix Multiplication").
+ * The MR x NR accumulator tile of the micro-kernel stays in vector registers,
+ * a KC x NR panel of B in L1, a MC x KC block of A in L2.
+ */
+template <BlockedGemmScalar TData>
+struct GemmBlocking {
+    static const size_t MR = 4;
+    static const size_t NR = 64 / sizeof(TData);
+    static const size_t MC = 128;
+    static const size_t KC = 256;
+    static const size_t NC = 4096;
+};
+
+namespace GemmDetail {
+
+// Packs the block A(i0 : i0 + mc, p0 : p0 + kc) into micro-panels of
+// MR rows, each stored column by column, zero-padded to a multiple of MR.
+template <class TData, size_t MR, class TA>
+void pack_a(const TA& a, size_t i0, size_t mc, size_t p0, size_t kc, TData* dst) {
+    for (size_t ir = 0; ir < mc; ir += MR) {
+        size_t mr = std::min(MR, mc - ir);
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t i = 0; i < mr; ++i) {
+                dst[i] = a(i0 + ir + i, p0 + p);
+            }
+            for (size_t i = mr; i < MR; ++i) {
+                dst[i] = 0;
+            }
+            dst += MR;
+        }
+    }
+}
+
+// Packs the NR columns starting at j0 of the block B(p0 : p0 + kc, :)
+// row by row, zero-padded to NR columns.
+template <class TData, size_t NR, class TB>
+void pack_b(const TB& b, size_t p0, size_t kc, size_t j0, size_t nr, TData* dst) {
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t j = 0; j < nr; ++j) {
+            dst[j] = b(p0 + p, j0 + j);
+        }
+        for (size_t j = nr; j < NR; ++j) {
+            dst[j] = 0;
+        }
+        dst += NR;
+    }
+}
+
+// Rank-kc update of a MR x NR register tile.
+// The inner loop has a compile-time trip count and vectorizes over NR.
+template <class TData, size_t MR, size_t NR>
+void micro_kernel(size_t kc, const TData* a, const TData* b, TData (&acc)[MR][NR]) {
+    for (size_t i = 0; i < MR; ++i) {
+        for (size_t j = 0; j < NR; ++j) {
+            acc[i][j] = 0;
+        }
+    }
+    for (size_t p = 0; p < kc; ++p) {
+        for (size_t i = 0; i < MR; ++i) {
+            TData ai = a[i];
+            #pragma omp simd
+            for (size_t j = 0; j < NR; ++j) {
+                acc[i][j] += ai * b[j];
+            }
+        }
+        a += MR;
+        b += NR;
+    }
+}
+
+}
+
+/*
+ * Cache-blocked, register-tiled matrix product C(m, n) (=, -=) A(m, k) * B(k, n).
+ * "a" and "b" are element accessors "(row, column) -> TData", "c" returns
+ * a reference to an element of C. The accessors are only called during packing,
+ * so transposed or strided views do not slow down the inner loop.
+ * If "lower_only" is true, only elements with row >= column are written.
+ */
+template <BlockedGemmScalar TData, class TA, class TB, class TC>
+void blocked_gemm(
+    size_t m,
+    size_t n,
+    size_t k,
+    const TA& a,
+    const TB& b,
+    const TC& c,
+    GemmUpdate update = GemmUpdate::ASSIGN,
+    bool lower_only = false)
+{
+    using B = GemmBlocking<TData>;
+    static const size_t MR = B::MR;
+    static const size_t NR = B::NR;
+    if ((k == 0) && (update == GemmUpdate::ASSIGN)) {
+        for (size_t r = 0; r < m; ++r) {
+            for (size_t col = 0; col < (lower_only ? std::min(r + 1, n) : n); ++col) {
+                c(r, col) = 0;
+            }
+        }
+        return;
+    }
+    size_t nmblocks = (m + B::MC - 1) / B::MC;
+    bool parallel = (m * n * k > 64 * 64 * 64);
+    std::vector<TData> bp((B::NC + NR) * B::KC);
+    for (size_t jc = 0; jc < n; jc += B::NC) {
+        size_t nc = std::min(B::NC, n - jc);
+        size_t nnpanels = (nc + NR - 1) / NR;
+        for (size_t pc = 0; pc < k; pc += B::KC) {
+            size_t kc = std::min(B::KC, k - pc);
+            bool first = (pc == 0);
+            #pragma omp parallel for if (parallel)
+            for (int jp = 0; jp < (int)nnpanels; ++jp) {
+                size_t jr = (size_t)jp * NR;
+                GemmDetail::pack_b<TData, NR>(b, pc, kc, jc + jr, std::min(NR, nc - jr), &bp[jr * kc]);
+            }
+            #pragma omp parallel for schedule(dynamic) if (parallel)
+            for (int mb = 0; mb < (int)nmblocks; ++mb) {
+                size_t ic = (size_t)mb * B::MC;
+                size_t mc = std::min(B::MC, m - ic);
+                if (lower_only && (ic + mc <= jc)) {
+                    continue;
+                }
+                std::vector<TData> ap((B::MC + MR) * kc);
+                GemmDetail::pack_a<TData, MR>(a, ic, mc, pc, kc, ap.data());
+                for (size_t jr = 0; jr < nc; jr += NR) {
+                    size_t nr = std::min(NR, nc - jr);
+                    for (size_t ir = 0; ir < mc; ir += MR) {
+                        size_t mr = std::min(MR, mc - ir);
+                        size_t r0 = ic + ir;
+                        size_t c0 = jc + jr;
+                        if (lower_only && (r0 + mr <= c0)) {
+                            continue;
+                        }
+                        TData acc[MR][NR];
+                        GemmDetail::micro_kernel<TData, MR, NR>(kc, &ap[ir * kc], &bp[jr * kc], acc);
+                        for (size_t i = 0; i < mr; ++i) {
+                            for (size_t j = 0; j < nr; ++j) {
+                                if (lower_only && (r0 + i < c0 + j)) {
+                                    break;
+                                }
+                                TData& v = c(r0 + i, c0 + j);
+                                if (update == GemmUpdate::SUBTRACT) {
+                                    v -= acc[i][j];
+                                } else if (first) {
+                                    v = acc[i][j];
+                                } else {
+                                    v += acc[i][j];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Right-looking blocked Cholesky decomposition A = L * L^T.
+ * "l" is a row-major n x n matrix that contains A on input and L on output.
+ * Only the lower triangle is read and written.
+ * Returns false if a squared diagonal element is below "diag2_min"
+ * (the check is disabled if "diag2_min" is zero).
+ */
+template <BlockedGemmScalar TData>
+bool blocked_cholesky(size_t n, TData* l, TData diag2_min = 0) {
+    static const size_t NB = 64;
+    auto L = [l, n](size_t r, size_t c) -> TData& { return l[r * n + c]; };
+    for (size_t k0 = 0; k0 < n; k0 += NB) {
+        size_t k1 = std::min(k0 + NB, n);
+        // Diagonal block, the columns left of k0 are already applied.
+        for (size_t i = k0; i < k1; ++i) {
+            for (size_t j = k0; j <= i; ++j) {
+                TData s = L(i, j);
+                for (size_t p = k0; p < j; ++p) {
+                    s -= L(i, p) * L(j, p);
+                }
+                if (i == j) {
+                    if ((diag2_min != 0) && (s < diag2_min)) {
+                        return false;
+                    }
+                    L(i, j) = std::sqrt(s);
+                } else {
+                    L(i, j) = s / L(j, j);
+                }
+            }
+        }
+        if (k1 == n) {
+            break;
+        }
+        // Panel below the diagonal block, L21 = A21 * L11^-T.
+        #pragma omp parallel for if ((n - k1) * NB > 64 * 64)
+        for (int ii = (int)k1; ii < (int)n; ++ii) {
+            size_t i = (size_t)ii;
+            for (size_t j = k0; j < k1; ++j) {
+                TData s = L(i, j);
+                for (size_t p = k0; p < j; ++p) {
+                    s -= L(i, p) * L(j, p);
+                }
+                L(i, j) = s / L(j, j);
+            }
+        }
+        // Trailing matrix, A22 -= L21 * L21^T (lower triangle only).
+        size_t nt = n - k1;
+        blocked_gemm<TData>(
+            nt,
+            nt,
+            k1 - k0,
+            [&L, k0, k1](size_t r, size_t p) { return L(k1 + r, k0 + p); },
+            [&L, k0, k1](size_t p, size_t c) { return L(k1 + c, k0 + p); },
+            [&L, k1](size_t r, size_t c) -> TData& { return L(k1 + r, k1 + c); },
+            GemmUpdate::SUBTRACT,
+            true);
+    }
+    return true;
+}
+
+}
@@ -3,6 +3,7 @@
 #include <Mlib/Array/Consteval_Workaround.hpp>
 #include <Mlib/Assert.hpp>
 #include <Mlib/Math/Abs.hpp>
+#include <Mlib/Math/Blocked_Gemm.hpp>
 #include <Mlib/Math/Float_Type.hpp>
 #include <Mlib/Math/Funpack.hpp>
 #include <Mlib/Rvalue_Address.hpp>
@@ -190,6 +191,21 @@ std::optional<Array<TData>> cholesky(
     assert(A.shape(0) == A.shape(1));
     Array<TData> L;
     L.resize(A.shape());
+    if constexpr (BlockedGemmScalar<TData>) {
+        if (A.shape(0) >= 128) {
+            size_t n = A.shape(0);
+            TData* l = L.flat_begin();
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    l[i * n + j] = (j <= i) ? A(i, j) : 0;
+                }
+            }
+            if (!blocked_cholesky(n, l, diag2_min)) {
+                return std::nullopt;
+            }
+            return L;
+        }
+    }
     for (size_t i = 0; i < A.shape(0); ++i) {
         for (size_t j = 0; j <= i; ++j) {
             TData s = 0;
@@ -358,7 +374,7 @@ std::optional<Array<typename TArrayA::value_type>> lstsq_chol(
     const Array<typename TArrayA::value_type>* dAT_B = nullptr,
     const typename FloatType<typename TArrayA::value_type>::value_type& diag2_min = 0)
 {
-    auto AT_A = dot2d(A.vH(), A);
+    auto AT_A = syrk(A);
     Array<typename TArrayA::value_type> AT_B = dot2d(A.vH(), B);
     if (dAT_A != nullptr) {
         assert(all(dAT_A->shape() == AT_A.shape()));
@@ -540,6 +556,64 @@ Array<TData> dirac_array(const ArrayShape& shape, const ArrayShape& index) {
     return result;
 }
 
+// Below this number of multiply-adds, the packing overhead
+// of "blocked_gemm" outweighs its benefits.
+static const size_t BLOCKED_GEMM_MIN_FLOPS = 32 * 32 * 32;
+
+/*
+ * Reference implementation of outer2d, without blocking.
+ */
+template <class TDerivedA, class TDerivedB, class TDerivedR, class TData>
+void outer2d_naive(
+    const BaseDenseArray<TDerivedA, TData>& a,
+    const BaseDenseArray<TDerivedB, TData>& b,
+    BaseDenseArray<TDerivedR, TData>& result)
+{
+    size_t rR = CW::static_shape<0>(*result);
+    size_t rC = CW::static_shape<1>(*result);
+    size_t aC = CW::static_shape<1>(*a);
+    if (rR > INT_MAX) {
+        THROW_OR_ABORT("Too many rows in matrix");
+    }
+    #pragma omp parallel for if (CW::nelements(*result) > 200 * 200)
+    for (int r = 0; r < (int)rR; ++r) {
+        for (size_t c = 0; c < rC; ++c) {
+            TData v = 0;
+            for (size_t i = 0; i < aC; ++i) {
+                v += (*a)((size_t)r, i) * conju((*b)(c, i));
+            }
+            (*result)((size_t)r, c) = v;
+        }
+    }
+}
+
+/*
+ * Reference implementation of dot2d, without blocking.
+ */
+template <class TDerivedA, class TDerivedB, class TDerivedR, class TData>
+void dot2d_naive(
+    const BaseDenseArray<TDerivedA, TData>& a,
+    const BaseDenseArray<TDerivedB, TData>& b,
+    BaseDenseArray<TDerivedR, TData>& result)
+{
+    size_t rR = CW::static_shape<0>(*result);
+    size_t rC = CW::static_shape<1>(*result);
+    size_t aC = CW::static_shape<1>(*a);
+    if (rR > INT_MAX) {
+        THROW_OR_ABORT("Too many rows in matrix");
+    }
+    #pragma omp parallel for if (CW::nelements(*result) > 200 * 200)
+    for (int r = 0; r < (int)rR; ++r) {
+        for (size_t c = 0; c <rC; ++c) {
+            TData v = 0;
+            for (size_t i = 0; i < aC; ++i) {
+                v += (*a)((size_t)r, i) * (*b)(i, c);
+            }
+            (*result)((size_t)r, c) = v;
+        }
+    }
+}
+
 /*
  * Outer product of two matrices.
  * outer2d(a, b) = dot(a, b.H())
@@ -569,16 +643,17 @@ void outer2d(
     if (rR > INT_MAX) {
         THROW_OR_ABORT("Too many rows in matrix");
     }
-    #pragma omp parallel for if (CW::nelements(*result) > 200 * 200)
-    for (int r = 0; r < (int)rR; ++r) {
-        for (size_t c = 0; c < rC; ++c) {
-            TData v = 0;
-            for (size_t i = 0; i < aC; ++i) {
-                v += (*a)((size_t)r, i) * conju((*b)(c, i));
-            }
-            (*result)((size_t)r, c) = v;
+    if constexpr (BlockedGemmScalar<TData>) {
+        if (rR * rC * aC >= BLOCKED_GEMM_MIN_FLOPS) {
+            blocked_gemm<TData>(
+                rR, rC, aC,
+                [&a](size_t r, size_t i) { return (*a)(r, i); },
+                [&b](size_t i, size_t c) { return (*b)(c, i); },
+                [&result](size_t r, size_t c) -> TData& { return (*result)(r, c); });
+            return;
         }
     }
+    outer2d_naive(a, b, result);
 }
 
 /*
@@ -668,16 +743,17 @@ void dot2d(
     if (rR > INT_MAX) {
         THROW_OR_ABORT("Too many rows in matrix");
     }
-    #pragma omp parallel for if (CW::nelements(*result) > 200 * 200)
-    for (int r = 0; r < (int)rR; ++r) {
-        for (size_t c = 0; c <rC; ++c) {
-            TData v = 0;
-            for (size_t i = 0; i < aC; ++i) {
-                v += (*a)((size_t)r, i) * (*b)(i, c);
-            }
-            (*result)((size_t)r, c) = v;
+    if constexpr (BlockedGemmScalar<TData>) {
+        if (rR * rC * aC >= BLOCKED_GEMM_MIN_FLOPS) {
+            blocked_gemm<TData>(
+                rR, rC, aC,
+                [&a](size_t r, size_t i) { return (*a)(r, i); },
+                [&b](size_t i, size_t c) { return (*b)(i, c); },
+                [&result](size_t r, size_t c) -> TData& { return (*result)(r, c); });
+            return;
         }
     }
+    dot2d_naive(a, b, result);
 }
 
 template <class TDerivedA, class TDerivedB, class TData>
@@ -701,6 +777,53 @@ Array<TData> dot2d(
     return result;
 }
 
+/*
+ * Symmetric rank-k product, syrk(a) = dot(a.H(), a).
+ * Only the lower triangle is computed, the upper one is mirrored.
+ */
+template <class TDerivedA, class TData>
+Array<TData> syrk(const BaseDenseArray<TDerivedA, TData>& a)
+{
+    assert_true(CW::ndim(*a) == 2);
+
+    size_t aR = CW::static_shape<0>(*a);
+    size_t aC = CW::static_shape<1>(*a);
+
+    Array<TData> result{ ArrayShape{aC, aC} };
+    if constexpr (BlockedGemmScalar<TData>) {
+        if (aC * aC * aR >= BLOCKED_GEMM_MIN_FLOPS) {
+            blocked_gemm<TData>(
+                aC, aC, aR,
+                [&a](size_t r, size_t i) { return (*a)(i, r); },
+                [&a](size_t i, size_t c) { return (*a)(i, c); },
+                [&result](size_t r, size_t c) -> TData& { return result(r, c); },
+                GemmUpdate::ASSIGN,
+                true);
+            for (size_t r = 0; r < aC; ++r) {
+                for (size_t c = r + 1; c < aC; ++c) {
+                    result(r, c) = result(c, r);
+                }
+            }
+            return result;
+        }
+    }
+    if (aC > INT_MAX) {
+        THROW_OR_ABORT("Too many columns in matrix");
+    }
+    #pragma omp parallel for if (CW::nelements(result) > 200 * 200)
+    for (int r = 0; r < (int)aC; ++r) {
+        for (size_t c = 0; c <= (size_t)r; ++c) {
+            TData v = 0;
+            for (size_t i = 0; i < aR; ++i) {
+                v += conju((*a)(i, (size_t)r)) * (*a)(i, c);
+            }
+            result((size_t)r, c) = v;
+            result(c, (size_t)r) = conju(v);
+        }
+    }
+    return result;
+}
+
 template <class TDerivedA, class TDerivedB, class TData>
 Array<TData> dot1d(
     const BaseDenseArray<TDerivedA, TData>& a,
@@ -0,0 +1,26 @@
+#pragma once
+#include <Mlib/Navigation/INavigation_Mesh.hpp>
+#include <list>
+#include <optional>
+
+class dtNavMesh;
+class dtNavMeshQuery;
+class dtQueryFilter;
+
+namespace Mlib {
+
+std::list<FixedArray<float, 3>> detour_shortest_path(
+    const dtNavMesh& navMesh,
+    const dtNavMeshQuery& navQuery,
+    const dtQueryFilter& filter,
+    const LocalizedNavmeshNode& start,
+    const LocalizedNavmeshNode& end,
+    float step_size);
+
+std::optional<LocalizedNavmeshNode> detour_closest_point(
+    const dtNavMeshQuery& navQuery,
+    const dtQueryFilter& filter,
+    const FixedArray<float, 3>& polyPickExtent,
+    const FixedArray<float, 3>& point);
+
+}
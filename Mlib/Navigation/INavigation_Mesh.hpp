@@ -0,0 +1,27 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsign-conversion"
+#include <DetourNavMesh.h>
+#pragma clang diagnostic pop
+#include <list>
+#include <optional>
+
+namespace Mlib {
+
+struct LocalizedNavmeshNode {
+    FixedArray<float, 3> position;
+    dtPolyRef polyRef;
+};
+
+class INavigationMesh {
+public:
+    virtual ~INavigationMesh() = default;
+    virtual std::optional<LocalizedNavmeshNode> closest_point_on_navmesh(const FixedArray<float, 3>& point) const = 0;
+    virtual std::list<FixedArray<float, 3>> shortest_path(
+        const LocalizedNavmeshNode& start,
+        const LocalizedNavmeshNode& end,
+        float step_size) const = 0;
+};
+
+}
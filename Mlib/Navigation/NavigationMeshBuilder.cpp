@@ -1,4 +1,6 @@
 #include "NavigationMeshBuilder.hpp"
+#include <Mlib/Navigation/Sample_SoloMesh.hpp>
+#include <Mlib/Navigation/Sample_TileMesh.hpp>
 #include <Mlib/Throw_Or_Abort.hpp>
 #include <chrono>
 #include <iostream>
@@ -8,31 +10,52 @@ using namespace Mlib;
 NavigationMeshBuilder::NavigationMeshBuilder(
     const std::string& filename,
     const NavigationMeshConfig& cfg)
-: ssm{ctx_, geom_}
 {
     if (!geom_.load(&ctx_, filename)) {
         THROW_OR_ABORT("Could not load obj file");
     }
-    ssm.m_cellSize = cfg.cell_size;
-    ssm.m_agentRadius = cfg.agent_radius;
-    if (!ssm.build()) {
-        THROW_OR_ABORT("Build failed");
-    }
+    build(cfg);
 }
 
 NavigationMeshBuilder::NavigationMeshBuilder(
     const IndexedFaceSet<float, float, size_t>& indexed_face_set,
     const NavigationMeshConfig& cfg)
-: ssm{ctx_, geom_}
 {
     if (!geom_.load(&ctx_, indexed_face_set)) {
         THROW_OR_ABORT("Could not import indexed face set");
     }
-    ssm.m_cellSize = cfg.cell_size;
-    ssm.m_agentRadius = cfg.agent_radius;
-    if (!ssm.build()) {
-        THROW_OR_ABORT("Build failed");
-    }
+    build(cfg);
 }
 
 NavigationMeshBuilder::~NavigationMeshBuilder() = default;
+
+void NavigationMeshBuilder::build(const NavigationMeshConfig& cfg) {
+    if (cfg.tile_size < 0) {
+        THROW_OR_ABORT("Navigation mesh tile size must not be negative");
+    }
+    if (cfg.tile_size == 0) {
+        solo_ = std::make_unique<Sample_SoloMesh>(ctx_, geom_);
+        solo_->m_cellSize = cfg.cell_size;
+        solo_->m_agentRadius = cfg.agent_radius;
+        if (!solo_->build()) {
+            THROW_OR_ABORT("Build failed");
+        }
+    } else {
+        tiled_ = std::make_unique<Sample_TileMesh>(ctx_, geom_);
+        tiled_->m_cellSize = cfg.cell_size;
+        tiled_->m_agentRadius = cfg.agent_radius;
+        tiled_->m_tileSize = cfg.tile_size;
+        tiled_->m_cacheDirectory = cfg.cache_directory;
+        if (!tiled_->build()) {
+            THROW_OR_ABORT("Build failed");
+        }
+    }
+}
+
+const INavigationMesh& NavigationMeshBuilder::navigation_mesh() const {
+    if (tiled_ != nullptr) {
+        return *tiled_;
+    }
+    return *solo_;
+}
+
@@ -1,17 +1,24 @@
 #pragma once
+#include <Mlib/Navigation/INavigation_Mesh.hpp>
 #include <Mlib/Navigation/InputGeom.hpp>
-#include <Mlib/Navigation/Sample_SoloMesh.hpp>
 #include <Mlib/Navigation/StderrContext.hpp>
+#include <memory>
 #include <string>
 
 namespace Mlib {
 
 template <class TDir, class TPos, class TIndex>
 class IndexedFaceSet;
+class Sample_SoloMesh;
+class Sample_TileMesh;
 
 struct NavigationMeshConfig {
     float cell_size;
     float agent_radius;
+    // Tile size in cells, 0 builds a single, monolithic mesh
+    int tile_size = 0;
+    // Directory of the tile cache, disabled if empty
+    std::string cache_directory;
 };
 
 class NavigationMeshBuilder {
@@ -23,11 +30,13 @@ public:
         const IndexedFaceSet<float, float, size_t>& indexed_face_set,
         const NavigationMeshConfig& cfg);
     ~NavigationMeshBuilder();
+    const INavigationMesh& navigation_mesh() const;
 private:
+    void build(const NavigationMeshConfig& cfg);
     StderrContext ctx_;
     InputGeom geom_;
-public:
-    Sample_SoloMesh ssm;
+    std::unique_ptr<Sample_SoloMesh> solo_;
+    std::unique_ptr<Sample_TileMesh> tiled_;
 };
 
 }
@@ -1,6 +1,6 @@
 #pragma once
 #include <Mlib/Array/Fixed_Array.hpp>
-#include <list>
+#include <Mlib/Navigation/INavigation_Mesh.hpp>
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wsign-conversion"
 #include <DetourNavMesh.h>
@@ -14,12 +14,7 @@ class InputGeom;
 
 namespace Mlib {
 
-struct LocalizedNavmeshNode {
-    FixedArray<float, 3> position;
-    dtPolyRef polyRef;
-};
-
-class Sample_SoloMesh
+class Sample_SoloMesh: public INavigationMesh
 {
 private:
     bool m_keepInterResults;
@@ -67,15 +62,15 @@ public:
     Sample_SoloMesh(
         rcContext& ctx,
         const InputGeom& geom);
-    ~Sample_SoloMesh();
+    virtual ~Sample_SoloMesh() override;
     
     void resetCommonSettings();
     bool build();
-    std::optional<LocalizedNavmeshNode> closest_point_on_navmesh(const FixedArray<float, 3>& point) const;
-    std::list<FixedArray<float, 3>> shortest_path(
+    virtual std::optional<LocalizedNavmeshNode> closest_point_on_navmesh(const FixedArray<float, 3>& point) const override;
+    virtual std::list<FixedArray<float, 3>> shortest_path(
         const LocalizedNavmeshNode& start,
         const LocalizedNavmeshNode& end,
-        float step_size) const;
+        float step_size) const override;
 
 private:
     // Explicitly disabled copy constructor and copy assignment operator.
@@ -0,0 +1,652 @@
+//
+// Copyright (c) 2009-2010 Mikko Mononen memon@inside.org
+//
+// This software is provided 'as-is', without any express or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//
+
+#include "Sample_TileMesh.hpp"
+#include <Mlib/Floating_Point_Exceptions.hpp>
+#include <Mlib/Navigation/Detour_Path.hpp>
+#include <Mlib/Navigation/InputGeom.hpp>
+#include <Mlib/Navigation/Sample_Flags.hpp>
+#include <Mlib/Navigation/StderrContext.hpp>
+#include <Mlib/Os/Os.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsign-conversion"
+#include <DetourCommon.h>
+#include <DetourNavMesh.h>
+#include <DetourNavMeshBuilder.h>
+#include <DetourNavMeshQuery.h>
+#include <Recast.h>
+#pragma clang diagnostic pop
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+
+using namespace Mlib;
+
+// Increment if the format of the cached tiles changes.
+static const uint64_t TILE_CACHE_VERSION = 1;
+
+namespace {
+
+// FNV-1a, stable across runs and platforms, unlike std::hash.
+class TileHash {
+public:
+    void add(const void* data, size_t size) {
+        const auto* d = (const unsigned char*)data;
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= d[i];
+            hash_ *= 0x100000001b3ULL;
+        }
+    }
+    template <class T>
+    void add(const T& v) {
+        add(&v, sizeof(v));
+    }
+    uint64_t get() const {
+        return hash_;
+    }
+private:
+    uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+std::filesystem::path tileFilename(const std::string& directory, uint64_t hash) {
+    std::stringstream sstr;
+    sstr << std::hex << std::setw(16) << std::setfill('0') << hash << ".tile";
+    return std::filesystem::path{ directory } / sstr.str();
+}
+
+struct TileJob {
+    int tx;
+    int ty;
+    unsigned char* data = nullptr;
+    int size = 0;
+    bool cached = false;
+};
+
+}
+
+Sample_TileMesh::Sample_TileMesh(
+    rcContext& ctx,
+    const InputGeom& geom)
+    : m_geom{ &geom }
+    , m_navMesh{ nullptr }
+    , m_ctx{ &ctx }
+    , m_tilesWidth{ 0 }
+    , m_tilesHeight{ 0 }
+    , m_tileWorldSize{ 0.f }
+    , m_nbuiltTiles{ 0 }
+    , m_ncachedTiles{ 0 }
+    , m_polyPickExtent{ uninitialized }
+{
+    resetCommonSettings();
+    m_navQuery = dtAllocNavMeshQuery();
+    m_filter.setIncludeFlags(SAMPLE_POLYFLAGS_ALL ^ SAMPLE_POLYFLAGS_DISABLED);
+    m_filter.setExcludeFlags(0);
+}
+
+Sample_TileMesh::~Sample_TileMesh()
+{
+    cleanup();
+    dtFreeNavMeshQuery(m_navQuery);
+}
+
+void Sample_TileMesh::cleanup()
+{
+    dtFreeNavMesh(m_navMesh);
+    m_navMesh = 0;
+    m_nbuiltTiles = 0;
+    m_ncachedTiles = 0;
+}
+
+bool Sample_TileMesh::build()
+{
+    if (!m_geom || !m_geom->getMesh() || !m_geom->getChunkyMesh())
+    {
+        m_ctx->log(RC_LOG_ERROR, "buildTiledNavigation: Input mesh is not specified.");
+        return false;
+    }
+    if (m_tileSize <= 0)
+    {
+        m_ctx->log(RC_LOG_ERROR, "buildTiledNavigation: Invalid tile size.");
+        return false;
+    }
+
+    cleanup();
+
+    const float* bmin = m_geom->getNavMeshBoundsMin();
+    const float* bmax = m_geom->getNavMeshBoundsMax();
+    int gw = 0, gh = 0;
+    rcCalcGridSize(bmin, bmax, m_cellSize, &gw, &gh);
+    m_tilesWidth = (gw + m_tileSize - 1) / m_tileSize;
+    m_tilesHeight = (gh + m_tileSize - 1) / m_tileSize;
+    m_tileWorldSize = (float)m_tileSize * m_cellSize;
+
+    // Detour packs the tile- and polygon-index into 22 bits.
+    int tileBits = rcMin((int)dtIlog2(dtNextPow2((unsigned int)(m_tilesWidth * m_tilesHeight))), 14);
+    int polyBits = 22 - tileBits;
+
+    dtNavMeshParams params;
+    memset(&params, 0, sizeof(params));
+    rcVcopy(params.orig, bmin);
+    params.tileWidth = m_tileWorldSize;
+    params.tileHeight = m_tileWorldSize;
+    params.maxTiles = 1 << tileBits;
+    params.maxPolys = 1 << polyBits;
+
+    m_navMesh = dtAllocNavMesh();
+    if (!m_navMesh)
+    {
+        m_ctx->log(RC_LOG_ERROR, "buildTiledNavigation: Could not allocate navmesh.");
+        return false;
+    }
+    if (dtStatusFailed(m_navMesh->init(&params)))
+    {
+        m_ctx->log(RC_LOG_ERROR, "buildTiledNavigation: Could not init navmesh.");
+        return false;
+    }
+    if (dtStatusFailed(m_navQuery->init(m_navMesh, 2048)))
+    {
+        m_ctx->log(RC_LOG_ERROR, "buildTiledNavigation: Could not init Detour navmesh query");
+        return false;
+    }
+
+    m_ctx->log(RC_LOG_PROGRESS, "Building tiled navigation:");
+    m_ctx->log(RC_LOG_PROGRESS, " - %d x %d cells", gw, gh);
+    m_ctx->log(RC_LOG_PROGRESS, " - %d x %d tiles", m_tilesWidth, m_tilesHeight);
+
+    buildTiles();
+
+    m_ctx->log(RC_LOG_PROGRESS, ">> Tiles: %d built, %d cached", (int)m_nbuiltTiles, (int)m_ncachedTiles);
+
+    return true;
+}
+
+void Sample_TileMesh::buildTiles()
+{
+    std::vector<TileJob> jobs;
+    for (int ty = 0; ty < m_tilesHeight; ++ty)
+        for (int tx = 0; tx < m_tilesWidth; ++tx)
+            jobs.push_back(TileJob{ .tx = tx, .ty = ty });
+
+    // The tiles are independent, only adding them to the navmesh is serial.
+    try {
+        parallel_for(jobs.size(), [&](size_t i)
+        {
+            auto& job = jobs[i];
+            rcConfig cfg;
+            tileConfig(job.tx, job.ty, cfg);
+            std::vector<int> cids;
+            tileTriangles(cfg, cids);
+            if (cids.empty())
+                return;
+            uint64_t hash = tileHash(cfg, cids);
+            if (!m_cacheDirectory.empty())
+            {
+                auto tile = loadCachedTile(hash);
+                if (tile.data)
+                {
+                    job.data = tile.data;
+                    job.size = tile.size;
+                    job.cached = true;
+                    return;
+                }
+            }
+            StderrContext ctx;
+            auto tile = buildTileMesh(ctx, cfg, cids);
+            job.data = tile.data;
+            job.size = tile.size;
+            if (tile.data && !m_cacheDirectory.empty())
+                saveCachedTile(hash, tile);
+        });
+    } catch (...) {
+        for (auto& job : jobs)
+            dtFree(job.data);
+        throw;
+    }
+
+    for (auto& job : jobs)
+    {
+        if (!job.data)
+            continue;
+        if (dtStatusFailed(m_navMesh->addTile(job.data, job.size, DT_TILE_FREE_DATA, 0, 0)))
+        {
+            dtFree(job.data);
+            m_ctx->log(RC_LOG_ERROR, "buildTiledNavigation: Could not add tile (%d, %d).", job.tx, job.ty);
+            continue;
+        }
+        if (job.cached)
+            ++m_ncachedTiles;
+        else
+            ++m_nbuiltTiles;
+    }
+}
+
+void Sample_TileMesh::tileConfig(int tx, int ty, rcConfig& cfg) const
+{
+    const float* bmin = m_geom->getNavMeshBoundsMin();
+    const float* bmax = m_geom->getNavMeshBoundsMax();
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.cs = m_cellSize;
+    cfg.ch = m_cellHeight;
+    cfg.walkableSlopeAngle = m_agentMaxSlope;
+    cfg.walkableHeight = (int)ceilf(m_agentHeight / cfg.ch);
+    cfg.walkableClimb = (int)floorf(m_agentMaxClimb / cfg.ch);
+    cfg.walkableRadius = (int)ceilf(m_agentRadius / cfg.cs);
+    cfg.maxEdgeLen = (int)(m_edgeMaxLen / m_cellSize);
+    cfg.maxSimplificationError = m_edgeMaxError;
+    cfg.minRegionArea = (int)rcSqr(m_regionMinSize);        // Note: area = size*size
+    cfg.mergeRegionArea = (int)rcSqr(m_regionMergeSize);    // Note: area = size*size
+    cfg.maxVertsPerPoly = (int)m_vertsPerPoly;
+    cfg.tileSize = m_tileSize;
+    cfg.borderSize = cfg.walkableRadius + 3; // Reserve enough padding.
+    cfg.width = cfg.tileSize + cfg.borderSize * 2;
+    cfg.height = cfg.tileSize + cfg.borderSize * 2;
+    cfg.detailSampleDist = m_detailSampleDist < 0.9f ? 0 : m_cellSize * m_detailSampleDist;
+    cfg.detailSampleMaxError = m_cellHeight * m_detailSampleMaxError;
+
+    // Expand the heighfield bounding box by border size to find the extents of geometry we need to build this tile.
+    //
+    // This is done in order to make sure that the navmesh tiles connect correctly at the borders,
+    // and the obstacles close to the border work correctly with the dilation process.
+    // No polygons (or contours) will be created on the border area.
+    cfg.bmin[0] = bmin[0] + (float)tx * m_tileWorldSize - (float)cfg.borderSize * cfg.cs;
+    cfg.bmin[1] = bmin[1];
+    cfg.bmin[2] = bmin[2] + (float)ty * m_tileWorldSize - (float)cfg.borderSize * cfg.cs;
+    cfg.bmax[0] = bmin[0] + (float)(tx + 1) * m_tileWorldSize + (float)cfg.borderSize * cfg.cs;
+    cfg.bmax[1] = bmax[1];
+    cfg.bmax[2] = bmin[2] + (float)(ty + 1) * m_tileWorldSize + (float)cfg.borderSize * cfg.cs;
+}
+
+void Sample_TileMesh::tileTriangles(const rcConfig& cfg, std::vector<int>& cids) const
+{
+    const rcChunkyTriMesh* chunkyMesh = m_geom->getChunkyMesh();
+    float tbmin[2] = { cfg.bmin[0], cfg.bmin[2] };
+    float tbmax[2] = { cfg.bmax[0], cfg.bmax[2] };
+    cids.resize(512);
+    while (true)
+    {
+        int ncid = rcGetChunksOverlappingRect(chunkyMesh, tbmin, tbmax, cids.data(), (int)cids.size());
+        if (ncid < (int)cids.size())
+        {
+            cids.resize((size_t)ncid);
+            return;
+        }
+        cids.resize(2 * cids.size());
+    }
+}
+
+uint64_t Sample_TileMesh::tileHash(const rcConfig& cfg, const std::vector<int>& cids) const
+{
+    TileHash hash;
+    hash.add(TILE_CACHE_VERSION);
+    hash.add(cfg);
+    hash.add(m_geom->getNavMeshBoundsMin(), 3 * sizeof(float));
+    hash.add(m_agentHeight);
+    hash.add(m_agentRadius);
+    hash.add(m_agentMaxClimb);
+    hash.add(m_partitionType);
+    hash.add(m_filterLowHangingObstacles);
+    hash.add(m_filterLedgeSpans);
+    hash.add(m_filterWalkableLowHeightSpans);
+
+    const float* verts = m_geom->getMesh()->getVerts();
+    const rcChunkyTriMesh* chunkyMesh = m_geom->getChunkyMesh();
+    for (int cid : cids)
+    {
+        const rcChunkyTriMeshNode& node = chunkyMesh->nodes[cid];
+        const int* ctris = &chunkyMesh->tris[node.i * 3];
+        for (int j = 0; j < node.n * 3; ++j)
+            hash.add(&verts[ctris[j] * 3], 3 * sizeof(float));
+    }
+
+    const ConvexVolume* vols = m_geom->getConvexVolumes();
+    for (int i = 0; i < m_geom->getConvexVolumeCount(); ++i)
+    {
+        hash.add(vols[i].verts, (size_t)vols[i].nverts * 3 * sizeof(float));
+        hash.add(vols[i].hmin);
+        hash.add(vols[i].hmax);
+        hash.add(vols[i].area);
+    }
+
+    int noff = m_geom->getOffMeshConnectionCount();
+    hash.add(noff);
+    hash.add(m_geom->getOffMeshConnectionVerts(), (size_t)noff * 6 * sizeof(float));
+    hash.add(m_geom->getOffMeshConnectionRads(), (size_t)noff * sizeof(float));
+    hash.add(m_geom->getOffMeshConnectionDirs(), (size_t)noff * sizeof(unsigned char));
+    hash.add(m_geom->getOffMeshConnectionAreas(), (size_t)noff * sizeof(unsigned char));
+    hash.add(m_geom->getOffMeshConnectionFlags(), (size_t)noff * sizeof(unsigned short));
+    hash.add(m_geom->getOffMeshConnectionId(), (size_t)noff * sizeof(unsigned int));
+    return hash.get();
+}
+
+Sample_TileMesh::TileData Sample_TileMesh::loadCachedTile(uint64_t hash) const
+{
+    auto filename = tileFilename(m_cacheDirectory, hash);
+    std::error_code ec;
+    if (!std::filesystem::exists(filename, ec))
+        return {};
+    auto f = create_ifstream(filename, std::ios::binary);
+    if (f->fail())
+        return {};
+    f->seekg(0, std::ios::end);
+    auto size = (std::streamoff)f->tellg();
+    f->seekg(0, std::ios::beg);
+    if (size <= 0)
+        return {};
+    auto* data = (unsigned char*)dtAlloc((size_t)size, DT_ALLOC_PERM);
+    if (!data)
+        return {};
+    f->read((char*)data, size);
+    if (f->fail())
+    {
+        dtFree(data);
+        return {};
+    }
+    return { .data = data, .size = (int)size };
+}
+
+void Sample_TileMesh::saveCachedTile(uint64_t hash, const TileData& tile) const
+{
+    auto filename = tileFilename(m_cacheDirectory, hash);
+    auto tmp_filename = filename;
+    tmp_filename += ".tmp";
+    std::error_code ec;
+    std::filesystem::create_directories(m_cacheDirectory, ec);
+    {
+        auto f = create_ofstream(tmp_filename, std::ios::binary);
+        f->write((const char*)tile.data, tile.size);
+        f->flush();
+        if (f->fail())
+        {
+            lwarn() << "Could not write navmesh tile \"" << tmp_filename.string() << '"';
+            return;
+        }
+    }
+    // Rename, so that concurrent readers never see partially written tiles.
+    std::filesystem::rename(tmp_filename, filename, ec);
+}
+
+Sample_TileMesh::TileData Sample_TileMesh::buildTileMesh(
+    rcContext& ctx,
+    const rcConfig& cfg_in,
+    const std::vector<int>& cids) const
+{
+    rcConfig cfg = cfg_in;
+    const float* verts = m_geom->getMesh()->getVerts();
+    const int nverts = m_geom->getMesh()->getVertCount();
+    const rcChunkyTriMesh* chunkyMesh = m_geom->getChunkyMesh();
+
+    std::unique_ptr<rcHeightfield, decltype(&rcFreeHeightField)> solid{ rcAllocHeightfield(), rcFreeHeightField };
+    if (!solid)
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Out of memory 'solid'.");
+        return {};
+    }
+    if (!rcCreateHeightfield(&ctx, *solid, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not create solid heightfield.");
+        return {};
+    }
+
+    // Rasterize only the chunks overlapping the tile, including its border.
+    std::vector<unsigned char> triareas((size_t)chunkyMesh->maxTrisPerChunk);
+    for (int cid : cids)
+    {
+        const rcChunkyTriMeshNode& node = chunkyMesh->nodes[cid];
+        const int* ctris = &chunkyMesh->tris[node.i * 3];
+        const int nctris = node.n;
+
+        memset(triareas.data(), 0, (size_t)nctris * sizeof(unsigned char));
+        rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, ctris, nctris, triareas.data());
+        if (!rcRasterizeTriangles(&ctx, verts, nverts, ctris, triareas.data(), nctris, *solid, cfg.walkableClimb))
+            return {};
+    }
+
+    if (m_filterLowHangingObstacles)
+        rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *solid);
+    if (m_filterLedgeSpans)
+        rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid);
+    if (m_filterWalkableLowHeightSpans)
+        rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *solid);
+
+    std::unique_ptr<rcCompactHeightfield, decltype(&rcFreeCompactHeightfield)> chf{ rcAllocCompactHeightfield(), rcFreeCompactHeightfield };
+    if (!chf)
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Out of memory 'chf'.");
+        return {};
+    }
+    if (!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *solid, *chf))
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build compact data.");
+        return {};
+    }
+    solid.reset();
+
+    if (!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf))
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not erode.");
+        return {};
+    }
+
+    const ConvexVolume* vols = m_geom->getConvexVolumes();
+    for (int i  = 0; i < m_geom->getConvexVolumeCount(); ++i)
+        rcMarkConvexPolyArea(&ctx, vols[i].verts, vols[i].nverts, vols[i].hmin, vols[i].hmax, (unsigned char)vols[i].area, *chf);
+
+    // See "Sample_SoloMesh::build" for a comparison of the partitioning methods.
+    if (m_partitionType == SAMPLE_PARTITION_WATERSHED)
+    {
+        if (!rcBuildDistanceField(&ctx, *chf))
+        {
+            ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build distance field.");
+            return {};
+        }
+        if (!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+        {
+            ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build watershed regions.");
+            return {};
+        }
+    }
+    else if (m_partitionType == SAMPLE_PARTITION_MONOTONE)
+    {
+        if (!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea))
+        {
+            ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build monotone regions.");
+            return {};
+        }
+    }
+    else // SAMPLE_PARTITION_LAYERS
+    {
+        if (!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea))
+        {
+            ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build layer regions.");
+            return {};
+        }
+    }
+
+    std::unique_ptr<rcContourSet, decltype(&rcFreeContourSet)> cset{ rcAllocContourSet(), rcFreeContourSet };
+    if (!cset)
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Out of memory 'cset'.");
+        return {};
+    }
+    if (!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset))
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not create contours.");
+        return {};
+    }
+    if (cset->nconts == 0)
+        return {};
+
+    std::unique_ptr<rcPolyMesh, decltype(&rcFreePolyMesh)> pmesh{ rcAllocPolyMesh(), rcFreePolyMesh };
+    if (!pmesh)
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Out of memory 'pmesh'.");
+        return {};
+    }
+    if (!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *pmesh))
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not triangulate contours.");
+        return {};
+    }
+
+    std::unique_ptr<rcPolyMeshDetail, decltype(&rcFreePolyMeshDetail)> dmesh{ rcAllocPolyMeshDetail(), rcFreePolyMeshDetail };
+    if (!dmesh)
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Out of memory 'pmdtl'.");
+        return {};
+    }
+    {
+        TemporarilyIgnoreFloatingPointExeptions ignore_except;
+        if (!rcBuildPolyMeshDetail(&ctx, *pmesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *dmesh))
+        {
+            ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build detail mesh.");
+            return {};
+        }
+    }
+    chf.reset();
+    cset.reset();
+
+    if ((cfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON) || (pmesh->npolys == 0))
+        return {};
+
+    // Detour stores the vertex indices of a tile as 16 bit values.
+    if (pmesh->nverts >= 0xffff)
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Too many vertices per tile %d (max: %d).", pmesh->nverts, 0xffff);
+        return {};
+    }
+
+    // Update poly flags from areas.
+    for (int i = 0; i < pmesh->npolys; ++i)
+    {
+        if (pmesh->areas[i] == RC_WALKABLE_AREA)
+            pmesh->areas[i] = SAMPLE_POLYAREA_GROUND;
+
+        if (pmesh->areas[i] == SAMPLE_POLYAREA_GROUND ||
+            pmesh->areas[i] == SAMPLE_POLYAREA_GRASS ||
+            pmesh->areas[i] == SAMPLE_POLYAREA_ROAD)
+        {
+            pmesh->flags[i] = SAMPLE_POLYFLAGS_WALK;
+        }
+        else if (pmesh->areas[i] == SAMPLE_POLYAREA_WATER)
+        {
+            pmesh->flags[i] = SAMPLE_POLYFLAGS_SWIM;
+        }
+        else if (pmesh->areas[i] == SAMPLE_POLYAREA_DOOR)
+        {
+            pmesh->flags[i] = SAMPLE_POLYFLAGS_WALK | SAMPLE_POLYFLAGS_DOOR;
+        }
+    }
+
+    const float* orig = m_geom->getNavMeshBoundsMin();
+    dtNavMeshCreateParams params;
+    memset(&params, 0, sizeof(params));
+    params.verts = pmesh->verts;
+    params.vertCount = pmesh->nverts;
+    params.polys = pmesh->polys;
+    params.polyAreas = pmesh->areas;
+    params.polyFlags = pmesh->flags;
+    params.polyCount = pmesh->npolys;
+    params.nvp = pmesh->nvp;
+    params.detailMeshes = dmesh->meshes;
+    params.detailVerts = dmesh->verts;
+    params.detailVertsCount = dmesh->nverts;
+    params.detailTris = dmesh->tris;
+    params.detailTriCount = dmesh->ntris;
+    params.offMeshConVerts = m_geom->getOffMeshConnectionVerts();
+    params.offMeshConRad = m_geom->getOffMeshConnectionRads();
+    params.offMeshConDir = m_geom->getOffMeshConnectionDirs();
+    params.offMeshConAreas = m_geom->getOffMeshConnectionAreas();
+    params.offMeshConFlags = m_geom->getOffMeshConnectionFlags();
+    params.offMeshConUserID = m_geom->getOffMeshConnectionId();
+    params.offMeshConCount = m_geom->getOffMeshConnectionCount();
+    params.walkableHeight = m_agentHeight;
+    params.walkableRadius = m_agentRadius;
+    params.walkableClimb = m_agentMaxClimb;
+    params.tileX = (int)std::lround((cfg.bmin[0] + (float)cfg.borderSize * cfg.cs - orig[0]) / m_tileWorldSize);
+    params.tileY = (int)std::lround((cfg.bmin[2] + (float)cfg.borderSize * cfg.cs - orig[2]) / m_tileWorldSize);
+    params.tileLayer = 0;
+    rcVcopy(params.bmin, pmesh->bmin);
+    rcVcopy(params.bmax, pmesh->bmax);
+    params.cs = cfg.cs;
+    params.ch = cfg.ch;
+    params.buildBvTree = true;
+
+    TileData result;
+    if (!dtCreateNavMeshData(&params, &result.data, &result.size))
+    {
+        ctx.log(RC_LOG_ERROR, "buildTileMesh: Could not build Detour navmesh.");
+        return {};
+    }
+    return result;
+}
+
+size_t Sample_TileMesh::nbuilt_tiles() const
+{
+    return m_nbuiltTiles;
+}
+
+size_t Sample_TileMesh::ncached_tiles() const
+{
+    return m_ncachedTiles;
+}
+
+void Sample_TileMesh::resetCommonSettings() {
+    m_filterLowHangingObstacles = true;
+    m_filterLedgeSpans = true;
+    m_filterWalkableLowHeightSpans = true;
+
+    m_cellSize = 0.3f;
+    m_cellHeight = 0.2f;
+    m_agentHeight = 2.0f;
+    m_agentRadius = 0.6f;
+    m_agentMaxClimb = 0.9f;
+    m_agentMaxSlope = 45.0f;
+    m_regionMinSize = 8;
+    m_regionMergeSize = 20;
+    m_edgeMaxLen = 12.0f;
+    m_edgeMaxError = 1.3f;
+    m_vertsPerPoly = 6.0f;
+    m_detailSampleDist = 6.0f;
+    m_detailSampleMaxError = 1.0f;
+    m_partitionType = SAMPLE_PARTITION_WATERSHED;
+    m_polyPickExtent = { 6.f, 8.f, 6.f };
+    m_tileSize = 64;
+    m_cacheDirectory.clear();
+}
+
+std::list<FixedArray<float, 3>> Sample_TileMesh::shortest_path(
+    const LocalizedNavmeshNode& start,
+    const LocalizedNavmeshNode& end,
+    float step_size) const
+{
+    if (!m_navMesh)
+        return {};
+    return detour_shortest_path(*m_navMesh, *m_navQuery, m_filter, start, end, step_size);
+}
+
+std::optional<LocalizedNavmeshNode> Sample_TileMesh::closest_point_on_navmesh(const FixedArray<float, 3>& point) const
+{
+    if (!m_navMesh)
+        return std::nullopt;
+    return detour_closest_point(*m_navQuery, m_filter, m_polyPickExtent, point);
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Navigation/INavigation_Mesh.hpp>
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wsign-conversion"
+#include <DetourNavMesh.h>
+#include <DetourNavMeshQuery.h>
+#include <Recast.h>
+#pragma clang diagnostic pop
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+class InputGeom;
+
+namespace Mlib {
+
+/**
+ * Navigation mesh consisting of a grid of independently built tiles.
+ *
+ * Tiles are built in parallel and can optionally be cached on disk,
+ * keyed by a hash of the geometry and settings that affect the tile.
+ */
+class Sample_TileMesh: public INavigationMesh
+{
+private:
+    struct TileData {
+        unsigned char* data = nullptr;
+        int size = 0;
+    };
+
+    const InputGeom* m_geom;
+    dtNavMesh* m_navMesh;
+    dtNavMeshQuery* m_navQuery;
+    rcContext* m_ctx;
+
+    dtQueryFilter m_filter;
+
+    int m_tilesWidth;
+    int m_tilesHeight;
+    float m_tileWorldSize;
+    size_t m_nbuiltTiles;
+    size_t m_ncachedTiles;
+
+    void cleanup();
+    void buildTiles();
+    void tileConfig(int tx, int ty, rcConfig& cfg) const;
+    void tileTriangles(const rcConfig& cfg, std::vector<int>& cids) const;
+    uint64_t tileHash(const rcConfig& cfg, const std::vector<int>& cids) const;
+    TileData buildTileMesh(rcContext& ctx, const rcConfig& cfg, const std::vector<int>& cids) const;
+    TileData loadCachedTile(uint64_t hash) const;
+    void saveCachedTile(uint64_t hash, const TileData& tile) const;
+
+public:
+    bool m_filterLowHangingObstacles;
+    bool m_filterLedgeSpans;
+    bool m_filterWalkableLowHeightSpans;
+
+    float m_cellSize;
+    float m_cellHeight;
+    float m_agentHeight;
+    float m_agentRadius;
+    float m_agentMaxClimb;
+    float m_agentMaxSlope;
+    float m_regionMinSize;
+    float m_regionMergeSize;
+    float m_edgeMaxLen;
+    float m_edgeMaxError;
+    float m_vertsPerPoly;
+    float m_detailSampleDist;
+    float m_detailSampleMaxError;
+    int m_partitionType;
+    FixedArray<float, 3> m_polyPickExtent;
+    // Tile size in cells
+    int m_tileSize;
+    // Directory of the tile cache, disabled if empty
+    std::string m_cacheDirectory;
+
+    Sample_TileMesh(
+        rcContext& ctx,
+        const InputGeom& geom);
+    virtual ~Sample_TileMesh() override;
+
+    void resetCommonSettings();
+    bool build();
+    size_t nbuilt_tiles() const;
+    size_t ncached_tiles() const;
+    virtual std::optional<LocalizedNavmeshNode> closest_point_on_navmesh(const FixedArray<float, 3>& point) const override;
+    virtual std::list<FixedArray<float, 3>> shortest_path(
+        const LocalizedNavmeshNode& start,
+        const LocalizedNavmeshNode& end,
+        float step_size) const override;
+
+private:
+    // Explicitly disabled copy constructor and copy assignment operator.
+    Sample_TileMesh(const Sample_TileMesh&) = delete;
+    Sample_TileMesh& operator=(const Sample_TileMesh&) = delete;
+};
+
+}
@@ -71,6 +71,7 @@
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Racing_Line_Bvh.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Report_Osm_Problems.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Road_Type.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Scatter_Tiles.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Smoothen_Ways.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Steiner_Point_Info.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Bvh.hpp>
@@ -116,6 +117,7 @@
 #include <cereal/types/optional.hpp>
 #include <cereal/types/string.hpp>
 #include <cereal/types/vector.hpp>
+#include <filesystem>
 #include <fstream>
 #include <mutex>
 #include <poly2tri/edge_exception.hpp>
@@ -147,6 +149,8 @@ OsmMapResource::OsmMapResource(
     NormalizedPointsFixed<double> normalized_points{ ScaleMode::NONE, OffsetMode::CENTERED };
 
     FunctionGuard fg{ "OSM map resource" };
+    // Seed of the tiled scattering, which only depends on the map.
+    unsigned int scatter_seed = scatter_map_seed(std::filesystem::path{ config.filename }.filename().string());
 
     fg.update("Parse OSM XML");
     parse_osm_xml(
@@ -543,6 +547,8 @@ OsmMapResource::OsmMapResource(
                 terrain_region_contours,
                 config.scale,
                 config.triangulation_scale,
+                config.triangulation_tile_size,
+                config.triangulation_tile_boundary_distance,
                 config.uv_scale_terrain,
                 config.uv_period_terrain,
                 (CompressedScenePos)0.f,
@@ -578,7 +584,9 @@ OsmMapResource::OsmMapResource(
                 steiner_points,
                 config.scale,
                 ws.min_dist,
-                ws.max_dist);
+                ws.max_dist,
+                config.scatter_tile_size,
+                scatter_seed);
         }
         // Note that ditch is in the group OsmTriangleLists::tls_terrain_nosmooth().
         draw_terrain_triangles(
@@ -1114,7 +1122,9 @@ OsmMapResource::OsmMapResource(
             config.zonemap_jitter,
             config.zonemap_step_size,
             config.scale,
-            config.water_height);
+            config.water_height,
+            config.scatter_tile_size,
+            scatter_seed);
     }
 
     if (config.forest_outline_tree_distance != INFINITY && !config.tree_resource_names.empty()) {
@@ -1131,7 +1141,9 @@ OsmMapResource::OsmMapResource(
             ways,
             config.forest_outline_tree_distance,
             config.forest_outline_tree_inwards_distance,
-            config.scale);
+            config.scale,
+            config.scatter_tile_size,
+            scatter_seed);
     }
     if (!config.road_bollard_resource_names.empty()) {
         ResourceNameCycle rnc{config.road_bollard_resource_names};
@@ -1219,7 +1231,9 @@ OsmMapResource::OsmMapResource(
             rnc,
             *(*tl_terrain_)[TerrainType::GRASS],
             config.scale,
-            CompressedScenePos::from_float_safe(config.much_grass_distance));
+            CompressedScenePos::from_float_safe(config.much_grass_distance),
+            config.scatter_tile_size,
+            scatter_seed);
     }
     fg.update("Calculate spawn points");
     calculate_spawn_points(
@@ -1322,6 +1336,8 @@ OsmMapResource::OsmMapResource(
                 water_contours,
                 config.scale,
                 config.triangulation_scale,
+                config.triangulation_tile_size,
+                config.triangulation_tile_boundary_distance,
                 1 / 100.f,              // uv_scale
                 1.f,                    // uv_period
                 config.water_height,
@@ -1541,7 +1557,9 @@ OsmMapResource::OsmMapResource(
                         indexed_face_set,
                         NavigationMeshConfig{
                             .cell_size = 1.f,
-                            .agent_radius = config.agent_radius}};
+                            .agent_radius = config.agent_radius,
+                            .tile_size = config.navmesh_tile_size,
+                            .cache_directory = config.navmesh_cache_dir}};
                     auto scaled_rotation = rotation.casted<double>() / scale_;
                     calculate_waypoint_adjacency(
                         way_points_[JoinedWayPointSandbox::EXPLICIT_GROUND],
@@ -1551,7 +1569,7 @@ OsmMapResource::OsmMapResource(
                         nodes,
                         *ground_bvh,
                         &scaled_rotation,
-                        &nmb.ssm,
+                        &nmb.navigation_mesh(),
                         config.scale,
                         config.waypoint_merge_radius,
                         config.waypoint_error_radius,
@@ -1564,7 +1582,7 @@ OsmMapResource::OsmMapResource(
                         nodes,
                         *ground_bvh,
                         &scaled_rotation,
-                        &nmb.ssm,
+                        &nmb.navigation_mesh(),
                         config.scale,
                         config.waypoint_merge_radius,
                         config.waypoint_error_radius,
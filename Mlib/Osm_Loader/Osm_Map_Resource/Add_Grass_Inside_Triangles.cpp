@@ -2,6 +2,7 @@
 #include <Mlib/Geometry/Mesh/Triangle_List.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_Sampler2.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Map_Resource_Helpers.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Scatter_Tiles.hpp>
 #include <Mlib/Render/Renderables/Triangle_Sampler/Resource_Name_Cycle.hpp>
 #include <Mlib/Scene_Graph/Resources/Batch_Resource_Instantiator.hpp>
 #include <Mlib/Scene_Graph/Resources/Parsed_Resource_Name.hpp>
@@ -10,27 +11,38 @@ using namespace Mlib;
 
 void Mlib::add_grass_inside_triangles(
     BatchResourceInstantiator& bri,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     const TriangleList<CompressedScenePos>& triangles,
     float scale,
-    CompressedScenePos distance)
+    CompressedScenePos distance,
+    CompressedScenePos tile_size,
+    unsigned int seed)
 {
-    TriangleSampler2<CompressedScenePos> ts{ 1 };
-    FastNormalRandomNumberGenerator<float> scale_rng{ 0, 1.f, 0.2f };
-    for (auto& t : triangles.triangles) {
-        FixedArray<CompressedScenePos, 3, 3> triangle{
-            t(0).position,
-            t(1).position,
-            t(2).position };
-        ts.sample_triangle_interior<3>(
-            triangle,
-            distance * scale,
-            [&](const FixedArray<double, 3>& bcs)
-            {
-                if (auto prn = rnc.try_multiple_times(10); prn != nullptr) {
-                    FixedArray<double, 3> p = dot(bcs, funpack(triangle));
-                    bri.add_parsed_resource_name(p.casted<CompressedScenePos>(), *prn, 0.f, scale_rng());
-                }
-            });
+    using Triangle = FixedArray<ColoredVertex<CompressedScenePos>, 3>;
+    ScatterGrid<const Triangle*> grid{ tile_size * scale };
+    for (const auto& t : triangles.triangles) {
+        grid.add(
+            FixedArray<CompressedScenePos, 2>{ t(0).position(0), t(0).position(1) },
+            &t);
     }
+    grid.scatter(bri, &rnc, seed, [&](const std::vector<const Triangle*>& tile_triangles, ScatterTile& tile){
+        TriangleSampler2<CompressedScenePos> ts{ tile.seed() };
+        FastNormalRandomNumberGenerator<float> scale_rng{ tile.seed() + 1, 1.f, 0.2f };
+        for (const Triangle* t : tile_triangles) {
+            FixedArray<CompressedScenePos, 3, 3> triangle{
+                (*t)(0).position,
+                (*t)(1).position,
+                (*t)(2).position };
+            ts.sample_triangle_interior<3>(
+                triangle,
+                distance * scale,
+                [&](const FixedArray<double, 3>& bcs)
+                {
+                    if (auto prn = tile.rnc().try_multiple_times(10); prn != nullptr) {
+                        FixedArray<double, 3> p = dot(bcs, funpack(triangle));
+                        tile.add(p.casted<CompressedScenePos>(), *prn, 0.f, scale_rng());
+                    }
+                });
+        }
+    });
 }
@@ -10,9 +10,11 @@ class TriangleList;
 
 void add_grass_inside_triangles(
     BatchResourceInstantiator& bri,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     const TriangleList<CompressedScenePos>& triangles,
     float scale,
-    CompressedScenePos distance);
+    CompressedScenePos distance,
+    CompressedScenePos tile_size,
+    unsigned int seed);
 
 }
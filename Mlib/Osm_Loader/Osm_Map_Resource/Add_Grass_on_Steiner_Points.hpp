@@ -1,4 +1,5 @@
 #pragma once
+#include <Mlib/Scene_Precision.hpp>
 #include <cstddef>
 #include <list>
 
@@ -13,12 +14,14 @@ class StreetBvh;
 
 void add_grass_on_steiner_points(
     BatchResourceInstantiator& bri,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     const StreetBvh& ground_bvh,
     const StreetBvh& air_bvh,
     const std::list<SteinerPointInfo>& steiner_points,
     float scale,
     float dmin,
-    float dmax);
+    float dmax,
+    CompressedScenePos tile_size,
+    unsigned int seed);
 
 }
@@ -11,9 +11,22 @@
 #include <Mlib/Scene_Graph/Resources/Scene_Node_Resources.hpp>
 #include <Mlib/Stats/Fast_Random_Number_Generators.hpp>
 #include <Mlib/Strings/To_Number.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#include <cstdint>
+#include <vector>
 
 using namespace Mlib;
 
+namespace {
+
+struct ModelInstance {
+    FixedArray<CompressedScenePos, 2> position;
+    ParsedResourceName prn;
+    float yangle;
+};
+
+}
+
 void Mlib::add_models_to_model_nodes(
     BatchResourceInstantiator& bri,
     const GroundBvh& ground_bvh,
@@ -43,6 +56,7 @@ void Mlib::add_models_to_model_nodes(
             }
         }
     }
+    std::vector<ModelInstance> instances;
     for (const auto& [node_id, node] : nodes) {
         const auto& tags = node.tags;
         if (auto mit = tags.find("model"); mit != tags.end()) {
@@ -109,15 +123,27 @@ void Mlib::add_models_to_model_nodes(
                     yangle = safe_stof(yit->second) * degrees;
                 }
             }
-            CompressedScenePos height;
-            if (ground_bvh.height(height, node.position)) {
-                bri.add_parsed_resource_name(
-                    node.position,
-                    height,
-                    prn,
-                    yangle,
-                    1.);
-            }
+            instances.push_back(ModelInstance{
+                .position = node.position,
+                .prn = std::move(prn),
+                .yangle = yangle});
+        }
+    }
+    // The ground heights are computed in parallel, and the models
+    // are added in the order of the node IDs.
+    std::vector<CompressedScenePos> heights(instances.size());
+    std::vector<uint8_t> valid(instances.size());
+    parallel_for(instances.size(), [&](size_t i){
+        valid[i] = ground_bvh.height(heights[i], instances[i].position);
+    }, 64);
+    for (size_t i = 0; i < instances.size(); ++i) {
+        if (valid[i]) {
+            bri.add_parsed_resource_name(
+                instances[i].position,
+                heights[i],
+                instances[i].prn,
+                instances[i].yangle,
+                1.);
         }
     }
 }
@@ -2,6 +2,7 @@
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Compute_Area.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Ground_Bvh.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Map_Resource_Helpers.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Scatter_Tiles.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Steiner_Point_Info.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Bvh.hpp>
 #include <Mlib/Render/Renderables/Triangle_Sampler/Resource_Name_Cycle.hpp>
@@ -12,10 +13,20 @@
 
 using namespace Mlib;
 
+namespace {
+
+struct ForestOutlineEdge {
+    FixedArray<double, 2> p0;
+    FixedArray<double, 2> p1;
+    double area;
+};
+
+}
+
 void Mlib::add_trees_to_forest_outlines(
     BatchResourceInstantiator& bri,
     // std::list<SteinerPointInfo>& steiner_points,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     double min_dist_to_road,
     const StreetBvh& street_bvh,
     const GroundBvh& ground_bvh,
@@ -23,11 +34,11 @@ void Mlib::add_trees_to_forest_outlines(
     const std::map<std::string, Way>& ways,
     double tree_distance,
     double tree_inwards_distance,
-    double scale)
+    double scale,
+    CompressedScenePos tile_size,
+    unsigned int seed)
 {
-    FastUniformRandomNumberGenerator<double> na_rng{ 0 };
-    FastNormalRandomNumberGenerator<float> scale_rng{ 0, 1.f, 0.2f };
-    // size_t rid = 0;
+    ScatterGrid<ForestOutlineEdge> grid{ tile_size * scale };
     for (const auto& w : ways) {
         const auto& tags = w.second.tags;
         if (tags.contains("landuse", "forest") ||
@@ -40,36 +51,47 @@ void Mlib::add_trees_to_forest_outlines(
                 if (s == w.second.nd.end()) {
                     continue;
                 }
-                FixedArray<double, 2> p0 = funpack(nodes.at(*it).position);
-                FixedArray<double, 2> p1 = funpack(nodes.at(*s).position);
-                double len = std::sqrt(sum(squared(p0 - p1)));
-                FixedArray<double, 2> normal{ p0(1) - p1(1), p1(0) - p0(0) };
-                normal /= len;
-                n_random_numbers(len / (tree_distance * scale), na_rng, [&](){
-                    double aa = na_rng();
-                    FixedArray<CompressedScenePos, 2> p =
-                        ((aa * p0 + (1 - aa) * p1) - tree_inwards_distance * scale * normal * sign(area))
-                        .casted<CompressedScenePos>();
-                    if (std::isnan(min_dist_to_road) || !street_bvh.has_neighbor(p, (CompressedScenePos)(min_dist_to_road * scale))) {
-                        CompressedScenePos height;
-                        if (ground_bvh.height(height, p)) {
-                            if (auto prn = rnc.try_multiple_times(10); prn != nullptr) {
-                                bri.add_parsed_resource_name(p, height, *prn, 0.f, scale_rng());
-                            }
-                        }
-                        // object_resource_descriptors.push_back({
-                        //     position: FixedArray<float, 3>{p(0), p(1), 0},
-                        //     name: rnc(),
-                        //     scale: rng()});
-                        // if ((rid++) % 4 == 0) {
-                        // steiner_points.push_back({
-                        //     .position = {p(0), p(1), 0.f},
-                        //     .type = SteinerPointType::FOREST_OUTLINE,
-                        //     .distance_to_road = NAN});
-                        // }
-                    }
-                });
+                grid.add(
+                    nodes.at(*it).position,
+                    ForestOutlineEdge{
+                        .p0 = funpack(nodes.at(*it).position),
+                        .p1 = funpack(nodes.at(*s).position),
+                        .area = area });
             }
         }
     }
+    // size_t rid = 0;
+    grid.scatter(bri, &rnc, seed, [&](const std::vector<ForestOutlineEdge>& edges, ScatterTile& tile){
+        FastUniformRandomNumberGenerator<double> na_rng{ tile.seed() };
+        FastNormalRandomNumberGenerator<float> scale_rng{ tile.seed() + 1, 1.f, 0.2f };
+        for (const auto& [p0, p1, area] : edges) {
+            double len = std::sqrt(sum(squared(p0 - p1)));
+            FixedArray<double, 2> normal{ p0(1) - p1(1), p1(0) - p0(0) };
+            normal /= len;
+            n_random_numbers(len / (tree_distance * scale), na_rng, [&](){
+                double aa = na_rng();
+                FixedArray<CompressedScenePos, 2> p =
+                    ((aa * p0 + (1 - aa) * p1) - tree_inwards_distance * scale * normal * sign(area))
+                    .casted<CompressedScenePos>();
+                if (std::isnan(min_dist_to_road) || !street_bvh.has_neighbor(p, (CompressedScenePos)(min_dist_to_road * scale))) {
+                    CompressedScenePos height;
+                    if (ground_bvh.height(height, p)) {
+                        if (auto prn = tile.rnc().try_multiple_times(10); prn != nullptr) {
+                            tile.add(p, height, *prn, 0.f, scale_rng());
+                        }
+                    }
+                    // object_resource_descriptors.push_back({
+                    //     position: FixedArray<float, 3>{p(0), p(1), 0},
+                    //     name: rnc(),
+                    //     scale: rng()});
+                    // if ((rid++) % 4 == 0) {
+                    // steiner_points.push_back({
+                    //     .position = {p(0), p(1), 0.f},
+                    //     .type = SteinerPointType::FOREST_OUTLINE,
+                    //     .distance_to_road = NAN});
+                    // }
+                }
+            });
+        }
+    });
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <Mlib/Scene_Precision.hpp>
 #include <map>
 #include <string>
 
@@ -14,7 +15,7 @@ class GroundBvh;
 void add_trees_to_forest_outlines(
     BatchResourceInstantiator& bri,
     // std::list<SteinerPointInfo>& steiner_points,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     double min_dist_to_road,
     const StreetBvh& street_bvh,
     const GroundBvh& ground_bvh,
@@ -22,6 +23,8 @@ void add_trees_to_forest_outlines(
     const std::map<std::string, Way>& ways,
     double tree_distance,
     double tree_inwards_distance,
-    double scale);
+    double scale,
+    CompressedScenePos tile_size,
+    unsigned int seed);
 
 }
@@ -4,6 +4,7 @@
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Compute_Area.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Ground_Bvh.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Map_Resource_Helpers.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Scatter_Tiles.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Bvh.hpp>
 #include <Mlib/Render/Renderables/Triangle_Sampler/Resource_Name_Cycle.hpp>
 #include <Mlib/Scene_Graph/Resources/Batch_Resource_Instantiator.hpp>
@@ -14,7 +15,7 @@ using namespace Mlib;
 
 void Mlib::add_trees_to_zonemap(
     BatchResourceInstantiator& bri,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     const BoundingInfo& bounding_info,
     double min_dist_to_road,
     const StreetBvh& street_bvh,
@@ -26,42 +27,69 @@ void Mlib::add_trees_to_zonemap(
     float jitter,
     double step_size,
     double position_scale,
-    CompressedScenePos min_height)
+    CompressedScenePos min_height,
+    CompressedScenePos tile_size,
+    unsigned int seed)
 {
-    FastUniformRandomNumberGenerator<double> prob_rng{ 0 };
-    FastNormalRandomNumberGenerator<float> scale_rng{ 0, 1.f, 0.2f };
-    FastNormalRandomNumberGenerator<float> jitter_rng{ 0, 0.f, jitter };
-    for (CompressedScenePos x = bounding_info.boundary_min(0); x < bounding_info.boundary_max(0); x += (CompressedScenePos)(step_size * position_scale)) {
-        for (CompressedScenePos y = bounding_info.boundary_min(1); y < bounding_info.boundary_max(1); y += (CompressedScenePos)(step_size * position_scale)) {
-            FixedArray<CompressedScenePos, 2> pos{
-                x + (CompressedScenePos)(position_scale * (double)jitter_rng()),
-                y + (CompressedScenePos)(position_scale * (double)jitter_rng()) };
-            FixedArray<double, 2> size{
-                tree_density_width * position_scale,
-                tree_density_height * position_scale};
-            FixedArray<double, 2> uv = funpack(pos) / size;
-            uv(0) -= std::floor(uv(0));
-            uv(1) -= std::floor(uv(1));
-            double prob;
-            if (!bilinear_grayscale_interpolation(
-                uv(1) * double(tree_density.shape(0) - 1),
-                uv(0) * double(tree_density.shape(1) - 1),
-                tree_density,
-                prob))
-            {
-                continue;
-            }
-            if (prob_rng() > prob * tree_density_multiplier) {
-                continue;
-            }
-            if (std::isnan(min_dist_to_road) || !street_bvh.has_neighbor(pos, (CompressedScenePos)(min_dist_to_road * position_scale))) {
-                CompressedScenePos height;
-                if (ground_bvh.height(height, pos) && (height > min_height * position_scale)) {
-                    if (auto prn = rnc.try_multiple_times(10); prn != nullptr) {
-                        bri.add_parsed_resource_name(pos, height, *prn, 0.f, scale_rng());
+    auto step = (CompressedScenePos)(step_size * position_scale);
+    if (step <= (CompressedScenePos)0.f) {
+        THROW_OR_ABORT("Zonemap step size is too small");
+    }
+    // The grid points are split into blocks of "tile_steps x tile_steps" points.
+    auto nsteps = [&step](CompressedScenePos min, CompressedScenePos max) -> int32_t {
+        return (max > min)
+            ? (int32_t)(((int64_t)max.count - (int64_t)min.count + step.count - 1) / step.count)
+            : 0;
+    };
+    int32_t nx = nsteps(bounding_info.boundary_min(0), bounding_info.boundary_max(0));
+    int32_t ny = nsteps(bounding_info.boundary_min(1), bounding_info.boundary_max(1));
+    int32_t tile_steps = std::max<int32_t>(1, (tile_size * position_scale).count / step.count);
+    std::vector<uint64_t> tile_ids;
+    for (int32_t tx = 0; tx < nx; tx += tile_steps) {
+        for (int32_t ty = 0; ty < ny; ty += tile_steps) {
+            tile_ids.push_back(((uint64_t)tx << 32) | (uint64_t)ty);
+        }
+    }
+    scatter_tiles(bri, &rnc, seed, tile_ids, [&](size_t i, ScatterTile& tile){
+        FastUniformRandomNumberGenerator<double> prob_rng{ tile.seed() };
+        FastNormalRandomNumberGenerator<float> scale_rng{ tile.seed() + 1, 1.f, 0.2f };
+        FastNormalRandomNumberGenerator<float> jitter_rng{ tile.seed() + 2, 0.f, jitter };
+        auto tx = (int32_t)(tile_ids[i] >> 32);
+        auto ty = (int32_t)(tile_ids[i] & 0xFFFFFFFF);
+        for (int32_t ix = tx; ix < std::min(tx + tile_steps, nx); ++ix) {
+            for (int32_t iy = ty; iy < std::min(ty + tile_steps, ny); ++iy) {
+                CompressedScenePos x = bounding_info.boundary_min(0) + step * ix;
+                CompressedScenePos y = bounding_info.boundary_min(1) + step * iy;
+                FixedArray<CompressedScenePos, 2> pos{
+                    x + (CompressedScenePos)(position_scale * (double)jitter_rng()),
+                    y + (CompressedScenePos)(position_scale * (double)jitter_rng()) };
+                FixedArray<double, 2> size{
+                    tree_density_width * position_scale,
+                    tree_density_height * position_scale};
+                FixedArray<double, 2> uv = funpack(pos) / size;
+                uv(0) -= std::floor(uv(0));
+                uv(1) -= std::floor(uv(1));
+                double prob;
+                if (!bilinear_grayscale_interpolation(
+                    uv(1) * double(tree_density.shape(0) - 1),
+                    uv(0) * double(tree_density.shape(1) - 1),
+                    tree_density,
+                    prob))
+                {
+                    continue;
+                }
+                if (prob_rng() > prob * tree_density_multiplier) {
+                    continue;
+                }
+                if (std::isnan(min_dist_to_road) || !street_bvh.has_neighbor(pos, (CompressedScenePos)(min_dist_to_road * position_scale))) {
+                    CompressedScenePos height;
+                    if (ground_bvh.height(height, pos) && (height > min_height * position_scale)) {
+                        if (auto prn = tile.rnc().try_multiple_times(10); prn != nullptr) {
+                            tile.add(pos, height, *prn, 0.f, scale_rng());
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
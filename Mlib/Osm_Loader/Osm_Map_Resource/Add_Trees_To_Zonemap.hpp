@@ -15,7 +15,7 @@ class Array;
 
 void add_trees_to_zonemap(
     BatchResourceInstantiator& bri,
-    ResourceNameCycle& rnc,
+    const ResourceNameCycle& rnc,
     const BoundingInfo& bounding_info,
     double min_dist_to_road,
     const StreetBvh& street_bvh,
@@ -27,6 +27,8 @@ void add_trees_to_zonemap(
     float jitter,
     double step_size,
     double position_scale,
-    CompressedScenePos min_height);
+    CompressedScenePos min_height,
+    CompressedScenePos tile_size,
+    unsigned int seed);
 
 }
@@ -4,7 +4,9 @@
 #include <Mlib/Math/Interp.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Bvh.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Vertex_Height_Binding.hpp>
+#include <cstdint>
 #include <map>
+#include <vector>
 
 using namespace Mlib;
 
@@ -25,6 +27,10 @@ void Mlib::apply_displacement_map(
         auto vc = OrderableFixedArray<CompressedScenePos, 2>{ v.value() };
         vertex_instances_map[vc].push_back(p);
     }
+    // Sample the displacement map for all vertices in a single batch.
+    std::vector<ColoredVertex<CompressedScenePos>*> vertices;
+    std::vector<double> rows;
+    std::vector<double> cols;
     for (auto& lst : triangles) {
         for (auto& tri : lst->triangles) {
             for (auto& v : tri.flat_iterable()) {
@@ -32,25 +38,34 @@ void Mlib::apply_displacement_map(
                 uv *= uv_scale / scale;
                 uv(0) -= std::floor(uv(0));
                 uv(1) -= std::floor(uv(1));
-                double displacement;
-                if (!bilinear_grayscale_interpolation(uv(1) * double(displacementmap.shape(0) - 1), uv(0) * double(displacementmap.shape(1) - 1), displacementmap, displacement)) {
-                    THROW_OR_ABORT("Unexpected bilinear interpolation failure");
-                }
-                auto pt = FixedArray<CompressedScenePos, 2>{ v.position(0), v.position(1) };
-                auto max_dist = (CompressedScenePos)(scale * distance_2_z_scale.xmax());
-                auto dist = (float)std::min(
-                    ground_street_bvh.min_dist(pt, max_dist).value_or(max_dist),
-                    air_bvh.min_dist(pt, max_dist).value_or(max_dist));
-                auto d = (scale * (min_displacement + displacement) * (v.normal * distance_2_z_scale(float(dist / scale))).casted<double>())
-                    .casted<CompressedScenePos>();
-                v.position += d;
-                displacements.try_emplace(OrderableFixedArray{pt}, v.position);
-                auto bit = vertex_instances_map.extract(OrderableFixedArray{pt});
-                if (!bit.empty()) {
-                    for (auto& p : bit.mapped()) {
-                        *p += d;
-                    }
-                }
+                vertices.push_back(&v);
+                rows.push_back(uv(1) * double(displacementmap.shape(0) - 1));
+                cols.push_back(uv(0) * double(displacementmap.shape(1) - 1));
+            }
+        }
+    }
+    std::vector<double> displacements_map_values(vertices.size());
+    std::vector<uint8_t> valid(vertices.size());
+    bilinear_grayscale_interpolation<double>(rows, cols, displacementmap, displacements_map_values, valid);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        auto& v = *vertices[i];
+        if (!valid[i]) {
+            THROW_OR_ABORT("Unexpected bilinear interpolation failure");
+        }
+        double displacement = displacements_map_values[i];
+        auto pt = FixedArray<CompressedScenePos, 2>{ v.position(0), v.position(1) };
+        auto max_dist = (CompressedScenePos)(scale * distance_2_z_scale.xmax());
+        auto dist = (float)std::min(
+            ground_street_bvh.min_dist(pt, max_dist).value_or(max_dist),
+            air_bvh.min_dist(pt, max_dist).value_or(max_dist));
+        auto d = (scale * (min_displacement + displacement) * (v.normal * distance_2_z_scale(float(dist / scale))).casted<double>())
+            .casted<CompressedScenePos>();
+        v.position += d;
+        displacements.try_emplace(OrderableFixedArray{pt}, v.position);
+        auto bit = vertex_instances_map.extract(OrderableFixedArray{pt});
+        if (!bit.empty()) {
+            for (auto& p : bit.mapped()) {
+                *p += d;
             }
         }
     }
@@ -9,27 +9,14 @@
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Node_Height_Binding.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Map_Resource_Helpers.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Triangle_Lists.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Node_Heights.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Vertex_Height_Binding.hpp>
 #include <Mlib/Render/Renderables/Triangle_Sampler/Terrain_Type.hpp>
 #include <Mlib/Strings/To_Number.hpp>
 #include <Mlib/Throw_Or_Abort.hpp>
-
-namespace Mlib {
-
-struct NodeHeight {
-    double height;
-    double smooth_height;
-    double layer;
-};
-
-struct NeighborWeight {
-    std::string id;
-    double weight;
-    int layer;
-    double bridge_height;
-};
-
-}
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 using namespace Mlib;
 
@@ -51,11 +38,15 @@ void Mlib::apply_heightmap(
     const Interp<double>& layer_heights)
 {
     // Smoothen raw 2D street nodes, ignoring which triangles they contributed to.
-    std::map<std::string, NodeHeight> node_height;
+    // The nodes with at least one neighbor are assigned dense indices
+    // in the order of their IDs.
+    std::map<std::string, size_t> node_indices;
+    StreetNodeHeights node_heights;
     if (street_node_smoothness != 0) {
         // Find all node neighbors and compute a weight for each
         // neighbor based on the distance.
-        std::map<std::string, std::list<NeighborWeight>> node_neighbors;
+        std::vector<std::pair<const std::string*, const std::string*>> edge_nodes;
+        std::vector<StreetEdge> edges;
         for (const auto& w : ways) {
             auto layer_it = w.second.tags.find("layer");
             int layer = (layer_it == w.second.tags.end()) ? 0 : safe_stoi(layer_it->second);
@@ -83,82 +74,50 @@ void Mlib::apply_heightmap(
                         THROW_OR_ABORT("Duplicates in neighboring points: " + *it + " - " + *s);
                     }
                     double weight = 1 / std::sqrt(sum(squared(nodes.at(*it).position - nodes.at(*s).position)));
-                    node_neighbors[*s].push_back({.id = *it, .weight = weight, .layer = layer, .bridge_height = bridge_height_ref});
-                    node_neighbors[*it].push_back({.id = *s, .weight = weight, .layer = layer, .bridge_height = bridge_height_ref});
+                    edge_nodes.emplace_back(&*it, &*s);
+                    edges.push_back({.a = 0, .b = 0, .weight = weight, .layer = layer, .bridge_height = bridge_height_ref});
                 }
             }
         }
-        // Iterate over the nodes with at least one neighbor
-        // and compute their initial heights.
-        for (const auto& n : node_neighbors) {
-            double layer = 0;
-            for (const auto& nn : n.second) {
-                layer += (double)nn.layer;
-            }
-            layer /= (double)n.second.size();
-            size_t nbridge_heights = 0;
-            double bridge_height = 0;
-            for (const auto& nn : n.second) {
-                if (!std::isnan(nn.bridge_height)) {
-                    bridge_height += nn.bridge_height;
-                    ++nbridge_heights;
-                }
-            }
-            if (nbridge_heights != 0) {
-                bridge_height /= (double)nbridge_heights;
-            }
-            if (nbridge_heights != 0) {
-                node_height[n.first] = {
-                    .height = layer_heights(layer) + bridge_height - layer_heights(0),
-                    .smooth_height = layer_heights(layer) + bridge_height - layer_heights(0)};
-            } else {
-                if (layer == 0) {
-                    // If the ways to all neighbors are on the ground (or they cancel out to 0),
-                    // pick the height of the heightmap exactly on the node.
-                    CompressedScenePos z;
-                    if (height_sampler(nodes.at(n.first).position, z)) {
-                        node_height[n.first] = {
-                            .height = (double)z,
-                            .smooth_height = (double)z};
-                    }
-                } else {
-                    // If some ways are not on the ground, and the heights don't cancel out to 0,
-                    // interpolate the height using the "layer_heights" interpolator.
-                    node_height[n.first] = {
-                        .height = layer_heights(layer),
-                        .smooth_height = layer_heights(layer)};
-                }
-            }
+        for (const auto& [a, b] : edge_nodes) {
+            node_indices.try_emplace(*a, 0);
+            node_indices.try_emplace(*b, 0);
         }
-        for (auto nnit = node_neighbors.begin(); nnit != node_neighbors.end();) {
-            auto nit = nodes.find(nnit->first);
-            if (auto tit = nit->second.tags.find("smoothing"); (tit != nit->second.tags.end()) && (!safe_stob(tit->second))) {
-                nnit = node_neighbors.erase(nnit);
-            } else {
-                ++nnit;
-            }
+        std::vector<const Node*> node_ptrs;
+        node_ptrs.reserve(node_indices.size());
+        for (auto& [id, index] : node_indices) {
+            index = node_ptrs.size();
+            node_ptrs.push_back(&nodes.at(id));
         }
-        // Smoothen the heights.
-        for (size_t i = 0; i < street_node_smoothing_iterations; ++i) {
-            for (const auto& n : node_neighbors) {
-                auto hit = node_height.find(n.first);
-                if (hit != node_height.end()) {
-                    double mean_height = 0;
-                    double sum_weights = 0;
-                    for (const auto& b : n.second) {
-                        auto it = node_height.find(b.id);
-                        if (it != node_height.end()) {
-                            mean_height += b.weight * it->second.smooth_height;
-                            sum_weights += b.weight;
-                        }
-                    }
-                    if (sum_weights > 0) {
-                        mean_height /= sum_weights;
-                        hit->second.smooth_height = street_node_smoothness * mean_height + (1 - street_node_smoothness) * hit->second.height;
-                    }
+        for (size_t i = 0; i < edges.size(); ++i) {
+            edges[i].a = node_indices.at(*edge_nodes[i].first);
+            edges[i].b = node_indices.at(*edge_nodes[i].second);
+        }
+        StreetNodeGraph graph{ node_ptrs.size(), edges };
+        node_heights = initial_street_node_heights(
+            graph,
+            layer_heights,
+            [&](size_t n, double& height){
+                CompressedScenePos z;
+                if (!height_sampler(node_ptrs[n]->position, z)) {
+                    return false;
                 }
-            }
+                height = (double)z;
+                return true;
+            });
+        // Nodes tagged with "smoothing=no" keep their height.
+        std::vector<uint8_t> fixed(node_ptrs.size());
+        for (size_t n = 0; n < node_ptrs.size(); ++n) {
+            const auto& tags = node_ptrs[n]->tags;
+            auto tit = tags.find("smoothing");
+            fixed[n] = (tit != tags.end()) && !safe_stob(tit->second);
         }
+        smooth_street_node_heights(
+            graph,
+            fixed,
+            street_node_smoothness,
+            street_node_smoothing_iterations,
+            node_heights);
     }
     std::map<EntranceType, std::set<const FixedArray<CompressedScenePos, 3>*>> terrain_entrance_vertices;
     for (const auto& [_, tt] : tl_terrain.map()) {
@@ -209,16 +168,20 @@ void Mlib::apply_heightmap(
         }
         vertex_instances_map[vc].push_back(iv);
     }
+    std::vector<FixedArray<CompressedScenePos, 2>> sampled_positions;
+    std::vector<const std::list<FixedArray<CompressedScenePos, 3>*>*> sampled_vertices;
     for (auto& position : vertex_instances_map) {
         FixedArray<CompressedScenePos, 2> vc = uninitialized;
         // Try to apply height bindings.
         auto it = node_height_bindings.find(OrderableFixedArray<CompressedScenePos, 2>{position.first(0), position.first(1)});
         if (it != node_height_bindings.end()) {
-            // Note that node_height is empty if street_node_smoothness == 0,
+            // Note that node_indices is empty if street_node_smoothness == 0,
             // so this test will then always return false.
-            if (auto hit = node_height.find(it->second.str()); hit != node_height.end()) {
+            if (auto nit = node_indices.find(it->second.str());
+                (nit != node_indices.end()) && node_heights.has_height[nit->second])
+            {
                 for (auto& pc : position.second) {
-                    (*pc)(2) += (CompressedScenePos)(hit->second.smooth_height * scale);
+                    (*pc)(2) += (CompressedScenePos)(node_heights.smooth_height[nit->second] * scale);
                     // Both the tunnel and the street vertices are part of the in_vertices.
                     // The terrain vertices lying on the tunnel vertices are therefore
                     // first moving down with the tunnel vertices in the line above,
@@ -236,18 +199,25 @@ void Mlib::apply_heightmap(
         } else {
             vc = {position.first(0), position.first(1)};
         }
-        // If no height binding could be applied, use the raw heightmap value.
-        CompressedScenePos z;
-        if (!height_sampler(vc, z)) {
+        sampled_positions.push_back(vc);
+        sampled_vertices.push_back(&position.second);
+    }
+    // If no height binding could be applied, use the raw heightmap value.
+    // The heightmap is sampled in a single batch.
+    std::vector<CompressedScenePos> z(sampled_positions.size());
+    std::vector<uint8_t> valid(sampled_positions.size());
+    height_sampler(sampled_positions, z, valid);
+    for (size_t i = 0; i < sampled_positions.size(); ++i) {
+        if (!valid[i]) {
             // lerr() << "Height out of bounds.";
-            for (auto& pc : position.second) {
+            for (auto& pc : *sampled_vertices[i]) {
                 if (!vertices_to_delete.insert(pc).second) {
                     THROW_OR_ABORT("Could not insert vertex to delete");
                 }
             }
         } else {
-            for (auto& pc : position.second) {
-                (*pc)(2) += z * scale;
+            for (auto& pc : *sampled_vertices[i]) {
+                (*pc)(2) += z[i] * scale;
             }
         }
     }
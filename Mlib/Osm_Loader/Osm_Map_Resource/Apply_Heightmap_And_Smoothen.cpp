@@ -1,5 +1,6 @@
 #include "Apply_Heightmap_And_Smoothen.hpp"
 #include <Mlib/Geography/Heightmaps/Load_Heightmap_From_File.hpp>
+#include <Mlib/Geography/Heightmaps/Tiled_Heightmap.hpp>
 #include <Mlib/Geometry/Coordinates/Normalized_Points_Fixed.hpp>
 #include <Mlib/Geometry/Exceptions/Point_Exception.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_List.hpp>
@@ -111,23 +112,38 @@ void Mlib::apply_heightmap_and_smoothen(
     };
     std::optional<HeightSampler> height_sampler;
     if (!config.heightmap.empty()) {
-        Array<double> heightmap = config.height_scale * load_heightmap_from_file<double>(config.heightmap);
-        Array<bool> heightmap_mask;
-        if (!config.heightmap_mask.empty()) {
-            heightmap_mask = PgmImage::load_from_file(config.heightmap_mask).casted<bool>();
+        auto normalization_matrix = normalized_points.chained(ScaleMode::DIAGONAL, OffsetMode::MINIMUM).normalization_matrix();
+        if (TiledHeightmap::is_tiled_heightmap(config.heightmap)) {
+            // Tiled heightmaps are sampled directly from the file,
+            // the extension requires the entire image.
+            if (!config.heightmap_mask.empty() || (config.heightmap_extension != 0)) {
+                THROW_OR_ABORT("Tiled heightmaps do not support masks or extensions");
+            }
+            height_sampler.emplace(
+                std::make_unique<TiledHeightmap>(
+                    config.heightmap,
+                    config.height_scale,
+                    config.heightmap_max_cached_tiles),
+                normalization_matrix);
         } else {
-            heightmap_mask.move() = ones<bool>(heightmap.shape());
+            Array<double> heightmap = config.height_scale * load_heightmap_from_file<double>(config.heightmap);
+            Array<bool> heightmap_mask;
+            if (!config.heightmap_mask.empty()) {
+                heightmap_mask = PgmImage::load_from_file(config.heightmap_mask).casted<bool>();
+            } else {
+                heightmap_mask.move() = ones<bool>(heightmap.shape());
+            }
+            size_t ext = std::max({ heightmap.shape(0), heightmap.shape(1), config.heightmap_extension });
+            ExtendedImage extended_heightmap{
+                heightmap,
+                heightmap_mask,
+                config.heightmap_extension,
+                50,
+                1 + ext / 50 };
+            height_sampler.emplace(
+                std::move(extended_heightmap),
+                normalization_matrix);
         }
-        size_t ext = std::max({ heightmap.shape(0), heightmap.shape(1), config.heightmap_extension });
-        ExtendedImage extended_heightmap{
-            heightmap,
-            heightmap_mask,
-            config.heightmap_extension,
-            50,
-            1 + ext / 50 };
-        height_sampler.emplace(
-            std::move(extended_heightmap),
-            normalized_points.chained(ScaleMode::DIAGONAL, OffsetMode::MINIMUM).normalization_matrix());
 
         LOG_INFO("apply_heightmap");
         std::list<std::shared_ptr<TriangleList<CompressedScenePos>>> tls_smoothed;
@@ -217,6 +233,9 @@ void Mlib::apply_heightmap_and_smoothen(
 
             std::unordered_map<OrderableFixedArray<CompressedScenePos, 3>, FixedArray<float, 3>> bias;
             if (height_sampler.has_value() && !config.terrain_edge_bias.empty()) {
+                std::vector<const FixedArray<CompressedScenePos, 3>*> biased_vertices;
+                std::vector<CompressedScenePos> closest_dists;
+                std::vector<FixedArray<CompressedScenePos, 2>> closest_pts;
                 for (const auto* s : smoothed_vertices) {
                     FixedArray<CompressedScenePos, 2> pt{ (*s)(0), (*s)(1) };
                     FixedArray<CompressedScenePos, 2> closest_ground = uninitialized;
@@ -229,16 +248,24 @@ void Mlib::apply_heightmap_and_smoothen(
                         auto closest_pt = (ground_dist < air_dist)
                             ? closest_ground
                             : closest_air;
-                        CompressedScenePos street_z;
-                        if ((*height_sampler)(closest_pt, street_z)) {
-                            bias.try_emplace(
-                                OrderableFixedArray{ *s },
-                                FixedArray<CompressedScenePos, 3>{
-                                    (CompressedScenePos)0.,
-                                    (CompressedScenePos)0.,
-                                    (CompressedScenePos)config.terrain_edge_bias(
-                                        (float)(closest_dist * sign(funpack((*s)(2)) / config.scale - funpack(street_z)))) });
-                        }
+                        biased_vertices.push_back(s);
+                        closest_dists.push_back(closest_dist);
+                        closest_pts.push_back(closest_pt);
+                    }
+                }
+                std::vector<CompressedScenePos> street_z(closest_pts.size());
+                std::vector<uint8_t> valid(closest_pts.size());
+                (*height_sampler)(closest_pts, street_z, valid);
+                for (size_t i = 0; i < biased_vertices.size(); ++i) {
+                    if (valid[i]) {
+                        const auto* s = biased_vertices[i];
+                        bias.try_emplace(
+                            OrderableFixedArray{ *s },
+                            FixedArray<CompressedScenePos, 3>{
+                                (CompressedScenePos)0.,
+                                (CompressedScenePos)0.,
+                                (CompressedScenePos)config.terrain_edge_bias(
+                                    (float)(closest_dists[i] * sign(funpack((*s)(2)) / config.scale - funpack(street_z[i])))) });
                     }
                 }
             }
@@ -7,7 +7,7 @@
 #include <Mlib/Geometry/Mesh/Points_And_Adjacency_Impl.hpp>
 #include <Mlib/Math/Fixed_Cholesky.hpp>
 #include <Mlib/Math/Orderable_Fixed_Array.hpp>
-#include <Mlib/Navigation/Sample_SoloMesh.hpp>
+#include <Mlib/Navigation/INavigation_Mesh.hpp>
 #include <Mlib/Navigation/Shortest_Path_Intermediate_Points_Creator.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Ground_Bvh.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Map_Resource_Helpers.hpp>
@@ -27,7 +27,7 @@ void Mlib::calculate_waypoint_adjacency(
     const std::map<std::string, Node>& nodes,
     const GroundBvh& ground_bvh,
     const FixedArray<double, 3, 3>* to_meters,
-    const Sample_SoloMesh* ssm,
+    const INavigationMesh* navmesh,
     double scale,
     double merge_radius,
     double error_radius,
@@ -169,14 +169,14 @@ void Mlib::calculate_waypoint_adjacency(
         }
         return res;
     };
-    if (!ssm != !to_meters) {
+    if (!navmesh != !to_meters) {
         THROW_OR_ABORT("Inconsistent to-meters mapping an navmesh parameters");
     }
     auto idef = interpolate_default<WayPoint>;
     InterpolatedIntermediatePointsCreator<WayPoint, decltype(idef)> default_iipc{
         waypoint_distance,
         idef };
-    if (ssm != nullptr) {
+    if (navmesh != nullptr) {
         std::map<OrderableFixedArray<CompressedScenePos, 3>, dtPolyRef> poly_refs;
         for (auto&& [i, p] : enumerate(way_points.points)) {
             auto pm = dot1d(*to_meters, funpack(p.position));
@@ -184,7 +184,7 @@ void Mlib::calculate_waypoint_adjacency(
                 p.position = pm.casted<CompressedScenePos>();
                 continue;
             }
-            auto lp = ssm->closest_point_on_navmesh(pm.casted<float>());
+            auto lp = navmesh->closest_point_on_navmesh(pm.casted<float>());
             if (!lp.has_value()) {
                 throw PointException<CompressedScenePos, 3>{ p.position, "Could not find closest point on navmesh" };
             }
@@ -199,7 +199,7 @@ void Mlib::calculate_waypoint_adjacency(
         if (!itm.has_value()) {
             THROW_OR_ABORT("Could not compute inverse to_meters mapping");
         }
-        ShortestPathIntermediatePointsCreator spipc{ *ssm, poly_refs, (float)waypoint_distance };
+        ShortestPathIntermediatePointsCreator spipc{ *navmesh, poly_refs, (float)waypoint_distance };
         try {
             way_points.subdivide(
                 [&](size_t r, size_t c, const CompressedScenePos& distance) -> std::vector<WayPoint> {
@@ -18,7 +18,7 @@ struct TerrainWayPoints;
 struct Node;
 class GroundBvh;
 struct StreetWayPoint;
-class Sample_SoloMesh;
+class INavigationMesh;
 enum class WayPointsClass;
 
 void calculate_waypoint_adjacency(
@@ -29,7 +29,7 @@ void calculate_waypoint_adjacency(
     const std::map<std::string, Node>& nodes,
     const GroundBvh& ground_bvh,
     const FixedArray<double, 3, 3>* to_meters,
-    const Sample_SoloMesh* ssm,
+    const INavigationMesh* navmesh,
     double scale,
     double merge_radius,
     double error_radius,
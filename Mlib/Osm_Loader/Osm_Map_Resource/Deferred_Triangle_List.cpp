@@ -0,0 +1,102 @@
+#include "Deferred_Triangle_List.hpp"
+#include <Mlib/Geometry/Mesh/Triangle_List.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+
+using namespace Mlib;
+
+DeferredTriangleList::DeferredTriangleList(
+    TriangleList<CompressedScenePos>& destination,
+    std::vector<DeferredPolygon>& polygons)
+    : destination_{ destination }
+    , polygons_{ polygons }
+{}
+
+void DeferredTriangleList::draw_triangle_wo_normals(
+    const FixedArray<CompressedScenePos, 3>& p00,
+    const FixedArray<CompressedScenePos, 3>& p10,
+    const FixedArray<CompressedScenePos, 3>& p01,
+    const FixedArray<uint8_t, 4>& c00,
+    const FixedArray<uint8_t, 4>& c10,
+    const FixedArray<uint8_t, 4>& c01,
+    const FixedArray<float, 2>& u00,
+    const FixedArray<float, 2>& u10,
+    const FixedArray<float, 2>& u01,
+    const std::vector<BoneWeight>& b00,
+    const std::vector<BoneWeight>& b10,
+    const std::vector<BoneWeight>& b01,
+    NormalVectorErrorBehavior normal_error_behavior,
+    TriangleTangentErrorBehavior tangent_error_behavior)
+{
+    if (!b00.empty() || !b10.empty() || !b01.empty()) {
+        THROW_OR_ABORT("Deferred triangle lists do not support bone weights");
+    }
+    polygons_.push_back(DeferredPolygon{
+        .destination = &destination_,
+        .nvertices = 3,
+        .positions = { p00, p10, p01, fixed_zeros<CompressedScenePos, 3>() },
+        .colors = { c00, c10, c01, fixed_zeros<uint8_t, 4>() },
+        .uvs = { u00, u10, u01, fixed_zeros<float, 2>() },
+        .normal_error_behavior = normal_error_behavior,
+        .tangent_error_behavior = tangent_error_behavior,
+        .rectangle_triangulation_mode = RectangleTriangulationMode::FIRST});
+}
+
+void DeferredTriangleList::draw_rectangle_wo_normals(
+    const FixedArray<CompressedScenePos, 3>& p00,
+    const FixedArray<CompressedScenePos, 3>& p10,
+    const FixedArray<CompressedScenePos, 3>& p11,
+    const FixedArray<CompressedScenePos, 3>& p01,
+    const FixedArray<uint8_t, 4>& c00,
+    const FixedArray<uint8_t, 4>& c10,
+    const FixedArray<uint8_t, 4>& c11,
+    const FixedArray<uint8_t, 4>& c01,
+    const FixedArray<float, 2>& u00,
+    const FixedArray<float, 2>& u10,
+    const FixedArray<float, 2>& u11,
+    const FixedArray<float, 2>& u01,
+    const std::vector<BoneWeight>& b00,
+    const std::vector<BoneWeight>& b10,
+    const std::vector<BoneWeight>& b11,
+    const std::vector<BoneWeight>& b01,
+    NormalVectorErrorBehavior normal_error_behavior,
+    TriangleTangentErrorBehavior tangent_error_behavior,
+    RectangleTriangulationMode rectangle_triangulation_mode)
+{
+    if (!b00.empty() || !b10.empty() || !b11.empty() || !b01.empty()) {
+        THROW_OR_ABORT("Deferred triangle lists do not support bone weights");
+    }
+    polygons_.push_back(DeferredPolygon{
+        .destination = &destination_,
+        .nvertices = 4,
+        .positions = { p00, p10, p11, p01 },
+        .colors = { c00, c10, c11, c01 },
+        .uvs = { u00, u10, u11, u01 },
+        .normal_error_behavior = normal_error_behavior,
+        .tangent_error_behavior = tangent_error_behavior,
+        .rectangle_triangulation_mode = rectangle_triangulation_mode});
+}
+
+void Mlib::draw_deferred_polygons(const std::vector<DeferredPolygon>& polygons) {
+    for (const auto& p : polygons) {
+        if (p.nvertices == 3) {
+            p.destination->draw_triangle_wo_normals(
+                p.positions[0], p.positions[1], p.positions[2],
+                p.colors[0], p.colors[1], p.colors[2],
+                p.uvs[0], p.uvs[1], p.uvs[2],
+                {}, {}, {},
+                p.normal_error_behavior,
+                p.tangent_error_behavior);
+        } else if (p.nvertices == 4) {
+            p.destination->draw_rectangle_wo_normals(
+                p.positions[0], p.positions[1], p.positions[2], p.positions[3],
+                p.colors[0], p.colors[1], p.colors[2], p.colors[3],
+                p.uvs[0], p.uvs[1], p.uvs[2], p.uvs[3],
+                {}, {}, {}, {},
+                p.normal_error_behavior,
+                p.tangent_error_behavior,
+                p.rectangle_triangulation_mode);
+        } else {
+            THROW_OR_ABORT("Unsupported number of deferred polygon vertices");
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Mesh/Bone_Weight.hpp>
+#include <Mlib/Geometry/Normal_Vector_Error_Behavior.hpp>
+#include <Mlib/Geometry/Rectangle_Triangulation_Mode.hpp>
+#include <Mlib/Geometry/Triangle_Tangent_Error_Behavior.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Mlib {
+
+template <class TPos>
+class TriangleList;
+
+/**
+ * Triangle or rectangle recorded for a TriangleList,
+ * so it can be computed in parallel and drawn in a fixed order.
+ */
+struct DeferredPolygon {
+    TriangleList<CompressedScenePos>* destination;
+    size_t nvertices;
+    FixedArray<CompressedScenePos, 4, 3> positions;
+    FixedArray<uint8_t, 4, 4> colors;
+    FixedArray<float, 4, 2> uvs;
+    NormalVectorErrorBehavior normal_error_behavior;
+    TriangleTangentErrorBehavior tangent_error_behavior;
+    RectangleTriangulationMode rectangle_triangulation_mode;
+};
+
+/**
+ * Records the "draw_*_wo_normals" calls of a TriangleList
+ * without modifying it. Bone weights are not supported.
+ */
+class DeferredTriangleList {
+public:
+    DeferredTriangleList(
+        TriangleList<CompressedScenePos>& destination,
+        std::vector<DeferredPolygon>& polygons);
+    void draw_triangle_wo_normals(
+        const FixedArray<CompressedScenePos, 3>& p00,
+        const FixedArray<CompressedScenePos, 3>& p10,
+        const FixedArray<CompressedScenePos, 3>& p01,
+        const FixedArray<uint8_t, 4>& c00 = Colors::RED,
+        const FixedArray<uint8_t, 4>& c10 = Colors::GREEN,
+        const FixedArray<uint8_t, 4>& c01 = Colors::BLUE,
+        const FixedArray<float, 2>& u00 = {0.f, 0.f},
+        const FixedArray<float, 2>& u10 = {1.f, 0.f},
+        const FixedArray<float, 2>& u01 = {0.f, 1.f},
+        const std::vector<BoneWeight>& b00 = {},
+        const std::vector<BoneWeight>& b10 = {},
+        const std::vector<BoneWeight>& b01 = {},
+        NormalVectorErrorBehavior normal_error_behavior = NormalVectorErrorBehavior::THROW,
+        TriangleTangentErrorBehavior tangent_error_behavior = TriangleTangentErrorBehavior::THROW);
+    void draw_rectangle_wo_normals(
+        const FixedArray<CompressedScenePos, 3>& p00,
+        const FixedArray<CompressedScenePos, 3>& p10,
+        const FixedArray<CompressedScenePos, 3>& p11,
+        const FixedArray<CompressedScenePos, 3>& p01,
+        const FixedArray<uint8_t, 4>& c00 = Colors::RED,
+        const FixedArray<uint8_t, 4>& c10 = Colors::GREEN,
+        const FixedArray<uint8_t, 4>& c11 = Colors::BLUE,
+        const FixedArray<uint8_t, 4>& c01 = Colors::CYAN,
+        const FixedArray<float, 2>& u00 = {0.f, 0.f},
+        const FixedArray<float, 2>& u10 = {1.f, 0.f},
+        const FixedArray<float, 2>& u11 = {1.f, 1.f},
+        const FixedArray<float, 2>& u01 = {0.f, 1.f},
+        const std::vector<BoneWeight>& b00 = {},
+        const std::vector<BoneWeight>& b10 = {},
+        const std::vector<BoneWeight>& b11 = {},
+        const std::vector<BoneWeight>& b01 = {},
+        NormalVectorErrorBehavior normal_error_behavior = NormalVectorErrorBehavior::THROW,
+        TriangleTangentErrorBehavior tangent_error_behavior = TriangleTangentErrorBehavior::THROW,
+        RectangleTriangulationMode rectangle_triangulation_mode = RectangleTriangulationMode::FIRST);
+private:
+    TriangleList<CompressedScenePos>& destination_;
+    std::vector<DeferredPolygon>& polygons_;
+};
+
+void draw_deferred_polygons(const std::vector<DeferredPolygon>& polygons);
+
+}
@@ -100,6 +100,8 @@ void Mlib::draw_buildings_ceiling_or_ground(
                 {},                                                              // region_contours
                 scale,                                                           // scale
                 triangulation_scale,                                             // triangulation_scale
+                (CompressedScenePos)0.,                                          // triangulation_tile_size
+                (CompressedScenePos)0.,                                          // triangulation_tile_boundary_distance
                 uv_scale,                                                        // uv_scale
                 uv_period,                                                       // uv_period
                 gz + sw.z,                                                       // z
@@ -6,6 +6,7 @@
 #include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_List.hpp>
 #include <Mlib/Os/Os.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Deferred_Triangle_List.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Entrance_Type.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Get_Way_Width.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Node_Height_Binding.hpp>
@@ -29,6 +30,10 @@
 #include <Mlib/Stats/Mean.hpp>
 #include <Mlib/Strings/String.hpp>
 #include <Mlib/Strings/To_Number.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#include <algorithm>
+#include <optional>
+#include <vector>
 
 using namespace Mlib;
 
@@ -99,33 +104,127 @@ struct NodeHoleVertex {
     std::string way_id;
 };
 
+struct StreetGraphIncidence {
+    size_t neighbor;
+    const AngleWay* angle_way;
+    float angle;
+    // Index of the incidence in the row of this node whose angle
+    // is stored in "node_neighbors" for the neighbor.
+    size_t canonical;
+    // Index of the incidence in the row of the neighbor whose angle
+    // is stored in "node_neighbors" for this node.
+    size_t reverse;
+    // Width stored in "node_neighbors" for the neighbor.
+    CompressedScenePos neighbor_width;
+};
+
+struct StreetSegment {
+    size_t node0;
+    size_t incidence;
+};
+
+/**
+ * Flattened copy of "node_angles".
+ * Nodes are indexed densely in the order of their IDs, the incidences
+ * of a node are stored in compressed sparse row format, sorted by angle.
+ * The segments are the incidences with "neighbor_is_second" set,
+ * in the order in which "node_angles" is iterated.
+ */
+struct StreetGraph {
+    std::vector<const std::string*> node_ids;
+    std::vector<const Node*> nodes;
+    std::vector<size_t> row_begins;
+    std::vector<StreetGraphIncidence> incidences;
+    std::vector<StreetSegment> segments;
+    // Returns the incidences left and right of the incidence "i"
+    // of node "n", wrapping around at the ends of the row.
+    void get_neighbors(size_t n, size_t i, size_t& l, size_t& r) const {
+        size_t begin = row_begins[n];
+        size_t end = row_begins[n + 1];
+        l = (i == begin) ? end - 1 : i - 1;
+        r = (i + 1 == end) ? begin : i + 1;
+    }
+};
+
+enum class StreetSegmentStatus {
+    OK,
+    TOO_SHORT,
+    TRIANGULATION_FAILED
+};
+
+/**
+ * Results of drawing one street segment. They are computed
+ * in parallel and merged in the order of the segments.
+ */
+struct StreetSegmentOutput {
+    std::vector<DeferredPolygon> polygons;
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding> node_height_bindings;
+    std::map<EntranceType, std::set<OrderableFixedArray<CompressedScenePos, 2>>> entrances;
+    std::map<WayPointSandbox, std::list<std::pair<StreetWayPoint, StreetWayPoint>>> way_point_edge_descriptors;
+    std::list<StreetRectangle> street_rectangles;
+    std::list<std::pair<std::map<AngleCurb, NodeHoleVertex>*, std::pair<AngleCurb, NodeHoleVertex>>> hole_contours;
+    std::list<std::pair<std::list<NodeHoleWaypoint>*, NodeHoleWaypoint>> hole_waypoints;
+};
+
 }
 
-static void get_neighbors(
-    const std::string& center,
-    const std::map<std::string, NeighborWay>& neighbors,
-    const std::map<float, AngleWay>& angles,
-    const std::string** l,
-    const std::string** r)
+static size_t find_angle(
+    const StreetGraph& graph,
+    size_t n,
+    float angle)
 {
-    float angle = neighbors.at(center).angle;
-    auto it = angles.find(angle);
-    if (it == angles.end()) {
+    auto begin = graph.incidences.begin() + (ptrdiff_t)graph.row_begins[n];
+    auto end = graph.incidences.begin() + (ptrdiff_t)graph.row_begins[n + 1];
+    auto it = std::ranges::lower_bound(begin, end, angle, {}, &StreetGraphIncidence::angle);
+    if ((it == end) || (it->angle != angle)) {
         THROW_OR_ABORT("Could not find angle");
     }
-    if (it == angles.begin()) {
-        *l = &angles.rbegin()->second.neighbor_id;
-    } else {
-        auto itL = it;
-        *l = &(--itL)->second.neighbor_id;
+    return (size_t)(it - graph.incidences.begin());
+}
+
+static StreetGraph build_street_graph(
+    const std::map<std::string, Node>& nodes,
+    const std::map<std::string, std::map<float, AngleWay>>& node_angles,
+    const std::map<std::string, std::map<std::string, NeighborWay>>& node_neighbors)
+{
+    StreetGraph result;
+    std::map<std::string, size_t> node_indices;
+    result.node_ids.reserve(node_angles.size());
+    result.nodes.reserve(node_angles.size());
+    result.row_begins.reserve(node_angles.size() + 1);
+    for (const auto& [node_id, angle_ways] : node_angles) {
+        node_indices.try_emplace(node_id, result.node_ids.size());
+        result.node_ids.push_back(&node_id);
+        result.nodes.push_back(&nodes.at(node_id));
+        result.row_begins.push_back(result.incidences.size());
+        for (const auto& [angle, angle_way] : angle_ways) {
+            result.incidences.push_back(StreetGraphIncidence{
+                .neighbor = SIZE_MAX,
+                .angle_way = &angle_way,
+                .angle = angle,
+                .canonical = SIZE_MAX,
+                .reverse = SIZE_MAX,
+                .neighbor_width = node_neighbors.at(node_id).at(angle_way.neighbor_id).width});
+        }
     }
-    auto itR = it;
-    ++itR;
-    if (itR == angles.end()) {
-        *r = &angles.begin()->second.neighbor_id;
-    } else {
-        *r = &itR->second.neighbor_id;
+    result.row_begins.push_back(result.incidences.size());
+    for (size_t n = 0; n < result.node_ids.size(); ++n) {
+        const auto& neighbors = node_neighbors.at(*result.node_ids[n]);
+        for (size_t i = result.row_begins[n]; i < result.row_begins[n + 1]; ++i) {
+            auto& inc = result.incidences[i];
+            const auto& neighbor_id = inc.angle_way->neighbor_id;
+            inc.neighbor = node_indices.at(neighbor_id);
+            inc.canonical = find_angle(result, n, neighbors.at(neighbor_id).angle);
+            inc.reverse = find_angle(
+                result,
+                inc.neighbor,
+                node_neighbors.at(neighbor_id).at(*result.node_ids[n]).angle);
+            if (inc.angle_way->neighbor_is_second) {
+                result.segments.push_back({ .node0 = n, .incidence = i });
+            }
+        }
     }
+    return result;
 }
 
 DrawStreets::DrawStreets(const DrawStreetsInput& in)
@@ -309,113 +408,169 @@ void DrawStreets::draw_streets() {
 
     // Compute rectangles and holes for each pair of connected nodes.
     // The "neighbor_is_second" field is used to avoid duplicates.
-    for (const auto& [node_id, angle_ways] : node_angles) {
-        for (const auto& [neighbor_angle, angle_way] : angle_ways) {
-            if (angle_way.neighbor_is_second) {
-                // node index: node_id
-                // neighbor index: angle_way.neighbor_id
-                // angle of neighbor: neighbor_angle
-                // angle at neighbor: node_neighbors.at(angle_way).at(node_id)
-                const std::string* aL;
-                const std::string* aR;
-                get_neighbors(angle_way.neighbor_id, node_neighbors.at(node_id), angle_ways, &aL, &aR);
-                const std::string* dL;
-                const std::string* dR;
-                get_neighbors(node_id, node_neighbors.at(angle_way.neighbor_id), node_angles.at(angle_way.neighbor_id), &dL, &dR);
-                if (sum(squared(nodes.at(node_id).position - nodes.at(angle_way.neighbor_id).position)) < squared(0.1 * scale))
-                {
-                    lwarn() << "Skipping street because it is too short. " <<
-                        angle_way.neighbor_id << " <-> " << node_id << ", (" <<
-                        nodes.at(angle_way.neighbor_id).position << ") <-> (" << nodes.at(node_id).position << ")";
-                    continue;
-                }
-                OsmRectangle2D rect = uninitialized;
-                if (!OsmRectangle2D::from_line(
-                    rect,
-                    nodes.at(*aR).position,
-                    nodes.at(*aL).position,
-                    nodes.at(node_id).position,
-                    nodes.at(angle_way.neighbor_id).position,
-                    nodes.at(*dL).position,
-                    nodes.at(*dR).position,
-                    *aR == node_id ? angle_way.width : node_neighbors.at(*aR).at(node_id).width,
-                    *aL == node_id ? angle_way.width : node_neighbors.at(*aL).at(node_id).width,
-                    angle_way.width,
-                    angle_way.width,
-                    *dL == node_id ? angle_way.width : node_neighbors.at(*dL).at(angle_way.neighbor_id).width,
-                    *dR == node_id ? angle_way.width : node_neighbors.at(*dR).at(angle_way.neighbor_id).width))
-                {
-                    lwarn() << "Error triangulating street nodes " <<
-                        angle_way.neighbor_id << " <-> " << node_id << ", (" <<
-                        nodes.at(angle_way.neighbor_id).position << ") <-> (" << nodes.at(node_id).position << ")";
-                    continue;
-                }
-                draw_streets_draw_ways(
-                    rect,
-                    node_id,
-                    angle_way);
-                draw_streets_find_hole_contours(
-                    rect,
-                    node_id,
-                    angle_way,
-                    neighbor_angle);
-                {
-                    const auto& wi = way_infos.at(angle_way.way_id);
-                    float lane_shift;
-                    if (angle_way.nlanes <= 2) {
-                        // alpha is in [-1 .. +1]
-                        lane_shift = 0.f;
-                    } else {
-                        // alpha is in [-1 .. +1]
-                        lane_shift = 0.125f;
-                    }
-                    if (angle_way.road_type != RoadType::WALL) {
-                        draw_streets_add_waypoints(
-                            rect,
-                            wi.curb_alpha,
-                            wi.curb2_alpha,
-                            angle_way.nlanes,
-                            lane_shift,
-                            node_id,
-                            angle_way);
-                        draw_streets_find_hole_waypoints(
-                            rect,
-                            node_id,
-                            angle_way,
-                            wi.curb_alpha,
-                            wi.curb2_alpha,
-                            lane_shift);
+    auto graph = build_street_graph(nodes, node_angles, node_neighbors);
+    std::vector<StreetSegmentStatus> statuses(graph.segments.size());
+    UUVector<OsmRectangle2D> rects(graph.segments.size());
+    std::vector<StreetSegmentOutput> outputs(graph.segments.size());
+    // The segments only read the graph and the node and way infos,
+    // so they are drawn in parallel into per-segment buffers.
+    parallel_for(graph.segments.size(), [&](size_t s){
+        const auto& seg = graph.segments[s];
+        const auto& inc = graph.incidences[seg.incidence];
+        size_t n0 = seg.node0;
+        size_t n1 = inc.neighbor;
+        // node index: n0
+        // neighbor index: n1
+        // angle of neighbor: inc.angle
+        // angle at neighbor: graph.incidences[inc.reverse].angle
+        size_t aL;
+        size_t aR;
+        graph.get_neighbors(n0, inc.canonical, aL, aR);
+        size_t dL;
+        size_t dR;
+        graph.get_neighbors(n1, inc.reverse, dL, dR);
+        const auto& p0 = graph.nodes[n0]->position;
+        const auto& p1 = graph.nodes[n1]->position;
+        if (sum(squared(p0 - p1)) < squared(0.1 * scale)) {
+            statuses[s] = StreetSegmentStatus::TOO_SHORT;
+            return;
+        }
+        auto width = [&](size_t i){
+            const auto& nb = graph.incidences[i];
+            return (nb.neighbor == n0) ? inc.angle_way->width : nb.neighbor_width;
+        };
+        statuses[s] = OsmRectangle2D::from_line(
+            rects[s],
+            graph.nodes[graph.incidences[aR].neighbor]->position,
+            graph.nodes[graph.incidences[aL].neighbor]->position,
+            p0,
+            p1,
+            graph.nodes[graph.incidences[dL].neighbor]->position,
+            graph.nodes[graph.incidences[dR].neighbor]->position,
+            width(aR),
+            width(aL),
+            inc.angle_way->width,
+            inc.angle_way->width,
+            width(dL),
+            width(dR))
+            ? StreetSegmentStatus::OK
+            : StreetSegmentStatus::TRIANGULATION_FAILED;
+        if (statuses[s] != StreetSegmentStatus::OK) {
+            return;
+        }
+        const auto& rect = rects[s];
+        const auto& node_id = *graph.node_ids[n0];
+        const auto& angle_way = *inc.angle_way;
+        auto& output = outputs[s];
+        draw_streets_draw_ways(
+            rect,
+            node_id,
+            angle_way,
+            output);
+        draw_streets_find_hole_contours(
+            rect,
+            node_id,
+            angle_way,
+            inc.angle,
+            output);
+        if (angle_way.road_type != RoadType::WALL) {
+            const auto& wi = way_infos.at(angle_way.way_id);
+            float lane_shift;
+            if (angle_way.nlanes <= 2) {
+                // alpha is in [-1 .. +1]
+                lane_shift = 0.f;
+            } else {
+                // alpha is in [-1 .. +1]
+                lane_shift = 0.125f;
+            }
+            draw_streets_add_waypoints(
+                rect,
+                wi.curb_alpha,
+                wi.curb2_alpha,
+                angle_way.nlanes,
+                lane_shift,
+                node_id,
+                angle_way,
+                output);
+            draw_streets_find_hole_waypoints(
+                rect,
+                node_id,
+                angle_way,
+                wi.curb_alpha,
+                wi.curb2_alpha,
+                lane_shift,
+                output);
+        }
+    }, 64);
+    // The buffers are merged in the order of the segments to keep
+    // the output deterministic. Only the street lights depend on the
+    // previous segments, so they are placed here.
+    for (size_t s = 0; s < graph.segments.size(); ++s) {
+        const auto& seg = graph.segments[s];
+        const auto& inc = graph.incidences[seg.incidence];
+        const auto& node_id = *graph.node_ids[seg.node0];
+        const auto& angle_way = *inc.angle_way;
+        if (statuses[s] == StreetSegmentStatus::TOO_SHORT) {
+            lwarn() << "Skipping street because it is too short. " <<
+                angle_way.neighbor_id << " <-> " << node_id << ", (" <<
+                nodes.at(angle_way.neighbor_id).position << ") <-> (" << nodes.at(node_id).position << ")";
+            continue;
+        }
+        if (statuses[s] == StreetSegmentStatus::TRIANGULATION_FAILED) {
+            lwarn() << "Error triangulating street nodes " <<
+                angle_way.neighbor_id << " <-> " << node_id << ", (" <<
+                nodes.at(angle_way.neighbor_id).position << ") <-> (" << nodes.at(node_id).position << ")";
+            continue;
+        }
+        const auto& rect = rects[s];
+        auto& output = outputs[s];
+        draw_deferred_polygons(output.polygons);
+        for (const auto& [p, b] : output.node_height_bindings) {
+            node_height_bindings[p] = b.str();
+        }
+        for (const auto& [t, e] : output.entrances) {
+            ground_triangles.entrances[t].insert(e.begin(), e.end());
+        }
+        for (auto& [sandbox, e] : output.way_point_edge_descriptors) {
+            auto& d = way_point_edge_descriptors[sandbox];
+            d.splice(d.end(), e);
+        }
+        street_rectangles.splice(street_rectangles.end(), output.street_rectangles);
+        for (auto& [d, c] : output.hole_contours) {
+            d->insert(std::move(c));
+        }
+        for (auto& [d, w] : output.hole_waypoints) {
+            d->push_back(std::move(w));
+        }
+        output = StreetSegmentOutput{};
+        if ((angle_way.road_type != RoadType::WALL) && (!street_lights.empty())) {
+            CompressedScenePos radius = (CompressedScenePos)(10 * scale);
+            auto add_distant_point = [&](const FixedArray<CompressedScenePos, 2>& p) {
+                bool p_found = !street_light_bvh.visit(
+                    AxisAlignedBoundingBox<CompressedScenePos, 2>::from_center_and_radius(p, radius),
+                    [](bool){return false;});
+                if (!p_found) {
+                    if (auto prn = street_lights.try_multiple_times(10); prn != nullptr) {
+                        street_light_bvh.insert(AxisAlignedBoundingBox<CompressedScenePos, 2>::from_point(p), true);
+                        bri.add_parsed_resource_name(p, (CompressedScenePos)0.f, *prn, 0.f, 1.f);
                     }
                 }
-                if ((angle_way.road_type != RoadType::WALL) && (!street_lights.empty())) {
-                    CompressedScenePos radius = (CompressedScenePos)(10 * scale);
-                    auto add_distant_point = [&](const FixedArray<CompressedScenePos, 2>& p) {
-                        bool p_found = !street_light_bvh.visit(
-                            AxisAlignedBoundingBox<CompressedScenePos, 2>::from_center_and_radius(p, radius),
-                            [](bool){return false;});
-                        if (!p_found) {
-                            if (auto prn = street_lights.try_multiple_times(10); prn != nullptr) {
-                                street_light_bvh.insert(AxisAlignedBoundingBox<CompressedScenePos, 2>::from_point(p), true);
-                                bri.add_parsed_resource_name(p, (CompressedScenePos)0.f, *prn, 0.f, 1.f);
-                            }
-                        }
-                    };
-                    add_distant_point(rect.p00_);
-                    add_distant_point(rect.p11_);
-                }
-                //for (float a = 0.1; a < 0.91; a += 0.4) {
-                //    auto p = a * rect.p00_ + (1 - a) * rect.p10_;
-                //    street_light_positions.push_back(std::make_pair(FixedArray<float, 3>{p(0), p(1), 0}, "bgrass"));
-                //}
-            }
+            };
+            add_distant_point(rect.p00_);
+            add_distant_point(rect.p11_);
         }
+        //for (float a = 0.1; a < 0.91; a += 0.4) {
+        //    auto p = a * rect.p00_ + (1 - a) * rect.p10_;
+        //    street_light_positions.push_back(std::make_pair(FixedArray<float, 3>{p(0), p(1), 0}, "bgrass"));
+        //}
     }
 }
 
+template <class TTriangleList>
 static void draw_terrain_triangle_hole(
     const Array<NodeHoleVertex>& hv,
     const std::map<std::string, WayInfo>& way_infos,
-    TriangleList<CompressedScenePos>& triangles)
+    TTriangleList& triangles)
 {
     if (hv.length() != 3) {
         THROW_OR_ABORT2("Triangle hole does not have 3 corners");
@@ -429,11 +584,12 @@ static void draw_terrain_triangle_hole(
         Colors::from_rgb(way_infos.at(hv(2).way_id).colors[0]));
 }
 
+template <class TTriangleList>
 static void draw_terrain_fan_hole(
     const Node& center,
     const Array<NodeHoleVertex>& hv,
     const std::map<std::string, WayInfo>& way_infos,
-    TriangleList<CompressedScenePos>& triangles)
+    TTriangleList& triangles)
 {
     if (hv.length() < 3) {
         THROW_OR_ABORT2("Fan has less than 3 corners");
@@ -452,6 +608,7 @@ static void draw_terrain_fan_hole(
     }
 }
 
+template <class TTriangleList>
 static void draw_street_fan_hole_segment(
     const Node& center,
     const AngleWay& angle_way,
@@ -461,7 +618,7 @@ static void draw_street_fan_hole_segment(
     float uv_len0,
     float uv_len1,
     float uv_scale,
-    TriangleList<CompressedScenePos>& triangles)
+    TTriangleList& triangles)
 {
     auto center1 = (left + right) / 2;
     auto dist1 = (float)std::sqrt(sum(squared(center1 - center.position)));
@@ -530,10 +687,19 @@ void DrawStreets::draw_holes() {
         draw_air_holes(air_support_node_hole_contours, air_triangles.tl_air_support);
         draw_air_holes(tunnel_node_hole_contours, air_triangles.tl_tunnel_crossing);
     }
-    for (const auto& [nid, nh] : node_hole_contours) {
-        if (nh.empty()) {
-            continue;
+    // The junctions are computed in parallel and drawn in the order of the nodes.
+    std::vector<std::map<std::string, std::map<AngleCurb, NodeHoleVertex>>::const_iterator> junctions;
+    junctions.reserve(node_hole_contours.size());
+    for (auto it = node_hole_contours.cbegin(); it != node_hole_contours.cend(); ++it) {
+        if (!it->second.empty()) {
+            junctions.push_back(it);
         }
+    }
+    std::vector<std::vector<DeferredPolygon>> junction_polygons(junctions.size());
+    std::vector<uint8_t> junction_bind_height(junctions.size(), 0);
+    parallel_for(junctions.size(), [&](size_t ji){
+        const auto& [nid, nh] = *junctions[ji];
+        auto& polygons = junction_polygons[ji];
         Array<NodeHoleVertex> hv{ArrayShape{nh.size()}};
         {
             size_t i = 0;
@@ -586,7 +752,7 @@ void DrawStreets::draw_holes() {
                 THROW_OR_ABORT("Incompatible curb2 alpha");
             }
         }
-        auto& crossings = *tlist2->tl_street_crossing[road_type];
+        DeferredTriangleList crossings{ *tlist2->tl_street_crossing[road_type], polygons };
         // A single triangle does not work with curbs when an angle is ~90°
         if ((nh.size() == 3) && (curb_alpha_ == 1)) {
             if (use_terrain_holes) {
@@ -598,7 +764,7 @@ void DrawStreets::draw_holes() {
                 draw_terrain_fan_hole(nodes.at(nid), hv, way_infos, crossings);
             }
             if (with_height_bindings && !nodes.at(nid).tags.contains("bind_height", "no")) {
-                node_height_bindings[OrderableFixedArray{ nodes.at(nid).position }] = nid;
+                junction_bind_height[ji] = 1;
             }
             // Draw corners
             if (curb_alpha_ != 1) {
@@ -612,7 +778,8 @@ void DrawStreets::draw_holes() {
                 }
                 for (size_t i = 0; i < angles.size(); ++i) {
                     size_t j = (i + 1) % angles.size();
-                    auto draw_rect = [&](TriangleList<CompressedScenePos>& tl, int curb0, int curb1, int curb2, int curb3, const FixedArray<float, 2>& uv, size_t road_id) {
+                    auto draw_rect = [&](TriangleList<CompressedScenePos>& destination, int curb0, int curb1, int curb2, int curb3, const FixedArray<float, 2>& uv, size_t road_id) {
+                        DeferredTriangleList tl{ destination, polygons };
                         const auto& p00 = nh.at(AngleCurb{angles[i], curb0});
                         const auto& p10 = nh.at(AngleCurb{angles[i], curb1});
                         const auto& p11 = nh.at(AngleCurb{angles[j], curb2});
@@ -643,7 +810,8 @@ void DrawStreets::draw_holes() {
                             FixedArray<float, 2>{f  , g  },
                             FixedArray<float, 2>{0.f, g  });
                     };
-                    auto draw_triangle = [&](TriangleList<CompressedScenePos>& tl, int curb0, int curb1, int curb2, const FixedArray<float, 2>& uv, size_t road_id) {
+                    auto draw_triangle = [&](TriangleList<CompressedScenePos>& destination, int curb0, int curb1, int curb2, const FixedArray<float, 2>& uv, size_t road_id) {
+                        DeferredTriangleList tl{ destination, polygons };
                         const auto& p00 = nh.at(AngleCurb{angles[i], curb0});
                         const auto& p10 = nh.at(AngleCurb{angles[i], curb1});
                         const auto& p01 = nh.at(AngleCurb{angles[j], curb2});
@@ -682,6 +850,13 @@ void DrawStreets::draw_holes() {
                 }
             }
         }
+    }, 16);
+    for (size_t ji = 0; ji < junctions.size(); ++ji) {
+        const auto& nid = junctions[ji]->first;
+        if (junction_bind_height[ji]) {
+            node_height_bindings[OrderableFixedArray{ nodes.at(nid).position }] = nid;
+        }
+        draw_deferred_polygons(junction_polygons[ji]);
     }
 
     for (std::list<std::shared_ptr<TriangleList<CompressedScenePos>>>& l : std::vector<std::list<std::shared_ptr<TriangleList<CompressedScenePos>>>>{
@@ -718,7 +893,8 @@ void DrawStreets::draw_streets_add_waypoints(
     unsigned int nlanes,
     float lane_shift,
     const std::string& node_id,
-    const AngleWay& angle_way)
+    const AngleWay& angle_way,
+    StreetSegmentOutput& output) const
 {
     if (angle_way.road_type == RoadType::RUNWAY_DISPLACEMENT_THRESHOLD) {
         return;
@@ -742,11 +918,11 @@ void DrawStreets::draw_streets_add_waypoints(
             way_loc = WayPointLocation::STREET;
         }
         CurbedStreet c5{ rect, -curb_alpha, curb_alpha };
-        way_point_edge_descriptors[way_sandbox].push_back({
+        output.way_point_edge_descriptors[way_sandbox].push_back({
             StreetWayPoint{.alpha{0.5f, 0.5f}, .edge{o23(c5.s[0][0], c5.s[0][1])}, .location = way_loc},
             StreetWayPoint{.alpha{0.5f, 0.5f}, .edge{o23(c5.s[1][0], c5.s[1][1])}, .location = way_loc}});
     } else {
-        auto add = [this, &rect, &angle_way](
+        auto add = [this, &rect, &angle_way, &output](
             float start,
             float stop,
             float shift,
@@ -770,14 +946,14 @@ void DrawStreets::draw_streets_add_waypoints(
                 else {
                     THROW_OR_ABORT("Unknown driving direction");
                 }
-                way_point_edge_descriptors[sandbox].push_back({
+                output.way_point_edge_descriptors[sandbox].push_back({
                     StreetWayPoint{.alpha{0.75f - shift, 0.25f + shift}, .edge{o23(c1.s[i0][0], c1.s[i0][1])}, .location = location},
                     StreetWayPoint{.alpha{0.75f - shift, 0.25f + shift}, .edge{o23(c1.s[i1][0], c1.s[i1][1])}, .location = location} });
-                way_point_edge_descriptors[sandbox].push_back({
+                output.way_point_edge_descriptors[sandbox].push_back({
                     StreetWayPoint{.alpha{0.25f + shift, 0.75f - shift}, .edge{o23(c1.s[i1][0], c1.s[i1][1])}, .location = location},
                     StreetWayPoint{.alpha{0.25f + shift, 0.75f - shift}, .edge{o23(c1.s[i0][0], c1.s[i0][1])}, .location = location} });
             }
-            street_rectangles.push_back(StreetRectangle{
+            output.street_rectangles.push_back(StreetRectangle{
                 .location = location,
                 .road_properties = RoadProperties{
                     .type = angle_way.road_type,
@@ -969,7 +1145,8 @@ std::string DrawStreets::auto_model_name(
 void DrawStreets::draw_streets_draw_ways(
     const OsmRectangle2D& rect,
     const std::string& node_id,
-    const AngleWay& angle_way)
+    const AngleWay& angle_way,
+    StreetSegmentOutput& output) const
 {
     auto sit = uv_scales.find(angle_way.road_type);
     if (sit == uv_scales.end()) {
@@ -991,6 +1168,10 @@ void DrawStreets::draw_streets_draw_ways(
     const auto& node_angles1 = node_angles.at(angle_way.neighbor_id);
     auto& tlists = angle_way.layer == 0 ? ground_triangles : air_triangles;
     auto& street_lst = tlists.tl_street[RoadProperties{angle_way.road_type, angle_way.nlanes}];
+    auto deferred = [&output](TriangleList<CompressedScenePos>& destination) {
+        return DeferredTriangleList{ destination, output.polygons };
+    };
+    auto racing_line_lst = deferred(*tlists.tl_racing_line);
     bool with_b_height_binding;
     bool with_c_height_binding;
     with_b_height_binding = with_height_bindings && !node0.tags.contains("bind_height", "no");
@@ -1028,6 +1209,11 @@ void DrawStreets::draw_streets_draw_ways(
     EntranceType et = (b_entrance_type != EntranceType::NONE)
         ? b_entrance_type
         : c_entrance_type;
+    std::optional<DeferredTriangleList> entrance_lst;
+    if (et != EntranceType::NONE) {
+        entrance_lst.emplace(*ground_triangles.tl_entrance.at(et), output.polygons);
+    }
+    DeferredTriangleList* entrance = entrance_lst.has_value() ? &*entrance_lst : nullptr;
     const auto& wi = way_infos.at(angle_way.way_id);
     // Final u-coordinate: (u - d) * s + 0.5 = u*s - d*s + 0.5
     // where d = 0.5 * (beta + 1)
@@ -1114,10 +1300,11 @@ void DrawStreets::draw_streets_draw_ways(
             try {
                 double uv_len_central = std::floor(uv_sy * uv_scale * (uv_len0 + uv_len1) / 2.);
                 double racing_line_uv_len_central = std::floor(racing_line_scale_y * (uv_len0 + uv_len1) / 2.);
-                rect.draw(
-                    *destination_triangles,
+                auto destination = deferred(*destination_triangles);
+                rect.draw<DeferredTriangleList>(
+                    destination,
                     !std::isnan(racing_line_dx0) && (cva->name == "street")
-                        ? tlists.tl_racing_line.get()
+                        ? &racing_line_lst
                         : nullptr,
                     racing_line_segment_scale_x0,
                     racing_line_segment_scale_x1,
@@ -1128,7 +1315,7 @@ void DrawStreets::draw_streets_draw_ways(
                     flip_racing_line,
                     !std::isnan(racing_line_dx0) ? racing_line_segment0->color : fixed_nans<float, 3>(),
                     !std::isnan(racing_line_dx1) ? racing_line_segment1->color : fixed_nans<float, 3>(),
-                    node_height_bindings,
+                    output.node_height_bindings,
                     node_id,
                     angle_way.neighbor_id,
                     cva->triangles,
@@ -1146,11 +1333,12 @@ void DrawStreets::draw_streets_draw_ways(
     auto draw_procedural_street = [&](){
         double uv_len_central = std::round(uv_scale * (uv_len0 + uv_len1) / 2.);
         double racing_line_uv_len_central = std::round(racing_line_scale_y * (uv_len0 + uv_len1) / 2.);
-        rect.draw_z0(
-            *street_lst.triangle_list,
+        auto street_triangles = deferred(*street_lst.triangle_list);
+        rect.draw_z0<DeferredTriangleList>(
+            street_triangles,
             std::isnan(racing_line_dx0)
                 ? nullptr
-                : tlists.tl_racing_line.get(),
+                : &racing_line_lst,
             racing_line_segment_scale_x0,
             racing_line_segment_scale_x1,
             racing_line_dx0,
@@ -1160,9 +1348,9 @@ void DrawStreets::draw_streets_draw_ways(
             flip_racing_line,
             !std::isnan(racing_line_dx0) ? racing_line_segment0->color : fixed_nans<float, 3>(),
             !std::isnan(racing_line_dx1) ? racing_line_segment1->color : fixed_nans<float, 3>(),
-            ground_triangles.tl_entrance[et].get(),
-            node_height_bindings,
-            ground_triangles.entrances,
+            entrance,
+            output.node_height_bindings,
+            output.entrances,
             node_id,
             angle_way.neighbor_id,
             wi.colors[0],
@@ -1187,9 +1375,9 @@ void DrawStreets::draw_streets_draw_ways(
                     (float)(uv_scale * uv_len0 - uv_len_central),
                     (float)(uv_scale * uv_len1 - uv_len_central),
                     uv_scale,
-                    *street_lst.triangle_list);
+                    street_triangles);
                 if (with_height_bindings && !node0.tags.contains("bind_height", "no")) {
-                    node_height_bindings[OrderableFixedArray{ node0.position }] = node_id;
+                    output.node_height_bindings[OrderableFixedArray{ node0.position }] = node_id;
                 }
             }
             if (node_angles1.size() > 2) {
@@ -1199,9 +1387,9 @@ void DrawStreets::draw_streets_draw_ways(
                     (float)(uv_scale * uv_len1 - uv_len_central),
                     (float)(uv_scale * uv_len0 - uv_len_central),
                     uv_scale,
-                    *street_lst.triangle_list);
+                    street_triangles);
                 if (with_height_bindings && !node1.tags.contains("bind_height", "no")) {
-                    node_height_bindings[OrderableFixedArray{ node1.position }] = angle_way.neighbor_id;
+                    output.node_height_bindings[OrderableFixedArray{ node1.position }] = angle_way.neighbor_id;
                 }
             }
         }
@@ -1225,8 +1413,9 @@ void DrawStreets::draw_streets_draw_ways(
     }
     if (angle_way.layer > 0) {
         double uv_len_central = std::round(uv_scale * (uv_len0 + uv_len1) / 2.);
-        rect.draw_z0(
-            *air_triangles.tl_air_support,
+        auto air_support_triangles = deferred(*air_triangles.tl_air_support);
+        rect.draw_z0<DeferredTriangleList>(
+            air_support_triangles,
             nullptr,
             NAN,
             NAN,
@@ -1238,8 +1427,8 @@ void DrawStreets::draw_streets_draw_ways(
             fixed_nans<float, 3>(),
             fixed_nans<float, 3>(),
             nullptr,
-            node_height_bindings,
-            ground_triangles.entrances,
+            output.node_height_bindings,
+            output.entrances,
             node_id,
             angle_way.neighbor_id,
             wi.colors[0],
@@ -1258,7 +1447,7 @@ void DrawStreets::draw_streets_draw_ways(
             angle_way.road_type);
     }
     if (angle_way.layer < 0) {
-        auto draw = [&](auto& lst, auto& mesh){rect.draw(
+        auto draw = [&](auto& lst, auto& mesh){rect.draw<DeferredTriangleList>(
             lst,
             nullptr,
             NAN,
@@ -1270,7 +1459,7 @@ void DrawStreets::draw_streets_draw_ways(
             false,
             fixed_nans<float, 3>(),
             fixed_nans<float, 3>(),
-            node_height_bindings,
+            output.node_height_bindings,
             node_id,
             angle_way.neighbor_id,
             mesh, scale,
@@ -1279,14 +1468,17 @@ void DrawStreets::draw_streets_draw_ways(
             1.f,
             NAN,
             NAN);};
-        draw(*air_triangles.tl_tunnel_pipe, tunnel_pipe_triangles);
-        draw(*air_triangles.tl_tunnel_bdry, tunnel_bdry_triangles);
+        auto tunnel_pipe_lst = deferred(*air_triangles.tl_tunnel_pipe);
+        auto tunnel_bdry_lst = deferred(*air_triangles.tl_tunnel_bdry);
+        draw(tunnel_pipe_lst, tunnel_pipe_triangles);
+        draw(tunnel_bdry_lst, tunnel_bdry_triangles);
     }
     if ((wi.curb_alpha != wi.curb2_alpha) && !wi.roads_delete(1)) {
         if (!wi.roads_delete_side(angle_way.neighbor_is_second, 1)) {
             double uv_len_central = std::round(curb_uv(1) * uv_scale * (uv_len0 + uv_len1) / 2.);
-            rect.draw_z0(
-                *tlists.tl_street_curb[angle_way.road_type],
+            auto curb_triangles = deferred(*tlists.tl_street_curb[angle_way.road_type]);
+            rect.draw_z0<DeferredTriangleList>(
+                curb_triangles,
                 nullptr,
                 NAN,
                 NAN,
@@ -1297,9 +1489,9 @@ void DrawStreets::draw_streets_draw_ways(
                 false,
                 fixed_nans<float, 3>(),
                 fixed_nans<float, 3>(),
-                ground_triangles.tl_entrance[et].get(),
-                node_height_bindings,
-                ground_triangles.entrances,
+                entrance,
+                output.node_height_bindings,
+                output.entrances,
                 node_id,
                 angle_way.neighbor_id,
                 wi.colors[1],
@@ -1319,8 +1511,9 @@ void DrawStreets::draw_streets_draw_ways(
         }
         if (!wi.roads_delete_side(!angle_way.neighbor_is_second, 1)) {
             double uv_len_central = std::round(curb_uv(1) * uv_scale * (uv_len0 + uv_len1) / 2.);
-            rect.draw_z0(
-                *tlists.tl_street_curb[angle_way.road_type],
+            auto curb_triangles = deferred(*tlists.tl_street_curb[angle_way.road_type]);
+            rect.draw_z0<DeferredTriangleList>(
+                curb_triangles,
                 nullptr,
                 NAN,
                 NAN,
@@ -1331,9 +1524,9 @@ void DrawStreets::draw_streets_draw_ways(
                 false,
                 fixed_nans<float, 3>(),
                 fixed_nans<float, 3>(),
-                ground_triangles.tl_entrance[et].get(),
-                node_height_bindings,
-                ground_triangles.entrances,
+                entrance,
+                output.node_height_bindings,
+                output.entrances,
                 node_id,
                 angle_way.neighbor_id,
                 wi.colors[1],
@@ -1355,8 +1548,9 @@ void DrawStreets::draw_streets_draw_ways(
     if ((wi.curb2_alpha != 1) && !wi.roads_delete(2)) {
         if (!wi.roads_delete_side(angle_way.neighbor_is_second, 2)) {
             double uv_len_central = std::round(curb2_uv(1) * uv_scale * (uv_len0 + uv_len1) / 2.);
-            rect.draw_z0(
-                *tlists.tl_street_curb2[angle_way.road_type],
+            auto curb2_triangles = deferred(*tlists.tl_street_curb2[angle_way.road_type]);
+            rect.draw_z0<DeferredTriangleList>(
+                curb2_triangles,
                 nullptr,
                 NAN,
                 NAN,
@@ -1367,9 +1561,9 @@ void DrawStreets::draw_streets_draw_ways(
                 false,
                 fixed_nans<float, 3>(),
                 fixed_nans<float, 3>(),
-                ground_triangles.tl_entrance[et].get(),
-                node_height_bindings,
-                ground_triangles.entrances,
+                entrance,
+                output.node_height_bindings,
+                output.entrances,
                 node_id,
                 angle_way.neighbor_id,
                 wi.colors[2],
@@ -1389,8 +1583,9 @@ void DrawStreets::draw_streets_draw_ways(
         }
         if (!wi.roads_delete_side(!angle_way.neighbor_is_second, 2)) {
             double uv_len_central = std::round(curb2_uv(1) * (uv_len0 + uv_len1) / 2.);
-            rect.draw_z0(
-                *tlists.tl_street_curb2[angle_way.road_type],
+            auto curb2_triangles = deferred(*tlists.tl_street_curb2[angle_way.road_type]);
+            rect.draw_z0<DeferredTriangleList>(
+                curb2_triangles,
                 nullptr,
                 NAN,
                 NAN,
@@ -1401,9 +1596,9 @@ void DrawStreets::draw_streets_draw_ways(
                 false,
                 fixed_nans<float, 3>(),
                 fixed_nans<float, 3>(),
-                ground_triangles.tl_entrance[et].get(),
-                node_height_bindings,
-                ground_triangles.entrances,
+                entrance,
+                output.node_height_bindings,
+                output.entrances,
                 node_id,
                 angle_way.neighbor_id,
                 wi.colors[2],
@@ -1428,7 +1623,8 @@ void DrawStreets::draw_streets_find_hole_contours(
     const OsmRectangle2D& rect,
     const std::string& node_id,
     const AngleWay& angle_way,
-    float node_angle)
+    float node_angle,
+    StreetSegmentOutput& output)
 {
     auto& air_hole_list = (angle_way.layer > 0)
         ? air_support_node_hole_contours
@@ -1438,22 +1634,22 @@ void DrawStreets::draw_streets_find_hole_contours(
     if (na.size() >= 3) {
         {
             CurbedStreet c0{rect, -wi.curb_alpha, wi.curb_alpha};
-            node_hole_contours.at(node_id).insert(std::make_pair(AngleCurb{.angle = node_angle, .curb = 0}, NodeHoleVertex{c0.s[0][0], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(node_id), std::make_pair(AngleCurb{.angle = node_angle, .curb = 0}, NodeHoleVertex{c0.s[0][0], angle_way.way_id}));
         }
         if (angle_way.layer != 0) {
-            air_hole_list.at(node_id).insert(std::make_pair(AngleCurb{.angle = node_angle, .curb = 0}, NodeHoleVertex{rect.p00_, angle_way.way_id}));
+            output.hole_contours.emplace_back(&air_hole_list.at(node_id), std::make_pair(AngleCurb{.angle = node_angle, .curb = 0}, NodeHoleVertex{rect.p00_, angle_way.way_id}));
         }
         if (wi.curb_alpha != wi.curb2_alpha) {
             CurbedStreet cN{rect, -wi.curb2_alpha, -wi.curb_alpha};
             CurbedStreet cP{rect, wi.curb_alpha, wi.curb2_alpha};
-            node_hole_contours.at(node_id).insert(std::make_pair(AngleCurb{.angle = node_angle, .curb = +1}, NodeHoleVertex{cN.s[0][0], angle_way.way_id}));
-            node_hole_contours.at(node_id).insert(std::make_pair(AngleCurb{.angle = node_angle, .curb = -1}, NodeHoleVertex{cP.s[0][0], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(node_id), std::make_pair(AngleCurb{.angle = node_angle, .curb = +1}, NodeHoleVertex{cN.s[0][0], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(node_id), std::make_pair(AngleCurb{.angle = node_angle, .curb = -1}, NodeHoleVertex{cP.s[0][0], angle_way.way_id}));
         }
         if (wi.curb2_alpha != 1) {
             CurbedStreet cN{rect, -1, -wi.curb2_alpha};
             CurbedStreet cP{rect, wi.curb2_alpha, 1};
-            node_hole_contours.at(node_id).insert(std::make_pair(AngleCurb{.angle = node_angle, .curb = +2}, NodeHoleVertex{cN.s[0][0], angle_way.way_id}));
-            node_hole_contours.at(node_id).insert(std::make_pair(AngleCurb{.angle = node_angle, .curb = -2}, NodeHoleVertex{cP.s[0][0], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(node_id), std::make_pair(AngleCurb{.angle = node_angle, .curb = +2}, NodeHoleVertex{cN.s[0][0], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(node_id), std::make_pair(AngleCurb{.angle = node_angle, .curb = -2}, NodeHoleVertex{cP.s[0][0], angle_way.way_id}));
         }
     }
     const std::map<std::string, NeighborWay>& nn = node_neighbors.at(angle_way.neighbor_id);
@@ -1461,22 +1657,22 @@ void DrawStreets::draw_streets_find_hole_contours(
         {
             CurbedStreet c0{rect, -wi.curb_alpha, wi.curb_alpha};
             // Left and right are swapped for the neighbor, so we use p11_ instead of p10_.
-            node_hole_contours.at(angle_way.neighbor_id).insert(std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = 0}, NodeHoleVertex{c0.s[1][1], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(angle_way.neighbor_id), std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = 0}, NodeHoleVertex{c0.s[1][1], angle_way.way_id}));
         }
         if (angle_way.layer != 0) {
-            air_hole_list.at(angle_way.neighbor_id).insert(std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = 0}, NodeHoleVertex{rect.p11_, angle_way.way_id}));
+            output.hole_contours.emplace_back(&air_hole_list.at(angle_way.neighbor_id), std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = 0}, NodeHoleVertex{rect.p11_, angle_way.way_id}));
         }
         if (wi.curb_alpha != wi.curb2_alpha) {
             CurbedStreet cN{rect, -wi.curb2_alpha, -wi.curb_alpha};
             CurbedStreet cP{rect, wi.curb_alpha, wi.curb2_alpha};
-            node_hole_contours.at(angle_way.neighbor_id).insert(std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = -1}, NodeHoleVertex{cN.s[1][1], angle_way.way_id}));
-            node_hole_contours.at(angle_way.neighbor_id).insert(std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = +1}, NodeHoleVertex{cP.s[1][1], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(angle_way.neighbor_id), std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = -1}, NodeHoleVertex{cN.s[1][1], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(angle_way.neighbor_id), std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = +1}, NodeHoleVertex{cP.s[1][1], angle_way.way_id}));
         }
         if (wi.curb2_alpha != 1) {
             CurbedStreet cN{rect, -1, -wi.curb2_alpha};
             CurbedStreet cP{rect, wi.curb2_alpha, 1};
-            node_hole_contours.at(angle_way.neighbor_id).insert(std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = -2}, NodeHoleVertex{cN.s[1][1], angle_way.way_id}));
-            node_hole_contours.at(angle_way.neighbor_id).insert(std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = +2}, NodeHoleVertex{cP.s[1][1], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(angle_way.neighbor_id), std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = -2}, NodeHoleVertex{cN.s[1][1], angle_way.way_id}));
+            output.hole_contours.emplace_back(&node_hole_contours.at(angle_way.neighbor_id), std::make_pair(AngleCurb{.angle = nn.at(node_id).angle, .curb = +2}, NodeHoleVertex{cP.s[1][1], angle_way.way_id}));
         }
     }
 }
@@ -1487,7 +1683,8 @@ void DrawStreets::draw_streets_find_hole_waypoints(
     const AngleWay& angle_way,
     float curb_alpha,
     float curb2_alpha,
-    float lane_shift)
+    float lane_shift,
+    StreetSegmentOutput& output)
 {
     if (angle_way.road_type == RoadType::RUNWAY_DISPLACEMENT_THRESHOLD) {
         return;
@@ -1505,16 +1702,16 @@ void DrawStreets::draw_streets_find_hole_waypoints(
         if (is_centered) {
             CurbedStreet c5{ rect, -curb_alpha, curb_alpha };
             if (angle_way.neighbor_is_second) {
-                node_hole_waypoints.at(street_waypoint_sandbox).at(node_id).out.push_back(NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.5f, 0.5f}, .edge{c5.s[0][0], c5.s[0][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(street_waypoint_sandbox).at(node_id).out, NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.5f, 0.5f}, .edge{c5.s[0][0], c5.s[0][1]}});
             } else {
-                node_hole_waypoints.at(street_waypoint_sandbox).at(node_id).in.push_back(NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.5f, 0.5f}, .edge{c5.s[0][0], c5.s[0][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(street_waypoint_sandbox).at(node_id).in, NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.5f, 0.5f}, .edge{c5.s[0][0], c5.s[0][1]}});
             }
         }
         if (driving_direction == DrivingDirection::LEFT) {
-            auto add = [&rect, &node_id, &angle_way](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
+            auto add = [&rect, &node_id, &angle_way, &output](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
                 CurbedStreet c5{ rect, start, stop };
-                node_hole_waypoints.at(node_id).out.push_back(NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[0][0], c5.s[0][1]}});
-                node_hole_waypoints.at(node_id).in.push_back(NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[0][0], c5.s[0][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(node_id).out, NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[0][0], c5.s[0][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(node_id).in, NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[0][0], c5.s[0][1]}});
                 };
             if (!is_centered) {
                 add(-curb_alpha, curb_alpha, lane_shift, node_hole_waypoints.at(WayPointSandbox::STREET));
@@ -1524,10 +1721,10 @@ void DrawStreets::draw_streets_find_hole_waypoints(
                 add(-1.f, -curb2_alpha, 0.f, node_hole_waypoints.at(WayPointSandbox::SIDEWALK));
             }
         } else if (driving_direction == DrivingDirection::RIGHT) {
-            auto add = [&rect, &node_id, &angle_way](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
+            auto add = [&rect, &node_id, &angle_way, &output](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
                 CurbedStreet c5{rect, start, stop};
-                node_hole_waypoints.at(node_id).in.push_back(NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[0][0], c5.s[0][1]}});
-                node_hole_waypoints.at(node_id).out.push_back(NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[0][0], c5.s[0][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(node_id).in, NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[0][0], c5.s[0][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(node_id).out, NodeHoleWaypoint{.node=angle_way.neighbor_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[0][0], c5.s[0][1]}});
             };
             add(-curb_alpha, curb_alpha, lane_shift, node_hole_waypoints.at(WayPointSandbox::STREET));
             if (curb2_alpha != 1) {
@@ -1543,16 +1740,16 @@ void DrawStreets::draw_streets_find_hole_waypoints(
         if (is_centered) {
             CurbedStreet c5{ rect, -curb_alpha, curb_alpha };
             if (!angle_way.neighbor_is_second) {
-                node_hole_waypoints.at(street_waypoint_sandbox).at(angle_way.neighbor_id).out.push_back(NodeHoleWaypoint{.node=node_id, .alpha{0.5f, 0.5f}, .edge{c5.s[1][0], c5.s[1][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(street_waypoint_sandbox).at(angle_way.neighbor_id).out, NodeHoleWaypoint{.node=node_id, .alpha{0.5f, 0.5f}, .edge{c5.s[1][0], c5.s[1][1]}});
             } else {
-                node_hole_waypoints.at(street_waypoint_sandbox).at(angle_way.neighbor_id).in.push_back(NodeHoleWaypoint{.node=node_id, .alpha{0.5f, 0.5f}, .edge{c5.s[1][0], c5.s[1][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(street_waypoint_sandbox).at(angle_way.neighbor_id).in, NodeHoleWaypoint{.node=node_id, .alpha{0.5f, 0.5f}, .edge{c5.s[1][0], c5.s[1][1]}});
             }
         }
         if (driving_direction == DrivingDirection::LEFT) {
-            auto add = [&rect, &angle_way, &node_id](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
+            auto add = [&rect, &angle_way, &node_id, &output](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
                 CurbedStreet c5{rect, start, stop};
-                node_hole_waypoints.at(angle_way.neighbor_id).out.push_back(NodeHoleWaypoint{.node=node_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[1][0], c5.s[1][1]}});
-                node_hole_waypoints.at(angle_way.neighbor_id).in.push_back(NodeHoleWaypoint{.node=node_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[1][0], c5.s[1][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(angle_way.neighbor_id).out, NodeHoleWaypoint{.node=node_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[1][0], c5.s[1][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(angle_way.neighbor_id).in, NodeHoleWaypoint{.node=node_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[1][0], c5.s[1][1]}});
             };
             if (!is_centered) {
                 add(-curb_alpha, curb_alpha, lane_shift, node_hole_waypoints.at(WayPointSandbox::STREET));
@@ -1562,10 +1759,10 @@ void DrawStreets::draw_streets_find_hole_waypoints(
                 add(-1.f, -curb2_alpha, 0.f, node_hole_waypoints.at(WayPointSandbox::SIDEWALK));
             }
         } else if (driving_direction == DrivingDirection::RIGHT) {
-            auto add = [&rect, &angle_way, &node_id](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
+            auto add = [&rect, &angle_way, &node_id, &output](float start, float stop, float shift, std::map<std::string, HoleWaypoint>& node_hole_waypoints){
                 CurbedStreet c5{rect, start, stop};
-                node_hole_waypoints.at(angle_way.neighbor_id).in.push_back(NodeHoleWaypoint{.node=node_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[1][0], c5.s[1][1]}});
-                node_hole_waypoints.at(angle_way.neighbor_id).out.push_back(NodeHoleWaypoint{.node=node_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[1][0], c5.s[1][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(angle_way.neighbor_id).in, NodeHoleWaypoint{.node=node_id, .alpha{0.25f + shift, 0.75f - shift}, .edge{c5.s[1][0], c5.s[1][1]}});
+                output.hole_waypoints.emplace_back(&node_hole_waypoints.at(angle_way.neighbor_id).out, NodeHoleWaypoint{.node=node_id, .alpha{0.75f - shift, 0.25f + shift}, .edge{c5.s[1][0], c5.s[1][1]}});
             };
             add(-curb_alpha, curb_alpha, lane_shift, node_hole_waypoints.at(WayPointSandbox::STREET));
             if (curb2_alpha != 1) {
@@ -46,6 +46,7 @@ class ColoredVertexArray;
 struct StreetWayPoint;
 class BatchResourceInstantiator;
 class RacingLineBvh;
+struct StreetSegmentOutput;
 
 struct DrawStreetsInput {
     SceneNodeResources& scene_node_resources;
@@ -109,23 +110,27 @@ private:
         unsigned int nlanes,
         float lane_shift,
         const std::string& node_id,
-        const AngleWay& angle_way);
+        const AngleWay& angle_way,
+        StreetSegmentOutput& output) const;
     void draw_streets_draw_ways(
         const OsmRectangle2D& rect,
         const std::string& node_id,
-        const AngleWay& angle_way);
+        const AngleWay& angle_way,
+        StreetSegmentOutput& output) const;
     void draw_streets_find_hole_contours(
         const OsmRectangle2D& rect,
         const std::string& node_id,
         const AngleWay& angle_way,
-        float node_angle);
+        float node_angle,
+        StreetSegmentOutput& output);
     void draw_streets_find_hole_waypoints(
         const OsmRectangle2D& rect,
         const std::string& node_id,
         const AngleWay& angle_way,
         float curb_alpha,
         float curb2_alpha,
-        float lane_shift);
+        float lane_shift,
+        StreetSegmentOutput& output);
     std::string auto_model_name(
         const std::string& node_id,
         const AngleWay& angle_way,
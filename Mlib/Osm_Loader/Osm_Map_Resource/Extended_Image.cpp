@@ -59,3 +59,21 @@ ExtendedImage::ExtendedImage(
 bool ExtendedImage::operator () (double r, double c, double& value) const {
     return bilinear_grayscale_interpolation(r + dextension_, c + dextension_, extended_image_, value);
 }
+
+void ExtendedImage::operator () (
+    std::span<const double> r,
+    std::span<const double> c,
+    std::span<double> values,
+    std::span<uint8_t> valid) const
+{
+    if (r.size() != c.size()) {
+        THROW_OR_ABORT("Extended image sample size mismatch");
+    }
+    std::vector<double> re(r.size());
+    std::vector<double> ce(c.size());
+    for (size_t i = 0; i < r.size(); ++i) {
+        re[i] = r[i] + dextension_;
+        ce[i] = c[i] + dextension_;
+    }
+    bilinear_grayscale_interpolation<double>(re, ce, extended_image_, values, valid);
+}
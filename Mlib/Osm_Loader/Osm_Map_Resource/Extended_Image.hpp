@@ -1,5 +1,7 @@
 #pragma once
 #include <Mlib/Array/Array.hpp>
+#include <cstdint>
+#include <span>
 
 namespace Mlib {
 
@@ -13,6 +15,11 @@ public:
         size_t niterations,
         bool preserve_original = true);
     bool operator () (double r, double c, double& value) const;
+    void operator () (
+        std::span<const double> r,
+        std::span<const double> c,
+        std::span<double> values,
+        std::span<uint8_t> valid) const;
     inline size_t original_shape(size_t i) const {
         return original_shape_(i);
     }
@@ -1,4 +1,7 @@
 #include "Height_Sampler.hpp"
+#include <Mlib/Geography/Heightmaps/Tiled_Heightmap.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <vector>
 
 using namespace Mlib;
 
@@ -9,15 +12,59 @@ HeightSampler::HeightSampler(
 	, normalization_matrix_{ normalization_matrix }
 {}
 
+HeightSampler::HeightSampler(
+	std::unique_ptr<TiledHeightmap> tiled_heightmap,
+	const TransformationMatrix<double, double, 2>& normalization_matrix)
+	: tiled_heightmap_{ std::move(tiled_heightmap) }
+	, normalization_matrix_{ normalization_matrix }
+{}
+
+HeightSampler::~HeightSampler() = default;
+
+size_t HeightSampler::shape(size_t i) const {
+	return image_.has_value()
+		? image_->original_shape(i)
+		: tiled_heightmap_->shape(i);
+}
+
 bool HeightSampler::operator () (const FixedArray<CompressedScenePos, 2>& pos, CompressedScenePos& z) const {
     FixedArray<double, 2> p = normalization_matrix_.transform(funpack(pos));
+	double r = (1 - p(1)) * double(shape(0) - 1);
+	double c = p(0) * double(shape(1) - 1);
 	double dz;
-    bool res = image_(
-		(1 - p(1)) * double(image_.original_shape(0) - 1),
-		p(0) * double(image_.original_shape(1) - 1),
-		dz);
+    bool res = image_.has_value()
+		? (*image_)(r, c, dz)
+		: (*tiled_heightmap_)(r, c, dz);
 	if (res) {
 		z = (CompressedScenePos)dz;
 	}
 	return res;
 }
+
+void HeightSampler::operator () (
+	std::span<const FixedArray<CompressedScenePos, 2>> pos,
+	std::span<CompressedScenePos> z,
+	std::span<uint8_t> valid) const
+{
+	if ((pos.size() != z.size()) || (pos.size() != valid.size())) {
+		THROW_OR_ABORT("Height sample size mismatch");
+	}
+	std::vector<double> r(pos.size());
+	std::vector<double> c(pos.size());
+	std::vector<double> dz(pos.size());
+	for (size_t i = 0; i < pos.size(); ++i) {
+		FixedArray<double, 2> p = normalization_matrix_.transform(funpack(pos[i]));
+		r[i] = (1 - p(1)) * double(shape(0) - 1);
+		c[i] = p(0) * double(shape(1) - 1);
+	}
+	if (image_.has_value()) {
+		(*image_)(r, c, dz, valid);
+	} else {
+		(*tiled_heightmap_)(r, c, dz, valid);
+	}
+	for (size_t i = 0; i < pos.size(); ++i) {
+		if (valid[i]) {
+			z[i] = (CompressedScenePos)dz[i];
+		}
+	}
+}
@@ -2,17 +2,34 @@
 #include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Extended_Image.hpp>
 #include <Mlib/Scene_Precision.hpp>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
 
 namespace Mlib {
 
+class TiledHeightmap;
+
 class HeightSampler {
 public:
 	HeightSampler(
 		ExtendedImage image,
 		const TransformationMatrix<double, double, 2>& normalization_matrix);
+	HeightSampler(
+		std::unique_ptr<TiledHeightmap> tiled_heightmap,
+		const TransformationMatrix<double, double, 2>& normalization_matrix);
+	~HeightSampler();
 	bool operator () (const FixedArray<CompressedScenePos, 2>& pos, CompressedScenePos& z) const;
+	// Samples all positions at once, "valid[i]" is 0 if position "i" is outside of the heightmap.
+	void operator () (
+		std::span<const FixedArray<CompressedScenePos, 2>> pos,
+		std::span<CompressedScenePos> z,
+		std::span<uint8_t> valid) const;
 private:
-	ExtendedImage image_;
+	size_t shape(size_t i) const;
+	std::optional<ExtendedImage> image_;
+	std::unique_ptr<TiledHeightmap> tiled_heightmap_;
 	TransformationMatrix<double, double, 2> normalization_matrix_;
 };
 
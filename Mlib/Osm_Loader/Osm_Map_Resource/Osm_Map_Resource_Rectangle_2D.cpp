@@ -3,6 +3,7 @@
 #include <Mlib/Geometry/Mesh/Triangle_List.hpp>
 #include <Mlib/Math/Math.hpp>
 #include <Mlib/Os/Os.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Deferred_Triangle_List.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Entrance_Type.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Node_Height_Binding.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Road_Type.hpp>
@@ -54,9 +55,10 @@ bool OsmRectangle2D::from_line(
         width_cdR);
 }
 
+template <class TTriangleList>
 void OsmRectangle2D::draw_z0(
-    TriangleList<CompressedScenePos>& tl_road,
-    TriangleList<CompressedScenePos>* tl_racing_line,
+    TTriangleList& tl_road,
+    TTriangleList* tl_racing_line,
     float uv0_sx,
     float uv1_sx,
     float uv0_dx,
@@ -66,7 +68,7 @@ void OsmRectangle2D::draw_z0(
     bool flip_racing_line,
     const FixedArray<float, 3>& racing_line_color0,
     const FixedArray<float, 3>& racing_line_color1,
-    TriangleList<CompressedScenePos>* tl_entrance,
+    TTriangleList* tl_entrance,
     std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding>& node_height_bindings,
     std::map<EntranceType, std::set<OrderableFixedArray<CompressedScenePos, 2>>>& entrances,
     const std::string& b,
@@ -266,9 +268,10 @@ void OsmRectangle2D::draw_z0(
     }
 }
 
+template <class TTriangleList>
 void OsmRectangle2D::draw(
-    TriangleList<CompressedScenePos>& tl,
-    TriangleList<CompressedScenePos>* tl_racing_line,
+    TTriangleList& tl,
+    TTriangleList* tl_racing_line,
     float racing_line_uv0_sx,
     float racing_line_uv1_sx,
     float racing_line_uv0_dx,
@@ -491,3 +494,113 @@ CurbedStreet::CurbedStreet(const OsmRectangle2D& r, ScenePos start, ScenePos sto
         s[1][1] = r.p11_;
     }
 }
+
+template void OsmRectangle2D::draw_z0<TriangleList<CompressedScenePos>>(
+    TriangleList<CompressedScenePos>& tl_road,
+    TriangleList<CompressedScenePos>* tl_racing_line,
+    float uv0_sx,
+    float uv1_sx,
+    float uv0_dx,
+    float uv1_dx,
+    float racing_line_uv0_y,
+    float racing_line_uv1_y,
+    bool flip_racing_line,
+    const FixedArray<float, 3>& racing_line_color0,
+    const FixedArray<float, 3>& racing_line_color1,
+    TriangleList<CompressedScenePos>* tl_entrance,
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding>& node_height_bindings,
+    std::map<EntranceType, std::set<OrderableFixedArray<CompressedScenePos, 2>>>& entrances,
+    const std::string& b,
+    const std::string& c,
+    const FixedArray<float, 3>& color0,
+    const FixedArray<float, 3>& color1,
+    float uv0_x,
+    float uv1_x,
+    float uv0_y,
+    float uv1_y,
+    float start,
+    float stop,
+    RectangleOrientation orientation,
+    bool with_b_height_binding,
+    bool with_c_height_binding,
+    EntranceType b_entrance_type,
+    EntranceType c_entrance_type,
+    RoadType road_type) const;
+
+template void OsmRectangle2D::draw<TriangleList<CompressedScenePos>>(
+    TriangleList<CompressedScenePos>& tl,
+    TriangleList<CompressedScenePos>* tl_racing_line,
+    float racing_line_uv0_sx,
+    float racing_line_uv1_sx,
+    float racing_line_uv0_dx,
+    float racing_line_uv1_dx,
+    float racing_line_uv0_y,
+    float racing_line_uv1_y,
+    bool flip_racing_line,
+    const FixedArray<float, 3>& racing_line_color0,
+    const FixedArray<float, 3>& racing_line_color1,
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding>& node_height_bindings,
+    const std::string& b,
+    const std::string& c,
+    const UUVector<FixedArray<ColoredVertex<float>, 3>>& triangles,
+    float scale,
+    float width,
+    CompressedScenePos height,
+    float uv_sx,
+    float uv0_y,
+    float uv1_y) const;
+
+template void OsmRectangle2D::draw_z0<DeferredTriangleList>(
+    DeferredTriangleList& tl_road,
+    DeferredTriangleList* tl_racing_line,
+    float uv0_sx,
+    float uv1_sx,
+    float uv0_dx,
+    float uv1_dx,
+    float racing_line_uv0_y,
+    float racing_line_uv1_y,
+    bool flip_racing_line,
+    const FixedArray<float, 3>& racing_line_color0,
+    const FixedArray<float, 3>& racing_line_color1,
+    DeferredTriangleList* tl_entrance,
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding>& node_height_bindings,
+    std::map<EntranceType, std::set<OrderableFixedArray<CompressedScenePos, 2>>>& entrances,
+    const std::string& b,
+    const std::string& c,
+    const FixedArray<float, 3>& color0,
+    const FixedArray<float, 3>& color1,
+    float uv0_x,
+    float uv1_x,
+    float uv0_y,
+    float uv1_y,
+    float start,
+    float stop,
+    RectangleOrientation orientation,
+    bool with_b_height_binding,
+    bool with_c_height_binding,
+    EntranceType b_entrance_type,
+    EntranceType c_entrance_type,
+    RoadType road_type) const;
+
+template void OsmRectangle2D::draw<DeferredTriangleList>(
+    DeferredTriangleList& tl,
+    DeferredTriangleList* tl_racing_line,
+    float racing_line_uv0_sx,
+    float racing_line_uv1_sx,
+    float racing_line_uv0_dx,
+    float racing_line_uv1_dx,
+    float racing_line_uv0_y,
+    float racing_line_uv1_y,
+    bool flip_racing_line,
+    const FixedArray<float, 3>& racing_line_color0,
+    const FixedArray<float, 3>& racing_line_color1,
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding>& node_height_bindings,
+    const std::string& b,
+    const std::string& c,
+    const UUVector<FixedArray<ColoredVertex<float>, 3>>& triangles,
+    float scale,
+    float width,
+    CompressedScenePos height,
+    float uv_sx,
+    float uv0_y,
+    float uv1_y) const;
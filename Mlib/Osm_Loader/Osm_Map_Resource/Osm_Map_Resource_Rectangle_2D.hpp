@@ -44,9 +44,10 @@ struct OsmRectangle2D {
         CompressedScenePos width_cdL,
         CompressedScenePos width_cdR);
 
+    template <class TTriangleList>
     void draw_z0(
-        TriangleList<CompressedScenePos>& tl_road,
-        TriangleList<CompressedScenePos>* tl_racing_line,
+        TTriangleList& tl_road,
+        TTriangleList* tl_racing_line,
         float uv0_sx,
         float uv1_sx,
         float uv0_dx,
@@ -56,7 +57,7 @@ struct OsmRectangle2D {
         bool flip_racing_line,
         const FixedArray<float, 3>& racing_line_color0,
         const FixedArray<float, 3>& racing_line_color1,
-        TriangleList<CompressedScenePos>* tl_entrance,
+        TTriangleList* tl_entrance,
         std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding>& node_height_bindings,
         std::map<EntranceType, std::set<OrderableFixedArray<CompressedScenePos, 2>>>& entrances,
         const std::string& b,
@@ -76,9 +77,10 @@ struct OsmRectangle2D {
         EntranceType c_entrance_type,
         RoadType road_type) const;
 
+    template <class TTriangleList>
     void draw(
-        TriangleList<CompressedScenePos>& tl,
-        TriangleList<CompressedScenePos>* tl_racing_line,
+        TTriangleList& tl,
+        TTriangleList* tl_racing_line,
         float racing_line_uv0_sx,
         float racing_line_uv1_sx,
         float racing_line_uv0_dx,
@@ -50,6 +50,7 @@ struct OsmResourceConfig {
     std::string heightmap;
     std::string heightmap_mask;
     size_t heightmap_extension = 0;
+    size_t heightmap_max_cached_tiles = 64;
     std::string displacementmap;
     double displacementmap_min = 0;
     double displacementmap_uv_scale = 1;
@@ -133,6 +134,9 @@ struct OsmResourceConfig {
     CompressedScenePos default_tunnel_pipe_height = (CompressedScenePos)(4 * meters);
     float scale = 1;
     float triangulation_scale = 1;
+    // Zero disables the tiled triangulation.
+    CompressedScenePos triangulation_tile_size = (CompressedScenePos)0.;
+    CompressedScenePos triangulation_tile_boundary_distance = (CompressedScenePos)(20 * meters);
     double waypoint_merge_radius = 1 * cm;
     double waypoint_error_radius = 2 * cm;
     CompressedScenePos waypoint_distance = (CompressedScenePos)(2 * meters);
@@ -160,6 +164,9 @@ struct OsmResourceConfig {
     float forest_outline_tree_distance = 10.f * meters;
     float forest_outline_tree_inwards_distance = 0 * meters;
     float much_grass_distance = 5.f * meters;
+    // Grass and trees are scattered in parallel, in square tiles of this size.
+    // Model nodes are not tiled, they have per-node seeds.
+    CompressedScenePos scatter_tile_size = (CompressedScenePos)(100 * meters);
     float raceway_beacon_distance = INFINITY;
     float min_dist_to_road = 0.5f;
     float min_dist_to_terrain_region = 10.f;
@@ -217,6 +224,9 @@ struct OsmResourceConfig {
     std::string navmesh_resource;
     bool refine_explicit_waypoints = true;
     float agent_radius = 0.6f;
+    // Navmesh tile size in cells, 0 builds a single, monolithic mesh
+    int navmesh_tile_size = 0;
+    std::string navmesh_cache_dir;
 };
 
 }
@@ -0,0 +1,66 @@
+#include "Scatter_Tiles.hpp"
+#include <Mlib/Hash.hpp>
+#include <Mlib/Scene_Graph/Resources/Batch_Resource_Instantiator.hpp>
+#include <Mlib/Scene_Graph/Resources/Parsed_Resource_Name.hpp>
+
+using namespace Mlib;
+
+ScatterTile::ScatterTile(unsigned int seed, const ResourceNameCycle* rnc)
+    : seed_{ seed }
+{
+    if (rnc != nullptr) {
+        rnc_.emplace(*rnc);
+        rnc_->seed(seed);
+    }
+}
+
+ScatterTile::~ScatterTile() = default;
+
+ResourceNameCycle& ScatterTile::rnc() {
+    if (!rnc_.has_value()) {
+        THROW_OR_ABORT("Scatter tile has no resource name cycle");
+    }
+    return *rnc_;
+}
+
+void ScatterTile::add(
+    const FixedArray<CompressedScenePos, 3>& p,
+    const ParsedResourceName& prn,
+    float dyangle,
+    float scale)
+{
+    resources.push_back({
+        .position = p,
+        .prn = &prn,
+        .dyangle = dyangle,
+        .scale = scale});
+}
+
+void ScatterTile::add(
+    const FixedArray<CompressedScenePos, 2>& p,
+    CompressedScenePos height,
+    const ParsedResourceName& prn,
+    float dyangle,
+    float scale)
+{
+    add(FixedArray<CompressedScenePos, 3>{ p(0), p(1), height }, prn, dyangle, scale);
+}
+
+unsigned int Mlib::scatter_map_seed(const std::string& map_name) {
+    return (unsigned int)hash_combine(map_name);
+}
+
+unsigned int Mlib::scatter_tile_seed(unsigned int map_seed, uint64_t tile_id) {
+    return (unsigned int)hash_combine(map_seed, tile_id);
+}
+
+void Mlib::add_scattered_resources(
+    BatchResourceInstantiator& bri,
+    const std::vector<ScatterTile>& tiles)
+{
+    for (const auto& tile : tiles) {
+        for (const auto& r : tile.resources) {
+            bri.add_parsed_resource_name(r.position, *r.prn, r.dyangle, r.scale);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <Mlib/Math/Fixed_Math.hpp>
+#include <Mlib/Render/Renderables/Triangle_Sampler/Resource_Name_Cycle.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Mlib {
+
+class BatchResourceInstantiator;
+struct ParsedResourceName;
+
+struct ScatteredResource {
+    FixedArray<CompressedScenePos, 3> position;
+    const ParsedResourceName* prn;
+    float dyangle;
+    float scale;
+};
+
+/**
+ * Random state and output of a single scatter tile.
+ * The seed only depends on the map seed and on the tile ID,
+ * so the output does not depend on the number of threads.
+ */
+class ScatterTile {
+    ScatterTile(const ScatterTile&) = delete;
+    ScatterTile& operator = (const ScatterTile&) = delete;
+public:
+    ScatterTile(unsigned int seed, const ResourceNameCycle* rnc);
+    ScatterTile(ScatterTile&&) = default;
+    ~ScatterTile();
+    inline unsigned int seed() const {
+        return seed_;
+    }
+    ResourceNameCycle& rnc();
+    void add(
+        const FixedArray<CompressedScenePos, 3>& p,
+        const ParsedResourceName& prn,
+        float dyangle,
+        float scale);
+    void add(
+        const FixedArray<CompressedScenePos, 2>& p,
+        CompressedScenePos height,
+        const ParsedResourceName& prn,
+        float dyangle,
+        float scale);
+    std::vector<ScatteredResource> resources;
+private:
+    unsigned int seed_;
+    std::optional<ResourceNameCycle> rnc_;
+};
+
+unsigned int scatter_map_seed(const std::string& map_name);
+unsigned int scatter_tile_seed(unsigned int map_seed, uint64_t tile_id);
+
+/**
+ * Adds the resources of all tiles to "bri", in the order of the tiles.
+ */
+void add_scattered_resources(
+    BatchResourceInstantiator& bri,
+    const std::vector<ScatterTile>& tiles);
+
+/**
+ * Runs "op(i, tile)" for every tile in parallel, and adds
+ * the resulting resources to "bri" in the order of "tile_ids".
+ * Every tile gets its own copy of "rnc" (if not null).
+ */
+template <class TOperation>
+void scatter_tiles(
+    BatchResourceInstantiator& bri,
+    const ResourceNameCycle* rnc,
+    unsigned int map_seed,
+    const std::vector<uint64_t>& tile_ids,
+    const TOperation& op)
+{
+    std::vector<ScatterTile> tiles;
+    tiles.reserve(tile_ids.size());
+    for (uint64_t id : tile_ids) {
+        tiles.emplace_back(scatter_tile_seed(map_seed, id), rnc);
+    }
+    parallel_for(tiles.size(), [&](size_t i){
+        op(i, tiles[i]);
+    });
+    add_scattered_resources(bri, tiles);
+}
+
+/**
+ * Assigns items to the cells of a square grid.
+ * The cells are visited in the order of their coordinates,
+ * the items of a cell in the order in which they were added.
+ */
+template <class TItem>
+class ScatterGrid {
+public:
+    explicit ScatterGrid(CompressedScenePos tile_size)
+        : tile_size_{ tile_size }
+    {
+        if (tile_size <= (CompressedScenePos)0.f) {
+            THROW_OR_ABORT("Scatter tile size must be positive");
+        }
+    }
+    void add(const FixedArray<CompressedScenePos, 2>& position, TItem item) {
+        auto cell = std::make_pair(
+            (int32_t)std::floor(funpack(position(0)) / funpack(tile_size_)),
+            (int32_t)std::floor(funpack(position(1)) / funpack(tile_size_)));
+        cells_[cell].push_back(std::move(item));
+    }
+    template <class TOperation>
+    void scatter(
+        BatchResourceInstantiator& bri,
+        const ResourceNameCycle* rnc,
+        unsigned int map_seed,
+        const TOperation& op) const
+    {
+        std::vector<uint64_t> tile_ids;
+        std::vector<const std::vector<TItem>*> items;
+        tile_ids.reserve(cells_.size());
+        items.reserve(cells_.size());
+        for (const auto& [cell, cell_items] : cells_) {
+            tile_ids.push_back(((uint64_t)(uint32_t)cell.first << 32) | (uint64_t)(uint32_t)cell.second);
+            items.push_back(&cell_items);
+        }
+        scatter_tiles(bri, rnc, map_seed, tile_ids, [&](size_t i, ScatterTile& tile){
+            op(*items[i], tile);
+        });
+    }
+private:
+    CompressedScenePos tile_size_;
+    std::map<std::pair<int32_t, int32_t>, std::vector<TItem>> cells_;
+};
+
+}
@@ -0,0 +1,139 @@
+#include "Street_Node_Heights.hpp"
+#include <Mlib/Math/Interp.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cmath>
+
+using namespace Mlib;
+
+StreetNodeGraph::StreetNodeGraph(size_t nnodes, const std::vector<StreetEdge>& edges) {
+    row_begins.resize(nnodes + 1, 0);
+    for (const auto& e : edges) {
+        if ((e.a >= nnodes) || (e.b >= nnodes)) {
+            THROW_OR_ABORT("Street edge node index out of bounds");
+        }
+        ++row_begins[e.a + 1];
+        ++row_begins[e.b + 1];
+    }
+    for (size_t n = 0; n < nnodes; ++n) {
+        row_begins[n + 1] += row_begins[n];
+    }
+    columns.resize(2 * edges.size());
+    weights.resize(2 * edges.size());
+    layers.resize(2 * edges.size());
+    bridge_heights.resize(2 * edges.size());
+    std::vector<size_t> row_ends(row_begins.begin(), row_begins.end() - 1);
+    auto add_entry = [&](size_t row, size_t column, const StreetEdge& e) {
+        size_t i = row_ends[row]++;
+        columns[i] = column;
+        weights[i] = e.weight;
+        layers[i] = e.layer;
+        bridge_heights[i] = e.bridge_height;
+    };
+    for (const auto& e : edges) {
+        add_entry(e.b, e.a, e);
+        add_entry(e.a, e.b, e);
+    }
+}
+
+size_t StreetNodeGraph::nnodes() const {
+    return row_begins.size() - 1;
+}
+
+StreetNodeHeights Mlib::initial_street_node_heights(
+    const StreetNodeGraph& graph,
+    const Interp<double>& layer_heights,
+    const std::function<bool(size_t node, double& height)>& sample_height)
+{
+    size_t nnodes = graph.nnodes();
+    StreetNodeHeights result;
+    result.height.resize(nnodes);
+    result.smooth_height.resize(nnodes);
+    result.has_height.resize(nnodes);
+    auto compute_initial_height = [&](size_t n) {
+        size_t row_begin = graph.row_begins[n];
+        size_t row_end = graph.row_begins[n + 1];
+        if (row_begin == row_end) {
+            THROW_OR_ABORT("Street node without neighbors");
+        }
+        double layer = 0;
+        for (size_t i = row_begin; i < row_end; ++i) {
+            layer += (double)graph.layers[i];
+        }
+        layer /= (double)(row_end - row_begin);
+        size_t nbridge_heights = 0;
+        double bridge_height = 0;
+        for (size_t i = row_begin; i < row_end; ++i) {
+            if (!std::isnan(graph.bridge_heights[i])) {
+                bridge_height += graph.bridge_heights[i];
+                ++nbridge_heights;
+            }
+        }
+        if (nbridge_heights != 0) {
+            bridge_height /= (double)nbridge_heights;
+        }
+        result.has_height[n] = 1;
+        if (nbridge_heights != 0) {
+            result.height[n] = layer_heights(layer) + bridge_height - layer_heights(0);
+        } else {
+            if (layer == 0) {
+                // If the ways to all neighbors are on the ground (or they cancel out to 0),
+                // pick the height of the heightmap exactly on the node.
+                if (!sample_height(n, result.height[n])) {
+                    result.height[n] = NAN;
+                    result.has_height[n] = 0;
+                }
+            } else {
+                // If some ways are not on the ground, and the heights don't cancel out to 0,
+                // interpolate the height using the "layer_heights" interpolator.
+                result.height[n] = layer_heights(layer);
+            }
+        }
+        result.smooth_height[n] = result.height[n];
+    };
+    parallel_for(nnodes, compute_initial_height, 64);
+    return result;
+}
+
+void Mlib::smooth_street_node_heights(
+    const StreetNodeGraph& graph,
+    const std::vector<uint8_t>& fixed,
+    double smoothness,
+    size_t niterations,
+    StreetNodeHeights& heights)
+{
+    size_t nnodes = graph.nnodes();
+    if ((fixed.size() != nnodes) ||
+        (heights.height.size() != nnodes) ||
+        (heights.smooth_height.size() != nnodes) ||
+        (heights.has_height.size() != nnodes))
+    {
+        THROW_OR_ABORT("Street node height size mismatch");
+    }
+    std::vector<size_t> smoothed_nodes;
+    smoothed_nodes.reserve(nnodes);
+    for (size_t n = 0; n < nnodes; ++n) {
+        if (!fixed[n] && heights.has_height[n]) {
+            smoothed_nodes.push_back(n);
+        }
+    }
+    // The Gauss-Seidel sweeps visit the nodes in the order of their indices,
+    // so the result does not depend on the number of threads.
+    for (size_t i = 0; i < niterations; ++i) {
+        for (size_t n : smoothed_nodes) {
+            double mean_height = 0;
+            double sum_weights = 0;
+            for (size_t j = graph.row_begins[n]; j < graph.row_begins[n + 1]; ++j) {
+                size_t c = graph.columns[j];
+                if (heights.has_height[c]) {
+                    mean_height += graph.weights[j] * heights.smooth_height[c];
+                    sum_weights += graph.weights[j];
+                }
+            }
+            if (sum_weights > 0) {
+                mean_height /= sum_weights;
+                heights.smooth_height[n] = smoothness * mean_height + (1 - smoothness) * heights.height[n];
+            }
+        }
+    }
+}
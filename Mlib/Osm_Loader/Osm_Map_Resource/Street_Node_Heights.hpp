@@ -0,0 +1,57 @@
+#pragma once
+#include <Mlib/Math/Interp_Fwd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Mlib {
+
+struct StreetEdge {
+    size_t a;
+    size_t b;
+    double weight;
+    int layer;
+    double bridge_height;
+};
+
+/**
+ * Street node graph in compressed sparse row format,
+ * indexed by the dense node indices.
+ * The entries of a row are in the order in which the edges were added.
+ */
+struct StreetNodeGraph {
+    StreetNodeGraph(size_t nnodes, const std::vector<StreetEdge>& edges);
+    size_t nnodes() const;
+    std::vector<size_t> row_begins;
+    std::vector<size_t> columns;
+    std::vector<double> weights;
+    std::vector<int> layers;
+    std::vector<double> bridge_heights;
+};
+
+struct StreetNodeHeights {
+    std::vector<double> height;
+    std::vector<double> smooth_height;
+    std::vector<uint8_t> has_height;
+};
+
+// Computes the heights of the nodes from the layers and bridge heights
+// of their edges. Nodes whose edges are all on the ground are sampled
+// by "sample_height", which returns false if the node is outside of the heightmap.
+// "sample_height" is called in parallel.
+StreetNodeHeights initial_street_node_heights(
+    const StreetNodeGraph& graph,
+    const Interp<double>& layer_heights,
+    const std::function<bool(size_t node, double& height)>& sample_height);
+
+// Gauss-Seidel smoothing of "heights.smooth_height".
+// The "fixed" nodes keep their height, but still act as neighbors of the other nodes.
+void smooth_street_node_heights(
+    const StreetNodeGraph& graph,
+    const std::vector<uint8_t>& fixed,
+    double smoothness,
+    size_t niterations,
+    StreetNodeHeights& heights);
+
+}
@@ -10,6 +10,7 @@
 #include <Mlib/Geometry/Mesh/Plot.hpp>
 #include <Mlib/Geometry/Mesh/Save_Obj.hpp>
 #include <Mlib/Geometry/Mesh/Terrain_Uv.hpp>
+#include <Mlib/Geometry/Mesh/Tiled_Triangulation.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_Largest_Cosine.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_List.hpp>
 #include <Mlib/Osm_Loader/Osm_Map_Resource/Bounding_Info.hpp>
@@ -20,6 +21,7 @@
 #include <Mlib/Render/Renderables/Triangle_Sampler/Terrain_Type.hpp>
 #include <Mlib/Throw_Or_Abort.hpp>
 #include <poly2tri/point_exception.hpp>
+#include <optional>
 
 using namespace Mlib;
 
@@ -193,6 +195,8 @@ void triangulate_entity_list(
     const std::list<std::pair<EntityType, std::list<FixedArray<CompressedScenePos, 2>>>>& region_contours,
     float scale,
     float triangulation_scale,
+    CompressedScenePos triangulation_tile_size,
+    CompressedScenePos triangulation_tile_boundary_distance,
     float uv_scale,
     float uv_period,
     CompressedScenePos z,
@@ -294,7 +298,16 @@ void triangulate_entity_list(
     p2t_hole_contours.reserve(ncontours + 1);  // include bounding contour
     p2t_region_types.reserve(ncontours);
 
-    p2t::CDT cdt{final_bounding_contour};
+    // The tiled triangulation creates one CDT per tile and
+    // only requires the contours.
+    bool tiled = (triangulation_tile_size != (CompressedScenePos)0.);
+    std::vector<std::vector<FixedArray<CompressedScenePos, 2>>> tiled_contours;
+    std::optional<p2t::CDT> cdt;
+    if (tiled) {
+        tiled_contours.reserve(ncontours + 1);  // include bounding contour
+    } else {
+        cdt.emplace(final_bounding_contour);
+    }
     auto add_contour = [&](EntityType region_type, const std::list<FixedArray<CompressedScenePos, 2>>& contour){
         p2t_hole_contours.emplace_back();
         p2t_region_types.push_back(region_type);
@@ -306,7 +319,11 @@ void triangulate_entity_list(
             // draw_node(triangles, p.casted<float>(), 0.1 * float(i++) / c.size());
         }
         check_contour(cnt);
-        cdt.AddHole(cnt);
+        if (tiled) {
+            tiled_contours.emplace_back(contour.begin(), contour.end());
+        } else {
+            cdt->AddHole(cnt);
+        }
     };
     for (auto& hc : hole_contours) {
         for (std::list<FixedArray<CompressedScenePos, 2>>& c : hc.second) {
@@ -333,26 +350,94 @@ void triangulate_entity_list(
             throw std::runtime_error("Could not add region contour: " + std::string(e.what()));
         }
     }
-    for (const auto& p : points.remaining_steiner_points()) {
-        cdt.AddPoint(p);
-    }
     auto all_contours = p2t_hole_contours;
     all_contours.push_back(final_bounding_contour);
     if (!contour_filename.empty()) {
         plot_contours(contour_filename, all_contours, scale * triangulation_scale);
     }
+    auto draw_triangle = [&](
+        auto& tl,
+        const FixedArray<CompressedScenePos, 2>& c0,
+        const FixedArray<CompressedScenePos, 2>& c1,
+        const FixedArray<CompressedScenePos, 2>& c2)
+    {
+        auto uv = terrain_uv<CompressedScenePos, double>(
+            c0,
+            c1,
+            c2,
+            scale,
+            uv_scale,
+            uv_period);
+        tl->draw_triangle_wo_normals(
+            {c0(0), c0(1), z},
+            {c1(0), c1(1), z},
+            {c2(0), c2(1), z},
+            Colors::from_rgb(color),
+            Colors::from_rgb(color),
+            Colors::from_rgb(color),
+            uv[0],
+            uv[1],
+            uv[2]);
+    };
+    // The tiled triangulation falls back to a single CDT if it fails.
+    std::vector<std::list<FixedArray<CompressedScenePos, 3, 2>>> tiled_triangles;
+    if (tiled) {
+        auto& bc = tiled_contours.emplace_back();
+        bc.reserve(final_bounding_contour.size());
+        for (const auto* p : final_bounding_contour) {
+            bc.push_back(points.compute_coords(p));
+        }
+        try {
+            tiled_triangles = triangulate_tiled(
+                tiled_contours,
+                steiner_point_positions,
+                triangulation_tile_size,
+                triangulation_tile_boundary_distance,
+                triangulation_scale);
+        } catch (const std::runtime_error& e) {
+            lwarn() << "Tiled triangulation failed, using a single triangulation: " << e.what();
+            tiled = false;
+        }
+    }
+    if (tiled) {
+        for (size_t i = 0; i < tiled_triangles.size(); ++i) {
+            EntityType tpe;
+            if (i < p2t_region_types.size()) {
+                tpe = p2t_region_types[i];
+                if (excluded_entitities.contains(tpe)) {
+                    continue;
+                }
+            } else {
+                tpe = (ncontours == 0) ? default_terrain_type : bounding_terrain_type;
+            }
+            auto& tl = tl_terrain[tpe];
+            for (const auto& t : tiled_triangles[i]) {
+                draw_triangle(tl, t[0], t[1], t[2]);
+            }
+        }
+        return;
+    }
+    if (!cdt.has_value()) {
+        cdt.emplace(final_bounding_contour);
+        for (const auto& c : p2t_hole_contours) {
+            cdt->AddHole(c);
+        }
+    }
+    for (const auto& p : points.remaining_steiner_points()) {
+        cdt->AddPoint(p);
+    }
     //triangles.clear();
-    cdt.Triangulate();
+    cdt->Triangulate();
     std::list<p2t::Triangle*> tris;
     std::vector<std::list<p2t::Triangle*>> inner_triangles;
     if (ncontours == 0) {
-        auto tris0 = cdt.GetTriangles();
+        auto tris0 = cdt->GetTriangles();
         tris.insert(tris.end(), tris0.begin(), tris0.end());
         if (!triangle_filename.empty()) {
             plot_tris(triangle_filename, tris);
         }
     } else {
-        auto tris0 = cdt.GetMap();
+        auto tris0 = cdt->GetMap();
         tris.insert(tris.end(), tris0.begin(), tris0.end());
         if (!triangle_filename.empty()) {
             plot_tris(triangle_filename, tris);
@@ -379,23 +464,7 @@ void triangulate_entity_list(
                 lwarn() << "Received unknown point";
                 continue;
             }
-            auto uv = terrain_uv<CompressedScenePos, double>(
-                *c0,
-                *c1,
-                *c2,
-                scale,
-                uv_scale,
-                uv_period);
-            tl->draw_triangle_wo_normals(
-                {(*c0)(0), (*c0)(1), z},
-                {(*c1)(0), (*c1)(1), z},
-                {(*c2)(0), (*c2)(1), z},
-                Colors::from_rgb(color),
-                Colors::from_rgb(color),
-                Colors::from_rgb(color),
-                uv[0],
-                uv[1],
-                uv[2]);
+            draw_triangle(tl, *c0, *c1, *c2);
         }
     };
     if (ncontours == 0) {
@@ -428,6 +497,8 @@ void Mlib::triangulate_terrain_or_ceilings(
     const std::list<std::pair<TerrainType, std::list<FixedArray<CompressedScenePos, 2>>>>& region_contours,
     float scale,
     float triangulation_scale,
+    CompressedScenePos triangulation_tile_size,
+    CompressedScenePos triangulation_tile_boundary_distance,
     float uv_scale,
     float uv_period,
     CompressedScenePos z,
@@ -449,6 +520,8 @@ void Mlib::triangulate_terrain_or_ceilings(
         region_contours,
         scale,
         triangulation_scale,
+        triangulation_tile_size,
+        triangulation_tile_boundary_distance,
         uv_scale,
         uv_period,
         z,
@@ -471,6 +544,8 @@ void Mlib::triangulate_water(
     const std::list<std::pair<WaterType, std::list<FixedArray<CompressedScenePos, 2>>>>& region_contours,
     float scale,
     float triangulation_scale,
+    CompressedScenePos triangulation_tile_size,
+    CompressedScenePos triangulation_tile_boundary_distance,
     float uv_scale,
     float uv_period,
     CompressedScenePos z,
@@ -491,6 +566,8 @@ void Mlib::triangulate_water(
         region_contours,
         scale,
         triangulation_scale,
+        triangulation_tile_size,
+        triangulation_tile_boundary_distance,
         uv_scale,
         uv_period,
         z,
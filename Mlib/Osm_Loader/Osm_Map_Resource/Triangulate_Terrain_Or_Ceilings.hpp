@@ -34,6 +34,8 @@ void triangulate_terrain_or_ceilings(
     const std::list<std::pair<TerrainType, std::list<FixedArray<CompressedScenePos, 2>>>>& region_contours,
     float scale,
     float triangulation_scale,
+    CompressedScenePos triangulation_tile_size,
+    CompressedScenePos triangulation_tile_boundary_distance,
     float uv_scale,
     float uv_period,
     CompressedScenePos z,
@@ -55,6 +57,8 @@ void triangulate_water(
     const std::list<std::pair<WaterType, std::list<FixedArray<CompressedScenePos, 2>>>>& region_contours,
     float scale,
     float triangulation_scale,
+    CompressedScenePos triangulation_tile_size,
+    CompressedScenePos triangulation_tile_boundary_distance,
     float uv_scale,
     float uv_period,
     CompressedScenePos z,
@@ -35,15 +35,15 @@ struct CollisionHistory {
     const StaticWorld& world;
     const SatTracker& st;
     const SurfaceContactDb& surface_contact_db;
-    ContactSmokeGenerator& csg;
-    ITrailRenderer& tr;
+    ContactSmokeGenerator* csg;  // nullptr in headless worlds
+    ITrailRenderer* tr;          // nullptr in headless worlds
     std::list<Beacon>* beacons;
     std::list<std::unique_ptr<IContactInfo>>& contact_infos;
     std::unordered_map<OrderableFixedArray<CompressedScenePos, 2, 3>, IntersectionSceneAndContact>& raycast_intersections;
     std::unordered_map<RigidBodyVehicle*, std::list<IntersectionSceneAndContact>>& concave_t0_intersections;
     std::unordered_map<RigidBodyVehicle*, GrindInfo>& grind_infos;
     std::unordered_map<RigidBodyVehicle*, std::list<FixedArray<ScenePos, 3>>>& ridge_intersection_points;
-    RidgeMap& ridge_map;
+    const RidgeMap& ridge_map;
     BaseLog* base_log;
 };
 
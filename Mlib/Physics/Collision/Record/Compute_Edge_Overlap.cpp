@@ -5,7 +5,6 @@
 #include <Mlib/Geometry/Mesh/Sat_Normals.hpp>
 #include <Mlib/Geometry/Mesh/Sat_Overlap.hpp>
 #include <Mlib/Geometry/Mesh/Sat_Overlap2.hpp>
-#include <Mlib/Geometry/Mesh/Static_Transformed_Mesh.hpp>
 #include <Mlib/Geometry/Physics_Material.hpp>
 #include <Mlib/Geometry/Plane_Nd.hpp>
 #include <Mlib/Math/Orderable_Fixed_Array.hpp>
@@ -61,12 +60,13 @@ bool Mlib::compute_edge_overlap(
         //     return;
         // }
 
-        auto reflect = [&](const auto& corners0){
-            using Corners0 = std::remove_reference_t<decltype(corners0)>;
+        auto reflect = [&](const auto& p0){
+            using Corners0 = std::remove_reference_t<decltype(p0.corners)>;
             static_assert(Corners0::ndim() == 2);
-            size_t ncorners = Corners0::template static_shape<0>();
-            std::vector<CollisionRidgeSphere<CompressedScenePos>> ridges;
-            ridges.reserve(ncorners);
+            constexpr size_t ncorners = Corners0::template static_shape<0>();
+            const auto& corners0 = p0.corners;
+            std::array<const CollisionRidgeSphere<CompressedScenePos>*, ncorners> ridges;
+            size_t nridges = 0;
             for (size_t i = 0; i < ncorners; ++i) {
                 auto a = OrderableFixedArray{corners0[i]};
                 auto b = OrderableFixedArray{corners0[(i + 1) % ncorners]};
@@ -78,33 +78,17 @@ bool Mlib::compute_edge_overlap(
                     // so failure is expected.
                     continue;
                 }
-                ridges.push_back(it->second.crp);
+                ridges[nridges++] = &it->second.crp;
             }
-            StaticTransformedMesh stm(
-                "temp",
-                AxisAlignedBoundingBox<CompressedScenePos, 3>::from_points(corners0),
-                BoundingSphere<CompressedScenePos, 3>{corners0},
-                (c.q0.has_value()) ? std::vector<CollisionPolygonSphere<CompressedScenePos, 4>>{*c.q0} : std::vector<CollisionPolygonSphere<CompressedScenePos, 4>>(),
-                (c.t0.has_value()) ? std::vector<CollisionPolygonSphere<CompressedScenePos, 3>>{*c.t0} : std::vector<CollisionPolygonSphere<CompressedScenePos, 3>>(),
-                std::vector<CollisionLineSphere<CompressedScenePos>>(),
-                std::vector<CollisionLineSphere<CompressedScenePos>>(),
-                std::move(ridges),
-                std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>());
 
             assert_true(c.r1.has_value());
-            try {
-                // get_overlap(stm, *c.mesh1, overlap, normal);
-                get_overlap2(stm, *c.r1, -INFINITY, overlap, normal);
-            } catch (const std::runtime_error& e) {
-                throw std::runtime_error(
-                    "Could not compute collision plane of temporary mesh and edge: " + std::string(e.what()));
-            }
+            get_overlap2(p0, ridges, nridges, *c.r1, -INFINITY, overlap, normal);
             };
         if (c.q0.has_value()) {
-            reflect(c.q0->corners);
+            reflect(*c.q0);
         }
         if (c.t0.has_value()) {
-            reflect(c.t0->corners);
+            reflect(*c.t0);
         }
         if (overlap == INFINITY) {
             return false;
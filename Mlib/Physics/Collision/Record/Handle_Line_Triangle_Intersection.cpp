@@ -104,8 +104,14 @@ void Mlib::handle_line_triangle_intersection(const IntersectionScene& c)
     {
         THROW_OR_ABORT("Unexpected c.l1_is_normal value");
     }
-    c.o0.next_vehicle_domain_ = VehicleDomain::GROUND;
-    c.o1.next_vehicle_domain_ = VehicleDomain::GROUND;
+    // Static geometry can be shared between worlds (see "PhysicsEngineBatch"),
+    // and is not written to.
+    if (c.o0.mass() != INFINITY) {
+        c.o0.next_vehicle_domain_ = VehicleDomain::GROUND;
+    }
+    if (c.o1.mass() != INFINITY) {
+        c.o1.next_vehicle_domain_ = VehicleDomain::GROUND;
+    }
     if (c.l1_is_normal) {
         IntersectionSceneAndContact cc{
             .scene = c,
@@ -152,7 +158,9 @@ void Mlib::handle_line_triangle_intersection(
     for (auto& c1 : c.o1.collision_observers_) {
         c1->notify_collided(iinfo.intersection_point, c.history.world, c.o0, CollisionRole::SECONDARY, collision_type, abort);
     }
-    c.history.csg.notify_contact(iinfo.intersection_point, fixed_zeros<float, 3>(), iinfo.normal0, c);
+    if (c.history.csg != nullptr) {
+        c.history.csg->notify_contact(iinfo.intersection_point, fixed_zeros<float, 3>(), iinfo.normal0, c);
+    }
     if (abort) {
         return;
     }
@@ -21,6 +21,7 @@ using namespace Mlib;
 
 RigidBodies::RigidBodies(const PhysicsEngineConfig& cfg)
     : cfg_{ cfg }
+    , static_rigid_bodies_{ nullptr }
     , convex_mesh_bvh_{ {cfg.bvh_max_size, cfg.bvh_max_size, cfg.bvh_max_size}, cfg.bvh_levels }
     , triangle_bvh_{ {cfg.bvh_max_size, cfg.bvh_max_size, cfg.bvh_max_size}, cfg.bvh_levels }
     , ridge_bvh_{ {cfg.bvh_max_size, cfg.bvh_max_size, cfg.bvh_max_size}, cfg.bvh_levels }
@@ -28,6 +29,22 @@ RigidBodies::RigidBodies(const PhysicsEngineConfig& cfg)
     , collision_ridges_baking_status_{ CollisionRidgeBakingStatus::NOT_BAKED }
 {}
 
+RigidBodies::RigidBodies(const PhysicsEngineConfig& cfg, const RigidBodies& static_rigid_bodies)
+    : RigidBodies{ cfg }
+{
+    if (static_rigid_bodies.static_rigid_bodies_ != nullptr) {
+        THROW_OR_ABORT("Static rigid bodies must not be shared recursively");
+    }
+    // Collision observers would be notified from several worlds concurrently.
+    for (const auto& [rb, _] : static_rigid_bodies.rigid_bodies_) {
+        if ((rb->mass() == INFINITY) && !rb->collision_observers_.empty()) {
+            THROW_OR_ABORT("Shared static rigid body has collision observers: \"" + rb->name() + '"');
+        }
+    }
+    static_rigid_bodies.bake_collision_ridges_if_necessary();
+    static_rigid_bodies_ = &static_rigid_bodies;
+}
+
 RigidBodies::~RigidBodies() {
     bool success = true;
     if (!rigid_bodies_.empty()) {
@@ -76,6 +93,9 @@ void RigidBodies::add_rigid_body(
     }
     auto rng = welzl_rng();
     if (collidable_mode == CollidableMode::STATIC) {
+        if (static_rigid_bodies_ != nullptr) {
+            THROW_OR_ABORT("Static geometry is shared and read-only: \"" + rb.name() + '"');
+        }
         if (rb.mass() != INFINITY) {
             THROW_OR_ABORT("Terrain requires infinite mass");
         }
@@ -291,6 +311,7 @@ void RigidBodies::delete_rigid_body(const RigidBodyVehicle& rigid_body) {
             if (it == objects_.end()) {
                 THROW_OR_ABORT("Could not delete dynamic rigid body (4)");
             }
+            remove_from_movable_bvh(*it);
             objects_.erase(it);
         }
         transformed_objects_.remove_if([&rigid_body](const RigidBodyAndIntersectableMeshes& rbtm){
@@ -303,15 +324,18 @@ void RigidBodies::delete_rigid_body(const RigidBodyVehicle& rigid_body) {
     rigid_bodies_.erase(&rigid_body);
 }
 
-void RigidBodies::transform_object_and_add(const RigidBodyAndMeshes& o) {
+void RigidBodies::transform_object_and_add(RigidBodyAndMeshes& o) {
     if (!o.has_meshes()) {
         THROW_OR_ABORT("Attempt to add rigid body \"" + o.rigid_body->name() + "\" without meshes");
     }
     auto m = o.rigid_body->get_new_absolute_model_matrix();
-    std::list<TypedMesh<std::shared_ptr<IIntersectableMesh>>> transformed_meshes;
-    auto add_meshes = [&](const auto& meshes){
-        for (const auto& msh : meshes) {
-            transformed_meshes.push_back({
+    if (!o.transformed_pose.has_value() ||
+        !all(o.transformed_pose->R == m.R) ||
+        !all(o.transformed_pose->t == m.t))
+    {
+        o.transformed_meshes.clear();
+        for (const auto& msh : o.meshes) {
+            o.transformed_meshes.push_back({
                 .physics_material = msh.physics_material,
                 .mesh = std::make_shared<LazyTransformedMesh>(
                     m,
@@ -319,11 +343,31 @@ void RigidBodies::transform_object_and_add(const RigidBodyAndMeshes& o) {
                     msh.mesh.second,
                     cfg_.max_min_cos_ridge)});
         }
-    };
-    add_meshes(o.meshes);
-    transformed_objects_.push_back({
+        o.transformed_pose = m;
+    }
+    auto aabb = AxisAlignedBoundingBox<CompressedScenePos, 3>::empty();
+    for (const auto& msh : o.transformed_meshes) {
+        aabb.extend(msh.mesh->aabb());
+    }
+    TransformedObjectReference ref{
+        .object = nullptr,
+        .index = transformed_objects_.size() };
+    ref.object = &transformed_objects_.emplace_back(RigidBodyAndIntersectableMeshes{
         .rigid_body = o.rigid_body,
-        .meshes = std::move(transformed_meshes) });
+        .meshes = o.transformed_meshes });
+    if (o.movable_bvh_leaf == SIZE_MAX) {
+        o.movable_bvh_leaf = movable_bvh_.insert(aabb, ref);
+    } else {
+        movable_bvh_.move(o.movable_bvh_leaf, aabb);
+        movable_bvh_.payload(o.movable_bvh_leaf) = ref;
+    }
+}
+
+void RigidBodies::remove_from_movable_bvh(RigidBodyAndMeshes& o) {
+    if (o.movable_bvh_leaf != SIZE_MAX) {
+        movable_bvh_.remove(o.movable_bvh_leaf);
+        o.movable_bvh_leaf = SIZE_MAX;
+    }
 }
 
 void RigidBodies::optimize_search_time(std::ostream& ostr) const {
@@ -384,18 +428,35 @@ IterableWrapper<std::list<RigidBodyAndIntersectableMeshes>> RigidBodies::transfo
 }
 
 const Bvh<CompressedScenePos, 3, RigidBodyAndIntersectableMesh>& RigidBodies::convex_mesh_bvh() const {
+    if (static_rigid_bodies_ != nullptr) {
+        return static_rigid_bodies_->convex_mesh_bvh_;
+    }
     return convex_mesh_bvh_;
 }
 
+const RigidBodies::MovableBvh& RigidBodies::movable_bvh() const {
+    return movable_bvh_;
+}
+
 const RigidBodies::TriangleBvh& RigidBodies::triangle_bvh() const {
+    if (static_rigid_bodies_ != nullptr) {
+        return static_rigid_bodies_->triangle_bvh_;
+    }
     return triangle_bvh_;
 }
 
 const RigidBodies::LineBvh& RigidBodies::line_bvh() const {
+    if (static_rigid_bodies_ != nullptr) {
+        return static_rigid_bodies_->line_bvh_;
+    }
     return line_bvh_;
 }
 
 void RigidBodies::bake_collision_ridges_if_necessary() const {
+    if (static_rigid_bodies_ != nullptr) {
+        // Baked in the constructor.
+        return;
+    }
     if (collision_ridges_baking_status_ == CollisionRidgeBakingStatus::BAKING) {
         THROW_OR_ABORT("Previous collision ridges baking failed");
     }
@@ -407,11 +468,17 @@ void RigidBodies::bake_collision_ridges_if_necessary() const {
 }
 
 const RigidBodies::RidgeBvh& RigidBodies::ridge_bvh() const {
+    if (static_rigid_bodies_ != nullptr) {
+        return static_rigid_bodies_->ridge_bvh_;
+    }
     bake_collision_ridges_if_necessary();
     return ridge_bvh_;
 }
 
-RidgeMap& RigidBodies::ridge_map() {
+const RidgeMap& RigidBodies::ridge_map() const {
+    if (static_rigid_bodies_ != nullptr) {
+        return static_rigid_bodies_->ridge_map_;
+    }
     bake_collision_ridges_if_necessary();
     return ridge_map_;
 }
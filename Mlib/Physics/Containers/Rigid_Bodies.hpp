@@ -2,9 +2,11 @@
 #include <Mlib/Geometry/Intersection/Bvh.hpp>
 #include <Mlib/Geometry/Intersection/Collision_Line.hpp>
 #include <Mlib/Geometry/Intersection/Collision_Ridge.hpp>
+#include <Mlib/Geometry/Intersection/Dynamic_Bvh.hpp>
 #include <Mlib/Geometry/Mesh/Collision_Ridges_Rigid_Body.hpp>
 #include <Mlib/Geometry/Mesh/Typed_Mesh.hpp>
 #include <Mlib/Iterator/Iterable_Wrapper.hpp>
+#include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
 #include <Mlib/Memory/Dangling_Base_Class.hpp>
 #include <Mlib/Physics/Containers/Elements/Collision_Line_Sphere.hpp>
 #include <Mlib/Physics/Containers/Elements/Collision_Ridge_Sphere.hpp>
@@ -15,6 +17,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <variant>
@@ -35,6 +38,10 @@ class IIntersectable;
 struct RigidBodyAndMeshes {
     DanglingBaseClassRef<RigidBodyVehicle> rigid_body;
     std::list<TypedMesh<std::pair<BoundingSphere<CompressedScenePos, 3>, std::shared_ptr<CollisionMesh>>>> meshes;
+    // World-space meshes, reused while the pose does not change.
+    std::optional<TransformationMatrix<float, ScenePos, 3>> transformed_pose;
+    std::list<TypedMesh<std::shared_ptr<IIntersectableMesh>>> transformed_meshes;
+    size_t movable_bvh_leaf = SIZE_MAX;
     inline bool has_meshes() const {
         return !meshes.empty();
     }
@@ -45,6 +52,12 @@ struct RigidBodyAndIntersectableMeshes {
     std::list<TypedMesh<std::shared_ptr<IIntersectableMesh>>> meshes;
 };
 
+struct TransformedObjectReference {
+    const RigidBodyAndIntersectableMeshes* object = nullptr;
+    // Index into "RigidBodies::transformed_objects"
+    size_t index = SIZE_MAX;
+};
+
 struct RigidBodyAndIntersectableMesh {
     DanglingBaseClassRef<RigidBodyVehicle> rb;
     TypedMesh<std::shared_ptr<IIntersectableMesh>> mesh;
@@ -77,8 +90,15 @@ public:
         RigidBodyAndCollisionLineSphere<CompressedScenePos>,
         RigidBodyAndCollisionLineSphere<HalfCompressedScenePos>,
         3>;
+    using MovableBvh = DynamicBvh<
+        CompressedScenePos,
+        3,
+        TransformedObjectReference>;
 
     explicit RigidBodies(const PhysicsEngineConfig& cfg);
+    //! Read static geometry (terrain, street BVHs) from another instance.
+    //! Only dynamic state is stored in this object.
+    RigidBodies(const PhysicsEngineConfig& cfg, const RigidBodies& static_rigid_bodies);
     ~RigidBodies();
     void add_rigid_body(
         RigidBodyVehicle& rigid_body,
@@ -96,22 +116,28 @@ public:
     IterableWrapper<std::list<RigidBodyAndMeshes>> objects() const;
     IterableWrapper<std::list<RigidBodyAndIntersectableMeshes>> transformed_objects() const;
     const Bvh<CompressedScenePos, 3, RigidBodyAndIntersectableMesh>& convex_mesh_bvh() const;
+    const MovableBvh& movable_bvh() const;
     const TriangleBvh& triangle_bvh() const;
     const RidgeBvh& ridge_bvh() const;
-    RidgeMap& ridge_map();
+    const RidgeMap& ridge_map() const;
     const LineBvh& line_bvh() const;
     bool empty() const;
+    //! Must be called before the static geometry is shared between threads.
+    void bake_collision_ridges_if_necessary() const;
 private:
-    void transform_object_and_add(const RigidBodyAndMeshes& o);
+    void transform_object_and_add(RigidBodyAndMeshes& o);
+    void remove_from_movable_bvh(RigidBodyAndMeshes& o);
     void bake_collision_ridges() const;
-    void bake_collision_ridges_if_necessary() const;
     const PhysicsEngineConfig& cfg_;
+    const RigidBodies* static_rigid_bodies_;
     std::unordered_map<const RigidBodyVehicle*, DestructionFunctionsTokensObject<RigidBodyVehicle>> rigid_bodies_;
     std::list<RigidBodyAndMeshes> objects_;
     std::list<RigidBodyAndIntersectableMeshes> transformed_objects_;
     std::map<const RigidBodyVehicle*, CollidableMode> collidable_modes_;
     // BVHs. Do not forget to .clear() the BVHs in the "delete_rigid_body" method.
     Bvh<CompressedScenePos, 3, RigidBodyAndIntersectableMesh> convex_mesh_bvh_;
+    // Persistent, refitted every substep. Contains the movables of "transformed_objects_".
+    MovableBvh movable_bvh_;
     TriangleBvh triangle_bvh_;
     mutable RidgeBvh ridge_bvh_;
     mutable RidgeMap ridge_map_;
@@ -0,0 +1,132 @@
+#include "Visibility_Queries.hpp"
+#include <Mlib/Physics/Containers/Collision_Query.hpp>
+#include <Mlib/Physics/Rigid_Body/Rigid_Body_Vehicle.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace Mlib;
+
+static FixedArray<ScenePos, 3> abs_target(const RigidBodyVehicle& rb, float time_offset) {
+    if (time_offset != 0) {
+        RigidBodyPulses rbp = rb.rbp_;
+        rbp.advance_time(time_offset);
+        return rbp.transform_to_world_coordinates(rb.target_);
+    } else {
+        return rb.abs_target();
+    }
+}
+
+VisibilityQueries::VisibilityQueries(
+    const CollisionQuery& collision_query,
+    ScenePos cell_size,
+    size_t max_age)
+    : collision_query_{ collision_query }
+    , cell_size_{ cell_size }
+    , max_age_{ max_age }
+    , time_{ 0 }
+{
+    if (!(cell_size > 0)) {
+        THROW_OR_ABORT("Visibility cell size must be positive");
+    }
+}
+
+VisibilityQueries::~VisibilityQueries() = default;
+
+std::optional<bool> VisibilityQueries::can_see(
+    const RigidBodyVehicle& watcher,
+    const FixedArray<ScenePos, 3>& watched,
+    bool only_terrain,
+    ScenePos height_offset,
+    float time_offset)
+{
+    return lookup(watcher, watched, nullptr, only_terrain, height_offset, time_offset);
+}
+
+std::optional<bool> VisibilityQueries::can_see(
+    const RigidBodyVehicle& watcher,
+    const RigidBodyVehicle& watched,
+    bool only_terrain,
+    ScenePos height_offset,
+    float time_offset)
+{
+    return lookup(watcher, abs_target(watched, time_offset), &watched, only_terrain, height_offset, time_offset);
+}
+
+OrderableFixedArray<int, 3> VisibilityQueries::cell(const FixedArray<ScenePos, 3>& position) const {
+    return OrderableFixedArray<int, 3>{ (position / cell_size_).applied<int>([](ScenePos v){ return (int)std::floor(v); }) };
+}
+
+std::optional<bool> VisibilityQueries::lookup(
+    const RigidBodyVehicle& watcher,
+    const FixedArray<ScenePos, 3>& watched,
+    const RigidBodyVehicle* watched_rb,
+    bool only_terrain,
+    ScenePos height_offset,
+    float time_offset)
+{
+    auto watcher_pos = abs_target(watcher, time_offset);
+    // The watcher's cell is part of the key, so that results are
+    // invalidated when the watcher moves.
+    Key key{
+        &watcher,
+        cell(watcher_pos),
+        watched_rb,
+        cell(watched),
+        height_offset,
+        time_offset,
+        only_terrain };
+    if (auto it = results_.find(key); it != results_.end()) {
+        return it->second.visible;
+    }
+    if (!pending_.contains(key)) {
+        FixedArray<ScenePos, 3> d{ (ScenePos)0, height_offset, (ScenePos)0 };
+        pending_.try_emplace(key, Ray{
+            .watcher = watcher_pos + d,
+            .watched = watched + d,
+            .excluded0 = &watcher,
+            .excluded1 = watched_rb,
+            .only_terrain = only_terrain });
+    }
+    return std::nullopt;
+}
+
+void VisibilityQueries::execute() {
+    ++time_;
+    std::erase_if(results_, [this](const auto& r){
+        return time_ - r.second.time > max_age_;
+    });
+    if (pending_.empty()) {
+        return;
+    }
+    std::vector<std::pair<const Key*, const Ray*>> rays;
+    rays.reserve(pending_.size());
+    for (const auto& [key, ray] : pending_) {
+        rays.emplace_back(&key, &ray);
+    }
+    std::vector<uint8_t> visible(rays.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < (int)rays.size(); ++i) {
+        const auto& ray = *rays[(size_t)i].second;
+        visible[(size_t)i] = collision_query_.can_see(
+            ray.watcher,
+            ray.watched,
+            ray.excluded0,
+            ray.excluded1,
+            ray.only_terrain);
+    }
+    for (size_t i = 0; i < rays.size(); ++i) {
+        results_.insert_or_assign(*rays[i].first, Result{ .visible = (visible[i] != 0), .time = time_ });
+    }
+    pending_.clear();
+}
+
+void VisibilityQueries::clear() {
+    results_.clear();
+    pending_.clear();
+}
+
+size_t VisibilityQueries::npending() const {
+    return pending_.size();
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Math/Orderable_Fixed_Array.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <map>
+#include <optional>
+#include <tuple>
+
+namespace Mlib {
+
+class CollisionQuery;
+class RigidBodyVehicle;
+
+/**
+ * Deferred line-of-sight queries.
+ *
+ * "can_see" returns the result of a previous query, or enqueues
+ * the ray and returns std::nullopt. "execute" traces all enqueued
+ * rays in parallel, i.e. the result is available after the next
+ * call to "execute".
+ *
+ * Results are cached per watcher, cell of the watcher, watched object
+ * and cell of the watched position, and expire after "max_age" calls
+ * to "execute".
+ */
+class VisibilityQueries {
+    VisibilityQueries(const VisibilityQueries&) = delete;
+    VisibilityQueries& operator = (const VisibilityQueries&) = delete;
+public:
+    VisibilityQueries(
+        const CollisionQuery& collision_query,
+        ScenePos cell_size,
+        size_t max_age);
+    ~VisibilityQueries();
+    std::optional<bool> can_see(
+        const RigidBodyVehicle& watcher,
+        const FixedArray<ScenePos, 3>& watched,
+        bool only_terrain = false,
+        ScenePos height_offset = 0,
+        float time_offset = 0);
+    std::optional<bool> can_see(
+        const RigidBodyVehicle& watcher,
+        const RigidBodyVehicle& watched,
+        bool only_terrain = false,
+        ScenePos height_offset = 0,
+        float time_offset = 0);
+    void execute();
+    void clear();
+    size_t npending() const;
+private:
+    // (watcher, watcher cell, watched, watched cell, height offset, time offset, only terrain)
+    using Key = std::tuple<
+        const RigidBodyVehicle*,
+        OrderableFixedArray<int, 3>,
+        const RigidBodyVehicle*,
+        OrderableFixedArray<int, 3>,
+        ScenePos,
+        float,
+        bool>;
+    struct Ray {
+        FixedArray<ScenePos, 3> watcher;
+        FixedArray<ScenePos, 3> watched;
+        const RigidBodyVehicle* excluded0;
+        const RigidBodyVehicle* excluded1;
+        bool only_terrain;
+    };
+    struct Result {
+        bool visible;
+        size_t time;
+    };
+    OrderableFixedArray<int, 3> cell(const FixedArray<ScenePos, 3>& position) const;
+    std::optional<bool> lookup(
+        const RigidBodyVehicle& watcher,
+        const FixedArray<ScenePos, 3>& watched,
+        const RigidBodyVehicle* watched_rb,
+        bool only_terrain,
+        ScenePos height_offset,
+        float time_offset);
+    const CollisionQuery& collision_query_;
+    ScenePos cell_size_;
+    size_t max_age_;
+    size_t time_;
+    std::map<Key, Result> results_;
+    std::map<Key, Ray> pending_;
+};
+
+}
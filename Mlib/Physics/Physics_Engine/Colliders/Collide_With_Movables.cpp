@@ -1,4 +1,5 @@
 #include "Collide_With_Movables.hpp"
+#include <Mlib/Geometry/Mesh/IIntersectable_Mesh.hpp>
 #include <Mlib/Geometry/Physics_Material.hpp>
 #include <Mlib/Iterator/Enumerate.hpp>
 #include <Mlib/Iterator/Reverse_Iterator.hpp>
@@ -42,28 +43,47 @@ static void collide_objects(
     }
 }
 
+static AxisAlignedBoundingBox<CompressedScenePos, 3> object_aabb(const RigidBodyAndIntersectableMeshes& o) {
+    auto result = AxisAlignedBoundingBox<CompressedScenePos, 3>::empty();
+    for (const auto& msh : o.meshes) {
+        result.extend(msh.mesh->aabb());
+    }
+    return result;
+}
+
 void Mlib::collide_with_movables(
     CollisionDirection collision_direction,
     RigidBodies& rigid_bodies,
     const CollisionHistory& history)
 {
+    // Each pair is collided once, with "o0" being the later object
+    // in the iteration order given by "collision_direction".
+    auto collide_with_neighbors = [&](const RigidBodyAndIntersectableMeshes& o0, size_t i0){
+        if (o0.meshes.empty()) {
+            return;
+        }
+        rigid_bodies.movable_bvh().visit(
+            object_aabb(o0),
+            [&](const TransformedObjectReference& r1){
+                if ((collision_direction == CollisionDirection::FORWARD)
+                        ? (r1.index < i0)
+                        : (r1.index > i0))
+                {
+                    collide_objects(o0, *r1.object, history);
+                }
+                return true;
+            });
+    };
     if (collision_direction == CollisionDirection::FORWARD) {
         for (const auto& [i0, o0] : enumerate(rigid_bodies.transformed_objects())) {
-            for (const auto& [i1, o1] : enumerate(rigid_bodies.transformed_objects())) {
-                if (i1 >= i0) {
-                    break;
-                }
-                collide_objects(o0, o1, history);
-            }
+            collide_with_neighbors(o0, i0);
         }
     } else {
+        // The indices refer to "transformed_objects", whose size can differ
+        // from the number of leaves in the movable BVH.
+        size_t n = rigid_bodies.transformed_objects().size();
         for (const auto& [i0, o0] : enumerate(reverse(rigid_bodies.transformed_objects()))) {
-            for (const auto& [i1, o1] : enumerate(reverse(rigid_bodies.transformed_objects()))) {
-                if (i1 >= i0) {
-                    break;
-                }
-                collide_objects(o0, o1, history);
-            }
+            collide_with_neighbors(o0, n - 1 - i0);
         }
     }
 }
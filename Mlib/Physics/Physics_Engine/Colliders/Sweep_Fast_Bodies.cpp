@@ -0,0 +1,224 @@
+#include "Sweep_Fast_Bodies.hpp"
+#include <Mlib/Geometry/Intersection/Ray_Sphere_Intersection.hpp>
+#include <Mlib/Geometry/Ray_Segment_3D.hpp>
+#include <Mlib/Physics/Containers/Rigid_Bodies.hpp>
+#include <Mlib/Physics/Physics_Engine/Physics_Engine_Config.hpp>
+#include <Mlib/Physics/Rigid_Body/Rigid_Body_Vehicle.hpp>
+
+using namespace Mlib;
+
+std::vector<FastBody> Mlib::get_fast_bodies(
+    const PhysicsEngineConfig& cfg,
+    const RigidBodies& rigid_bodies)
+{
+    std::vector<FastBody> result;
+    if (!cfg.continuous_collision) {
+        return result;
+    }
+    for (const auto& o : rigid_bodies.objects()) {
+        auto& rb = o.rigid_body.get();
+        if (rb.is_deactivated_avatar() || !o.has_meshes()) {
+            continue;
+        }
+        ScenePos radius = 0;
+        for (const auto& msh : o.meshes) {
+            radius = std::max(radius, (ScenePos)msh.mesh.first.radius);
+        }
+        if (radius > cfg.ccd_max_radius) {
+            continue;
+        }
+        auto distance = std::sqrt(sum(squared(rb.rbp_.v_))) * cfg.dt_substeps();
+        if (distance <= radius) {
+            continue;
+        }
+        result.push_back(FastBody{
+            .rb = rb,
+            .start = rb.rbp_.abs_position(),
+            .radius = radius });
+    }
+    return result;
+}
+
+// Earliest distance "t" along the unit direction "dir" at which a sphere of
+// radius "radius", starting at "start", touches the point "p".
+static bool sweep_sphere_point(
+    const FixedArray<ScenePos, 3>& start,
+    const FixedArray<ScenePos, 3>& dir,
+    const FixedArray<ScenePos, 3>& p,
+    ScenePos radius,
+    ScenePos& t)
+{
+    ScenePos t1;
+    ScenePos t0;
+    if (!ray_intersects_sphere(start, dir, p, squared(radius), &t1, &t0) || (t0 < 0)) {
+        return false;
+    }
+    t = t0;
+    return true;
+}
+
+// Earliest distance "t" along the unit direction "dir" at which a sphere of
+// radius "radius", starting at "start", touches the inner part of the segment "a-b".
+// The end points are handled by "sweep_sphere_point".
+static bool sweep_sphere_segment(
+    const FixedArray<ScenePos, 3>& start,
+    const FixedArray<ScenePos, 3>& dir,
+    const FixedArray<ScenePos, 3>& a,
+    const FixedArray<ScenePos, 3>& b,
+    ScenePos radius,
+    ScenePos& t,
+    FixedArray<ScenePos, 3>& closest_point)
+{
+    auto e = b - a;
+    auto e_len = std::sqrt(sum(squared(e)));
+    if (e_len < 1e-12) {
+        return false;
+    }
+    e /= e_len;
+    // Distance to the infinite line, in the plane orthogonal to the segment.
+    auto m = start - a;
+    auto m_orth = m - dot0d(m, e) * e;
+    auto d_orth = dir - dot0d(dir, e) * e;
+    auto qa = sum(squared(d_orth));
+    if (qa < 1e-12) {
+        return false;
+    }
+    auto qb = dot0d(m_orth, d_orth);
+    auto qc = sum(squared(m_orth)) - squared(radius);
+    auto disc = squared(qb) - qa * qc;
+    if (disc < 0) {
+        return false;
+    }
+    auto t0 = (-qb - std::sqrt(disc)) / qa;
+    if (t0 < 0) {
+        return false;
+    }
+    auto u = dot0d(m + t0 * dir, e);
+    if ((u < 0) || (u > e_len)) {
+        return false;
+    }
+    t = t0;
+    closest_point = a + u * e;
+    return true;
+}
+
+bool Mlib::sweep_static_geometry(
+    const RigidBodies& rigid_bodies,
+    const FixedArray<ScenePos, 3>& start,
+    const FixedArray<ScenePos, 3>& stop,
+    ScenePos radius,
+    ScenePos& time_of_impact,
+    FixedArray<SceneDir, 3>* normal)
+{
+    if (sum(squared(stop - start)) < 1e-12) {
+        return false;
+    }
+    RaySegment3D<ScenePos, ScenePos> ray{ start, stop };
+    const auto& dir = ray.direction;
+    ScenePos t_min = INFINITY;
+    FixedArray<ScenePos, 3> n_min = uninitialized;
+    // Contact of the sphere with a point "p" of the geometry at distance "t".
+    auto add_point_contact = [&](ScenePos t, const FixedArray<ScenePos, 3>& p) {
+        if (t < t_min) {
+            t_min = t;
+            n_min = (start + t * dir - p) / radius;
+        }
+    };
+    auto sweep_segment = [&](const FixedArray<ScenePos, 3>& a, const FixedArray<ScenePos, 3>& b) {
+        ScenePos t;
+        FixedArray<ScenePos, 3> closest_point = uninitialized;
+        if (sweep_sphere_segment(start, dir, a, b, radius, t, closest_point)) {
+            add_point_contact(t, closest_point);
+        }
+        if (sweep_sphere_point(start, dir, a, radius, t)) {
+            add_point_contact(t, a);
+        }
+        if (sweep_sphere_point(start, dir, b, radius, t)) {
+            add_point_contact(t, b);
+        }
+    };
+    auto path_aabb = AxisAlignedBoundingBox<CompressedScenePos, 3>::from_min_max(
+        (minimum(start, stop) - radius).casted<CompressedScenePos>(),
+        (maximum(start, stop) + radius).casted<CompressedScenePos>());
+    rigid_bodies.triangle_bvh().visit(
+        path_aabb,
+        [&](const RigidBodyAndCollisionTriangleSphere<CompressedScenePos>& t0)
+        {
+            std::visit(
+                [&](const auto& ctp)
+                {
+                    auto polygon = ctp.polygon.template casted<ScenePos, ScenePos>();
+                    auto n = polygon.plane.normal;
+                    auto d0 = dot0d(n, start) + polygon.plane.intercept;
+                    auto dd = dot0d(n, dir);
+                    ScenePos t;
+                    FixedArray<ScenePos, 3> intersection_point = uninitialized;
+                    if (std::abs(d0) >= radius) {
+                        // Face: the sphere touches the plane inside of the polygon.
+                        ScenePos side = (d0 > 0) ? 1 : -1;
+                        if (side * dd < -1e-12) {
+                            t = (std::abs(d0) - radius) / (-side * dd);
+                            auto contact_point = start + t * dir - side * radius * n;
+                            if ((t <= ray.length) && polygon.contains(contact_point)) {
+                                add_point_contact(t, contact_point);
+                            }
+                        }
+                    } else if (ray.intersects(polygon, &t, &intersection_point)) {
+                        // The sphere already overlaps the plane, stop before the
+                        // center crosses the polygon.
+                        if (t < t_min) {
+                            t_min = t;
+                            n_min = -sign(dd) * n;
+                        }
+                    }
+                    // Edges and corners.
+                    auto corners = ctp.corners.template casted<ScenePos>();
+                    static const size_t ncorners = decltype(corners)::template static_shape<0>();
+                    for (size_t i = 0; i < ncorners; ++i) {
+                        sweep_segment(corners[i], corners[(i + 1) % ncorners]);
+                    }
+                }, t0.ctp);
+            return true;
+        });
+    rigid_bodies.line_bvh().visit(
+        path_aabb,
+        [&](const RigidBodyAndCollisionLineSphere<CompressedScenePos>& l0)
+        {
+            auto line = l0.clp.line.casted<ScenePos>();
+            sweep_segment(line[0], line[1]);
+            return true;
+        });
+    if (t_min > ray.length) {
+        return false;
+    }
+    time_of_impact = t_min / ray.length;
+    if (normal != nullptr) {
+        // Point the normal against the direction of motion.
+        if (dot0d(n_min, dir) > 0) {
+            n_min = -n_min;
+        }
+        *normal = n_min.casted<SceneDir>();
+    }
+    return true;
+}
+
+void Mlib::sweep_fast_bodies(
+    const RigidBodies& rigid_bodies,
+    const std::vector<FastBody>& fast_bodies)
+{
+    for (const auto& b : fast_bodies) {
+        auto stop = b.rb.rbp_.abs_position();
+        ScenePos toi;
+        FixedArray<SceneDir, 3> normal = uninitialized;
+        if (!sweep_static_geometry(rigid_bodies, b.start, stop, b.radius, toi, &normal)) {
+            continue;
+        }
+        b.rb.rbp_.set_pose(b.rb.rbp_.rotation_, b.start + toi * (stop - b.start));
+        // Remove the velocity towards the surface, so the body
+        // does not penetrate it again during the next substep.
+        auto vn = dot0d(b.rb.rbp_.v_, normal);
+        if (vn < 0) {
+            b.rb.rbp_.v_ -= vn * normal;
+        }
+    }
+}
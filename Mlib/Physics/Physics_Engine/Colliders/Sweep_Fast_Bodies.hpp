@@ -0,0 +1,50 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <vector>
+
+namespace Mlib {
+
+struct PhysicsEngineConfig;
+class RigidBodies;
+class RigidBodyVehicle;
+
+struct FastBody {
+    RigidBodyVehicle& rb;
+    FixedArray<ScenePos, 3> start;
+    ScenePos radius;
+};
+
+/**
+ * Small bodies that move more than their radius during one substep,
+ * i.e. that could tunnel through thin static geometry.
+ */
+std::vector<FastBody> get_fast_bodies(
+    const PhysicsEngineConfig& cfg,
+    const RigidBodies& rigid_bodies);
+
+/**
+ * Time of impact (in [0, 1]) of a sphere moving from "start" to "stop"
+ * with the faces, edges and corners of the static triangles, and with the lines.
+ * At the time of impact, the sphere touches the geometry.
+ * The optional "normal" of the surface points against the direction of motion.
+ */
+bool sweep_static_geometry(
+    const RigidBodies& rigid_bodies,
+    const FixedArray<ScenePos, 3>& start,
+    const FixedArray<ScenePos, 3>& stop,
+    ScenePos radius,
+    ScenePos& time_of_impact,
+    FixedArray<SceneDir, 3>* normal = nullptr);
+
+/**
+ * Moves each fast body back to its first contact with the static geometry
+ * along the path it travelled since "get_fast_bodies" was called,
+ * and removes its velocity component towards the surface.
+ * The discrete collision detection of the next substep handles the contact.
+ */
+void sweep_fast_bodies(
+    const RigidBodies& rigid_bodies,
+    const std::vector<FastBody>& fast_bodies);
+
+}
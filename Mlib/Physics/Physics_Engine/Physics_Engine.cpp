@@ -17,6 +17,7 @@
 #include <Mlib/Physics/Physics_Engine/Colliders/Collide_Raycast_Intersections.hpp>
 #include <Mlib/Physics/Physics_Engine/Colliders/Collide_With_Movables.hpp>
 #include <Mlib/Physics/Physics_Engine/Colliders/Collide_With_Terrain.hpp>
+#include <Mlib/Physics/Physics_Engine/Colliders/Sweep_Fast_Bodies.hpp>
 #include <Mlib/Physics/Physics_Engine/Physics_Phase.hpp>
 #include <Mlib/Physics/Rigid_Body/Rigid_Body_Vehicle.hpp>
 #include <Mlib/Physics/Smoke_Generation/Contact_Smoke_Generator.hpp>
@@ -34,6 +35,19 @@ PhysicsEngine::PhysicsEngine(const PhysicsEngineConfig& cfg)
     , contact_smoke_generator_{ nullptr }
     , particle_renderer_{ nullptr }
     , trail_renderer_{ nullptr }
+    , headless_{ false }
+    , cfg_{ cfg }
+{}
+
+PhysicsEngine::PhysicsEngine(const PhysicsEngineConfig& cfg, const PhysicsEngine& static_engine)
+    : rigid_bodies_{ cfg, static_engine.rigid_bodies_ }
+    , collision_query_{ *this }
+    , collision_direction_{ CollisionDirection::FORWARD }
+    , surface_contact_db_{ nullptr }
+    , contact_smoke_generator_{ nullptr }
+    , particle_renderer_{ nullptr }
+    , trail_renderer_{ nullptr }
+    , headless_{ true }
     , cfg_{ cfg }
 {}
 
@@ -76,10 +90,10 @@ void PhysicsEngine::collide(
     if (surface_contact_db_ == nullptr) {
         THROW_OR_ABORT("surface_contact_db not set");
     }
-    if (contact_smoke_generator_ == nullptr) {
+    if (!headless_ && (contact_smoke_generator_ == nullptr)) {
         THROW_OR_ABORT("contact_smoke_generator not set");
     }
-    if (trail_renderer_ == nullptr) {
+    if (!headless_ && (trail_renderer_ == nullptr)) {
         THROW_OR_ABORT("trail_renderer not set");
     }
     CollisionHistory history{
@@ -88,8 +102,8 @@ void PhysicsEngine::collide(
         .world = world,
         .st = st,
         .surface_contact_db = *surface_contact_db_,
-        .csg = *contact_smoke_generator_,
-        .tr = *trail_renderer_,
+        .csg = contact_smoke_generator_,
+        .tr = trail_renderer_,
         .beacons = beacons,
         .contact_infos = contact_infos,
         .raycast_intersections = raycast_intersections,
@@ -99,9 +113,10 @@ void PhysicsEngine::collide(
         .ridge_map = rigid_bodies_.ridge_map(),
         .base_log = base_log
     };
-    for (const auto& o : rigid_bodies_.objects_) {
+    for (auto& o : rigid_bodies_.objects_) {
         if ((o.rigid_body->mass() == INFINITY) || o.rigid_body->is_deactivated_avatar())
         {
+            rigid_bodies_.remove_from_movable_bvh(o);
             continue;
         }
         if (o.has_meshes()) {
@@ -109,6 +124,10 @@ void PhysicsEngine::collide(
         }
         o.rigid_body->collide_with_air(history);
     }
+    // The movable BVH is refitted every substep, and rebalanced once per frame.
+    if ((oversampling_iteration == 0) || (oversampling_iteration == SIZE_MAX)) {
+        rigid_bodies_.movable_bvh_.rebalance();
+    }
     collision_direction_ = (collision_direction_ == CollisionDirection::FORWARD)
         ? CollisionDirection::BACKWARD
         : CollisionDirection::FORWARD;
@@ -132,6 +151,7 @@ void PhysicsEngine::move_rigid_bodies(
     std::list<Beacon>* beacons,
     const PhysicsPhase& phase)
 {
+    auto fast_bodies = get_fast_bodies(cfg_, rigid_bodies_);
     for (const auto& rbm : rigid_bodies_.objects_) {
         if (rbm.rigid_body->is_deactivated_avatar()) {
             continue;
@@ -140,14 +160,16 @@ void PhysicsEngine::move_rigid_bodies(
         assert_true(rb->mass() != INFINITY);
         rb->advance_time(cfg_, world, beacons, phase);
     }
+    sweep_fast_bodies(rigid_bodies_, fast_bodies);
 }
 
 void PhysicsEngine::move_particles(const StaticWorld& world)
 {
-    if (contact_smoke_generator_ == nullptr) {
+    if (contact_smoke_generator_ != nullptr) {
+        contact_smoke_generator_->advance_time(cfg_.dt_substeps());
+    } else if (!headless_) {
         THROW_OR_ABORT("contact_smoke_generator not set");
     }
-    contact_smoke_generator_->advance_time(cfg_.dt_substeps());
     if (particle_renderer_ != nullptr) {
         particle_renderer_->move(cfg_.dt_substeps(), world);
     }
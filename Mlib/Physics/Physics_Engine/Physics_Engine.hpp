@@ -25,6 +25,10 @@ struct PhysicsPhase;
 class PhysicsEngine {
 public:
     explicit PhysicsEngine(const PhysicsEngineConfig& cfg);
+    //! Shares the static geometry of "static_engine" (see "PhysicsEngineBatch").
+    //! The resulting engine is headless, i.e., the contact smoke generator,
+    //! the particle renderer and the trail renderer are optional.
+    PhysicsEngine(const PhysicsEngineConfig& cfg, const PhysicsEngine& static_engine);
     ~PhysicsEngine();
     void add_external_force_provider(IExternalForceProvider& efp);
     void add_controllable(IControllable& co);
@@ -60,6 +64,7 @@ private:
     ContactSmokeGenerator* contact_smoke_generator_;
     IParticleRenderer* particle_renderer_;
     ITrailRenderer* trail_renderer_;
+    bool headless_;
     std::list<IExternalForceProvider*> external_force_providers_;
     std::set<IControllable*> controllables_;
     PhysicsEngineConfig cfg_;
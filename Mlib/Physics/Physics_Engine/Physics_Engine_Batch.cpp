@@ -0,0 +1,91 @@
+#include "Physics_Engine_Batch.hpp"
+#include <Mlib/Physics/Physics_Engine/Physics_Engine.hpp>
+#include <Mlib/Physics/Physics_Engine/Physics_Phase.hpp>
+#include <Mlib/Physics/Smoke_Generation/Surface_Contact_Db.hpp>
+#include <Mlib/Physics/Smoke_Generation/Surface_Contact_Info.hpp>
+#include <Mlib/Scene_Graph/Instances/Static_World.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+
+using namespace Mlib;
+
+PhysicsEngineBatch::PhysicsEngineBatch(
+    const PhysicsEngineConfig& cfg,
+    const PhysicsEngine& static_engine,
+    const SurfaceContactDb& surface_contact_db,
+    size_t nworlds)
+    : cfg_{ cfg }
+{
+    if (cfg_.nsubsteps == 0) {
+        THROW_OR_ABORT("Number of substeps is zero");
+    }
+    surface_contact_dbs_.reserve(nworlds);
+    worlds_.reserve(nworlds);
+    for (size_t i = 0; i < nworlds; ++i) {
+        surface_contact_dbs_.push_back(std::make_unique<SurfaceContactDb>(surface_contact_db));
+        worlds_.push_back(std::make_unique<PhysicsEngine>(cfg_, static_engine));
+        worlds_.back()->set_surface_contact_db(*surface_contact_dbs_.back());
+    }
+}
+
+PhysicsEngineBatch::~PhysicsEngineBatch() = default;
+
+size_t PhysicsEngineBatch::size() const {
+    return worlds_.size();
+}
+
+PhysicsEngine& PhysicsEngineBatch::operator [] (size_t i) {
+    if (i >= worlds_.size()) {
+        THROW_OR_ABORT("Physics world index out of bounds");
+    }
+    return *worlds_[i];
+}
+
+const PhysicsEngine& PhysicsEngineBatch::operator [] (size_t i) const {
+    return const_cast<PhysicsEngineBatch&>(*this)[i];
+}
+
+template <class TOperation>
+void PhysicsEngineBatch::parallel_for_each_world(const TOperation& op) {
+    parallel_for(worlds_.size(), [&](size_t i){
+        op(*worlds_[i]);
+    });
+}
+
+void PhysicsEngineBatch::step(
+    const StaticWorld& world,
+    std::chrono::steady_clock::time_point time)
+{
+    auto idt = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(cfg_.dt_substeps() / seconds));
+    parallel_for_each_world([&](PhysicsEngine& engine){
+        StaticWorld w = world;
+        for (size_t i = 0; i < cfg_.nsubsteps; ++i) {
+            w.time = time - (cfg_.nsubsteps - 1 - i) * idt;
+            engine.collide(
+                w,
+                nullptr,        // beacons
+                false,          // false=burn_in
+                i,
+                nullptr);       // base_log
+            engine.move_rigid_bodies(
+                w,
+                nullptr,        // beacons
+                PhysicsPhase{
+                    .burn_in = false,
+                    .substep = i
+                });
+            engine.move_particles(w);
+        }
+        engine.move_advance_times(w);
+    });
+}
+
+void PhysicsEngineBatch::burn_in(
+    const StaticWorld& world,
+    float duration)
+{
+    parallel_for_each_world([&](PhysicsEngine& engine){
+        engine.burn_in(world, duration);
+    });
+}
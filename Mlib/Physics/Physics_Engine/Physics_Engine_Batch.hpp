@@ -0,0 +1,52 @@
+#pragma once
+#include <Mlib/Physics/Physics_Engine/Physics_Engine_Config.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Mlib {
+
+class PhysicsEngine;
+class SurfaceContactDb;
+struct StaticWorld;
+
+/**
+ * Many independent, headless physics worlds in one process.
+ *
+ * All worlds read the static geometry (terrain, street and line BVHs)
+ * of one "static engine", that must not change while the batch exists.
+ * Each world only stores its dynamic state (movables, contacts, advance times)
+ * and its own copy of the surface contact DB. The worlds are headless,
+ * i.e., they have no contact smoke generator and no renderers.
+ * The worlds are stepped in parallel.
+ */
+class PhysicsEngineBatch {
+    PhysicsEngineBatch(const PhysicsEngineBatch&) = delete;
+    PhysicsEngineBatch& operator = (const PhysicsEngineBatch&) = delete;
+public:
+    PhysicsEngineBatch(
+        const PhysicsEngineConfig& cfg,
+        const PhysicsEngine& static_engine,
+        const SurfaceContactDb& surface_contact_db,
+        size_t nworlds);
+    ~PhysicsEngineBatch();
+    size_t size() const;
+    PhysicsEngine& operator [] (size_t i);
+    const PhysicsEngine& operator [] (size_t i) const;
+    //! Equivalent of "PhysicsIteration::operator()", without scene and beacons.
+    void step(
+        const StaticWorld& world,
+        std::chrono::steady_clock::time_point time);
+    void burn_in(
+        const StaticWorld& world,
+        float duration);
+private:
+    template <class TOperation>
+    void parallel_for_each_world(const TOperation& op);
+    PhysicsEngineConfig cfg_;
+    std::vector<std::unique_ptr<SurfaceContactDb>> surface_contact_dbs_;
+    std::vector<std::unique_ptr<PhysicsEngine>> worlds_;
+};
+
+}
@@ -57,6 +57,10 @@ struct PhysicsEngineConfig {
     size_t nsubsteps = 20;
     bool enable_ridge_map = false;  // disabled to save memory, the swept sphere volume is used instead.
 
+    // Continuous collision
+    bool continuous_collision = false;
+    ScenePos ccd_max_radius = 0.5f * meters;
+
     // Grind
     float max_grind_cos = 0.5;
     size_t nframes_straight_grind = 30;
@@ -14,13 +14,14 @@ static GameLogicConfig cfg;
 GameLogic::GameLogic(
     Scene& scene,
     AdvanceTimes& advance_times,
+    const CollisionQuery& collision_query,
     VehicleSpawners& vehicle_spawners,
     Players& players,
     SupplyDepots& supply_depots,
     DeleteNodeMutex& delete_node_mutex,
     std::function<void()> setup_new_round)
     : spawn{ vehicle_spawners, players, cfg, delete_node_mutex, scene }
-    , bystanders{ vehicle_spawners, players, scene, spawn, cfg }
+    , bystanders{ vehicle_spawners, players, scene, spawn, collision_query, cfg }
     , team_deathmatch{ vehicle_spawners, players, spawn, std::move(setup_new_round) }
     , vehicle_changer_{ vehicle_spawners, delete_node_mutex }
     , vehicle_spawners_{ vehicle_spawners }
@@ -38,6 +39,7 @@ void GameLogic::advance_time(float dt, const StaticWorld& world) {
     // TimeGuard tg{"GameLogic::advance_time"};
     spawn.nspawns_ = 0;
     spawn.ndelete_ = 0;
+    players_.update_spatial_hash();
     vehicle_spawners_.advance_time(dt);
     team_deathmatch.handle_respawn();
     bystanders.handle_bystanders();
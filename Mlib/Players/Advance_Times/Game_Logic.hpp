@@ -19,6 +19,7 @@ enum class Focus;
 class Scene;
 class SceneNode;
 class AdvanceTimes;
+class CollisionQuery;
 class DeleteNodeMutex;
 
 class GameLogic: public IAdvanceTime, public virtual DanglingBaseClass {
@@ -26,6 +27,7 @@ public:
     GameLogic(
         Scene& scene,
         AdvanceTimes& advance_times,
+        const CollisionQuery& collision_query,
         VehicleSpawners& vehicle_spawners,
         Players& players,
         SupplyDepots& supply_depots,
@@ -6,22 +6,28 @@
 #include <Mlib/Physics/Containers/Race_History.hpp>
 #include <Mlib/Physics/Containers/Race_Identifier.hpp>
 #include <Mlib/Physics/Score_Board_Configuration.hpp>
+#include <Mlib/Physics/Units.hpp>
 #include <Mlib/Players/Advance_Times/Player.hpp>
 #include <Mlib/Players/Team/Team.hpp>
+#include <Mlib/Scene_Graph/Elements/Scene_Node.hpp>
 #include <Mlib/Throw_Or_Abort.hpp>
 #include <Mlib/Time/Format.hpp>
+#include <cmath>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
 using namespace Mlib;
 
+static const ScenePos SPATIAL_HASH_CELL_SIZE = 50 * meters;
+
 Players::Players(
     size_t max_tracks,
     bool save_playback,
     const SceneNodeResources& scene_node_resources,
     const RaceIdentifier& race_identifier)
-    : race_history_{std::make_unique<RaceHistory>(
+    : spatial_hash_{ SPATIAL_HASH_CELL_SIZE }
+    , race_history_{std::make_unique<RaceHistory>(
         max_tracks,
         save_playback,
         scene_node_resources,
@@ -62,6 +68,7 @@ void Players::remove_player(const std::string& name) {
     if (players_.erase(name) != 1) {
         verbose_abort("Could not remove player \"" + name + '"');
     }
+    spatial_hash_.clear();
 }
 
 DanglingBaseClassRef<Player> Players::get_player(const std::string& name, SourceLocation loc) {
@@ -237,3 +244,24 @@ std::ostream& Mlib::operator << (std::ostream& ostr, const Players& players) {
     }
     return ostr;
 }
+
+void Players::update_spatial_hash() {
+    spatial_hash_.clear();
+    for (const auto& [_, p] : players_) {
+        if (!p->has_scene_vehicle()) {
+            continue;
+        }
+        auto position = p->scene_node()->position();
+        spatial_hash_.insert(position, p.get());
+    }
+}
+
+bool Players::visit_players_in_radius(
+    const FixedArray<ScenePos, 3>& center,
+    ScenePos radius,
+    const std::function<bool(const Player& player, const FixedArray<ScenePos, 3>& position)>& visitor) const
+{
+    return spatial_hash_.visit(center, radius, [&](const Player* player, const FixedArray<ScenePos, 3>& position){
+        return visitor(*player, position);
+    });
+}
@@ -1,9 +1,11 @@
 #pragma once
 #include <Mlib/Array/Array_Forward.hpp>
 #include <Mlib/Default_Uninitialized_Vector.hpp>
+#include <Mlib/Geometry/Intersection/Spatial_Hash.hpp>
 #include <Mlib/Geometry/Mesh/Point_And_Flags.hpp>
 #include <Mlib/Scene_Precision.hpp>
 #include <Mlib/Source_Location.hpp>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -69,7 +71,15 @@ public:
     std::map<std::string, DestructionFunctionsTokensObject<Team>>& teams();
     const std::map<std::string, DestructionFunctionsTokensObject<Team>>& teams() const;
     size_t nactive() const;
+    // Uniform grid of the positions of players with a vehicle,
+    // updated once per physics iteration.
+    void update_spatial_hash();
+    bool visit_players_in_radius(
+        const FixedArray<ScenePos, 3>& center,
+        ScenePos radius,
+        const std::function<bool(const Player& player, const FixedArray<ScenePos, 3>& position)>& visitor) const;
 private:
+    SpatialHash<ScenePos, const Player*> spatial_hash_;
     std::map<std::string, DestructionFunctionsTokensObject<Player>> players_;
     std::map<std::string, DestructionFunctionsTokensObject<Team>> teams_;
     std::unique_ptr<RaceHistory> race_history_;
@@ -23,6 +23,7 @@ Bystanders::Bystanders(
     Players& players,
     Scene& scene,
     Spawn& spawn,
+    const CollisionQuery& collision_query,
     GameLogicConfig& cfg)
 : current_bystander_rng_{ 0 },
   current_bvh_rng_{ 0 },
@@ -32,7 +33,8 @@ Bystanders::Bystanders(
   players_{ players },
   scene_{ scene },
   spawn_{ spawn },
-  cfg_{ cfg }
+  cfg_{ cfg },
+  visibility_queries_{ collision_query, funpack(cfg.visibility_cell_size), cfg.visibility_max_age }
 {}
 
 Bystanders::~Bystanders()
@@ -50,6 +52,7 @@ bool Bystanders::spawn_for_vip(
         THROW_OR_ABORT("Spawner already has a vehicle");
     }
     bool success = false;
+    const auto& vip_rb = vip_->rigid_body();
     spawn_.spawn_points_bvh_split_.at(current_bvh_)->visit(
         AxisAlignedBoundingBox<CompressedScenePos, 3>::from_center_and_radius(
             vip_pos.casted<CompressedScenePos>(),
@@ -72,50 +75,52 @@ bool Bystanders::spawn_for_vip(
             return true;
         }
         // Abort if another car is nearby.
+        if (!players_.visit_players_in_radius(
+            funpack(sp->position),
+            funpack(cfg_.r_neighbors),
+            [](const Player&, const FixedArray<ScenePos, 3>&){ return false; }))
         {
-            bool exists = false;
-            for (const auto& [_, player2] : players_.players()) {
-                if (player2->has_scene_vehicle()) {
-                    if (sum(squared(funpack(sp->position) - player2->scene_node()->position())) < squared(cfg_.r_neighbors)) {
-                        exists = true;
-                        break;
-                    }
-                }
-            }
-            if (exists) {
-                return true;
-            }
+            return true;
         }
-        bool spotted = vip_->can_see(
+        // The visibility is evaluated in a later frame,
+        // abort if it is not yet known.
+        auto spotted = visibility_queries_.can_see(
+            vip_rb,
             funpack(sp->position),
             cfg_.only_terrain,
             funpack(cfg_.can_see_y_offset));
         if (dist2 < squared(cfg_.r_spawn_near)) {
             // The spawn point is near the VIP.
-
+            auto spotted_later = visibility_queries_.can_see(
+                vip_rb,
+                funpack(sp->position),
+                cfg_.only_terrain,
+                funpack(cfg_.can_see_y_offset),
+                cfg_.visible_after_spawn_time);
+            if (!spotted.has_value() || !spotted_later.has_value()) {
+                return true;
+            }
             // Abort if visible.
-            if (spotted) {
+            if (*spotted) {
                 return true;
             }
             // Abort if not visible after x seconds.
-            if (!vip_->can_see(
-                funpack(sp->position),
-                cfg_.only_terrain,
-                funpack(cfg_.can_see_y_offset),
-                cfg_.visible_after_spawn_time))
-            {
+            if (!*spotted_later) {
                 return true;
             }
         } else {
             // The spawn point is far away from the VIP.
+            if (!spotted.has_value()) {
+                return true;
+            }
 
             // Abort if not visible.
-            if (!spotted) {
+            if (!*spotted) {
                 return true;
             }
         }
         spawn_.spawn_at_spawn_point(spawner, *sp);
-        if (spotted) {
+        if (*spotted) {
             spawner.set_spotted_by_vip();
         }
         success = true;
@@ -135,6 +140,7 @@ bool Bystanders::delete_for_vip(
         THROW_OR_ABORT("Spawner has no scene vehicle");
     }
     size_t ndelete_votes = 0;
+    const auto& vip_rb = vip_->rigid_body();
     for (const auto& vehicle : spawner.get_scene_vehicles()) {
         FixedArray<ScenePos, 3> player_pos = vehicle->scene_node()->position();
         ScenePos dist2 = sum(squared(player_pos - vip_pos));
@@ -146,11 +152,16 @@ bool Bystanders::delete_for_vip(
             }
         }
         if (dist2 > squared(cfg_.r_delete_far)) {
-            if (!vip_->can_see(
-                *vehicle,
+            auto spotted = visibility_queries_.can_see(
+                vip_rb,
+                vehicle->rb(),
                 cfg_.only_terrain,
-                funpack(cfg_.can_see_y_offset)))
-            {
+                funpack(cfg_.can_see_y_offset));
+            if (!spotted.has_value()) {
+                // Not yet known, keep the vehicle for now.
+                continue;
+            }
+            if (!*spotted) {
                 ++ndelete_votes;
                 continue;
             } else {
@@ -158,11 +169,16 @@ bool Bystanders::delete_for_vip(
             }
         }
         if (!spawner.get_spotted_by_vip() && (spawner.get_time_since_spawn() > cfg_.visible_after_delete_time)) {
-            if (!vip_->can_see(
-                *vehicle,
+            auto spotted = visibility_queries_.can_see(
+                vip_rb,
+                vehicle->rb(),
                 cfg_.only_terrain,
-                funpack(cfg_.can_see_y_offset)))
-            {
+                funpack(cfg_.can_see_y_offset));
+            if (!spotted.has_value()) {
+                // Not yet known, keep the vehicle for now.
+                continue;
+            }
+            if (!*spotted) {
                 ++ndelete_votes;
                 continue;
             } else {
@@ -185,9 +201,12 @@ bool Bystanders::delete_for_vip(
 
 void Bystanders::set_vip(const DanglingBaseClassPtr<Player>& vip) {
     vip_ = vip;
+    visibility_queries_.clear();
 }
 
 void Bystanders::handle_bystanders() {
+    // Trace the rays enqueued in the previous frame.
+    visibility_queries_.execute();
     if (vip_ == nullptr) {
         return;
     }
@@ -1,5 +1,6 @@
 #pragma once
 #include <Mlib/Memory/Dangling_Base_Class.hpp>
+#include <Mlib/Physics/Containers/Visibility_Queries.hpp>
 #include <Mlib/Scene_Precision.hpp>
 #include <random>
 
@@ -12,9 +13,8 @@ class Player;
 class GameLogic;
 class Scene;
 class Spawn;
+class CollisionQuery;
 struct GameLogicConfig;
-template <typename TData, size_t... tshape>
-class FixedArray;
 
 class Bystanders {
     friend GameLogic;
@@ -24,6 +24,7 @@ public:
         Players& players,
         Scene& scene,
         Spawn& spawn,
+        const CollisionQuery& collision_query,
         GameLogicConfig& cfg);
     ~Bystanders();
     void set_vip(const DanglingBaseClassPtr<Player>& vip);
@@ -46,6 +47,7 @@ private:
     Scene& scene_;
     Spawn& spawn_;
     GameLogicConfig& cfg_;
+    VisibilityQueries visibility_queries_;
 };
 
 }
@@ -14,6 +14,8 @@ struct GameLogicConfig {
     CompressedScenePos spawn_y_offset = (CompressedScenePos)(0.7f * meters);
     bool only_terrain = true;
     CompressedScenePos can_see_y_offset = (CompressedScenePos)(2 * meters);
+    CompressedScenePos visibility_cell_size = (CompressedScenePos)(5 * meters);
+    size_t visibility_max_age = 30;
     size_t spawn_points_nsubdivisions = 5 * 60;
     CompressedScenePos r_occupied_spawn_point = (CompressedScenePos)(5 * meters);
 };
@@ -27,22 +27,33 @@ static void iterate_replacements(
     }
 }
 
-std::string Mlib::substitute_dollar(const std::string_view& str, const std::function<std::string(std::string_view)>& replacements) {
+void Mlib::split_dollar(
+    const std::string_view& str,
+    const std::function<void(std::string_view)>& literal,
+    const std::function<void(std::string_view)>& variable)
+{
     using namespace TemplateRegex;
-    std::string new_line;
     // "(?:\\$(\\$[$\\w/]+|\\w+)-?|([^$]+))");
     auto ddw = seq(chr('$'), plus(par(chr('$'), word, chr('/')))); // \\$[$\\w/]+
     auto left = seq(group(par(ddw, plus(word))), opt(chr('-')));
     auto nd = CharPredicate{[](char c){ return (c != '$'); }};
     auto right = group(plus(nd));
     static const auto s0 = par(seq(chr('$'), left), right);
-    find_all_templated(str, s0, [&new_line, &replacements](const TemplateRegex::SMatch<3>& v) {
+    find_all_templated(str, s0, [&literal, &variable](const TemplateRegex::SMatch<3>& v) {
         if (v[1].matched) {
-            new_line += replacements(v[1].str());
+            variable(v[1].str());
         } else {
-            new_line += v[2].str();
+            literal(v[2].str());
         }
     });
+}
+
+std::string Mlib::substitute_dollar(const std::string_view& str, const std::function<std::string(std::string_view)>& replacements) {
+    std::string new_line;
+    split_dollar(
+        str,
+        [&new_line](std::string_view s) { new_line += s; },
+        [&new_line, &replacements](std::string_view s) { new_line += replacements(s); });
     return new_line;
 }
 
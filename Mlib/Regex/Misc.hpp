@@ -17,6 +17,11 @@ std::string substitute(
     const std::string& str,
     const std::map<std::string, std::string>& replacements);
 
+void split_dollar(
+    const std::string_view& str,
+    const std::function<void(std::string_view)>& literal,
+    const std::function<void(std::string_view)>& variable);
+
 std::string substitute_dollar(
     const std::string_view& str,
     const std::function<std::string(std::string_view)>& replacements);
@@ -0,0 +1,128 @@
+#include "Aggregate_Cells.hpp"
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
+#include <Mlib/Math/Fixed_Math.hpp>
+#include <Mlib/Render/Yield.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+using namespace Mlib;
+
+AggregateCells::AggregateCells(ScenePos cell_size)
+    : cell_size_{ cell_size }
+    , next_partition_id_{ 0 }
+    , npartitioned_{ 0 }
+{
+    if (!(cell_size > 0)) {
+        THROW_OR_ABORT("Aggregate cell size must be positive");
+    }
+}
+
+AggregateCells::~AggregateCells() = default;
+
+FixedArray<ScenePos, 3> AggregateCells::cell_center(const CellIndex& index) const {
+    return (index.casted<ScenePos>() + (ScenePos)0.5) * cell_size_;
+}
+
+std::unique_ptr<AggregateCells::ArrayPartition> AggregateCells::partition(
+    const LargeAggregate& aggregate)
+{
+    const auto& array = *aggregate.array;
+    if (array.triangles.size() > UINT32_MAX) {
+        THROW_OR_ABORT("Too many triangles in aggregate array \"" + array.name + '"');
+    }
+    auto result = std::make_unique<ArrayPartition>(ArrayPartition{
+        .id = next_partition_id_++,
+        .aggregate = aggregate,
+        .cells = {} });
+    for (size_t i = 0; i < array.triangles.size(); ++i) {
+        if (i % THREAD_YIELD_INTERVAL == 0) {
+            std::this_thread::yield();
+        }
+        const auto& c = array.triangles[i];
+        auto center = (
+            c(0).position.casted<ScenePos>() +
+            c(1).position.casted<ScenePos>() +
+            c(2).position.casted<ScenePos>()) / (ScenePos)3;
+        auto index = CellIndex{ (aggregate.m.transform(center) / cell_size_).applied<int>(
+            [](ScenePos v){ return (int)std::floor(v); }) };
+        result->cells[index].push_back((uint32_t)i);
+    }
+    ++npartitioned_;
+    return result;
+}
+
+AggregateCells::Contents AggregateCells::update(
+    const FixedArray<ScenePos, 3>& offset,
+    const std::list<LargeAggregate>& aggregates,
+    bool cull)
+{
+    npartitioned_ = 0;
+    ScenePos cell_radius = cell_size_ * std::sqrt((ScenePos)3) / 2;
+    Contents result;
+    for (const auto& a : aggregates) {
+        const ArrayPartition* p = nullptr;
+        auto [begin, end] = partitions_.equal_range(a.array.get());
+        for (auto it = begin; it != end; ++it) {
+            const auto& m = it->second->aggregate.m;
+            if (all(m.R == a.m.R) && all(m.t == a.m.t)) {
+                p = it->second.get();
+                break;
+            }
+        }
+        if (p == nullptr) {
+            p = partitions_.emplace(a.array.get(), partition(a))->second.get();
+        }
+        bool cull_array = cull && (a.array->morphology.max_triangle_distance != INFINITY);
+        for (const auto& [index, triangles] : p->cells) {
+            if (cull_array &&
+                (sum(squared(cell_center(index) - offset)) >
+                 squared(a.array->morphology.max_triangle_distance + cell_radius)))
+            {
+                continue;
+            }
+            auto& content = result[index];
+            content.sources.push_back(p->id);
+            content.triangles.push_back({ &p->aggregate, &triangles });
+        }
+    }
+    // Sort the sources, so that the content of a cell does not
+    // depend on the order of the arrays.
+    for (auto& [_, content] : result) {
+        std::vector<size_t> order(content.sources.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j){
+            return content.sources[i] < content.sources[j];
+        });
+        CellContent sorted;
+        sorted.sources.reserve(order.size());
+        sorted.triangles.reserve(order.size());
+        for (size_t i : order) {
+            sorted.sources.push_back(content.sources[i]);
+            sorted.triangles.push_back(content.triangles[i]);
+        }
+        content = std::move(sorted);
+    }
+    // Evict the partitions of arrays that were deleted from the scene,
+    // i.e. that are only referenced by their partition.
+    std::erase_if(partitions_, [](const auto& e){
+        return e.second->aggregate.array.use_count() == 1;
+    });
+    return result;
+}
+
+void AggregateCells::clear() {
+    partitions_.clear();
+}
+
+size_t AggregateCells::npartitioned() const {
+    return npartitioned_;
+}
+
+size_t AggregateCells::npartitions() const {
+    return partitions_.size();
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Geometry/Material.hpp>
+#include <Mlib/Math/Orderable_Fixed_Array.hpp>
+#include <Mlib/Scene_Graph/Batch_Renderers/Large_Aggregate.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Mlib {
+
+template <class TPos>
+class ColoredVertexArray;
+
+/**
+ * Partitions the triangles of the arrays of static nodes into
+ * cubic cells of size "cell_size".
+ *
+ * The arrays are identified by their address and their model matrix.
+ * Each array is partitioned when it is first seen, later updates
+ * only look it up, i.e. an update does not touch the triangles.
+ * The arrays are assumed to be immutable, "clear" must be called
+ * if they are modified in place.
+ * Every partition gets a unique ID, and the content of a cell is
+ * identified by the sorted IDs of the partitions contributing to it.
+ */
+class AggregateCells {
+    AggregateCells(const AggregateCells&) = delete;
+    AggregateCells& operator = (const AggregateCells&) = delete;
+public:
+    using CellIndex = OrderableFixedArray<int, 3>;
+    struct TriangleIndices {
+        const LargeAggregate* aggregate;
+        const std::vector<uint32_t>* triangles;
+    };
+    struct CellContent {
+        std::vector<uint64_t> sources;
+        std::vector<TriangleIndices> triangles;
+    };
+    using Contents = std::map<CellIndex, CellContent>;
+
+    explicit AggregateCells(ScenePos cell_size);
+    ~AggregateCells();
+    FixedArray<ScenePos, 3> cell_center(const CellIndex& index) const;
+    // Returns the content of all cells not culled by the
+    // "max_triangle_distance" of the arrays.
+    // The triangle indices are valid until the next call.
+    // Not thread-safe.
+    Contents update(
+        const FixedArray<ScenePos, 3>& offset,
+        const std::list<LargeAggregate>& aggregates,
+        bool cull);
+    // Removes all partitions.
+    void clear();
+    // Number of arrays that were partitioned by the last update,
+    // i.e. that were not found in the cache.
+    size_t npartitioned() const;
+    // Number of cached partitions.
+    size_t npartitions() const;
+
+private:
+    struct ArrayPartition {
+        uint64_t id;
+        LargeAggregate aggregate;
+        std::map<CellIndex, std::vector<uint32_t>> cells;
+    };
+    using Partitions = std::unordered_multimap<
+        const ColoredVertexArray<CompressedScenePos>*,
+        std::unique_ptr<ArrayPartition>>;
+    std::unique_ptr<ArrayPartition> partition(const LargeAggregate& aggregate);
+    ScenePos cell_size_;
+    Partitions partitions_;
+    uint64_t next_partition_id_;
+    size_t npartitioned_;
+};
+
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Intersection/Bounding_Sphere.hpp>
+#include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
+#include <Mlib/Math/Fixed_Math.hpp>
+#include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
+#include <Mlib/Render/Yield.hpp>
+#include <Mlib/Scene_Graph/Render_Pass_Extended.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace Mlib {
+
+enum class TextureLayerType {
+    NONE,
+    CONTINUOUS,
+    DISCRETE
+};
+
+template <TextureLayerType ttexture_layer_type>
+struct AggregateTriangle;
+
+template <>
+struct AggregateTriangle<TextureLayerType::NONE> {
+    FixedArray<ColoredVertex<float>, 3> triangle;
+    float distance_to_origin2;
+};
+
+template <>
+struct AggregateTriangle<TextureLayerType::CONTINUOUS> {
+    FixedArray<ColoredVertex<float>, 3> triangle;
+    FixedArray<float, 3> continuous_layer;
+    float distance_to_origin2;
+};
+
+template <>
+struct AggregateTriangle<TextureLayerType::DISCRETE> {
+    FixedArray<ColoredVertex<float>, 3> triangle;
+    FixedArray<uint8_t, 3> discrete_layer;
+    float distance_to_origin2;
+};
+
+class IAggregateTriangles {
+public:
+    virtual ~IAggregateTriangles() = default;
+    virtual void append(
+        const ColoredVertexArray<float>& a,
+        std::minstd_rand& rng,
+        const ExternalRenderPass& external_render_pass) = 0;
+    // Appends triangle "i" of "a", transformed by "m".
+    // "r" is the rotation of "m", without scale.
+    virtual void append_triangle(
+        const ColoredVertexArray<CompressedScenePos>& a,
+        size_t i,
+        const TransformationMatrix<float, ScenePos, 3>& m,
+        const FixedArray<float, 3, 3>& r) = 0;
+    virtual void build(
+        UUVector<FixedArray<ColoredVertex<float>, 3>>& triangles,
+        UUVector<FixedArray<float, 3>>& continuous_triangle_texture_layers,
+        UUVector<FixedArray<uint8_t, 3>>& discrete_triangle_texture_layers) = 0;
+    virtual void sort() = 0;
+    virtual bool empty() const = 0;
+};
+
+template <TextureLayerType ttexture_layer_type>
+struct AggregateTriangles: public IAggregateTriangles {
+public:
+    template <class TPos>
+    static void check(const ColoredVertexArray<TPos>& a) {
+        if (a.triangles.empty()) {
+            THROW_OR_ABORT("Detected empty triangles in array \"" + a.name + '"');
+        }
+        if constexpr (ttexture_layer_type == TextureLayerType::NONE) {
+            if (!a.continuous_triangle_texture_layers.empty()) {
+                THROW_OR_ABORT("Unexpected continuous texture layers in array \"" + a.name + '"');
+            }
+            if (!a.discrete_triangle_texture_layers.empty()) {
+                THROW_OR_ABORT("Unexpected discrete texture layers in array \"" + a.name + '"');
+            }
+        }
+        if constexpr (ttexture_layer_type == TextureLayerType::CONTINUOUS) {
+            if (a.continuous_triangle_texture_layers.size() != a.triangles.size()) {
+                THROW_OR_ABORT("Conflicting number of continuous texture layers in array \"" + a.name + '"');
+            }
+            if (!a.discrete_triangle_texture_layers.empty()) {
+                THROW_OR_ABORT("Unexpected discrete texture layers in array \"" + a.name + '"');
+            }
+        }
+        if constexpr (ttexture_layer_type == TextureLayerType::DISCRETE) {
+            if (!a.continuous_triangle_texture_layers.empty()) {
+                THROW_OR_ABORT("Unexpected continuous texture layers in array \"" + a.name + '"');
+            }
+            if (a.discrete_triangle_texture_layers.size() != a.triangles.size()) {
+                THROW_OR_ABORT("Conflicting number of texture layers in array \"" + a.name + '"');
+            }
+        }
+    }
+    virtual void append(
+        const ColoredVertexArray<float>& a,
+        std::minstd_rand& rng,
+        const ExternalRenderPass& external_render_pass) override
+    {
+        check(a);
+        auto camera_sphere = BoundingSphere<float, 3>{ fixed_zeros<float, 3>(), a.morphology.max_triangle_distance };
+        for (size_t i = 0; i < a.triangles.size(); ++i) {
+            if (i % THREAD_YIELD_INTERVAL == 0) {
+                std::this_thread::yield();
+            }
+            const auto& c = a.triangles[i];
+            // auto triangle_sphere = welzl_from_fixed(FixedArray<FixedArray<float, 3>, 3>{ c(0).position, c(1).position, c(2).position }, rng);
+            auto triangle_sphere = BoundingSphere<float, 3>{ FixedArray<float, 3, 3>{ c(0).position, c(1).position, c(2).position } };
+            if (!any(external_render_pass.pass & ExternalRenderPassType::IS_GLOBAL_MASK) &&
+                (a.morphology.max_triangle_distance != INFINITY) &&
+                !camera_sphere.intersects(triangle_sphere))
+            {
+                continue;
+            }
+            push_back(a, i, c, sum(squared(triangle_sphere.center)));
+        }
+    }
+    virtual void append_triangle(
+        const ColoredVertexArray<CompressedScenePos>& a,
+        size_t i,
+        const TransformationMatrix<float, ScenePos, 3>& m,
+        const FixedArray<float, 3, 3>& r) override
+    {
+        check(a);
+        const auto& c = a.triangles[i];
+        FixedArray<ColoredVertex<float>, 3> transformed{
+            c(0).template casted<ScenePos>().transformed(m, r).template casted<float>(),
+            c(1).template casted<ScenePos>().transformed(m, r).template casted<float>(),
+            c(2).template casted<ScenePos>().transformed(m, r).template casted<float>()};
+        auto center = (transformed(0).position + transformed(1).position + transformed(2).position) / 3.f;
+        push_back(a, i, transformed, sum(squared(center)));
+    }
+    virtual void build(
+        UUVector<FixedArray<ColoredVertex<float>, 3>>& triangles,
+        UUVector<FixedArray<float, 3>>& continuous_triangle_texture_layers,
+        UUVector<FixedArray<uint8_t, 3>>& discrete_triangle_texture_layers) override
+    {
+        assert_true(triangles.empty());
+        assert_true(continuous_triangle_texture_layers.empty());
+        assert_true(discrete_triangle_texture_layers.empty());
+        triangles.reserve(atriangles_.size());
+        if constexpr (ttexture_layer_type == TextureLayerType::CONTINUOUS) {
+            continuous_triangle_texture_layers.reserve(atriangles_.size());
+        }
+        if constexpr (ttexture_layer_type == TextureLayerType::DISCRETE) {
+            discrete_triangle_texture_layers.reserve(atriangles_.size());
+        }
+        for (const auto& a : atriangles_) {
+            triangles.push_back(a.triangle);
+            if constexpr (ttexture_layer_type == TextureLayerType::CONTINUOUS) {
+                continuous_triangle_texture_layers.push_back(a.continuous_layer);
+            }
+            if constexpr (ttexture_layer_type == TextureLayerType::DISCRETE) {
+                discrete_triangle_texture_layers.push_back(a.discrete_layer);
+            }
+        }
+    }
+    virtual void sort() override {
+        atriangles_.sort([](
+            const AggregateTriangle<ttexture_layer_type>& a,
+            const AggregateTriangle<ttexture_layer_type>& b)
+            {
+                return a.distance_to_origin2 > b.distance_to_origin2;
+            });
+    }
+    virtual bool empty() const override {
+        return atriangles_.empty();
+    }
+private:
+    template <class TPos>
+    void push_back(
+        const ColoredVertexArray<TPos>& a,
+        size_t i,
+        const FixedArray<ColoredVertex<float>, 3>& c,
+        float distance_to_origin2)
+    {
+        if constexpr (ttexture_layer_type == TextureLayerType::NONE) {
+            atriangles_.push_back({ c, distance_to_origin2 });
+        }
+        if constexpr (ttexture_layer_type == TextureLayerType::CONTINUOUS) {
+            atriangles_.push_back({ c, a.continuous_triangle_texture_layers[i], distance_to_origin2 });
+        }
+        if constexpr (ttexture_layer_type == TextureLayerType::DISCRETE) {
+            atriangles_.push_back({ c, a.discrete_triangle_texture_layers[i], distance_to_origin2 });
+        }
+    }
+    std::list<AggregateTriangle<ttexture_layer_type>> atriangles_;
+};
+
+template <class TPos>
+std::unique_ptr<IAggregateTriangles> construct_aggregate_triangles(
+    const ColoredVertexArray<TPos>& a)
+{
+    std::unique_ptr<IAggregateTriangles> result;
+    if (!a.continuous_triangle_texture_layers.empty() &&
+        !a.discrete_triangle_texture_layers.empty())
+    {
+        THROW_OR_ABORT("Detected continuous and discrete texture layers");
+    }
+    if (!a.continuous_triangle_texture_layers.empty()) {
+        result = std::make_unique<AggregateTriangles<TextureLayerType::CONTINUOUS>>();
+    } else if (!a.discrete_triangle_texture_layers.empty()) {
+        result = std::make_unique<AggregateTriangles<TextureLayerType::DISCRETE>>();
+    } else {
+        result = std::make_unique<AggregateTriangles<TextureLayerType::NONE>>();
+    }
+    return result;
+}
+
+inline std::unique_ptr<IAggregateTriangles> construct_aggregate_triangles(
+    const ColoredVertexArray<float>& a,
+    std::minstd_rand& rng,
+    const ExternalRenderPass& external_render_pass)
+{
+    auto result = construct_aggregate_triangles(a);
+    result->append(a, rng, external_render_pass);
+    return result;
+}
+
+}
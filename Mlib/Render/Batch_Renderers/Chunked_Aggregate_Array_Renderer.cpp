@@ -0,0 +1,240 @@
+#include "Chunked_Aggregate_Array_Renderer.hpp"
+#include <Mlib/Geometry/Material.hpp>
+#include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
+#include <Mlib/Geometry/Physics_Material.hpp>
+#include <Mlib/Math/Fixed_Math.hpp>
+#include <Mlib/Render/Batch_Renderers/Aggregate_Triangles.hpp>
+#include <Mlib/Render/Batch_Renderers/Optional_Material_Hider.hpp>
+#include <Mlib/Render/Batch_Renderers/Optional_Mesh_Hider.hpp>
+#include <Mlib/Render/Batch_Renderers/Special_Renderable_Names.hpp>
+#include <Mlib/Render/Renderables/Renderable_Colored_Vertex_Array.hpp>
+#include <Mlib/Render/Resources/Colored_Vertex_Array_Resource.hpp>
+#include <Mlib/Scene_Graph/Batch_Renderers/Task_Location.hpp>
+#include <Mlib/Scene_Graph/Elements/Color_Style.hpp>
+#include <Mlib/Scene_Graph/Render_Pass_Extended.hpp>
+#include <Mlib/Scene_Graph/Resources/Renderable_Resource_Filter.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace Mlib;
+
+ChunkedAggregateArrayRenderer::ChunkedAggregateArrayRenderer(
+    RenderingResources& rendering_resources,
+    ScenePos cell_size)
+    : rendering_resources_{ rendering_resources }
+    , aggregate_cells_{ cell_size }
+    , offset_((ScenePos)NAN)
+    , next_offset_{ uninitialized }
+    , is_initialized_{ false }
+{}
+
+ChunkedAggregateArrayRenderer::~ChunkedAggregateArrayRenderer() = default;
+
+void ChunkedAggregateArrayRenderer::update_aggregates(
+    const FixedArray<ScenePos, 3>& offset,
+    const std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue,
+    const ExternalRenderPass& external_render_pass,
+    TaskLocation task_location)
+{
+    THROW_OR_ABORT("ChunkedAggregateArrayRenderer only supports large aggregates");
+}
+
+void ChunkedAggregateArrayRenderer::update_large_aggregates(
+    const FixedArray<ScenePos, 3>& offset,
+    const std::list<LargeAggregate>& aggregates,
+    const ExternalRenderPass& external_render_pass,
+    TaskLocation task_location)
+{
+    // The cell partition is not thread-safe.
+    std::scoped_lock update_lock{ update_mutex_ };
+    Cells old_cells;
+    {
+        std::scoped_lock lock_guard{ mutex_ };
+        if (next_cells_.has_value()) {
+            return;
+        }
+        old_cells = cells_;
+    }
+    OptionalMaterialHider mhd;
+    OptionalMeshHider nhd;
+    bool is_global = any(external_render_pass.pass & ExternalRenderPassType::IS_GLOBAL_MASK);
+    std::list<LargeAggregate> visible_aggregates;
+    for (const auto& a : aggregates) {
+        if (a.array->triangles.empty()) {
+            THROW_OR_ABORT("Aggregate triangle list is empty: \"" + a.array->name + '"');
+        }
+        if (nhd.is_hidden(a.array->name) || mhd.is_hidden(a.array->material)) {
+            continue;
+        }
+        visible_aggregates.push_back(a);
+    }
+    auto contents = aggregate_cells_.update(offset, visible_aggregates, !is_global);
+    Cells new_cells;
+    std::list<std::shared_ptr<ColoredVertexArrayResource>> new_rcvas;
+    bool changed = (contents.size() != old_cells.size());
+    for (const auto& [index, content] : contents) {
+        auto it = old_cells.find(index);
+        if ((it != old_cells.end()) && (it->second.sources == content.sources)) {
+            new_cells.try_emplace(index, it->second);
+            continue;
+        }
+        changed = true;
+        auto center = aggregate_cells_.cell_center(index);
+        std::map<Material, std::unique_ptr<IAggregateTriangles>> mat_lists;
+        for (const auto& t : content.triangles) {
+            const auto& array = *t.aggregate->array;
+            auto mat = array.material;
+            mat.aggregate_mode = AggregateMode::NONE;
+            auto lit = mat_lists.find(mat);
+            if (lit == mat_lists.end()) {
+                lit = mat_lists.try_emplace(mat, construct_aggregate_triangles(array)).first;
+            }
+            // Vertices relative to the cell center.
+            const auto& m = t.aggregate->m;
+            TransformationMatrix<float, ScenePos, 3> mc{ m.R, m.t - center };
+            auto r = m.R / m.get_scale();
+            for (uint32_t i : *t.triangles) {
+                lit->second->append_triangle(array, i, mc, r);
+            }
+        }
+        std::list<std::shared_ptr<ColoredVertexArray<float>>> mat_vectors;
+        for (auto& [mat, list] : mat_lists) {
+            if (any(mat.blend_mode & BlendMode::ANY_CONTINUOUS)) {
+                list->sort();
+            }
+            UUVector<FixedArray<ColoredVertex<float>, 3>> tris;
+            UUVector<FixedArray<float, 3>> continuous_texture_layers;
+            UUVector<FixedArray<uint8_t, 3>> discrete_texture_layers;
+            list->build(tris, continuous_texture_layers, discrete_texture_layers);
+            mat_vectors.push_back(std::make_shared<ColoredVertexArray<float>>(
+                *AAR_NAME,
+                mat,
+                Morphology{ .physics_material = PhysicsMaterial::ATTR_VISIBLE },
+                ModifierBacklog{},
+                UUVector<FixedArray<ColoredVertex<float>, 4>>(),
+                std::move(tris),
+                UUVector<FixedArray<ColoredVertex<float>, 2>>(),
+                UUVector<FixedArray<std::vector<BoneWeight>, 3>>(),
+                std::move(continuous_texture_layers),
+                std::move(discrete_texture_layers),
+                std::vector<UUVector<FixedArray<float, 3, 2>>>(),
+                std::vector<UUVector<FixedArray<float, 3>>>(),
+                UUVector<FixedArray<float, 3>>()));
+        }
+        auto rcva = std::make_shared<ColoredVertexArrayResource>(
+            mat_vectors,
+            std::list<std::shared_ptr<ColoredVertexArray<CompressedScenePos>>>{});
+        auto rcvai = std::make_shared<RenderableColoredVertexArray>(rendering_resources_, rcva, RenderableResourceFilter{});
+        new_rcvas.push_back(rcva);
+        new_cells.try_emplace(index, Cell{
+            .center = center,
+            .sources = content.sources,
+            .rcva = std::move(rcva),
+            .rcvai = std::move(rcvai) });
+    }
+    if (task_location == TaskLocation::FOREGROUND) {
+        for (const auto& rcva : new_rcvas) {
+            rcva->wait();
+        }
+    }
+    {
+        std::scoped_lock lock_guard{ mutex_ };
+        if (next_cells_.has_value()) {
+            verbose_abort("ChunkedAggregateArrayRenderer::update_aggregates called in parallel");
+        }
+        if (changed || !is_initialized_) {
+            next_cells_ = std::move(new_cells);
+            next_offset_ = offset;
+        } else {
+            offset_ = offset;
+        }
+        is_initialized_ = true;
+    }
+}
+
+void ChunkedAggregateArrayRenderer::render_aggregates(
+    const FixedArray<ScenePos, 4, 4>& vp,
+    const TransformationMatrix<float, ScenePos, 3>& iv,
+    const std::list<std::pair<TransformationMatrix<float, ScenePos, 3>, std::shared_ptr<Light>>>& lights,
+    const std::list<std::pair<TransformationMatrix<float, ScenePos, 3>, std::shared_ptr<Skidmark>>>& skidmarks,
+    const SceneGraphConfig& scene_graph_config,
+    const RenderConfig& render_config,
+    const ExternalRenderPass& external_render_pass,
+    const std::list<const ColorStyle*>& color_styles) const
+{
+    std::vector<std::pair<ScenePos, const Cell*>> sorted_cells;
+    std::unique_lock lock_guard{ mutex_ };
+    if (!is_initialized_) {
+        return;
+    }
+    if (next_cells_.has_value() &&
+        std::none_of(next_cells_->begin(), next_cells_->end(), [](const auto& c){
+            return c.second.rcva->copy_in_progress(); }))
+    {
+        cells_ = std::move(*next_cells_);
+        next_cells_.reset();
+        offset_ = next_offset_;
+    }
+    if (cells_.empty()) {
+        return;
+    }
+    // Far cells first, for continuous blending.
+    sorted_cells.reserve(cells_.size());
+    for (const auto& [_, c] : cells_) {
+        sorted_cells.emplace_back(sum(squared(c.center - iv.t)), &c);
+    }
+    std::sort(sorted_cells.begin(), sorted_cells.end(), [](const auto& a, const auto& b){
+        return a.first > b.first;
+    });
+    std::vector<Cell> cells;
+    cells.reserve(sorted_cells.size());
+    for (const auto& [_, c] : sorted_cells) {
+        cells.push_back(*c);
+    }
+    lock_guard.unlock();
+    ColorStyle r_style;
+    for (const auto& style : color_styles) {
+        if (style->matches(AAR_NAME)) {
+            r_style.insert(*style);
+        }
+    }
+    for (const auto& c : cells) {
+        TransformationMatrix<float, ScenePos, 3> m{fixed_identity_array<float, 3>(), c.center};
+        c.rcvai->render(
+            dot2d(vp, m.affine()),
+            m,
+            iv,
+            nullptr,    // dynamic style
+            lights,
+            skidmarks,
+            scene_graph_config,
+            render_config,
+            { external_render_pass, InternalRenderPass::AGGREGATE },
+            nullptr,    // animation_state
+            &r_style);  // color_style
+    }
+}
+
+bool ChunkedAggregateArrayRenderer::is_initialized() const {
+    std::scoped_lock lock_guard{ mutex_ };
+    return is_initialized_;
+}
+
+void ChunkedAggregateArrayRenderer::invalidate() {
+    {
+        std::scoped_lock update_lock{ update_mutex_ };
+        aggregate_cells_.clear();
+    }
+    std::scoped_lock lock_guard{ mutex_ };
+    is_initialized_ = false;
+    cells_.clear();
+    next_cells_.reset();
+}
+
+FixedArray<ScenePos, 3> ChunkedAggregateArrayRenderer::offset() const {
+    std::scoped_lock lock_guard{ mutex_ };
+    if (!is_initialized_) {
+        THROW_OR_ABORT("ChunkedAggregateArrayRenderer not initialized, cannot return offset");
+    }
+    return offset_;
+}
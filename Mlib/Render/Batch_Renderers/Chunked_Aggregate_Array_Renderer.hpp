@@ -0,0 +1,85 @@
+#pragma once
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Render/Batch_Renderers/Aggregate_Cells.hpp>
+#include <Mlib/Scene_Graph/Batch_Renderers/IAggregate_Renderer.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <Mlib/Threads/Fast_Mutex.hpp>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Mlib {
+
+class RenderingResources;
+class RenderableColoredVertexArray;
+class ColoredVertexArrayResource;
+
+/**
+ * Aggregate renderer that partitions the triangles into cubic cells
+ * of size "cell_size", with one GPU buffer per cell.
+ *
+ * The vertices of a cell are stored relative to the cell center.
+ * Only large aggregates are supported, i.e. the arrays of static nodes
+ * in model coordinates. Each array is partitioned once (see "AggregateCells").
+ * An update only builds the cells that are new or whose content
+ * changed, the other cells are reused, and cells that received
+ * no triangles are dropped.
+ *
+ * In contrast to "AggregateArrayRenderer", "max_triangle_distance"
+ * is applied per cell, i.e. triangles are kept if their cell
+ * intersects the sphere around the offset.
+ */
+class ChunkedAggregateArrayRenderer: public IAggregateRenderer {
+    ChunkedAggregateArrayRenderer(const ChunkedAggregateArrayRenderer& other) = delete;
+    ChunkedAggregateArrayRenderer& operator = (const ChunkedAggregateArrayRenderer& other) = delete;
+
+public:
+    ChunkedAggregateArrayRenderer(
+        RenderingResources& rendering_resources,
+        ScenePos cell_size);
+    virtual ~ChunkedAggregateArrayRenderer() override;
+    virtual bool is_initialized() const override;
+    virtual void invalidate() override;
+    virtual void update_aggregates(
+        const FixedArray<ScenePos, 3>& offset,
+        const std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue,
+        const ExternalRenderPass& external_render_pass,
+        TaskLocation task_location) override;
+    virtual void update_large_aggregates(
+        const FixedArray<ScenePos, 3>& offset,
+        const std::list<LargeAggregate>& aggregates,
+        const ExternalRenderPass& external_render_pass,
+        TaskLocation task_location) override;
+    virtual void render_aggregates(
+        const FixedArray<ScenePos, 4, 4>& vp,
+        const TransformationMatrix<float, ScenePos, 3>& iv,
+        const std::list<std::pair<TransformationMatrix<float, ScenePos, 3>, std::shared_ptr<Light>>>& lights,
+        const std::list<std::pair<TransformationMatrix<float, ScenePos, 3>, std::shared_ptr<Skidmark>>>& skidmarks,
+        const SceneGraphConfig& scene_graph_config,
+        const RenderConfig& render_config,
+        const ExternalRenderPass& external_render_pass,
+        const std::list<const ColorStyle*>& color_styles) const override;
+    virtual FixedArray<ScenePos, 3> offset() const override;
+
+private:
+    using CellIndex = AggregateCells::CellIndex;
+    struct Cell {
+        FixedArray<ScenePos, 3> center;
+        std::vector<uint64_t> sources;
+        std::shared_ptr<ColoredVertexArrayResource> rcva;
+        std::shared_ptr<RenderableColoredVertexArray> rcvai;
+    };
+    using Cells = std::map<CellIndex, Cell>;
+    RenderingResources& rendering_resources_;
+    AggregateCells aggregate_cells_;
+    mutable Cells cells_;
+    mutable std::optional<Cells> next_cells_;
+    mutable FixedArray<ScenePos, 3> offset_;
+    FixedArray<ScenePos, 3> next_offset_;
+    mutable FastMutex mutex_;
+    FastMutex update_mutex_;
+    bool is_initialized_;
+};
+
+}
@@ -1,9 +1,11 @@
 #include "Aggregate_Render_Logic.hpp"
 #include <Mlib/Geometry/Cameras/Camera.hpp>
 #include <Mlib/Log.hpp>
+#include <Mlib/Physics/Units.hpp>
 #include <Mlib/Render/Batch_Renderers/Aggregate_Array_Renderer.hpp>
 #include <Mlib/Render/Batch_Renderers/Array_Instances_Renderer.hpp>
 #include <Mlib/Render/Batch_Renderers/Array_Instances_Renderers.hpp>
+#include <Mlib/Render/Batch_Renderers/Chunked_Aggregate_Array_Renderer.hpp>
 #include <Mlib/Render/Render_Setup.hpp>
 #include <Mlib/Render/Rendered_Scene_Descriptor.hpp>
 #include <Mlib/Scene_Graph/Batch_Renderers/IAggregate_Renderer.hpp>
@@ -12,13 +14,15 @@
 
 using namespace Mlib;
 
+static const ScenePos LARGE_AGGREGATE_CELL_SIZE = 256 * meters;
+
 AggregateRenderLogic::AggregateRenderLogic(
     RenderingResources& rendering_resources,
     RenderLogic& child_logic)
     : child_logic_{ child_logic }
     , small_sorted_aggregate_renderer_{ std::make_shared<AggregateArrayRenderer>(rendering_resources) }
     , small_sorted_instances_renderers_{ std::make_shared<ArrayInstancesRenderers>(rendering_resources) }
-    , large_aggregate_renderer_{ std::make_shared<AggregateArrayRenderer>(rendering_resources) }
+    , large_aggregate_renderer_{ std::make_shared<ChunkedAggregateArrayRenderer>(rendering_resources, LARGE_AGGREGATE_CELL_SIZE) }
     , large_instances_renderer_{ std::make_shared<ArrayInstancesRenderer>(rendering_resources) }
 {}
 
@@ -27,6 +27,7 @@
 #include <Mlib/Render/Resources/Colored_Vertex_Array_Resource/IInstance_Buffers.hpp>
 #include <Mlib/Render/Resources/Colored_Vertex_Array_Resource/IVertex_Data.hpp>
 #include <Mlib/Render/Toggle_Benchmark_Rendering.hpp>
+#include <Mlib/Scene_Graph/Batch_Renderers/Large_Aggregate.hpp>
 #include <Mlib/Scene_Graph/Batch_Renderers/Task_Location.hpp>
 #include <Mlib/Scene_Graph/Culling/Frustum_Visibility_Check.hpp>
 #include <Mlib/Scene_Graph/Culling/Instances_Are_Visible.hpp>
@@ -1396,13 +1397,11 @@ void RenderableColoredVertexArray::append_sorted_aggregates_to_queue(
 
 void RenderableColoredVertexArray::append_large_aggregates_to_queue(
     const TransformationMatrix<float, ScenePos, 3>& m,
-    const FixedArray<ScenePos, 3>& offset,
     const SceneGraphConfig& scene_graph_config,
-    std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue) const
+    std::list<LargeAggregate>& aggregate_queue) const
 {
     for (const auto& cva : aggregate_once_) {
-        TransformationMatrix<float, ScenePos, 3> mo{m.R, m.t - offset};
-        aggregate_queue.push_back(cva->transformed<float>(mo, "_transformed_tm"));
+        aggregate_queue.push_back({ cva, m });
     }
 }
 
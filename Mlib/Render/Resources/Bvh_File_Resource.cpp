@@ -1,12 +1,16 @@
 #include "Bvh_File_Resource.hpp"
 #include <Mlib/Geometry/Mesh/Load/Load_Bvh.hpp>
+#include <mutex>
 
 using namespace Mlib;
 
+static const size_t POSE_CACHE_SIZE = 16;
+
 BvhFileResource::BvhFileResource(
     const std::string& filename,
     const BvhConfig& config)
 : bvh_loader{ std::make_unique<BvhLoader>(filename, config)}
+, next_pose_cache_slot_{ 0 }
 {}
 
 BvhFileResource::~BvhFileResource()
@@ -24,6 +28,28 @@ std::map<std::string, OffsetAndQuaternion<float, float>> BvhFileResource::get_ab
     return bvh_loader->get_absolute_interpolated_frame(time);
 }
 
+size_t BvhFileResource::get_bone_index(const std::string& bone_name) const {
+    return bvh_loader->joint_index(bone_name);
+}
+
+OffsetAndQuaternion<float, float> BvhFileResource::get_absolute_pose(size_t bone_index, float seconds) const {
+    std::scoped_lock lock{ pose_cache_mutex_ };
+    for (const auto& c : pose_cache_) {
+        if (c.seconds == seconds) {
+            return c.poses.at(bone_index);
+        }
+    }
+    CachedPoses c{ seconds, bvh_loader->get_indexed_absolute_interpolated_frame(seconds) };
+    auto result = c.poses.at(bone_index);
+    if (pose_cache_.size() < POSE_CACHE_SIZE) {
+        pose_cache_.push_back(std::move(c));
+    } else {
+        pose_cache_[next_pose_cache_slot_] = std::move(c);
+        next_pose_cache_slot_ = (next_pose_cache_slot_ + 1) % POSE_CACHE_SIZE;
+    }
+    return result;
+}
+
 float BvhFileResource::get_animation_duration() const {
     return bvh_loader->duration();
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <Mlib/Scene_Graph/Interfaces/IScene_Node_Resource.hpp>
+#include <Mlib/Threads/Fast_Mutex.hpp>
 #include <memory>
+#include <vector>
 
 namespace Mlib {
 
@@ -16,9 +18,20 @@ public:
     virtual void preload(const RenderableResourceFilter& filter) const override;
     virtual std::map<std::string, OffsetAndQuaternion<float, float>> get_relative_poses(float seconds) const override;
     virtual std::map<std::string, OffsetAndQuaternion<float, float>> get_absolute_poses(float seconds) const override;
+    virtual size_t get_bone_index(const std::string& bone_name) const override;
+    virtual OffsetAndQuaternion<float, float> get_absolute_pose(size_t bone_index, float seconds) const override;
     virtual float get_animation_duration() const override;
 private:
+    struct CachedPoses {
+        float seconds;
+        std::vector<OffsetAndQuaternion<float, float>> poses;
+    };
     std::unique_ptr<BvhLoader> bvh_loader;
+    // The bone nodes of a skeleton query the same time,
+    // so the poses are evaluated once per skeleton and frame.
+    mutable std::vector<CachedPoses> pose_cache_;
+    mutable size_t next_pose_cache_slot_;
+    mutable FastMutex pose_cache_mutex_;
 };
 
 }
@@ -39,6 +39,7 @@ DECLARE_ARGUMENT(cache_filename);
 DECLARE_ARGUMENT(heightmap);
 DECLARE_ARGUMENT(heightmap_mask);
 DECLARE_ARGUMENT(heightmap_extension);
+DECLARE_ARGUMENT(heightmap_max_cached_tiles);
 DECLARE_ARGUMENT(grass_foliagemap);
 DECLARE_ARGUMENT(grass_foliagemap_period);
 DECLARE_ARGUMENT(street_mudmap);
@@ -159,6 +160,8 @@ DECLARE_ARGUMENT(default_tunnel_pipe_width);
 DECLARE_ARGUMENT(default_tunnel_pipe_height);
 DECLARE_ARGUMENT(scale);
 DECLARE_ARGUMENT(triangulation_scale);
+DECLARE_ARGUMENT(triangulation_tile_size);
+DECLARE_ARGUMENT(triangulation_tile_boundary_distance);
 DECLARE_ARGUMENT(height_scale);
 DECLARE_ARGUMENT(uv_scale_terrain);
 DECLARE_ARGUMENT(uv_period_terrain);
@@ -195,6 +198,7 @@ DECLARE_ARGUMENT(with_tree_nodes);
 DECLARE_ARGUMENT(forest_outline_tree_distance);
 DECLARE_ARGUMENT(forest_outline_tree_inwards_distance);
 DECLARE_ARGUMENT(much_grass_distance);
+DECLARE_ARGUMENT(scatter_tile_size);
 DECLARE_ARGUMENT(street_mud_grass_distance);
 DECLARE_ARGUMENT(path_mud_grass_distance);
 DECLARE_ARGUMENT(much_near_grass_distance);
@@ -267,6 +271,8 @@ DECLARE_ARGUMENT(game_level);
 DECLARE_ARGUMENT(base_osm_map_resource);
 DECLARE_ARGUMENT(navmesh_resource);
 DECLARE_ARGUMENT(agent_radius);
+DECLARE_ARGUMENT(navmesh_tile_size);
+DECLARE_ARGUMENT(navmesh_cache_dir);
 DECLARE_ARGUMENT(refine_explicit_waypoints);
 DECLARE_ARGUMENT(displacementmap);
 DECLARE_ARGUMENT(displacementmap_min);
@@ -395,6 +401,9 @@ LoadSceneJsonUserFunction LoadOsmResource::json_user_function = [](const LoadSce
         if (args.arguments.contains(KnownArgs::heightmap_extension)) {
             config.heightmap_extension = args.arguments.at<size_t>(KnownArgs::heightmap_extension);
         }
+        if (args.arguments.contains(KnownArgs::heightmap_max_cached_tiles)) {
+            config.heightmap_max_cached_tiles = args.arguments.at<size_t>(KnownArgs::heightmap_max_cached_tiles);
+        }
         if (args.arguments.contains(KnownArgs::grass_foliagemap)) {
             tconfig.street_mud_config.foliagemap_filename = args.arguments.path(KnownArgs::grass_foliagemap);
             tconfig.path_mud_config.foliagemap_filename = args.arguments.path(KnownArgs::grass_foliagemap);
@@ -770,6 +779,12 @@ LoadSceneJsonUserFunction LoadOsmResource::json_user_function = [](const LoadSce
         if (args.arguments.contains(KnownArgs::triangulation_scale)) {
             config.triangulation_scale = args.arguments.at<float>(KnownArgs::triangulation_scale);
         }
+        if (args.arguments.contains(KnownArgs::triangulation_tile_size)) {
+            config.triangulation_tile_size = fixed_from_meters(args.arguments.at<ScenePos>(KnownArgs::triangulation_tile_size));
+        }
+        if (args.arguments.contains(KnownArgs::triangulation_tile_boundary_distance)) {
+            config.triangulation_tile_boundary_distance = fixed_from_meters(args.arguments.at<ScenePos>(KnownArgs::triangulation_tile_boundary_distance));
+        }
         if (args.arguments.contains(KnownArgs::height_scale)) {
             config.height_scale = args.arguments.at<float>(KnownArgs::height_scale);
         }
@@ -878,6 +893,9 @@ LoadSceneJsonUserFunction LoadOsmResource::json_user_function = [](const LoadSce
         if (args.arguments.contains(KnownArgs::much_grass_distance)) {
             config.much_grass_distance = args.arguments.at<float>(KnownArgs::much_grass_distance) * meters;
         }
+        if (args.arguments.contains(KnownArgs::scatter_tile_size)) {
+            config.scatter_tile_size = fixed_from_meters(args.arguments.at<ScenePos>(KnownArgs::scatter_tile_size));
+        }
         if (args.arguments.contains(KnownArgs::street_mud_grass_distance)) {
             tconfig.street_mud_config.much_near_distance = args.arguments.at<float>(KnownArgs::street_mud_grass_distance) * meters;
         }
@@ -1123,6 +1141,12 @@ LoadSceneJsonUserFunction LoadOsmResource::json_user_function = [](const LoadSce
         if (args.arguments.contains(KnownArgs::agent_radius)) {
             config.agent_radius = args.arguments.at<float>(KnownArgs::agent_radius) * meters;
         }
+        if (args.arguments.contains(KnownArgs::navmesh_tile_size)) {
+            config.navmesh_tile_size = args.arguments.at<int>(KnownArgs::navmesh_tile_size);
+        }
+        if (args.arguments.contains(KnownArgs::navmesh_cache_dir)) {
+            config.navmesh_cache_dir = args.arguments.path(KnownArgs::navmesh_cache_dir);
+        }
         if (args.arguments.contains(KnownArgs::refine_explicit_waypoints)) {
             config.refine_explicit_waypoints = args.arguments.at<bool>(KnownArgs::refine_explicit_waypoints);
         }
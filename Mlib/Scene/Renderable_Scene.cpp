@@ -278,6 +278,7 @@ void RenderableScene::instantiate_game_logic(std::function<void()> setup_new_rou
     game_logic_ = std::make_unique<GameLogic>(
         scene_,
         physics_engine_.advance_times_,
+        physics_engine_.collision_query_,
         vehicle_spawners_,
         players_,
         supply_depots_,
@@ -1,4 +1,6 @@
 #include "IAggregate_Renderer.hpp"
+#include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
+#include <Mlib/Scene_Graph/Batch_Renderers/Large_Aggregate.hpp>
 
 using namespace Mlib;
 
@@ -21,6 +23,20 @@ AggregateRendererGuard::~AggregateRendererGuard() {
 
 IAggregateRenderer::~IAggregateRenderer() = default;
 
+void IAggregateRenderer::update_large_aggregates(
+    const FixedArray<ScenePos, 3>& offset,
+    const std::list<LargeAggregate>& aggregates,
+    const ExternalRenderPass& external_render_pass,
+    TaskLocation task_location)
+{
+    std::list<std::shared_ptr<ColoredVertexArray<float>>> aggregate_queue;
+    for (const auto& a : aggregates) {
+        TransformationMatrix<float, ScenePos, 3> mo{a.m.R, a.m.t - offset};
+        aggregate_queue.push_back(a.array->transformed<float>(mo, "_transformed_tm"));
+    }
+    update_aggregates(offset, aggregate_queue, external_render_pass, task_location);
+}
+
 std::shared_ptr<IAggregateRenderer> IAggregateRenderer::small_sorted_aggregate_renderer() {
     return small_sorted_aggregate_renderer_ == nullptr
         ? nullptr
@@ -20,6 +20,7 @@ class IAggregateRenderer;
 struct ColorStyle;
 struct ExternalRenderPass;
 enum class TaskLocation;
+struct LargeAggregate;
 
 class AggregateRendererGuard {
     AggregateRendererGuard(const AggregateRendererGuard&) = delete;
@@ -48,6 +49,14 @@ public:
         const std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue,
         const ExternalRenderPass& external_render_pass,
         TaskLocation task_location) = 0;
+    // Updates from the arrays of static nodes in model coordinates.
+    // The default implementation transforms the arrays relative to
+    // "offset" and calls "update_aggregates".
+    virtual void update_large_aggregates(
+        const FixedArray<ScenePos, 3>& offset,
+        const std::list<LargeAggregate>& aggregates,
+        const ExternalRenderPass& external_render_pass,
+        TaskLocation task_location);
     virtual void render_aggregates(
         const FixedArray<ScenePos, 4, 4>& vp,
         const TransformationMatrix<float, ScenePos, 3>& iv,
@@ -0,0 +1,22 @@
+#pragma once
+#include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
+#include <Mlib/Scene_Precision.hpp>
+#include <memory>
+
+namespace Mlib {
+
+template <class TPos>
+class ColoredVertexArray;
+
+/**
+ * Array of a static node in model coordinates, with the
+ * absolute model matrix of the node.
+ * The array is shared with the renderable, so the pair of array and
+ * model matrix identifies the aggregate between updates.
+ */
+struct LargeAggregate {
+    std::shared_ptr<ColoredVertexArray<CompressedScenePos>> array;
+    TransformationMatrix<float, ScenePos, 3> m;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <Mlib/Memory/Recursive_Deletion.hpp>
 #include <Mlib/Scene_Graph/Batch_Renderers/IAggregate_Renderer.hpp>
 #include <Mlib/Scene_Graph/Batch_Renderers/IInstances_Renderer.hpp>
+#include <Mlib/Scene_Graph/Batch_Renderers/Large_Aggregate.hpp>
 #include <Mlib/Scene_Graph/Batch_Renderers/Task_Location.hpp>
 #include <Mlib/Scene_Graph/Containers/Root_Nodes.hpp>
 #include <Mlib/Scene_Graph/Delete_Node_Mutex.hpp>
@@ -576,11 +577,11 @@ void Scene::render(
                                 std::shared_lock lock{ mutex_ };
                                 root_aggregate_once_nodes_.visit(iv.t, [&nodes](const auto& node) { nodes.emplace_back(&node.obj()); return true; });
                             }
-                            std::list<std::shared_ptr<ColoredVertexArray<float>>> aggregate_queue;
+                            std::list<LargeAggregate> aggregate_queue;
                             for (const auto& node : nodes) {
-                                node->append_large_aggregates_to_queue(TransformationMatrix<float, ScenePos, 3>::identity(), iv.t, aggregate_queue, scene_graph_config);
+                                node->append_large_aggregates_to_queue(TransformationMatrix<float, ScenePos, 3>::identity(), aggregate_queue, scene_graph_config);
                             }
-                            large_aggregate_renderer->update_aggregates(iv.t, aggregate_queue, external_render_pass, task_location);
+                            large_aggregate_renderer->update_large_aggregates(iv.t, aggregate_queue, external_render_pass, task_location);
                         });
                     };
                     if (is_foreground_task || (is_background_task && !large_aggregate_renderer->is_initialized())) {
@@ -35,6 +35,7 @@ enum class RenderingStrategies;
 class SceneNode;
 class SmallInstancesQueues;
 class LargeInstancesQueue;
+struct LargeAggregate;
 
 class Renderable {
 public:
@@ -63,9 +64,8 @@ public:
         std::list<std::pair<float, std::shared_ptr<ColoredVertexArray<float>>>>& aggregate_queue) const;
     virtual void append_large_aggregates_to_queue(
         const TransformationMatrix<float, ScenePos, 3>& m,
-        const FixedArray<ScenePos, 3>& offset,
         const SceneGraphConfig& scene_graph_config,
-        std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue) const;
+        std::list<LargeAggregate>& aggregate_queue) const;
     virtual void append_filtered_to_queue(
         std::list<std::shared_ptr<ColoredVertexArray<float>>>& float_queue,
         std::list<std::shared_ptr<ColoredVertexArray<CompressedScenePos>>>& double_queue,
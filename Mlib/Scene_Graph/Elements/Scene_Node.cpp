@@ -57,9 +57,15 @@ SceneNode::SceneNode(
     , trafo_{ OffsetAndQuaternion<float, ScenePos>::from_tait_bryan_angles({ rotation, position }) }
     , trafo_history_{ trafo_, std::chrono::steady_clock::now() }
     , trafo_history_invalidated_{ false }
+    , pose_snapshot_{ (interpolation_mode == PoseInterpolationMode::ENABLED)
+        ? std::make_unique<TripleBuffer<SceneNodePoseSnapshot>>()
+        : nullptr }
     , scale_{ scale }
     , rotation_matrix_{ tait_bryan_angles_2_matrix(rotation) }
+    , absolute_model_matrix_dirty_{ true }
+    , absolute_model_matrix_{ uninitialized }
     , interpolation_mode_{ interpolation_mode }
+    , bone_index_{ SIZE_MAX }
     , state_{ SceneNodeState::DETACHED }
     , shutting_down_{ false }
     , shutdown_called_{ false }
@@ -123,6 +129,7 @@ void SceneNode::set_parent(DanglingRef<SceneNode> parent) {
         THROW_OR_ABORT("Node already has a parent");
     }
     parent_ = parent.ptr().set_loc(DP_LOC);
+    invalidate_absolute_model_matrix();
 }
 
 bool SceneNode::has_parent() const {
@@ -160,6 +167,7 @@ void SceneNode::setup_child_unsafe(
             THROW_OR_ABORT("Scene node \"" + name + "\" already has a parent");
         }
         node->parent_ = DanglingPtr<SceneNode>::from_object(*this, DP_LOC);
+        node->invalidate_absolute_model_matrix();
     } else if (node->parent_ != DanglingPtr<SceneNode>::from_object(*this, DP_LOC)) {
         THROW_OR_ABORT("Child parent mismatch");
     }
@@ -756,14 +764,15 @@ void SceneNode::move(
                 if (std::isnan(time)) {
                     THROW_OR_ABORT("Scene node animation loop time is NAN");
                 }
-                auto poses = scene_node_resources->get_absolute_poses(
+                if (bone_animation_name_ != animation_name) {
+                    bone_index_ = scene_node_resources->get_bone_index(animation_name, bone_.name);
+                    bone_animation_name_ = animation_name;
+                }
+                auto pose = scene_node_resources->get_absolute_pose(
                     animation_name,
+                    bone_index_,
                     time);
-                auto it = poses.find(bone_.name);
-                if (it == poses.end()) {
-                    THROW_OR_ABORT("Could not find bone with name \"node\" in animation \"" + animation_name + '"');
-                }
-                OffsetAndQuaternion<float, ScenePos> q1{it->second.t.casted<ScenePos>(), it->second.q};
+                OffsetAndQuaternion<float, ScenePos> q1{pose.t.casted<ScenePos>(), pose.q};
                 auto res_pose = trafo_.slerp(q1, 1.f - bone_.smoothness);
                 res_pose.q = res_pose.q.slerp(Quaternion<float>::identity(), 1.f - bone_.rotation_strength);
                 set_relative_pose(
@@ -834,6 +843,17 @@ void SceneNode::move(
         trafo_history_invalidated_ = false;
     }
     trafo_history_.append(trafo_, time);
+    publish_pose_snapshot();
+}
+
+void SceneNode::publish_pose_snapshot() {
+    if (pose_snapshot_ == nullptr) {
+        return;
+    }
+    auto& snapshot = pose_snapshot_->write_buffer();
+    snapshot.trafo_history = trafo_history_;
+    snapshot.scale = scale_;
+    pose_snapshot_->publish();
 }
 
 bool SceneNode::to_be_deleted() const {
@@ -847,6 +867,7 @@ bool SceneNode::to_be_deleted() const {
 void SceneNode::set_bone(const SceneNodeBone& bone) {
     std::scoped_lock lock{ mutex_ };
     bone_ = bone;
+    bone_animation_name_.clear();
 }
 
 void SceneNode::set_periodic_animation(const std::string& name) {
@@ -927,7 +948,7 @@ void SceneNode::render(
     const std::list<const ColorStyle*>& color_styles,
     SceneNodeVisibility visibility) const
 {
-    auto child_m = relative_model_matrix(external_render_pass.time);
+    auto child_m = rendered_model_matrix(external_render_pass.time);
     std::shared_lock lock{ mutex_ };
     if (state_ == SceneNodeState::DETACHED) {
         THROW_OR_ABORT("Cannot render detached node");
@@ -1037,8 +1058,7 @@ void SceneNode::append_sorted_aggregates_to_queue(
 
 void SceneNode::append_large_aggregates_to_queue(
     const TransformationMatrix<float, ScenePos, 3>& parent_m,
-    const FixedArray<ScenePos, 3>& offset,
-    std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue,
+    std::list<LargeAggregate>& aggregate_queue,
     const SceneGraphConfig& scene_graph_config) const
 {
     TransformationMatrix<float, ScenePos, 3> m = parent_m * relative_model_matrix();
@@ -1047,13 +1067,13 @@ void SceneNode::append_large_aggregates_to_queue(
         THROW_OR_ABORT("Cannot append large aggregates to queue for a non-static node");
     }
     for (const auto& [_, r] : un_guarded_iterator(renderables_, lock)) {
-        (*r)->append_large_aggregates_to_queue(m, offset, scene_graph_config, aggregate_queue);
+        (*r)->append_large_aggregates_to_queue(m, scene_graph_config, aggregate_queue);
     }
     for (const auto& [_, c] : un_guarded_iterator(children_, lock)) {
-        c.scene_node->append_large_aggregates_to_queue(m, offset, aggregate_queue, scene_graph_config);
+        c.scene_node->append_large_aggregates_to_queue(m, aggregate_queue, scene_graph_config);
     }
     for (const auto& [_, a] : un_guarded_iterator(aggregate_children_, lock)) {
-        a.scene_node->append_large_aggregates_to_queue(m, offset, aggregate_queue, scene_graph_config);
+        a.scene_node->append_large_aggregates_to_queue(m, aggregate_queue, scene_graph_config);
     }
 }
 
@@ -1237,19 +1257,13 @@ void SceneNode::set_position(
             THROW_OR_ABORT("Cannot set position for a static node");
         }
     }
-    std::scoped_lock lock{ pose_mutex_ };
-    trafo_.t = position;
-    if (!time.has_value()) {
-        // Do nothing
-    } else if (*time == std::chrono::steady_clock::time_point()) {
-        trafo_history_.clear();
-        trafo_history_.append(trafo_, std::chrono::steady_clock::now());
-    } else {
-        if (interpolation_mode_ == PoseInterpolationMode::DISABLED) {
-            THROW_OR_ABORT("Attempt to set interpolated position of a node with interpolation disabled");
-        }
-        trafo_history_.append(trafo_, *time);
+    {
+        std::scoped_lock lock{ pose_mutex_ };
+        trafo_.t = position;
+        append_to_trafo_history_unsafe(time);
+        publish_pose_snapshot();
     }
+    invalidate_absolute_model_matrix();
 }
 
 void SceneNode::set_rotation(
@@ -1262,29 +1276,30 @@ void SceneNode::set_rotation(
             THROW_OR_ABORT("Cannot set rotation for a static node");
         }
     }
-    std::scoped_lock lock{ pose_mutex_ };
-    trafo_.q = Quaternion<float>::from_tait_bryan_angles(rotation);
-    rotation_matrix_ = tait_bryan_angles_2_matrix(rotation);
-    if (!time.has_value()) {
-        // Do nothing
-    } else if (*time == std::chrono::steady_clock::time_point()) {
-        trafo_history_.clear();
-        trafo_history_.append(trafo_, std::chrono::steady_clock::now());
-    } else {
-        if (interpolation_mode_ == PoseInterpolationMode::DISABLED) {
-            THROW_OR_ABORT("Attempt to set interpolated rotation of a node with interpolation disabled");
-        }
-        trafo_history_.append(trafo_, *time);
+    {
+        std::scoped_lock lock{ pose_mutex_ };
+        trafo_.q = Quaternion<float>::from_tait_bryan_angles(rotation);
+        rotation_matrix_ = tait_bryan_angles_2_matrix(rotation);
+        append_to_trafo_history_unsafe(time);
+        publish_pose_snapshot();
     }
+    invalidate_absolute_model_matrix();
 }
 
 void SceneNode::set_scale(float scale)
 {
-    std::scoped_lock lock{ pose_mutex_ };
-    if (state_ == SceneNodeState::STATIC) {
-        THROW_OR_ABORT("Cannot set scale for a static node");
+    {
+        std::scoped_lock lock{ mutex_ };
+        if (state_ == SceneNodeState::STATIC) {
+            THROW_OR_ABORT("Cannot set scale for a static node");
+        }
+    }
+    {
+        std::scoped_lock lock{ pose_mutex_ };
+        scale_ = scale;
+        publish_pose_snapshot();
     }
-    scale_ = scale;
+    invalidate_absolute_model_matrix();
 }
 
 void SceneNode::set_relative_pose(
@@ -1293,10 +1308,25 @@ void SceneNode::set_relative_pose(
     float scale,
     std::optional<std::chrono::steady_clock::time_point> time)
 {
-    std::scoped_lock lock{ pose_mutex_ };
-    set_position(position, SUCCESSOR_POSE);
-    set_rotation(rotation, SUCCESSOR_POSE);
-    set_scale(scale);
+    {
+        std::scoped_lock lock{ mutex_ };
+        if (state_ == SceneNodeState::STATIC) {
+            THROW_OR_ABORT("Cannot set pose for a static node");
+        }
+    }
+    {
+        std::scoped_lock lock{ pose_mutex_ };
+        trafo_.t = position;
+        trafo_.q = Quaternion<float>::from_tait_bryan_angles(rotation);
+        rotation_matrix_ = tait_bryan_angles_2_matrix(rotation);
+        scale_ = scale;
+        append_to_trafo_history_unsafe(time);
+        publish_pose_snapshot();
+    }
+    invalidate_absolute_model_matrix();
+}
+
+void SceneNode::append_to_trafo_history_unsafe(std::optional<std::chrono::steady_clock::time_point> time) {
     if (!time.has_value()) {
         // Do nothing
     } else if (*time == std::chrono::steady_clock::time_point()) {
@@ -1304,7 +1334,7 @@ void SceneNode::set_relative_pose(
         trafo_history_.append(trafo_, std::chrono::steady_clock::now());
     } else {
         if (interpolation_mode_ == PoseInterpolationMode::DISABLED) {
-            THROW_OR_ABORT("Attempt to set interpolated position of a node with interpolation disabled");
+            THROW_OR_ABORT("Attempt to set interpolated pose of a node with interpolation disabled");
         }
         trafo_history_.append(trafo_, *time);
     }
@@ -1322,6 +1352,22 @@ TransformationMatrix<float, ScenePos, 3> SceneNode::relative_model_matrix(std::c
     }
 }
 
+TransformationMatrix<float, ScenePos, 3> SceneNode::rendered_model_matrix(std::chrono::steady_clock::time_point time) const {
+    // Interpolate in the latest snapshot published by the physics thread,
+    // without waiting for "pose_mutex_".
+    // Only the rendering thread may call this, the triple buffer
+    // supports a single consumer and throws otherwise.
+    if ((time != std::chrono::steady_clock::time_point()) &&
+        (pose_snapshot_ != nullptr))
+    {
+        if (const auto* snapshot = pose_snapshot_->latest(); snapshot != nullptr) {
+            auto res = snapshot->trafo_history.get(time);
+            return TransformationMatrix{res.q.to_rotation_matrix() * snapshot->scale, res.t};
+        }
+    }
+    return relative_model_matrix(time);
+}
+
 TransformationMatrix<float, ScenePos, 3> SceneNode::absolute_model_matrix(std::chrono::steady_clock::time_point time) const {
     return absolute_model_matrix(LockingStrategy::ACQUIRE_LOCK, time);
 }
@@ -1329,6 +1375,22 @@ TransformationMatrix<float, ScenePos, 3> SceneNode::absolute_model_matrix(std::c
 TransformationMatrix<float, ScenePos, 3> SceneNode::absolute_model_matrix(
     LockingStrategy locking_strategy,
     std::chrono::steady_clock::time_point time) const
+{
+    if (time == std::chrono::steady_clock::time_point()) {
+        // The flag is reset before the parents are queried, so a concurrent
+        // pose update sets it again and the next call recomputes the matrix.
+        std::scoped_lock cache_lock{ absolute_model_matrix_mutex_ };
+        if (absolute_model_matrix_dirty_.exchange(false)) {
+            absolute_model_matrix_ = uncached_absolute_model_matrix(locking_strategy, time);
+        }
+        return absolute_model_matrix_;
+    }
+    return uncached_absolute_model_matrix(locking_strategy, time);
+}
+
+TransformationMatrix<float, ScenePos, 3> SceneNode::uncached_absolute_model_matrix(
+    LockingStrategy locking_strategy,
+    std::chrono::steady_clock::time_point time) const
 {
     auto result = relative_model_matrix(time);
     std::shared_lock lock{ pose_mutex_, std::defer_lock };
@@ -1413,15 +1475,23 @@ void SceneNode::set_absolute_pose(
     float scale,
     std::optional<std::chrono::steady_clock::time_point> time)
 {
-    std::scoped_lock lock{ pose_mutex_ };
-    if (parent_ == nullptr) {
+    // "pose_mutex_" must not be held by "set_relative_pose", see
+    // "invalidate_absolute_model_matrix".
+    std::optional<TransformationMatrix<float, ScenePos, 3>> parent_view_matrix;
+    {
+        std::shared_lock lock{ pose_mutex_ };
+        if (parent_ != nullptr) {
+            parent_view_matrix = parent_->absolute_view_matrix();
+        }
+    }
+    if (!parent_view_matrix.has_value()) {
         set_relative_pose(
             position,
             rotation,
             scale,
             time);
     } else {
-        auto p_v = parent_->absolute_view_matrix();
+        const auto& p_v = *parent_view_matrix;
         auto m = TransformationMatrix<float, ScenePos, 3>{
             tait_bryan_angles_2_matrix(rotation) * scale,
             position};
@@ -1601,6 +1671,25 @@ PoseInterpolationMode SceneNode::pose_interpolation_mode() const {
     return interpolation_mode_;
 }
 
+// Locks "mutex_" of this node and its descendants, so it must not be called
+// while holding "pose_mutex_": "move" holds "mutex_" while setting the pose.
+void SceneNode::invalidate_absolute_model_matrix() {
+    // If the flag was already set, the descendants are invalid, too.
+    if (absolute_model_matrix_dirty_.exchange(true)) {
+        return;
+    }
+    std::shared_lock lock{ mutex_ };
+    for (auto& [_, c] : children_) {
+        c.scene_node->invalidate_absolute_model_matrix();
+    }
+    for (auto& [_, c] : aggregate_children_) {
+        c.scene_node->invalidate_absolute_model_matrix();
+    }
+    for (auto& [_, c] : instances_children_) {
+        c.scene_node->invalidate_absolute_model_matrix();
+    }
+}
+
 void SceneNode::invalidate_transformation_history() {
     std::scoped_lock lock{ mutex_ };
     trafo_history_invalidated_ = true;
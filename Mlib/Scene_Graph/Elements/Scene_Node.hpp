@@ -13,7 +13,9 @@
 #include <Mlib/Scene_Graph/Interpolation.hpp>
 #include <Mlib/Scene_Graph/Pose_Interpolation_Mode.hpp>
 #include <Mlib/Scene_Precision.hpp>
+#include <Mlib/Threads/Fast_Mutex.hpp>
 #include <Mlib/Threads/Safe_Recursive_Shared_Mutex.hpp>
+#include <Mlib/Threads/Triple_Buffer.hpp>
 #include <atomic>
 #include <cstdint>
 #include <iosfwd>
@@ -53,6 +55,7 @@ template <class TPos>
 class ColoredVertexArray;
 class SmallInstancesQueues;
 class LargeInstancesQueue;
+struct LargeAggregate;
 class Blended;
 template <class T>
 struct Bijection;
@@ -79,6 +82,11 @@ struct SceneNodeBone {
     float rotation_strength;
 };
 
+struct SceneNodePoseSnapshot {
+    QuaternionSeries<float, ScenePos, NINTERPOLATED> trafo_history;
+    float scale;
+};
+
 enum class SceneNodeState {
     DETACHED,
     STATIC,
@@ -234,8 +242,7 @@ public:
         const ExternalRenderPass& external_render_pass) const;
     void append_large_aggregates_to_queue(
         const TransformationMatrix<float, ScenePos, 3>& parent_m,
-        const FixedArray<ScenePos, 3>& offset,
-        std::list<std::shared_ptr<ColoredVertexArray<float>>>& aggregate_queue,
+        std::list<LargeAggregate>& aggregate_queue,
         const SceneGraphConfig& scene_graph_config) const;
     void append_small_instances_to_queue(
         const FixedArray<ScenePos, 4, 4>& parent_mvp,
@@ -330,9 +337,16 @@ private:
         ChildRegistrationState child_registration_state,
         ChildParentState child_parent_state);
     void clear_unsafe();
+    void publish_pose_snapshot();
+    void append_to_trafo_history_unsafe(std::optional<std::chrono::steady_clock::time_point> time);
+    TransformationMatrix<float, ScenePos, 3> rendered_model_matrix(std::chrono::steady_clock::time_point time) const;
     TransformationMatrix<float, ScenePos, 3> absolute_model_matrix(
         LockingStrategy locking_strategy,
         std::chrono::steady_clock::time_point time = std::chrono::steady_clock::time_point()) const;
+    TransformationMatrix<float, ScenePos, 3> uncached_absolute_model_matrix(
+        LockingStrategy locking_strategy,
+        std::chrono::steady_clock::time_point time) const;
+    void invalidate_absolute_model_matrix();
     Scene* scene_;
     DanglingPtr<SceneNode> parent_;
     DanglingBaseClassPtr<IAbsoluteMovable> absolute_movable_;
@@ -351,13 +365,25 @@ private:
     OffsetAndQuaternion<float, ScenePos> trafo_;
     QuaternionSeries<float, ScenePos, NINTERPOLATED> trafo_history_;
     bool trafo_history_invalidated_;
+    // Written by the pose setters while holding "pose_mutex_",
+    // read by the single rendering thread. Only allocated if pose interpolation
+    // is enabled, which is never the case for static nodes.
+    std::unique_ptr<TripleBuffer<SceneNodePoseSnapshot>> pose_snapshot_;
     float scale_;
     FixedArray<float, 3, 3> rotation_matrix_;
+    // Cached "absolute_model_matrix()" of the current pose, set dirty by the
+    // pose setters of this node and its ancestors.
+    mutable FastMutex absolute_model_matrix_mutex_;
+    mutable std::atomic_bool absolute_model_matrix_dirty_;
+    mutable TransformationMatrix<float, ScenePos, 3> absolute_model_matrix_;
     PoseInterpolationMode interpolation_mode_;
     std::shared_ptr<AnimationState> animation_state_;
     std::list<std::unique_ptr<ColorStyle>> color_styles_;
     std::unique_ptr<AnimationStateUpdater> animation_state_updater_;
     SceneNodeBone bone_;
+    // Index of "bone_.name" in "bone_animation_name_".
+    std::string bone_animation_name_;
+    size_t bone_index_;
     std::string periodic_animation_;
     std::string aperiodic_animation_;
     SceneNodeState state_;
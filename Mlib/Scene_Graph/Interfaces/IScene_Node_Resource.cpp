@@ -148,6 +148,14 @@ std::map<std::string, OffsetAndQuaternion<float, float>> ISceneNodeResource::get
     THROW_OR_ABORT("get_absolute_poses not implemented");
 }
 
+size_t ISceneNodeResource::get_bone_index(const std::string& bone_name) const {
+    THROW_OR_ABORT("get_bone_index not implemented");
+}
+
+OffsetAndQuaternion<float, float> ISceneNodeResource::get_absolute_pose(size_t bone_index, float seconds) const {
+    THROW_OR_ABORT("get_absolute_pose not implemented");
+}
+
 float ISceneNodeResource::get_animation_duration() const {
     THROW_OR_ABORT("get_animation_duration not implemented");
 }
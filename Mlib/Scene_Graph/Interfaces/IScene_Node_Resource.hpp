@@ -67,6 +67,8 @@ public:
         float max_distance);
     virtual std::map<std::string, OffsetAndQuaternion<float, float>> get_relative_poses(float seconds) const;
     virtual std::map<std::string, OffsetAndQuaternion<float, float>> get_absolute_poses(float seconds) const;
+    virtual size_t get_bone_index(const std::string& bone_name) const;
+    virtual OffsetAndQuaternion<float, float> get_absolute_pose(size_t bone_index, float seconds) const;
     virtual float get_animation_duration() const;
 
     // Modifiers
@@ -253,7 +253,7 @@ void BatchResourceInstantiator::remove(
         return vertices_to_delete.contains(&d.position);
     });
     for (auto& [_, ps] : resource_instance_positions_) {
-        ps.remove_if([&vertices_to_delete](const ResourceInstanceDescriptor& d){
+        std::erase_if(ps, [&vertices_to_delete](const ResourceInstanceDescriptor& d){
             return vertices_to_delete.contains(&d.position);
         });
     }
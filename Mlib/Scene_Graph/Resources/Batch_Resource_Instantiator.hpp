@@ -8,6 +8,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Mlib {
 
@@ -75,7 +76,7 @@ private:
     FixedArray<float, 3> rotation_;
     float scale_;
     std::list<ObjectResourceDescriptor> object_resource_descriptors_;
-    std::unordered_map<VariableAndHash<std::string>, std::list<ResourceInstanceDescriptor>> resource_instance_positions_;
+    std::unordered_map<VariableAndHash<std::string>, std::vector<ResourceInstanceDescriptor>> resource_instance_positions_;
     std::map<std::string, std::list<ResourceInstanceDescriptor>> hitboxes_;
 };
 
@@ -373,6 +373,26 @@ std::map<std::string, OffsetAndQuaternion<float, float>> SceneNodeResources::get
     }
 }
 
+size_t SceneNodeResources::get_bone_index(const std::string& name, const std::string& bone_name) const
+{
+    auto resource = get_resource(name);
+    try {
+        return resource->get_bone_index(bone_name);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("get_bone_index for resource \"" + name + "\" failed: " + e.what());
+    }
+}
+
+OffsetAndQuaternion<float, float> SceneNodeResources::get_absolute_pose(const std::string& name, size_t bone_index, float seconds) const
+{
+    auto resource = get_resource(name);
+    try {
+        return resource->get_absolute_pose(bone_index, seconds);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("get_absolute_pose for resource \"" + name + "\" failed: " + e.what());
+    }
+}
+
 float SceneNodeResources::get_animation_duration(const std::string& name) const {
     auto resource = get_resource(name);
     try {
@@ -127,6 +127,8 @@ public:
     void set_relative_joint_poses(const std::string& name, const std::map<std::string, OffsetAndQuaternion<float, float>>& poses);
     std::map<std::string, OffsetAndQuaternion<float, float>> get_relative_poses(const std::string& name, float seconds) const;
     std::map<std::string, OffsetAndQuaternion<float, float>> get_absolute_poses(const std::string& name, float seconds) const;
+    size_t get_bone_index(const std::string& name, const std::string& bone_name) const;
+    OffsetAndQuaternion<float, float> get_absolute_pose(const std::string& name, size_t bone_index, float seconds) const;
     float get_animation_duration(const std::string& name) const;
 
     // Modifiers
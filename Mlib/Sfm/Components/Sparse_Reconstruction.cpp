@@ -8,7 +8,6 @@
 #include <Mlib/Images/Features.hpp>
 #include <Mlib/Math/Fixed_Rodrigues.hpp>
 #include <Mlib/Math/Optimize/Generic_Optimization.hpp>
-#include <Mlib/Math/Optimize/Levenberg_Marquardt.hpp>
 #include <Mlib/Math/Transformation/Quaternion.hpp>
 #include <Mlib/Sfm/Configuration/Tracking_Mode.hpp>
 #include <Mlib/Sfm/Disparity/Corresponding_Descriptors_In_Candidate_List.hpp>
@@ -22,6 +21,7 @@
 #include <Mlib/Sfm/Rigid_Motion/Normalized_Projection.hpp>
 #include <Mlib/Sfm/Rigid_Motion/Projection_To_TR.hpp>
 #include <Mlib/Sfm/Rigid_Motion/Projection_To_TR_Ransac.hpp>
+#include <Mlib/Sfm/Sparse_Bundle/Schur_Bundle_Solver.hpp>
 #include <Mlib/Stats/Min_Max.hpp>
 #include <deque>
 #include <filesystem>
@@ -664,10 +664,11 @@ void SparseReconstruction::global_bundle_adjustment_lvm() {
         dropped_observations_};
     lerr() << "global shape " << gb.Jg.shape();
 
-    Array<float> x_opt = levenberg_marquardt<float>(
+    // Levenberg-Marquardt, with the points eliminated
+    // from the normal equations using the Schur complement.
+    Array<float> x_opt = generic_optimization<float>(
         gb.xg,
-        gb.yg,
-        [&](const Array<float>& x) {
+        [&](const Array<float>& x, size_t i) {
             gb.copy_out(x, reconstructed_points_, packed_intrinsic_coefficients_, camera_frames_);
             gb.copy_in(
                 particles_,
@@ -678,27 +679,25 @@ void SparseReconstruction::global_bundle_adjustment_lvm() {
                 frozen_camera_frames_,
                 skip_missing_cameras,
                 dropped_observations_);
-            return gb.fg;
+            return gb.yg - gb.fg;
         },
-        [&](const Array<float>& x) {
-            // Not necessary due to levenberg-marquardt implementation
-            // (x does not change from f to J).
-            // gb.copy_out(x, reconstructed_points_, camera_frames_);
-            // gb.copy_in(
-            //     particles_,
-            //     reconstructed_points_,
-            //     camera_frames_,
-            //     intrinsic_matrix_,
-            //     skip_missing_cameras);
-            return gb.Jg;
+        [](const Array<float>& x, const Array<float>& residual, size_t i) {
+            return (residual.length() == 0)
+                ? 0
+                : sum(squared(residual)) / residual.length();
+        },
+        [&](const Array<float>& x, const Array<float>& residual, size_t i) {
+            // Not necessary to recompute the Jacobian,
+            // x does not change from the residual to the update step.
+            return x + schur_bundle_lstsq_1d(
+                gb.Jg,
+                residual,
+                gb.npoint_columns(),
+                float{ 1e-2 },      // alpha
+                float{ 1e-2 }).value(); // beta
         },
-        float{ 1e-2 },          // alpha
-        float{ 1e-2 },          // beta
-        float{ 1e-2 },          // alpha2
-        float{ 1e-2 },          // beta2
         float{ 1e-3 },          // min_redux
         100,                    // niterations
-        5,                      // nburnin
         3,                      // nmisses
         cfg_.print_residual,    // print_residual
         false,                  // nothrow
@@ -1,7 +1,10 @@
 #include "Corresponding_Descriptors_In_Candidate_List.hpp"
 #include <Mlib/Images/Coordinates_Fixed.hpp>
-#include <Mlib/Sfm/Disparity/Traceable_Descriptor.hpp>
+#include <Mlib/Sfm/Disparity/Descriptor_Kd_Tree.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <climits>
 #include <map>
+#include <vector>
 
 using namespace Mlib;
 using namespace Mlib::Sfm;
@@ -11,22 +14,30 @@ CorrespondingDescriptorsInCandidateList::CorrespondingDescriptorsInCandidateList
     const Array<FixedArray<float, 2>>& feature_points1,
     const Array<float>& descriptors0,
     const Array<float>& descriptors1,
-    float lowe_ratio)
+    float lowe_ratio,
+    size_t max_checks)
 {
     assert(descriptors0.ndim() == 2);
     assert(descriptors1.ndim() == 2);
     assert(feature_points0.length() == descriptors0.shape(0));
     assert(feature_points1.length() == descriptors1.shape(0));
 
+    if (feature_points0.length() > INT_MAX) {
+        THROW_OR_ABORT("Too many feature points");
+    }
+    DescriptorKdTree tree{ descriptors1 };
+    std::vector<size_t> best_ids1(feature_points0.length());
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int i0 = 0; i0 < (int)feature_points0.length(); ++i0) {
+        best_ids1[(size_t)i0] = tree.ratio_match(&descriptors0((size_t)i0, 0), lowe_ratio, max_checks);
+    }
+
     std::list<FixedArray<float, 2>> yl0;
     std::list<FixedArray<float, 2>> yl1;
     std::map<size_t, size_t> inserted_keypoints1;
     std::list<std::pair<size_t, size_t>> matches;
     for (size_t i0 = 0; i0 < feature_points0.length(); ++i0) {
-        size_t best_i1 = TraceableDescriptor::descriptor_id_in_parameter_list(
-            &descriptors0(i0, 0),
-            descriptors1,
-            lowe_ratio);
+        size_t best_i1 = best_ids1[i0];
         if (best_i1 != SIZE_MAX) {
             if ((best_i1 != SIZE_MAX) && !inserted_keypoints1.contains(best_i1)) {
                 matches.push_back({ i0, best_i1 });
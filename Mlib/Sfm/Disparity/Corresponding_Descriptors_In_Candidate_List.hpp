@@ -3,6 +3,13 @@
 
 namespace Mlib::Sfm {
 
+/**
+ * Matches every descriptor in "descriptors0" against "descriptors1"
+ * using a k-d tree and Lowe's ratio test, keeping only matches
+ * whose target is not claimed by another descriptor.
+ * "max_checks" limits the number of compared descriptors per query,
+ * 0 means exact search (see "DescriptorKdTree").
+ */
 class CorrespondingDescriptorsInCandidateList {
 public:
     CorrespondingDescriptorsInCandidateList(
@@ -10,7 +17,8 @@ public:
         const Array<FixedArray<float, 2>>& feature_points1,
         const Array<float>& descriptors0,
         const Array<float>& descriptors1,
-        float lowe_ratio = 0.75f);
+        float lowe_ratio = 0.75f,
+        size_t max_checks = 0);
 
     Array<FixedArray<float, 2>> y0;
     Array<FixedArray<float, 2>> y1;
@@ -0,0 +1,147 @@
+#include "Descriptor_Kd_Tree.hpp"
+#include <Mlib/Math/Math.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <algorithm>
+#include <queue>
+
+using namespace Mlib;
+using namespace Mlib::Sfm;
+
+static float squared_distance(const float* a, const float* b, size_t ndims) {
+    float result = 0;
+    #pragma omp simd reduction(+:result)
+    for (size_t d = 0; d < ndims; ++d) {
+        result += squared(a[d] - b[d]);
+    }
+    return result;
+}
+
+DescriptorKdTree::DescriptorKdTree(const Array<float>& descriptors, size_t leaf_size)
+: ndims_{ descriptors.ndim() == 2 ? descriptors.shape(1) : 0 }
+{
+    if (descriptors.ndim() != 2) {
+        THROW_OR_ABORT("Descriptor matrix is not 2-dimensional");
+    }
+    if (leaf_size == 0) {
+        THROW_OR_ABORT("Leaf size of descriptor k-d tree is zero");
+    }
+    size_t n = descriptors.shape(0);
+    ids_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids_[i] = i;
+    }
+    if (n != 0) {
+        build(descriptors, 0, n, leaf_size);
+    }
+    data_.resize(n * ndims_);
+    for (size_t i = 0; i < n; ++i) {
+        std::copy(&descriptors(ids_[i], 0), &descriptors(ids_[i], 0) + ndims_, &data_[i * ndims_]);
+    }
+}
+
+size_t DescriptorKdTree::build(const Array<float>& descriptors, size_t begin, size_t end, size_t leaf_size) {
+    size_t node_id = nodes_.size();
+    nodes_.push_back(Node{
+        .split_dim = SIZE_MAX,
+        .split_value = 0.f,
+        .left = SIZE_MAX,
+        .right = SIZE_MAX,
+        .begin = begin,
+        .end = end });
+    if (end - begin <= leaf_size) {
+        return node_id;
+    }
+    size_t split_dim = 0;
+    double max_var = -1;
+    for (size_t d = 0; d < ndims_; ++d) {
+        double s = 0;
+        double s2 = 0;
+        for (size_t i = begin; i < end; ++i) {
+            double v = descriptors(ids_[i], d);
+            s += v;
+            s2 += v * v;
+        }
+        double var = s2 - s * s / double(end - begin);
+        if (var > max_var) {
+            max_var = var;
+            split_dim = d;
+        }
+    }
+    size_t mid = begin + (end - begin) / 2;
+    std::nth_element(
+        ids_.begin() + (std::ptrdiff_t)begin,
+        ids_.begin() + (std::ptrdiff_t)mid,
+        ids_.begin() + (std::ptrdiff_t)end,
+        [&descriptors, split_dim](size_t a, size_t b){
+            return descriptors(a, split_dim) < descriptors(b, split_dim);
+        });
+    float split_value = descriptors(ids_[mid], split_dim);
+    size_t left = build(descriptors, begin, mid, leaf_size);
+    size_t right = build(descriptors, mid, end, leaf_size);
+    Node& node = nodes_[node_id];
+    node.split_dim = split_dim;
+    node.split_value = split_value;
+    node.left = left;
+    node.right = right;
+    return node_id;
+}
+
+DescriptorNeighbors DescriptorKdTree::nearest_two(const float* descriptor, size_t max_checks) const {
+    DescriptorNeighbors result;
+    if (nodes_.empty()) {
+        return result;
+    }
+    // (lower bound of the squared distance, node)
+    using Branch = std::pair<float, size_t>;
+    std::priority_queue<Branch, std::vector<Branch>, std::greater<Branch>> branches;
+    branches.push({ 0.f, 0 });
+    size_t nchecks = 0;
+    while (!branches.empty()) {
+        auto [bound, node_id] = branches.top();
+        branches.pop();
+        if (bound >= result.second_best_dist2) {
+            break;
+        }
+        // Descend to the closest leaf, remembering the far branches.
+        while (nodes_[node_id].left != SIZE_MAX) {
+            const Node& node = nodes_[node_id];
+            float diff = descriptor[node.split_dim] - node.split_value;
+            size_t near = (diff < 0) ? node.left : node.right;
+            size_t far = (diff < 0) ? node.right : node.left;
+            float far_bound = std::max(bound, squared(diff));
+            if (far_bound < result.second_best_dist2) {
+                branches.push({ far_bound, far });
+            }
+            node_id = near;
+        }
+        const Node& leaf = nodes_[node_id];
+        for (size_t i = leaf.begin; i < leaf.end; ++i) {
+            float dist2 = squared_distance(descriptor, &data_[i * ndims_], ndims_);
+            if (dist2 < result.best_dist2) {
+                result.second_best_dist2 = result.best_dist2;
+                result.best_dist2 = dist2;
+                result.best = ids_[i];
+            } else if (dist2 < result.second_best_dist2) {
+                result.second_best_dist2 = dist2;
+            }
+        }
+        nchecks += leaf.end - leaf.begin;
+        if ((max_checks != 0) && (nchecks >= max_checks)) {
+            break;
+        }
+    }
+    return result;
+}
+
+size_t DescriptorKdTree::ratio_match(const float* descriptor, float lowe_ratio, size_t max_checks) const {
+    DescriptorNeighbors n = nearest_two(descriptor, max_checks);
+    if (n.best_dist2 < squared(lowe_ratio) * n.second_best_dist2) {
+        return n.best;
+    } else {
+        return SIZE_MAX;
+    }
+}
+
+size_t DescriptorKdTree::size() const {
+    return ids_.size();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <Mlib/Array/Array.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace Mlib::Sfm {
+
+struct DescriptorNeighbors {
+    size_t best = SIZE_MAX;
+    float best_dist2 = INFINITY;
+    float second_best_dist2 = INFINITY;
+};
+
+/**
+ * K-d tree over the rows of a descriptor matrix, used to find the
+ * two nearest neighbors of a descriptor for Lowe's ratio test.
+ *
+ * Nodes are split at the median of the dimension with the largest variance.
+ * The descriptors are stored in leaf order so that each leaf is contiguous.
+ *
+ * Source: Beis, Lowe, "Shape indexing using approximate nearest-neighbour
+ *         search in high-dimensional spaces", CVPR 1997
+ *
+ * Leaves are visited best-bin-first. The search is exact if "max_checks"
+ * is 0, otherwise it stops after "max_checks" descriptors were compared.
+ * The tree is immutable after construction, so queries can run in parallel.
+ */
+class DescriptorKdTree {
+public:
+    explicit DescriptorKdTree(const Array<float>& descriptors, size_t leaf_size = 8);
+    DescriptorNeighbors nearest_two(const float* descriptor, size_t max_checks = 0) const;
+    // Returns SIZE_MAX if the ratio test fails,
+    // equivalent to "TraceableDescriptor::descriptor_id_in_parameter_list".
+    size_t ratio_match(const float* descriptor, float lowe_ratio = 0.75f, size_t max_checks = 0) const;
+    size_t size() const;
+private:
+    struct Node {
+        size_t split_dim;
+        float split_value;
+        size_t left;
+        size_t right;
+        size_t begin;
+        size_t end;
+    };
+    size_t build(const Array<float>& descriptors, size_t begin, size_t end, size_t leaf_size);
+    size_t ndims_;
+    std::vector<size_t> ids_;
+    std::vector<float> data_;
+    std::vector<Node> nodes_;
+};
+
+}
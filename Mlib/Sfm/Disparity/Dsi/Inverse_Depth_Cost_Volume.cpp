@@ -1,16 +1,27 @@
 #include "Inverse_Depth_Cost_Volume.hpp"
 #include <Mlib/Geometry/Coordinates/Homogeneous.hpp>
+#include <Mlib/Images/Bilinear_Interpolation.hpp>
 #include <Mlib/Images/Coordinates_Fixed.hpp>
 #include <Mlib/Images/Resample/Down_Sample_Average.hpp>
 #include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
 #include <Mlib/Sfm/Homography/Homography_From_Transform.hpp>
-#include <Mlib/Sfm/Homography/Homography_Sampler.hpp>
 #include <Mlib/Sfm/Rigid_Motion/Initial_Reconstruction2.hpp>
 #include <Mlib/Stats/Min_Max.hpp>
+#include <half/half.h>
+#include <bit>
+#include <vector>
 
 using namespace Mlib;
 using namespace Mlib::Sfm;
 
+static float half_bits_to_float(uint16_t h) {
+    return std::bit_cast<float>(half_to_float(h));
+}
+
+static uint16_t float_to_half_bits(float f) {
+    return half_from_float(std::bit_cast<uint32_t>(f));
+}
+
 InverseDepthCostVolume::InverseDepthCostVolume(const Array<float>& dsi)
 : dsi_(dsi)
 {}
@@ -32,11 +43,12 @@ InverseDepthCostVolumeAccumulator::InverseDepthCostVolumeAccumulator(
     const Array<float>& inverse_depths)
 : space_shape_(space_shape),
   inverse_depths_(inverse_depths),
-  idsi_sum_(zeros<float>(ArrayShape{inverse_depths.length()}.concatenated(space_shape))),
-  nelements_idsi_(zeros<size_t>(idsi_sum_.shape())),
+  idsi_mean_(zeros<uint16_t>(ArrayShape{inverse_depths.length()}.concatenated(space_shape))),
+  nelements_idsi_(zeros<uint16_t>(idsi_mean_.shape())),
   nchannel_increments_(0)
 {
     assert(inverse_depths.ndim() == 1);
+    assert(space_shape.ndim() == 2);
 }
 
 void InverseDepthCostVolumeAccumulator::increment(
@@ -63,61 +75,83 @@ void InverseDepthCostVolumeAccumulator::increment(
             }
         }
     }
+    bool check_epipole = (epipole_radius != 0) && !any(Mlib::isnan(e));
 
+    std::vector<FixedArray<float, 3, 3>> homographies;
+    homographies.reserve(inverse_depths_.length());
     for (size_t di = 0; di < inverse_depths_.length(); ++di) {
         FixedArray<float, 3, 3> homog_e = rotation_and_translation_to_homography(
             ke,
             -FixedArray<float, 3>{0.f, 0.f, 1.f},
             1.f / inverse_depths_(di));
-        FixedArray<float, 3, 3> homog_i = pixel_homography(intrinsic_matrix, homog_e);
-        FixedArray<size_t, 2> space_shape_f{space_shape_};
-        HomographySampler<float> hs{homog_i};
-        #pragma omp parallel for
-        for (int ri = 0; ri < (int)im0_rgb.shape(1); ++ri) {
+        homographies.push_back(pixel_homography(intrinsic_matrix, homog_e));
+    }
+
+    size_t nrows = space_shape_(0);
+    size_t ncols = space_shape_(1);
+    size_t nchannels = im0_rgb.shape(0);
+    #pragma omp parallel
+    {
+        std::vector<float> rf(ncols);
+        std::vector<float> cf(ncols);
+        std::vector<float> sum(ncols);
+        std::vector<uint16_t> nsum(ncols);
+        #pragma omp for schedule(dynamic)
+        for (int ri = 0; ri < (int)nrows; ++ri) {
             size_t r = (size_t)ri;
-            for (size_t c = 0; c < im0_rgb.shape(2); ++c) {
-                if ((epipole_radius != 0) && !any(Mlib::isnan(e)) && (std::abs(r - e(0)) < epipole_radius) && (std::abs(c - e(1)) < epipole_radius)) {
-                    continue;
+            for (size_t di = 0; di < homographies.size(); ++di) {
+                // Pixel (r, c) has the homogeneous array coordinates
+                // (c + 0.5, r + 0.5, 1), so the projection is affine in c.
+                const auto& H = homographies[di];
+                float ar = i2a(r);
+                float b0 = H(0, 1) * ar + H(0, 2);
+                float b1 = H(1, 1) * ar + H(1, 2);
+                float b2 = H(2, 1) * ar + H(2, 2);
+                #pragma omp simd
+                for (size_t c = 0; c < ncols; ++c) {
+                    float ac = i2a(c);
+                    float x0 = H(0, 0) * ac + b0;
+                    float x1 = H(1, 0) * ac + b1;
+                    float x2 = H(2, 0) * ac + b2;
+                    rf[c] = a2fi(x1 / x2);
+                    cf[c] = a2fi(x0 / x2);
                 }
-                if (false) {
-                    FixedArray<size_t, 2> i0{r, c};
-                    FixedArray<float, 2> ai0 = i2a(i0);
-                    FixedArray<float, 2> ai1 = apply_homography(homog_i, ai0);
-                    FixedArray<size_t, 2> i1 = a2i(ai1);
-                    // lerr() << "i0 " << i0 << " i1 " << i1;
-                    if (all(i1 < space_shape_f)) {
-                        for (size_t h = 0; h < im0_rgb.shape(0); ++h) {
-                            idsi_sum_(di, r, c) += std::abs(
-                                im0_rgb(h, i0(0), i0(1)) -
-                                im1_rgb(h, i1(0), i1(1)));
-                            ++nelements_idsi_(di, r, c);
-                        }
+                for (size_t c = 0; c < ncols; ++c) {
+                    sum[c] = 0.f;
+                    nsum[c] = 0;
+                    if (check_epipole && (std::abs((float)r - e(0)) < epipole_radius) && (std::abs((float)c - e(1)) < epipole_radius)) {
+                        continue;
                     }
-                } else if (false) {
-                    FixedArray<size_t, 2> i0{r, c};
-                    FixedArray<float, 2> ai0 = i2a(i0);
-                    FixedArray<float, 2> ai1 = apply_homography(homog_i, ai0);
-                    FixedArray<size_t, 2> i1 = a2i(ai1);
-                    if (all(i1 < space_shape_f)) {
-                        for (size_t h = 0; h < im0_rgb.shape(0); ++h) {
-                            idsi_sum_(di, r, c) += std::abs(
-                                im0_rgb(h, i0(0), i0(1)) -
-                                im1_rgb(h, i1(0), i1(1)));
-                            ++nelements_idsi_(di, r, c);
-                        }
+                    // The range check also rejects NaN coordinates.
+                    if (!(rf[c] < (float)nrows) || !(cf[c] < (float)ncols)) {
+                        continue;
                     }
-                } else {
                     BilinearInterpolator<float> bi;
-                    if (hs.sample_destination(r, c, space_shape_(0), space_shape_(1), bi)) {
-                        for (size_t h = 0; h < im0_rgb.shape(0); ++h) {
+                    if (bilinear_interpolation(rf[c], cf[c], nrows, ncols, bi)) {
+                        for (size_t h = 0; h < nchannels; ++h) {
                             float v = bi(im1_rgb, h);
                             if (!std::isnan(v)) {
-                                idsi_sum_(di, r, c) += std::abs(im0_rgb(h, r, c) - v);
-                                ++nelements_idsi_(di, r, c);
+                                sum[c] += std::abs(im0_rgb(h, r, c) - v);
+                                ++nsum[c];
                             }
                         }
                     }
                 }
+                uint16_t* mean = &idsi_mean_(di, r, 0);
+                uint16_t* n = &nelements_idsi_(di, r, 0);
+                for (size_t c = 0; c < ncols; ++c) {
+                    if (nsum[c] == 0) {
+                        continue;
+                    }
+                    uint32_t n_new = (uint32_t)n[c] + nsum[c];
+                    if (n_new > UINT16_MAX) {
+                        continue;
+                    }
+                    float m = (n[c] == 0) ? 0.f : half_bits_to_float(mean[c]);
+                    m += (sum[c] - (float)nsum[c] * m) / (float)n_new;
+                    mean[c] = float_to_half_bits(m);
+                    n[c] = (uint16_t)n_new;
+                }
             }
         }
     }
@@ -127,16 +161,22 @@ std::unique_ptr<CostVolume> InverseDepthCostVolumeAccumulator::get(size_t min_ch
     if (nchannel_increments_ < min_channel_increments) {
         throw std::runtime_error("nincrements is smaller than min_channel_increments");
     }
-    Array<float> res = idsi_sum_.array_array_binop(nelements_idsi_, [&](float s, size_t n) {
-        return n == 0 ? NAN : s / n;
-    });
-    Array<bool> all_set = all(nelements_idsi_ >= min_channel_increments, 0);
-    for (size_t di = 0; di < inverse_depths_.length(); ++di) {
-        for (size_t r = 0; r < res.shape(1); ++r) {
-            for (size_t c = 0; c < res.shape(2); ++c) {
-                if (!all_set(r, c)) {
-                    res(di, r, c) = NAN;
-                }
+    Array<float> res{ idsi_mean_.shape() };
+    size_t nlayers = res.shape(0);
+    size_t nrows = res.shape(1);
+    size_t ncols = res.shape(2);
+    #pragma omp parallel for
+    for (int ri = 0; ri < (int)nrows; ++ri) {
+        size_t r = (size_t)ri;
+        for (size_t c = 0; c < ncols; ++c) {
+            bool all_set = true;
+            for (size_t di = 0; di < nlayers; ++di) {
+                all_set &= (nelements_idsi_(di, r, c) >= min_channel_increments);
+            }
+            for (size_t di = 0; di < nlayers; ++di) {
+                res(di, r, c) = (!all_set || (nelements_idsi_(di, r, c) == 0))
+                    ? NAN
+                    : half_bits_to_float(idsi_mean_(di, r, c));
             }
         }
     }
@@ -1,6 +1,7 @@
 #pragma once
 #include <Mlib/Array/Array.hpp>
 #include <Mlib/Sfm/Disparity/Dsi/Cost_Volume.hpp>
+#include <cstdint>
 
 namespace Mlib {
    
@@ -19,6 +20,17 @@ private:
     Array<float> dsi_;
 };
 
+/**
+ * Accumulates the mean absolute photometric error of every
+ * (inverse depth, row, column) voxel over the channels of all frames.
+ *
+ * The volume is stored compactly as a half-precision running mean
+ * and a 16-bit sample count (4 bytes per voxel). Every frame is
+ * streamed row by row: all depth layers of one row are sampled
+ * (the homography is evaluated vectorized along the row) and
+ * merged into the running mean, without per-frame volume temporaries.
+ * Voxels stop updating once their count would exceed UINT16_MAX.
+ */
 class InverseDepthCostVolumeAccumulator: public CostVolumeAccumulator {
 public:
     InverseDepthCostVolumeAccumulator(
@@ -38,8 +50,9 @@ public:
 private:
     const ArrayShape space_shape_;
     const Array<float> inverse_depths_;
-    Array<float> idsi_sum_;
-    Array<size_t> nelements_idsi_;
+    // Half-precision bit patterns, see "half/half.h".
+    Array<uint16_t> idsi_mean_;
+    Array<uint16_t> nelements_idsi_;
     size_t nchannel_increments_;
 };
 
@@ -50,6 +50,8 @@ size_t TraceableDescriptor::descriptor_id_in_parameter_list(
             best_i1 = i1;
             second_best_dist = best_dist;
             best_dist = dist;
+        } else if (dist < second_best_dist) {
+            second_best_dist = dist;
         }
     }
     if (best_dist < squared(lowe_ratio) * second_best_dist) {
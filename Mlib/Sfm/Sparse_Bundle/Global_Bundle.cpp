@@ -403,6 +403,10 @@ size_t GlobalBundle::column_id(const XKe& xke) const {
     return xps.size() + xkis.size() + xkes.at(xke);
 }
 
+size_t GlobalBundle::npoint_columns() const {
+    return xps.size();
+}
+
 float& GlobalBundle::Jg_at(const Y& y, const XP& xp) {
     return Jg(row_id(y), column_id(xp));
 }
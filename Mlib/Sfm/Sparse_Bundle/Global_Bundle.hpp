@@ -93,6 +93,7 @@ public:
     size_t column_id(const XP& xp) const;
     size_t column_id(const XKi& xki) const;
     size_t column_id(const XKe& xke) const;
+    size_t npoint_columns() const;
     float& Jg_at(const Y& y, const XP& xp);
     float& Jg_at(const Y& y, const XKi& xki);
     float& Jg_at(const Y& y, const XKe& xke);
@@ -0,0 +1,204 @@
+#include "Schur_Bundle_Solver.hpp"
+#include <Mlib/Array/Sparse_Array.hpp>
+#include <Mlib/Math/Fixed_Cholesky.hpp>
+#include <Mlib/Math/Math.hpp>
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace Mlib;
+using namespace Mlib::Sfm;
+
+namespace {
+
+struct CameraEntry {
+    size_t column;
+    double value;
+};
+
+// Normal equations of a single point, H_pp * x_p + H_pc * x_c = b_p,
+// with the camera columns "cameras" of H_pc and E = H_pp^-1 * H_pc.
+struct PointBlock {
+    FixedArray<double, 3, 3> H_pp_inv = uninitialized;
+    FixedArray<double, 3> b_p = uninitialized;
+    std::vector<size_t> cameras;
+    std::vector<FixedArray<double, 3>> H_pc;
+    std::vector<FixedArray<double, 3>> E;
+};
+
+// Reference to the i'th camera column of a point block.
+struct PointReference {
+    size_t point;
+    size_t index;
+};
+
+FixedArray<double, 3> dot33(const FixedArray<double, 3, 3>& a, const FixedArray<double, 3>& b) {
+    FixedArray<double, 3> result = uninitialized;
+    for (size_t r = 0; r < 3; ++r) {
+        result(r) = a(r, 0) * b(0) + a(r, 1) * b(1) + a(r, 2) * b(2);
+    }
+    return result;
+}
+
+double dot3(const FixedArray<double, 3>& a, const FixedArray<double, 3>& b) {
+    return a(0) * b(0) + a(1) * b(1) + a(2) * b(2);
+}
+
+}
+
+std::optional<Array<float>> Mlib::Sfm::schur_bundle_lstsq_1d(
+    const SparseArrayCcs<float>& J,
+    const Array<float>& residual,
+    size_t npoint_columns,
+    float alpha,
+    float beta)
+{
+    if (npoint_columns % 3 != 0) {
+        THROW_OR_ABORT("Number of point columns is not a multiple of 3");
+    }
+    if (npoint_columns > J.shape(1)) {
+        THROW_OR_ABORT("Number of point columns exceeds the number of Jacobian columns");
+    }
+    if (residual.length() != J.shape(0)) {
+        THROW_OR_ABORT("Residual length does not match the number of Jacobian rows");
+    }
+    size_t npoints = npoint_columns / 3;
+    size_t ncameras = J.shape(1) - npoint_columns;
+
+    // Row-major view of the camera columns.
+    std::vector<std::vector<CameraEntry>> camera_rows(J.shape(0));
+    for (size_t c = 0; c < ncameras; ++c) {
+        for (const auto& [r, v] : J.column(npoint_columns + c)) {
+            camera_rows[r].push_back({ c, v });
+        }
+    }
+
+    // Point blocks, H_pp is damped and inverted.
+    std::vector<PointBlock> blocks(npoints);
+    std::atomic_bool point_failed = false;
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int ip = 0; ip < (int)npoints; ++ip) {
+        auto& block = blocks[(size_t)ip];
+        std::vector<std::pair<size_t, FixedArray<double, 3>>> rows;
+        for (size_t d = 0; d < 3; ++d) {
+            for (const auto& [r, v] : J.column(3 * (size_t)ip + d)) {
+                auto it = std::find_if(rows.begin(), rows.end(), [r](const auto& e){ return e.first == r; });
+                if (it == rows.end()) {
+                    rows.emplace_back(r, fixed_zeros<double, 3>());
+                    it = rows.end() - 1;
+                }
+                it->second(d) = v;
+            }
+        }
+        FixedArray<double, 3, 3> H_pp = fixed_zeros<double, 3, 3>();
+        block.b_p = 0.;
+        std::vector<std::pair<size_t, FixedArray<double, 3>>> H_pc;
+        for (const auto& [r, j] : rows) {
+            for (size_t i = 0; i < 3; ++i) {
+                for (size_t k = 0; k < 3; ++k) {
+                    H_pp(i, k) += j(i) * j(k);
+                }
+                block.b_p(i) += j(i) * residual(r);
+            }
+            for (const auto& e : camera_rows[r]) {
+                H_pc.emplace_back(e.column, j * e.value);
+            }
+        }
+        std::sort(H_pc.begin(), H_pc.end(), [](const auto& a, const auto& b){ return a.first < b.first; });
+        for (const auto& [c, h] : H_pc) {
+            if (block.cameras.empty() || (block.cameras.back() != c)) {
+                block.cameras.push_back(c);
+                block.H_pc.push_back(h);
+            } else {
+                block.H_pc.back() += h;
+            }
+        }
+        for (size_t i = 0; i < 3; ++i) {
+            H_pp(i, i) += alpha + beta * H_pp(i, i);
+        }
+        auto L = cholesky(H_pp, 1e-12);
+        if (!L.has_value()) {
+            point_failed = true;
+            continue;
+        }
+        block.H_pp_inv = solve_LU(*L, L->T(), fixed_identity_array<double, 3>());
+        block.E.reserve(block.H_pc.size());
+        for (const auto& h : block.H_pc) {
+            block.E.push_back(dot33(block.H_pp_inv, h));
+        }
+    }
+    if (point_failed) {
+        return std::nullopt;
+    }
+
+    // Points coupled to each camera column.
+    std::vector<std::vector<PointReference>> camera_points(ncameras);
+    for (size_t p = 0; p < npoints; ++p) {
+        for (size_t i = 0; i < blocks[p].cameras.size(); ++i) {
+            camera_points[blocks[p].cameras[i]].push_back({ p, i });
+        }
+    }
+
+    // Reduced camera system S * x_c = g,
+    // S = H_cc - sum_p H_cp * H_pp^-1 * H_pc, g = b_c - sum_p H_cp * H_pp^-1 * b_p.
+    // Every iteration writes the lower triangle of one row of S.
+    Array<double> S = zeros<double>(ArrayShape{ ncameras, ncameras });
+    Array<double> g = zeros<double>(ArrayShape{ ncameras });
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int ic = 0; ic < (int)ncameras; ++ic) {
+        size_t c = (size_t)ic;
+        for (const auto& [r, v] : J.column(npoint_columns + c)) {
+            for (const auto& e : camera_rows[r]) {
+                if (e.column > c) {
+                    break;
+                }
+                S(c, e.column) += v * e.value;
+            }
+            g(c) += v * residual(r);
+        }
+        S(c, c) += alpha + beta * S(c, c);
+        for (const auto& pr : camera_points[c]) {
+            const auto& block = blocks[pr.point];
+            const auto& E = block.E[pr.index];
+            for (size_t i = 0; i < block.cameras.size(); ++i) {
+                if (block.cameras[i] > c) {
+                    break;
+                }
+                S(c, block.cameras[i]) -= dot3(E, block.H_pc[i]);
+            }
+            g(c) -= dot3(E, block.b_p);
+        }
+    }
+    for (size_t r = 0; r < ncameras; ++r) {
+        for (size_t c = r + 1; c < ncameras; ++c) {
+            S(r, c) = S(c, r);
+        }
+    }
+    Array<double> x_c;
+    if (ncameras != 0) {
+        auto x = solve_symm_1d(S, g);
+        if (!x.has_value()) {
+            return std::nullopt;
+        }
+        x_c = std::move(*x);
+    }
+
+    // Back-substitution, x_p = H_pp^-1 * b_p - E * x_c.
+    Array<float> result{ ArrayShape{ J.shape(1) } };
+    #pragma omp parallel for
+    for (int ip = 0; ip < (int)npoints; ++ip) {
+        const auto& block = blocks[(size_t)ip];
+        FixedArray<double, 3> x_p = dot33(block.H_pp_inv, block.b_p);
+        for (size_t i = 0; i < block.cameras.size(); ++i) {
+            x_p -= block.E[i] * x_c(block.cameras[i]);
+        }
+        for (size_t d = 0; d < 3; ++d) {
+            result(3 * (size_t)ip + d) = (float)x_p(d);
+        }
+    }
+    for (size_t c = 0; c < ncameras; ++c) {
+        result(npoint_columns + c) = (float)x_c(c);
+    }
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <Mlib/Array/Array_Forward.hpp>
+#include <cstddef>
+#include <optional>
+
+namespace Mlib {
+
+template <class TData>
+class SparseArrayCcs;
+
+namespace Sfm {
+
+/**
+ * Solves the damped normal equations (J'J + D) * dx = J'r of a
+ * bundle adjustment problem, D(r, r) = alpha + beta * (J'J)(r, r)
+ * (the same damping as "lstsq_chol_1d").
+ *
+ * The first "npoint_columns" columns of "J" must hold the 3-D points,
+ * three consecutive columns per point. All remaining columns are camera
+ * parameters (intrinsics and extrinsics).
+ * The 3x3 point blocks are built in parallel and eliminated using the
+ * Schur complement, the reduced camera system is solved with Cholesky,
+ * and the point updates are back-substituted.
+ *
+ * Returns std::nullopt if a point block or the reduced camera system
+ * is not positive definite.
+ */
+std::optional<Array<float>> schur_bundle_lstsq_1d(
+    const SparseArrayCcs<float>& J,
+    const Array<float>& residual,
+    size_t npoint_columns,
+    float alpha = 0,
+    float beta = 0);
+
+}
+
+}
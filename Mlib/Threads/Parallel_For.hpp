@@ -0,0 +1,43 @@
+#pragma once
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <vector>
+
+namespace Mlib {
+
+/**
+ * Calls "op(i)" for every i in [0, n) in an OpenMP loop
+ * with dynamic scheduling.
+ *
+ * Exceptions must not leave an OpenMP region, so they are
+ * captured per iteration. After all iterations finished,
+ * the exception of the smallest index is rethrown, which
+ * does not depend on the number of threads.
+ */
+template <class TOperation>
+void parallel_for(size_t n, const TOperation& op, int chunk_size = 1) {
+    if (n > (size_t)std::numeric_limits<int>::max()) {
+        THROW_OR_ABORT("Too many iterations for parallel_for");
+    }
+    if (chunk_size < 1) {
+        THROW_OR_ABORT("parallel_for chunk size must be positive");
+    }
+    std::vector<std::exception_ptr> exceptions(n);
+    #pragma omp parallel for schedule(dynamic, chunk_size)
+    for (int i = 0; i < (int)n; ++i) {
+        try {
+            op((size_t)i);
+        } catch (...) {
+            exceptions[(size_t)i] = std::current_exception();
+        }
+    }
+    for (const auto& e : exceptions) {
+        if (e != nullptr) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <Mlib/Throw_Or_Abort.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace Mlib {
+
+/**
+ * Lock-free single-producer, single-consumer handoff of the latest value.
+ *
+ * The producer fills "write_buffer()" and calls "publish()", the consumer
+ * calls "latest()". Neither side ever waits for the other. Intermediate
+ * values are dropped if the producer publishes faster than the consumer reads.
+ *
+ * There must be exactly one consumer thread, because "latest()" swaps the
+ * read slot. The first thread calling "latest()" becomes the consumer,
+ * calls from any other thread throw.
+ */
+template <class T>
+class TripleBuffer {
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator = (const TripleBuffer&) = delete;
+    static const uint8_t FRESH = 4;
+    static const uint8_t INDEX_MASK = 3;
+public:
+    TripleBuffer()
+        : middle_{ 1 }
+        , write_{ 0 }
+        , read_{ 2 }
+        , received_{ false }
+        , consumer_{ std::thread::id() }
+    {}
+
+    // Producer side
+
+    T& write_buffer() {
+        return buffers_[write_];
+    }
+
+    void publish() {
+        write_ = middle_.exchange(write_ | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Consumer side
+
+    /**
+     * Returns the most recently published value,
+     * or nullptr if nothing was published yet.
+     * The result is valid until the next call of "latest()".
+     */
+    const T* latest() {
+        assert_this_thread_is_consumer();
+        if ((middle_.load(std::memory_order_relaxed) & FRESH) != 0) {
+            read_ = middle_.exchange(read_, std::memory_order_acq_rel) & INDEX_MASK;
+            received_ = true;
+        }
+        return received_ ? &buffers_[read_] : nullptr;
+    }
+
+private:
+    void assert_this_thread_is_consumer() {
+        auto id = std::this_thread::get_id();
+        auto expected = std::thread::id();
+        if (!consumer_.compare_exchange_strong(expected, id, std::memory_order_relaxed) &&
+            (expected != id))
+        {
+            THROW_OR_ABORT("Triple buffer read by more than one thread");
+        }
+    }
+    // No "alignas" here, the buffer is embedded in objects that are
+    // allocated by "make_dunique", which does not support over-alignment.
+    std::array<T, 3> buffers_;
+    std::atomic_uint8_t middle_;
+    uint8_t write_;
+    uint8_t read_;
+    bool received_;
+    std::atomic<std::thread::id> consumer_;
+};
+
+}
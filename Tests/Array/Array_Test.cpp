@@ -1,5 +1,6 @@
 #include <Mlib/Array/Array.hpp>
 #include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Array/Lazy_Array.hpp>
 #include <Mlib/Array/Sparse_Array.hpp>
 #include <Mlib/Floating_Point_Exceptions.hpp>
 #include <Mlib/Math/Math.hpp>
@@ -222,6 +223,27 @@ void test_copy() {
     assert_allclose(a, Array<float>{5, 2, 3});
 }
 
+void test_lazy_array() {
+    Array<float> a = uniform_random_array<float>(ArrayShape{ 7, 5 }, 1);
+    Array<float> b = uniform_random_array<float>(ArrayShape{ 7, 5 }, 2);
+    Array<float> c = uniform_random_array<float>(ArrayShape{ 7, 5 }, 3);
+    assert_allclose(
+        ((lazy(a) + 2.f * lazy(b)) / (1.f + c) - 3).eval(),
+        (a + 2.f * b) / (1.f + c) - 3.f);
+    assert_allclose(
+        (-lazy(a) * b).applied([](float v){ return std::abs(v); }).eval(),
+        abs(-a * b));
+    assert_isclose(lazy(a).applied([](float v){ return v * v; }).sum(), sum(squared(a)));
+    {
+        // More than one block of the parallel sum.
+        Array<double> l = uniform_random_array<double>(ArrayShape{ 300, 100 }, 4);
+        assert_isclose(lazy(l).sum(), sum(l), 1e-9);
+    }
+    Array<float> r = a.copy();
+    r = lazy(r) * 2 + a;
+    assert_allclose(r, 3.f * a);
+}
+
 void test_sparse_array2() {
     SparseArrayCcs<float> a{ArrayShape{6, 5}};
 
@@ -267,6 +289,7 @@ int main(int argc, char **argv) {
     test_fixed_array_slicing();
     test_append();
     test_copy();
+    test_lazy_array();
     test_semi_fix();
     test_fixed_array_of_string();
     return 0;
@@ -1,8 +1,14 @@
+#include <Mlib/Assert.hpp>
+#include <Mlib/Geometry/Coordinates/Homogeneous.hpp>
+#include <Mlib/Math/Fixed_Rodrigues.hpp>
 #include <Mlib/Math/Math.hpp>
 #include <Mlib/Math/Optimize/Numerical_Differentiation.hpp>
+#include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
 #include <Mlib/Sfm/Disparity/Dsi/Inverse_Depth_Cost_Volume.hpp>
 #include <Mlib/Sfm/Disparity/Regularization/Dense_Mapping.hpp>
 #include <Mlib/Sfm/Disparity/Regularization/Dense_Mapping_Common.hpp>
+#include <Mlib/Sfm/Homography/Homography_From_Transform.hpp>
+#include <Mlib/Sfm/Homography/Homography_Sampler.hpp>
 #include <Mlib/Stats/Random_Arrays.hpp>
 #include <iostream>
 #include <random>
@@ -162,9 +168,66 @@ void test_boundary_and_nan() {
     }
 }
 
+void test_inverse_depth_cost_volume() {
+    TransformationMatrix<float, float, 2> intrinsic_matrix{ FixedArray<float, 3, 3>::init(
+        20.f, 0.f, 15.f,
+        0.f, 20.f, 10.f,
+        0.f, 0.f, 1.f) };
+    Array<float> inverse_depths{ 0.1f, 0.3f, 0.5f, 1.f };
+    Array<float> im0 = uniform_random_array<float>(ArrayShape{ 3, 20, 30 }, 1);
+    std::vector<TransformationMatrix<float, float, 3>> cams;
+    std::vector<Array<float>> ims;
+    for (unsigned int i = 0; i < 3; ++i) {
+        cams.push_back(TransformationMatrix<float, float, 3>{
+            tait_bryan_angles_2_matrix(FixedArray<float, 3>{ 0.01f * (float)i, -0.02f * (float)i, 0.f }),
+            FixedArray<float, 3>{ 0.2f * (float)i, 0.1f, 0.f } });
+        ims.push_back(uniform_random_array<float>(im0.shape(), 2 + i));
+    }
+    ims[1](1, 5, 7) = NAN;
+    TransformationMatrix<float, float, 3> c0 = TransformationMatrix<float, float, 3>::identity();
+    InverseDepthCostVolumeAccumulator acc{ im0.shape().erased_first(), inverse_depths };
+    Array<float> sum = zeros<float>(ArrayShape{ inverse_depths.length() }.concatenated(im0.shape().erased_first()));
+    Array<float> n = zeros<float>(sum.shape());
+    for (size_t i = 0; i < cams.size(); ++i) {
+        acc.increment(intrinsic_matrix, c0, cams[i], im0, ims[i]);
+        // Reference, sampling every pixel with "HomographySampler".
+        TransformationMatrix<float, float, 3> ke = projection_in_reference(c0, cams[i]);
+        for (size_t di = 0; di < inverse_depths.length(); ++di) {
+            HomographySampler<float> hs{ pixel_homography(intrinsic_matrix, rotation_and_translation_to_homography(
+                ke,
+                -FixedArray<float, 3>{0.f, 0.f, 1.f},
+                1.f / inverse_depths(di))) };
+            for (size_t r = 0; r < im0.shape(1); ++r) {
+                for (size_t c = 0; c < im0.shape(2); ++c) {
+                    BilinearInterpolator<float> bi;
+                    if (hs.sample_destination(r, c, im0.shape(1), im0.shape(2), bi)) {
+                        for (size_t h = 0; h < im0.shape(0); ++h) {
+                            float v = bi(ims[i], h);
+                            if (!std::isnan(v)) {
+                                sum(di, r, c) += std::abs(im0(h, r, c) - v);
+                                ++n(di, r, c);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    Array<float> dsi = acc.get(0)->dsi();
+    Array<float> expected = sum.array_array_binop(n, [](float s, float n) {
+        return n == 0 ? NAN : s / n;
+    });
+    assert_true(all(Mlib::isnan(dsi) == Mlib::isnan(expected)));
+    Array<bool> m = !Mlib::isnan(expected);
+    assert_true(count_nonzero(m) > 0);
+    // Half precision
+    assert_allclose(dsi[m], expected[m], 2e-3f);
+}
+
 int main(int argc, char** argv) {
     test_numerical_differentiation();
     test_gauss_newton_step();
     test_boundary_and_nan();
+    test_inverse_depth_cost_volume();
     return 0;
 }
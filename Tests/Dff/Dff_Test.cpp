@@ -1,14 +1,26 @@
+#include <Mlib/Assert.hpp>
+#include <Mlib/Env.hpp>
 #include <Mlib/Floating_Point_Exceptions.hpp>
 #include <Mlib/Geometry/Material/Aggregate_Mode.hpp>
 #include <Mlib/Geometry/Material/Blend_Mode.hpp>
 #include <Mlib/Geometry/Material/Render_Pass.hpp>
 #include <Mlib/Geometry/Material/Transformation_Mode.hpp>
 #include <Mlib/Geometry/Mesh/Load/Draw_Distance_Db.hpp>
+#include <Mlib/Geometry/Mesh/Load/Img_Reader.hpp>
 #include <Mlib/Geometry/Mesh/Load/Load_Dff_Array.hpp>
 #include <Mlib/Geometry/Mesh/Load/Load_Mesh_Config.hpp>
 #include <Mlib/Geometry/Physics_Material.hpp>
 #include <Mlib/Geometry/Rectangle_Triangulation_Mode.hpp>
 #include <Mlib/Os/Os.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace Mlib;
 
@@ -36,11 +48,111 @@ static void test_teapot() {
         FrameTransformation::KEEP);
 }
 
+// Writes a synthetic GTA-style archive with entry sizes like real DFF and TXD
+// files and reads all entries with the stream-based reader and with the
+// memory-mapped dictionary, using the same thread counts for both.
+// The size of the archive in MiB is set by "IMG_ARCHIVE_MIB".
+static void test_img_archive() {
+    static const size_t sector_size = 2'048;
+    size_t archive_size = getenv_default_size_t("IMG_ARCHIVE_MIB", 256) << 20;
+    auto dir_filename = (std::filesystem::temp_directory_path() / "mlib_test_archive.dir").string();
+    auto img_filename = (std::filesystem::temp_directory_path() / "mlib_test_archive.img").string();
+    std::vector<std::string> names;
+    std::vector<size_t> expected;
+    {
+        std::ofstream dir{ dir_filename, std::ios::binary };
+        std::ofstream img{ img_filename, std::ios::binary };
+        // Log-uniform entry sizes between 4 KiB and 2 MiB.
+        std::mt19937 rng{ 42 };
+        std::uniform_real_distribution<double> log_nsectors{ std::log(2.), std::log(1'024.) };
+        std::vector<char> data;
+        uint32_t offset = 0;
+        for (size_t i = 0; (size_t)offset * sector_size < archive_size; ++i) {
+            auto nsectors = (uint32_t)std::round(std::exp(log_nsectors(rng)));
+            char entry[32] = {};
+            std::memcpy(entry, &offset, 4);
+            std::memcpy(entry + 4, &nsectors, 4);
+            auto name = "entry" + std::to_string(i) + ((i % 2 == 0) ? ".dff" : ".txd");
+            std::memcpy(entry + 8, name.data(), name.size());
+            dir.write(entry, sizeof(entry));
+            data.resize(nsectors * sector_size);
+            std::fill(data.begin(), data.end(), (char)(i % 127));
+            img.write(data.data(), integral_cast<std::streamsize>(data.size()));
+            names.push_back(name);
+            expected.push_back((i % 127) * data.size());
+            offset += nsectors;
+        }
+        assert_true(!dir.fail() && !img.fail());
+        linfo() << "IMG archive: " << names.size() << " entries, " <<
+            (((size_t)offset * sector_size) >> 20) << " MiB";
+    }
+    auto checksum = [](IIStreamDictionary& archive, const std::string& name) {
+        auto s = archive.read(name, std::ios::binary, CURRENT_SOURCE_LOCATION);
+        std::vector<char> data(integral_cast<size_t>(s.size));
+        s.stream->read(data.data(), s.size);
+        if (s.stream->fail()) {
+            THROW_OR_ABORT("Could not read \"" + name + '"');
+        }
+        size_t result = 0;
+        for (char c : data) {
+            result += (size_t)c;
+        }
+        return result;
+    };
+    // Returns the duration in seconds.
+    auto read_all = [&](IIStreamDictionary& archive, int nthreads) {
+        auto start = std::chrono::steady_clock::now();
+        size_t nerrors = 0;
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic) reduction(+:nerrors)
+        for (int i = 0; i < (int)names.size(); ++i) {
+            // Exceptions must not leave an OpenMP region.
+            try {
+                if (checksum(archive, names[(size_t)i]) != expected[(size_t)i]) {
+                    ++nerrors;
+                }
+            } catch (const std::exception& e) {
+                lerr() << e.what();
+                ++nerrors;
+            }
+        }
+        assert_true(nerrors == 0);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    std::ifstream dir{ dir_filename, std::ios::binary };
+    ImgReader stream_archive{ dir, std::make_unique<std::ifstream>(img_filename, std::ios::binary) };
+    auto mapped_archive = ImgReader::load_from_file(img_filename);
+    assert_true(mapped_archive->names().size() == names.size());
+    // The archive was just written, so both readers see a warm page cache.
+    double stream_t1 = NAN;
+    double mapped_t1 = NAN;
+    int max_threads = 1;
+#ifdef _OPENMP
+    max_threads = omp_get_max_threads();
+#endif
+    for (int nthreads = 1; ; nthreads = std::min(2 * nthreads, max_threads)) {
+        double stream_t = read_all(stream_archive, nthreads);
+        double mapped_t = read_all(*mapped_archive, nthreads);
+        if (nthreads == 1) {
+            stream_t1 = stream_t;
+            mapped_t1 = mapped_t;
+        }
+        linfo() << nthreads << " thread(s): stream-based " << stream_t << " s (speed-up " << stream_t1 / stream_t <<
+            "), memory-mapped " << mapped_t << " s (speed-up " << mapped_t1 / mapped_t <<
+            ", " << stream_t / mapped_t << "x faster than stream-based)";
+        if (nthreads == max_threads) {
+            break;
+        }
+    }
+    std::filesystem::remove(dir_filename);
+    std::filesystem::remove(img_filename);
+}
+
 int main(int argc, char** argv) {
     enable_floating_point_exceptions();
 
     try {
         test_teapot();
+        test_img_archive();
     } catch (const std::runtime_error& e) {
         lerr() << e.what();
         return 1;
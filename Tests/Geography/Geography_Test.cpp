@@ -1,10 +1,18 @@
+#include <Mlib/Array/Array.hpp>
 #include <Mlib/Assert.hpp>
 #include <Mlib/Floating_Point_Exceptions.hpp>
+#include <Mlib/Geography/Heightmaps/Load_Heightmap_From_File.hpp>
+#include <Mlib/Geography/Heightmaps/Terrarium.hpp>
+#include <Mlib/Geography/Heightmaps/Tiled_Heightmap.hpp>
 #include <Mlib/Geography/Season.hpp>
 #include <Mlib/Geography/Sun_Direction.hpp>
+#include <Mlib/Images/Bilinear_Interpolation.hpp>
 #include <Mlib/Images/StbImage1.hpp>
+#include <Mlib/Images/StbImage3.hpp>
 #include <Mlib/Physics/Units.hpp>
 #include <algorithm>
+#include <filesystem>
+#include <random>
 
 using namespace Mlib;
 
@@ -101,6 +109,78 @@ void test_season_christchurch() {
     assert_string_equals(serialize_time_point(winter, "%Y-%m-%d %H:%M:%S"), "2042-06-22 00:00:00");
 }
 
+void test_tiled_heightmap() {
+    auto filename = std::filesystem::temp_directory_path() / "mlib_test_heightmap.thm";
+    std::mt19937 gen{ 0 };
+    std::uniform_real_distribution<float> height{ 0.f, 100.f };
+    Array<float> heightmap{ ArrayShape{ 23, 17 } };
+    Array<double> expected_image{ heightmap.shape() };
+    for (size_t r = 0; r < heightmap.shape(0); ++r) {
+        for (size_t c = 0; c < heightmap.shape(1); ++c) {
+            heightmap(r, c) = height(gen);
+            expected_image(r, c) = 2. * heightmap(r, c);
+        }
+    }
+    TiledHeightmap::save(filename, heightmap, 5);
+    {
+        TiledHeightmap thm{ filename, 2., 2 };
+        assert_true(thm.shape(0) == 23);
+        assert_true(thm.shape(1) == 17);
+        std::uniform_real_distribution<double> pos{ -1., 24. };
+        std::vector<double> rows(200);
+        std::vector<double> cols(200);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            rows[i] = pos(gen);
+            cols[i] = pos(gen);
+        }
+        std::vector<double> values(rows.size());
+        std::vector<uint8_t> valid(rows.size());
+        thm(rows, cols, values, valid);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            double expected;
+            bool expected_valid = bilinear_grayscale_interpolation(rows[i], cols[i], expected_image, expected);
+            double value;
+            assert_true(thm(rows[i], cols[i], value) == expected_valid);
+            assert_true((valid[i] != 0) == expected_valid);
+            if (expected_valid) {
+                assert_isclose(value, expected, 1e-5);
+                assert_isclose(values[i], expected, 1e-5);
+            }
+        }
+        assert_true(thm.ncached_tiles() <= 2);
+    }
+    std::filesystem::remove(filename);
+}
+
+void test_convert_tiled_heightmap() {
+    auto png_filename = std::filesystem::temp_directory_path() / "mlib_test_heightmap.png";
+    auto thm_filename = std::filesystem::temp_directory_path() / "mlib_test_converted_heightmap.thm";
+    std::mt19937 gen{ 1 };
+    std::uniform_real_distribution<float> height{ -50.f, 500.f };
+    Array<float> meters{ ArrayShape{ 19, 26 } };
+    for (float& v : meters.flat_iterable()) {
+        v = height(gen);
+    }
+    StbImage3::from_rgb(meters_to_terrarium(meters)).save_to_file(png_filename.string());
+    TiledHeightmap::convert(png_filename, thm_filename, 8);
+    {
+        auto expected = load_heightmap_from_file<double>(png_filename.string());
+        TiledHeightmap thm{ thm_filename, 3., 4 };
+        assert_true(thm.shape(0) == 19);
+        assert_true(thm.shape(1) == 26);
+        for (size_t r = 0; r < thm.shape(0); ++r) {
+            for (size_t c = 0; c < thm.shape(1); ++c) {
+                double value;
+                assert_true(thm((double)r, (double)c, value));
+                assert_isclose(value, 3. * expected(r, c), 1e-4);
+                assert_isclose(value, 3. * meters(r, c), 3. / 256.);
+            }
+        }
+    }
+    std::filesystem::remove(png_filename);
+    std::filesystem::remove(thm_filename);
+}
+
 int main(int argc, const char** argv) {
     enable_floating_point_exceptions();
     test_sun_angles();
@@ -108,5 +188,7 @@ int main(int argc, const char** argv) {
     test_sun_position_day();
     test_season_berlin();
     test_season_christchurch();
+    test_tiled_heightmap();
+    test_convert_tiled_heightmap();
     return 0;
 }
@@ -5,29 +5,44 @@
 #include <Mlib/Geometry/Coordinates/Cv_Look_At.hpp>
 #include <Mlib/Geometry/Coordinates/Homogeneous.hpp>
 #include <Mlib/Geometry/Cross.hpp>
+#include <Mlib/Geometry/Exceptions/Point_Exception.hpp>
 #include <Mlib/Geometry/Fixed_Cross.hpp>
 #include <Mlib/Geometry/Intersection/Bvh.hpp>
 #include <Mlib/Geometry/Intersection/Caching_Bvh.hpp>
 #include <Mlib/Geometry/Intersection/Distange_Polygon_Aabb.hpp>
+#include <Mlib/Geometry/Intersection/Dynamic_Bvh.hpp>
 #include <Mlib/Geometry/Intersection/Frustum3.hpp>
 #include <Mlib/Geometry/Intersection/Intersect_Lines.hpp>
 #include <Mlib/Geometry/Intersection/Octree.hpp>
 #include <Mlib/Geometry/Intersection/Point_Triangle_Intersection.hpp>
 #include <Mlib/Geometry/Intersection/Ray_Sphere_Intersection.hpp>
+#include <Mlib/Geometry/Intersection/Spatial_Hash.hpp>
 #include <Mlib/Geometry/Intersection/Welzl.hpp>
+#include <Mlib/Geometry/Intersection/Collision_Line.hpp>
+#include <Mlib/Geometry/Intersection/Collision_Polygon.hpp>
+#include <Mlib/Geometry/Intersection/Collision_Ridge.hpp>
+#include <Mlib/Geometry/Mesh/Collision_Ridges.hpp>
 #include <Mlib/Geometry/Mesh/Contour.hpp>
 #include <Mlib/Geometry/Mesh/Contour_Detection_Strategy.hpp>
+#include <Mlib/Geometry/Mesh/Convex_Hitbox.hpp>
 #include <Mlib/Geometry/Mesh/Interpolated_Intermediate_Points_Creator.hpp>
 #include <Mlib/Geometry/Mesh/Lines_To_Rectangles.hpp>
+#include <Mlib/Geometry/Mesh/Load/Load_Bvh.hpp>
 #include <Mlib/Geometry/Mesh/Point_And_Flags.hpp>
 #include <Mlib/Geometry/Mesh/Points_And_Adjacency.hpp>
 #include <Mlib/Geometry/Mesh/Points_And_Adjacency_Impl.hpp>
 #include <Mlib/Geometry/Mesh/Quad_Area.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Convex_Hitbox.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Normals.hpp>
+#include <Mlib/Geometry/Mesh/Sat_Overlap.hpp>
 #include <Mlib/Geometry/Mesh/Save_Obj.hpp>
+#include <Mlib/Geometry/Mesh/Static_Transformed_Mesh.hpp>
+#include <Mlib/Geometry/Mesh/Tiled_Triangulation.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_Area.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_Largest_Cosine.hpp>
 #include <Mlib/Geometry/Mesh/Triangle_List.hpp>
 #include <Mlib/Geometry/Mesh/Triangulate_3D.hpp>
+#include <Mlib/Geometry/Mesh/Typed_Mesh.hpp>
 #include <Mlib/Geometry/Physics_Material.hpp>
 #include <Mlib/Geometry/Polygon_3D.hpp>
 #include <Mlib/Geometry/Ray_Segment_3D.hpp>
@@ -42,7 +57,9 @@
 #include <Mlib/Math/Orderable_Fixed_Array.hpp>
 #include <Mlib/Math/Rodrigues.hpp>
 #include <Mlib/Stats/Random_Arrays.hpp>
+#include <Mlib/Stats/Random_Number_Generators.hpp>
 #include <poly2tri/poly2tri.h>
+#include <set>
 
 using namespace Mlib;
 
@@ -339,6 +356,212 @@ void test_bvh() {
         });
 }
 
+void test_dynamic_bvh() {
+    using AABB = AxisAlignedBoundingBox<float, 3>;
+    DynamicBvh<float, 3, size_t> bvh;
+    std::vector<AABB> boxes;
+    std::vector<size_t> leaves;
+    auto box = [](float x, float y){
+        return AABB::from_min_max({x, y, 0.f}, {x + 1.f, y + 1.f, 1.f});
+    };
+    for (size_t i = 0; i < 100; ++i) {
+        boxes.push_back(box(float(i % 10) * 3.f, float(i / 10) * 3.f));
+        leaves.push_back(bvh.insert(boxes.back(), i));
+    }
+    auto count = [&](const AABB& query){
+        size_t n = 0;
+        bvh.visit(query, [&](size_t i){
+            assert_true(boxes[i].intersects(query));
+            ++n;
+            return true;
+        });
+        size_t n_expected = 0;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if ((leaves[i] != SIZE_MAX) && boxes[i].intersects(query)) {
+                ++n_expected;
+            }
+        }
+        assert_isequal(n, n_expected);
+        return n;
+    };
+    assert_isequal(count(box(0.f, 0.f)), (size_t)1);
+    for (size_t i = 0; i < 100; i += 2) {
+        boxes[i] = box(0.5f, 0.5f);
+        bvh.move(leaves[i], boxes[i]);
+    }
+    assert_isequal(count(box(0.f, 0.f)), (size_t)50);
+    bvh.rebalance();
+    assert_isequal(count(box(0.f, 0.f)), (size_t)50);
+    for (size_t i = 0; i < 100; i += 4) {
+        bvh.remove(leaves[i]);
+        leaves[i] = SIZE_MAX;
+    }
+    assert_isequal(bvh.size(), (size_t)75);
+    assert_isequal(count(box(0.f, 0.f)), (size_t)25);
+    assert_isequal(count(AABB::from_min_max({-1.f, -1.f, -1.f}, {40.f, 40.f, 2.f})), (size_t)75);
+}
+
+void test_spatial_hash() {
+    using Hash = SpatialHash<double, int>;
+    Hash hash{ 10. };
+    // Cells: (0, 0), (-1, -1), (-1, 0), (2, 0), (0, 0) at a large height.
+    hash.insert({ 9.5, 0., 9.5 }, 0);
+    hash.insert({ -0.5, 0., -0.5 }, 1);
+    hash.insert({ -9.5, 0., 0.1 }, 2);
+    hash.insert({ 25., 0., 5. }, 3);
+    hash.insert({ 5., 100., 5. }, 4);
+    assert_true(all(hash.cell(-0.5, -0.5) == FixedArray<int, 2>{ -1, -1 }));
+    assert_true(all(hash.cell(-10., 10.) == FixedArray<int, 2>{ -1, 1 }));
+    auto query = [&](const FixedArray<double, 3>& center, double radius) {
+        std::set<int> result;
+        hash.visit(center, radius, [&](int i, const FixedArray<double, 3>& position) {
+            assert_true(sum(squared(position - center)) <= squared(radius));
+            assert_true(result.insert(i).second);
+            return true;
+        });
+        return result;
+    };
+    // Radius across the border between cells (0, 0) and (-1, *).
+    assert_true((query({ 0.1, 0., 0.1 }, 1.) == std::set<int>{ 1 }));
+    assert_true((query({ 0.1, 0., 0.1 }, 10.) == std::set<int>{ 1, 2 }));
+    // Negative coordinates only.
+    assert_true((query({ -5., 0., -5. }, 6.5) == std::set<int>{ 1 }));
+    assert_true(query({ -15., 0., -15. }, 5.).empty());
+    // Three cells away from the center cell.
+    assert_true((query({ 0., 0., 0. }, 25.6) == std::set<int>{ 0, 1, 2, 3 }));
+    // Within the radius in the xz-plane, but not in 3D.
+    assert_true((query({ 5., 0., 5. }, 50.) == std::set<int>{ 0, 1, 2, 3 }));
+    assert_true((query({ 5., 90., 5. }, 50.) == std::set<int>{ 4 }));
+    // Aborting the visit.
+    size_t nvisited = 0;
+    assert_true(!hash.visit({ 0., 0., 0. }, 30., [&](int, const FixedArray<double, 3>&) {
+        ++nvisited;
+        return false;
+    }));
+    assert_isequal(nvisited, (size_t)1);
+    hash.clear();
+    assert_true(hash.empty());
+    assert_true(query({ 0., 0., 0. }, 1e3).empty());
+}
+
+void test_convex_hitbox_sat() {
+    using P = CompressedScenePos;
+    auto rng = welzl_rng();
+    auto cube = [&](ScenePos x){
+        auto c = [&](ScenePos dx, ScenePos dy, ScenePos dz){
+            return FixedArray<P, 3>{ (P)(x + dx), (P)dy, (P)dz };
+        };
+        auto q = [&](const FixedArray<P, 3>& a, const FixedArray<P, 3>& b, const FixedArray<P, 3>& c, const FixedArray<P, 3>& d){
+            Quad3D<P> poly{ FixedArray<P, 4, 3>{ a, b, c, d } };
+            return CollisionPolygonSphere<P, 4>{
+                .bounding_sphere = poly.bounding_sphere(rng),
+                .polygon = poly.polygon().template casted<SceneDir, P>(),
+                .physics_material = PhysicsMaterial::ATTR_CONVEX,
+                .corners = poly.vertices()
+            };
+        };
+        auto h = 0.5;
+        return std::vector<CollisionPolygonSphere<P, 4>>{
+            q(c(-h, -h, -h), c(-h, +h, -h), c(+h, +h, -h), c(+h, -h, -h)),
+            q(c(-h, -h, +h), c(+h, -h, +h), c(+h, +h, +h), c(-h, +h, +h)),
+            q(c(-h, -h, -h), c(+h, -h, -h), c(+h, -h, +h), c(-h, -h, +h)),
+            q(c(-h, +h, -h), c(-h, +h, +h), c(+h, +h, +h), c(+h, +h, -h)),
+            q(c(-h, -h, -h), c(-h, -h, +h), c(-h, +h, +h), c(-h, +h, -h)),
+            q(c(+h, -h, -h), c(+h, +h, -h), c(+h, +h, +h), c(+h, -h, +h))};
+    };
+    auto q0 = cube(0.);
+    auto q1 = cube(0.8);
+    auto h0 = ConvexHitboxVariant::from_polygons(q0, {});
+    auto h1 = ConvexHitboxVariant::from_polygons(q1, {});
+    assert_true(std::holds_alternative<BoxHitbox>(h0.hitbox));
+    assert_true(std::holds_alternative<BoxHitbox>(h1.hitbox));
+    assert_true(!ConvexHitboxVariant::from_polygons({ q0[0], q0[1] }, {}).has_value());
+    ScenePos overlap;
+    FixedArray<SceneDir, 3> normal = uninitialized;
+    assert_true(get_overlap_convex_hitboxes(h0, h1, overlap, normal));
+    assert_isclose<ScenePos>(overlap, 0.2, 1e-3);
+    assert_allclose(normal, FixedArray<SceneDir, 3>{ 1.f, 0.f, 0.f });
+    // The face axis agrees with the generic signed overlap.
+    assert_isclose<ScenePos>(
+        sat_overlap_signed(normal, std::get<BoxHitbox>(h0.hitbox).vertices, std::get<BoxHitbox>(h1.hitbox).vertices),
+        overlap,
+        1e-6);
+    assert_true(!get_overlap_convex_hitboxes(h0, ConvexHitboxVariant{}, overlap, normal));
+}
+
+void test_convex_hitbox_sat_rotated() {
+    using P = CompressedScenePos;
+    auto rng = welzl_rng();
+    // Unit cube, rotated by "R" and translated by "t".
+    auto cube = [&](const FixedArray<ScenePos, 3, 3>& R, const FixedArray<ScenePos, 3>& t){
+        auto c = [&](ScenePos dx, ScenePos dy, ScenePos dz){
+            return (dot1d(R, FixedArray<ScenePos, 3>{ dx, dy, dz }) + t).casted<P>();
+        };
+        auto q = [&](const FixedArray<P, 3>& a, const FixedArray<P, 3>& b, const FixedArray<P, 3>& c, const FixedArray<P, 3>& d){
+            Quad3D<P> poly{ FixedArray<P, 4, 3>{ a, b, c, d } };
+            return CollisionPolygonSphere<P, 4>{
+                .bounding_sphere = poly.bounding_sphere(rng),
+                .polygon = poly.polygon().template casted<SceneDir, P>(),
+                .physics_material = PhysicsMaterial::ATTR_CONVEX,
+                .corners = poly.vertices()
+            };
+        };
+        auto h = 0.5;
+        std::vector<CollisionPolygonSphere<P, 4>> quads{
+            q(c(-h, -h, -h), c(-h, +h, -h), c(+h, +h, -h), c(+h, -h, -h)),
+            q(c(-h, -h, +h), c(+h, -h, +h), c(+h, +h, +h), c(-h, +h, +h)),
+            q(c(-h, -h, -h), c(+h, -h, -h), c(+h, -h, +h), c(-h, -h, +h)),
+            q(c(-h, +h, -h), c(-h, +h, +h), c(+h, +h, +h), c(+h, +h, -h)),
+            q(c(-h, -h, -h), c(-h, -h, +h), c(-h, +h, +h), c(-h, +h, -h)),
+            q(c(+h, -h, -h), c(+h, +h, -h), c(+h, +h, +h), c(+h, -h, +h))};
+        CollisionRidges<P> collision_ridges;
+        for (const auto& p : quads) {
+            collision_ridges.insert(p.corners, p.polygon.plane.normal, 1e-4f, PhysicsMaterial::ATTR_CONVEX);
+        }
+        std::vector<CollisionRidgeSphere<P>> ridges;
+        for (const auto& e : collision_ridges) {
+            if (e.collision_ridge_sphere.is_touchable(SingleFaceBehavior::UNTOUCHABLE)) {
+                ridges.emplace_back(e.collision_ridge_sphere).finalize();
+            }
+        }
+        auto r = std::sqrt(3.) * h + 1e-3;
+        return std::make_unique<StaticTransformedMesh>(
+            "cube",
+            AxisAlignedBoundingBox<P, 3>::from_min_max((t - r).casted<P>(), (t + r).casted<P>()),
+            BoundingSphere<P, 3>{ t.casted<P>(), (P)r },
+            std::move(quads),
+            std::vector<CollisionPolygonSphere<P, 3>>{},
+            std::vector<CollisionLineSphere<P>>{},
+            std::vector<CollisionLineSphere<P>>{},
+            std::move(ridges),
+            std::vector<TypedMesh<std::shared_ptr<IIntersectable>>>{});
+    };
+    UniformRandomNumberGenerator<ScenePos> angle_rng{ 1, -M_PI, M_PI };
+    UniformRandomNumberGenerator<ScenePos> offset_rng{ 2, -0.5, 0.5 };
+    for (size_t i = 0; i < 100; ++i) {
+        auto m0 = cube(
+            tait_bryan_angles_2_matrix(FixedArray<ScenePos, 3>{ angle_rng(), angle_rng(), angle_rng() }),
+            fixed_zeros<ScenePos, 3>());
+        auto m1 = cube(
+            tait_bryan_angles_2_matrix(FixedArray<ScenePos, 3>{ angle_rng(), angle_rng(), angle_rng() }),
+            FixedArray<ScenePos, 3>{ offset_rng(), offset_rng(), offset_rng() });
+        assert_true(std::holds_alternative<BoxHitbox>(m0->get_convex_hitbox().hitbox));
+        assert_true(std::holds_alternative<BoxHitbox>(m1->get_convex_hitbox().hitbox));
+        ScenePos overlap_hitbox;
+        ScenePos overlap_generic;
+        FixedArray<SceneDir, 3> normal_hitbox = uninitialized;
+        FixedArray<SceneDir, 3> normal_generic = uninitialized;
+        get_overlap(*m0, *m1, overlap_hitbox, normal_hitbox);
+        get_overlap_polygons(*m0, *m1, overlap_generic, normal_generic);
+        assert_isclose<ScenePos>(overlap_hitbox, overlap_generic, 1e-3);
+        // Ties between axes may select different normals with the same overlap.
+        assert_isclose<ScenePos>(
+            sat_overlap_signed(normal_hitbox, m0->get_vertices(), m1->get_vertices()),
+            overlap_generic,
+            1e-3);
+    }
+}
+
 void test_bvh_performance() {
     using AABB = AxisAlignedBoundingBox<float, 3>;
     {
@@ -783,11 +1006,133 @@ void test_touching_holes() {
     // plot_tris("/tmp/tris_test.obj", result);
 }
 
+void test_indexed_bvh_frame() {
+    {
+        std::ofstream ostr("test_indexed_bvh_frame.bvh");
+        ostr <<
+            "HIERARCHY\n"
+            "ROOT hips\n"
+            "{\n"
+            "  OFFSET 0 1 0\n"
+            "  CHANNELS 6 Xposition Yposition Zposition Zrotation Xrotation Yrotation\n"
+            "  JOINT spine\n"
+            "  {\n"
+            "    OFFSET 0 0.5 0\n"
+            "    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+            "    JOINT head\n"
+            "    {\n"
+            "      OFFSET 0 0.3 0.1\n"
+            "      CHANNELS 3 Zrotation Xrotation Yrotation\n"
+            "      End Site\n"
+            "      {\n"
+            "        OFFSET 0 0.1 0\n"
+            "      }\n"
+            "    }\n"
+            "  }\n"
+            "  JOINT leg\n"
+            "  {\n"
+            "    OFFSET 0.2 -0.5 0\n"
+            "    CHANNELS 3 Zrotation Xrotation Yrotation\n"
+            "  }\n"
+            "}\n"
+            "MOTION\n"
+            "Frames: 4\n"
+            "Frame Time: 0.1\n"
+            "0 1 0 0 0 0 10 0 0 0 0 0 0 0 0\n"
+            "0.1 1 0 10 20 170 20 5 0 0.1 0 0 -30 0 0\n"
+            "0.2 1.1 0 -170 20 -170 30 0 0 0.2 0 0 -60 0 0\n"
+            "0.3 1 0.1 40 0 10 10 0 5 0.3 0.1 0 -30 0 0\n";
+    }
+    BvhLoader loader{ "test_indexed_bvh_frame.bvh", BvhConfig{ .smooth_radius = 0 } };
+    for (float time : { 0.f, 0.04f, 0.1f, 0.17f, 0.25f, 0.33f, 0.4f, 1.f }) {
+        auto expected = loader.get_absolute_interpolated_frame(time);
+        auto indexed = loader.get_indexed_absolute_interpolated_frame(time);
+        assert_isequal(indexed.size(), expected.size());
+        for (const auto& [name, e] : expected) {
+            const auto& a = indexed.at(loader.joint_index(name));
+            assert_allclose(a.t, e.t, 1e-5f);
+            assert_allclose(a.q.to_rotation_matrix(), e.q.to_rotation_matrix(), 1e-5f);
+        }
+    }
+}
+
+void test_tiled_triangulation() {
+    using P2 = FixedArray<CompressedScenePos, 2>;
+    auto p = [](double x, double y) { return P2{ (CompressedScenePos)x, (CompressedScenePos)y }; };
+    // The first tile boundaries are at the smallest coordinate minus one quantum,
+    // plus multiples of the tile size.
+    auto quantum = CompressedScenePos::from_count(1);
+    auto l = (CompressedScenePos)256. - quantum;
+    auto d = (CompressedScenePos)20.;
+    std::vector<std::vector<P2>> contours{
+        // Inside of a single tile
+        {p(30, 20), p(40, 20), p(40, 40), p(20, 40)},
+        // Crossing the tile boundaries
+        {p(300, 300), p(700, 300), p(700, 700), p(300, 700)},
+        // Passing through a tile corner, which moves the tile boundary
+        {P2{ l - d, l - d }, P2{ l + d, l + d }, P2{ l - d, l + d }},
+        // Bounding contour
+        {p(0, 0), p(1000, 0), p(1000, 1000), p(0, 1000)}};
+    std::list<P2> steiner_points;
+    for (double x = 5; x < 1000; x += 37) {
+        for (double y = 7; y < 1000; y += 41) {
+            steiner_points.push_back(p(x, y));
+        }
+    }
+    auto triangles = triangulate_tiled(
+        contours,
+        steiner_points,
+        (CompressedScenePos)256.,
+        (CompressedScenePos)50.,
+        1.);
+    assert_isequal(triangles.size(), contours.size());
+    double expected_areas[] = { 300., 160'000., 800., 1'000'000. - 160'000. - 800. - 300. };
+    for (size_t i = 0; i < contours.size(); ++i) {
+        double area = 0.;
+        for (const auto& t : triangles[i]) {
+            area += triangle_area(funpack(t));
+        }
+        assert_isclose(area, expected_areas[i], 1e-3);
+    }
+    // The tiles share the vertices of their boundaries, i.e. no vertex
+    // lies in the interior of the edge of another triangle (T-junction).
+    std::set<OrderableFixedArray<CompressedScenePos, 2>> vertices;
+    for (const auto& ts : triangles) {
+        for (const auto& t : ts) {
+            for (size_t i = 0; i < 3; ++i) {
+                vertices.insert(OrderableFixedArray<CompressedScenePos, 2>{ t[i] });
+            }
+        }
+    }
+    for (const auto& ts : triangles) {
+        for (const auto& t : ts) {
+            for (size_t i = 0; i < 3; ++i) {
+                auto a = funpack(t[i]);
+                auto b = funpack(t[(i + 1) % 3]);
+                auto ab = b - a;
+                double len2 = sum(squared(ab));
+                for (const auto& v : vertices) {
+                    auto av = funpack(v) - a;
+                    double s = dot0d(av, ab) / len2;
+                    if ((s <= 1e-9) || (s >= 1 - 1e-9)) {
+                        continue;
+                    }
+                    double cross = ab(0) * av(1) - ab(1) * av(0);
+                    if (std::abs(cross) < 1e-9 * len2) {
+                        THROW_OR_ABORT2((PointException<CompressedScenePos, 2>{ v, "T-junction in tiled triangulation" }));
+                    }
+                }
+            }
+        }
+    }
+}
+
 int main(int argc, const char** argv) {
     enable_floating_point_exceptions();
 
     try {
         test_touching_holes();
+        test_tiled_triangulation();
 
         test_special_tait_bryan_angles();
         test_tait_bryan_angles_2_matrix();
@@ -806,6 +1151,10 @@ int main(int argc, const char** argv) {
         test_lines_to_rectangles();
         test_inverse_rodrigues();
         test_bvh();
+        test_dynamic_bvh();
+        test_spatial_hash();
+        test_convex_hitbox_sat();
+        test_convex_hitbox_sat_rotated();
         // test_bvh_performance();
         test_ray_segment_intersects_aabb();
         test_roundness_estimator();
@@ -826,6 +1175,7 @@ int main(int argc, const char** argv) {
         test_ray_sphere_intersection();
         test_distance_polygon_aabb();
         test_plane_shift();
+        test_indexed_bvh_frame();
     } catch (const std::runtime_error& e) {
         lerr() << e.what();
         return 1;
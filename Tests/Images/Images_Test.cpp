@@ -148,6 +148,28 @@ void test_median_filter_2d() {
         {NAN, NAN, NAN, NAN, NAN, NAN, NAN}});
 }
 
+void test_rank_filter_2d() {
+    Array<float> im = uniform_random_array<float>(ArrayShape{ 23, 31 }, 1);
+    for (size_t r = 0; r < 23; r += 3) {
+        im(r, (r * 7) % 31) = NAN;
+    }
+    Array<uint8_t> im8 = (255.f * im).applied<uint8_t>([](float v){ return std::isnan(v) ? 0 : (uint8_t)v; });
+    Array<uint16_t> im16 = (60000.f * im).applied<uint16_t>([](float v){ return std::isnan(v) ? 0 : (uint16_t)v; });
+    for (size_t window_size : { 0, 1, 3 }) {
+        for (double rank : { 0., 0.1, 0.5, 1. }) {
+            assert_allclose(
+                rank_filter_2d(im, window_size, rank, 5, NAN),
+                rank_filter_2d_naive(im, window_size, rank, 5, NAN));
+            assert_true(all(
+                rank_filter_2d(im8, window_size, rank, 1, (uint8_t)0) ==
+                rank_filter_2d_naive(im8, window_size, rank, 1, (uint8_t)0)));
+            assert_true(all(
+                rank_filter_2d(im16, window_size, rank, 1, (uint16_t)0) ==
+                rank_filter_2d_naive(im16, window_size, rank, 1, (uint16_t)0)));
+        }
+    }
+}
+
 void test_up_sample2() {
     Array<float> im{
         {2, 3, 4, 5},
@@ -183,6 +205,43 @@ void test_lowpass() {
             {0, 0, 0, 0, 0}});
 }
 
+void test_tiled_separable_filter() {
+    Array<float> im = uniform_random_array<float>(ArrayShape{ 3, 21, 37 }, 1);
+    im(1, 5, 7) = NAN;
+    im(2, 10, 0) = NAN;
+    Array<float> coeffs{ 1, 3, 4, 3, 1, 0.5 };
+    for (size_t axis = 0; axis < 3; ++axis) {
+        for (auto fc : { FilterExtension::NONE, FilterExtension::NWE, FilterExtension::NWE | FilterExtension::PERIODIC }) {
+            assert_allclose(
+                lowpass_filter_1d_NWE(im, coeffs, NAN, axis, fc),
+                lowpass_filter_1d_NWE_naive(im, coeffs, NAN, axis, fc),
+                1e-5f);
+        }
+    }
+    // Kernels with a negative sum of weights.
+    Array<float> coeffs_neg{ 1, -4, 1 };
+    for (size_t axis = 0; axis < 3; ++axis) {
+        assert_allclose(
+            lowpass_filter_1d_NWE(im, coeffs_neg, NAN, axis, FilterExtension::NWE),
+            lowpass_filter_1d_NWE_naive(im, coeffs_neg, NAN, axis, FilterExtension::NWE),
+            1e-5f);
+    }
+    Array<float> im2 = uniform_random_array<float>(ArrayShape{ 50, 300 }, 2);
+    im2(20, 100) = NAN;
+    for (size_t axis = 0; axis < 2; ++axis) {
+        float sigma = 2 * RECURSIVE_GAUSSIAN_MIN_SIGMA;
+        Array<float> coeffs2{ ArrayShape{ 1 + 2 * size_t(4 * sigma) } };
+        size_t cdist = coeffs2.length() / 2;
+        for (size_t i = 0; i < coeffs2.length(); ++i) {
+            coeffs2(i) = std::exp(-squared(((float)i - (float)cdist) / sigma) / 2);
+        }
+        assert_allclose(
+            gaussian_filter_1d_NWE(im2, sigma, axis, NAN),
+            lowpass_filter_1d_NWE_naive(im2, coeffs2, NAN, axis),
+            5e-3f);
+    }
+}
+
 void test_color_spaces() {
     Array<float> a = uniform_random_array<float>(ArrayShape{3, 4, 5}, 1);
     assert_allclose(yuv2rgb(rgb2yuv(a)), a, 1e-5f);
@@ -322,7 +381,9 @@ int main(int argc, char **argv) {
         test_pyramid();
         test_quantize();
         test_median_filter_2d();
+        test_rank_filter_2d();
         test_lowpass();
+        test_tiled_separable_filter();
         test_color_spaces();
         test_central_differences();
         test_small_boxes();
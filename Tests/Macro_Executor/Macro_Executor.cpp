@@ -1,3 +1,4 @@
+#include <Mlib/Assert.hpp>
 #include <Mlib/Env.hpp>
 #include <Mlib/Macro_Executor/Asset_References.hpp>
 #include <Mlib/Macro_Executor/Json_Expression.hpp>
@@ -43,6 +44,24 @@ void test_eval() {
     linfo() << "eval " << eval<bool>("%%levels/aircraft_carrier0/game_modes == 'hello'", JsonView{ nlohmann::json::object() });
 }
 
+void test_eval_cached() {
+    auto vars = nlohmann::json::object();
+    vars["a"] = "x";
+    vars["b"] = true;
+    vars["d"] = { { "k", 5 } };
+    vars["name"] = "k";
+    for (size_t i = 0; i < 2; ++i) {
+        assert_true(eval<bool>("%a in {'x', 'y'}", JsonView{ vars }) == (i == 0));
+        assert_true(eval<bool>("%a not in {'y', %a}", JsonView{ vars }) == false);
+        assert_true(eval<bool>("!b", JsonView{ vars }) == (i != 0));
+        assert_true(eval<std::string>("pre_$a-post", JsonView{ vars }) == (i == 0 ? "pre_xpost" : "pre_zpost"));
+        assert_true(eval("%/d/$name", JsonView{ vars }) == 5);
+        assert_true(eval("{1, 2.5}", JsonView{ vars }) == nlohmann::json(std::set<nlohmann::json>{ 1, 2.5 }));
+        vars["a"] = "z";
+        vars["b"] = false;
+    }
+}
+
 int main(int argc, char** argv) {
 #ifndef __ANDROID__
     set_app_reldir("macro_executor_test");
@@ -50,6 +69,7 @@ int main(int argc, char** argv) {
     try {
         test_json();
         test_eval();
+        test_eval_cached();
     } catch (const std::runtime_error& e) {
         lerr() << e.what();
         return 1;
@@ -28,6 +28,7 @@
 #include <Mlib/Stats/Mean.hpp>
 #include <Mlib/Stats/Random_Arrays.hpp>
 #include <Mlib/Time/Time_Guard.hpp>
+#include <chrono>
 
 using namespace Mlib;
 
@@ -43,6 +44,49 @@ void test_blocking_transposed() {
     TimeGuard::print_groups(lraw().ref());
 }
 
+void test_blocked_gemm() {
+    Array<double> a = uniform_random_array<double>(ArrayShape{ 150, 170 }, 1);
+    Array<double> b = uniform_random_array<double>(ArrayShape{ 170, 130 }, 2);
+    {
+        Array<double> expected{ ArrayShape{ 150, 130 } };
+        dot2d_naive(a, b, expected);
+        assert_allclose(dot2d(a, b), expected, 1e-10);
+        assert_allclose(dot2d(b.vH(), a.vH()), expected.H(), 1e-10);
+    }
+    {
+        Array<double> expected{ ArrayShape{ 150, 150 } };
+        outer2d_naive(a, a, expected);
+        assert_allclose(outer2d(a, a), expected, 1e-10);
+        assert_allclose(syrk(a.vH()), expected, 1e-10);
+    }
+    {
+        // Symmetric positive definite matrix, larger than one Cholesky block.
+        Array<double> c = uniform_random_array<double>(ArrayShape{ 300, 200 }, 3);
+        Array<double> A = syrk(c) + 300. * identity_array<double>(200);
+        auto L = cholesky(A);
+        assert_true(L.has_value());
+        assert_allclose(outer2d(*L, *L), A, 1e-8);
+        Array<double> N = A;
+        N(150, 150) = -1;
+        assert_true(!cholesky(N, 1e-12).has_value());
+    }
+    // Benchmark against the reference implementation.
+    for (size_t n : { 128, 256, 512 }) {
+        Array<float> x = uniform_random_array<float>(ArrayShape{ n, n }, 4);
+        Array<float> y = uniform_random_array<float>(ArrayShape{ n, n }, 5);
+        Array<float> r{ ArrayShape{ n, n } };
+        auto t0 = std::chrono::steady_clock::now();
+        dot2d_naive(x, y, r);
+        auto t1 = std::chrono::steady_clock::now();
+        dot2d(x, y, r);
+        auto t2 = std::chrono::steady_clock::now();
+        linfo() <<
+            "gemm n=" << n <<
+            " naive: " << std::chrono::duration<double>(t1 - t0).count() << " s" <<
+            ", blocked: " << std::chrono::duration<double>(t2 - t1).count() << " s";
+    }
+}
+
 void test_svd() {
     Array<float> a = random_array<float>(ArrayShape{3, 2});
     Array<float> uT;
@@ -537,6 +581,7 @@ void test_inv() {
 int main(int argc, const char** argv) {
     try {
         test_blocking_transposed();
+        test_blocked_gemm();
         test_svd();
         test_svd_j();
         test_qdq();
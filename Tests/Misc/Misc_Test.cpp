@@ -12,7 +12,9 @@
 #include <Mlib/Regex/Misc.hpp>
 #include <Mlib/Regex/Template_Regex.hpp>
 #include <Mlib/Threads/Dispatcher.hpp>
+#include <Mlib/Threads/Parallel_For.hpp>
 #include <Mlib/Threads/Recursive_Shared_Mutex.hpp>
+#include <Mlib/Threads/Triple_Buffer.hpp>
 #include <Mlib/Try_Find.hpp>
 #include <iostream>
 
@@ -263,6 +265,68 @@ void test_thread_safe_list() {
     }
 }
 
+void test_triple_buffer() {
+    TripleBuffer<std::array<size_t, 16>> buffer;
+    assert_true(buffer.latest() == nullptr);
+    static const size_t n = 100'000;
+    std::thread producer{[&](){
+        for (size_t i = 1; i <= n; ++i) {
+            buffer.write_buffer().fill(i);
+            buffer.publish();
+        }
+    }};
+    size_t last = 0;
+    while (last != n) {
+        const auto* v = buffer.latest();
+        if (v == nullptr) {
+            continue;
+        }
+        for (size_t e : *v) {
+            assert_true(e == (*v)[0]);
+        }
+        assert_true((*v)[0] >= last);
+        last = (*v)[0];
+    }
+    producer.join();
+#ifndef WITHOUT_EXCEPTIONS
+    bool second_consumer_failed = false;
+    std::thread second_consumer{[&](){
+        try {
+            buffer.latest();
+        } catch (const std::runtime_error&) {
+            second_consumer_failed = true;
+        }
+    }};
+    second_consumer.join();
+    assert_true(second_consumer_failed);
+#endif
+}
+
+void test_parallel_for() {
+    std::vector<size_t> visited(1000, 0);
+    parallel_for(visited.size(), [&](size_t i){
+        visited[i] += i;
+    }, 7);
+    for (size_t i = 0; i < visited.size(); ++i) {
+        assert_true(visited[i] == i);
+    }
+#ifndef WITHOUT_EXCEPTIONS
+    // The exception of the smallest index is rethrown,
+    // independent of the order in which the threads finish.
+    std::string message;
+    try {
+        parallel_for(visited.size(), [&](size_t i){
+            if (i % 100 == 37) {
+                throw std::runtime_error("Iteration " + std::to_string(i));
+            }
+        });
+    } catch (const std::runtime_error& e) {
+        message = e.what();
+    }
+    assert_true(message == "Iteration 37");
+#endif
+}
+
 int main(int argc, const char** argv) {
     enable_floating_point_exceptions();
 
@@ -282,6 +346,8 @@ int main(int argc, const char** argv) {
         test_try_find();
         test_log();
         test_atomic_recursive_shared_mutex();
+        test_triple_buffer();
+        test_parallel_for();
     } catch (const std::runtime_error& e) {
         lerr() << "Test failed: " << e.what();
         return 1;
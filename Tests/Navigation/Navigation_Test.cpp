@@ -0,0 +1,173 @@
+#include <Mlib/Assert.hpp>
+#include <Mlib/Floating_Point_Exceptions.hpp>
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Mesh/Indexed_Face_Set.hpp>
+#include <Mlib/Math/Fixed_Math.hpp>
+#include <Mlib/Math/Fixed_Test.hpp>
+#include <Mlib/Math/Math.hpp>
+#include <Mlib/Navigation/InputGeom.hpp>
+#include <Mlib/Navigation/Sample_SoloMesh.hpp>
+#include <Mlib/Navigation/Sample_TileMesh.hpp>
+#include <Mlib/Navigation/StderrContext.hpp>
+#include <Mlib/Os/Os.hpp>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <utility>
+
+using namespace Mlib;
+
+static const float GROUND_SIZE = 48.f;
+
+// Adds a quad as two triangles whose front side faces "normal",
+// so that Recast marks it walkable if the normal points up.
+static void add_quad(
+    std::list<FixedArray<ColoredVertex<float>, 3>>& triangles,
+    FixedArray<FixedArray<float, 3>, 4> p,
+    const FixedArray<float, 3>& normal)
+{
+    if (dot0d(cross(p(1) - p(0), p(2) - p(0)), normal) < 0.f) {
+        std::swap(p(1), p(3));
+    }
+    auto v = [&](size_t i){
+        return ColoredVertex<float>{p(i), Colors::WHITE, fixed_zeros<float, 2>(), normal};
+    };
+    triangles.push_back({ v(0), v(1), v(2) });
+    triangles.push_back({ v(0), v(2), v(3) });
+}
+
+// Ground of 1m cells, so that the chunks of the Recast input mesh are local,
+// and a wall blocking the direct path along the x-axis.
+// "raised_cell_height" lifts one ground cell, without changing the xz-layout of the triangles.
+static std::list<FixedArray<ColoredVertex<float>, 3>> test_scene(float raised_cell_height = 0.f) {
+    std::list<FixedArray<ColoredVertex<float>, 3>> result;
+    FixedArray<float, 3> up{ 0.f, 1.f, 0.f };
+    for (int x = 0; x < (int)GROUND_SIZE; ++x) {
+        for (int z = 0; z < (int)GROUND_SIZE; ++z) {
+            float y = ((x == 44) && (z == 44)) ? raised_cell_height : 0.f;
+            add_quad(
+                result,
+                {
+                    FixedArray<float, 3>{ (float)x, y, (float)z },
+                    FixedArray<float, 3>{ (float)x + 1.f, y, (float)z },
+                    FixedArray<float, 3>{ (float)x + 1.f, y, (float)z + 1.f },
+                    FixedArray<float, 3>{ (float)x, y, (float)z + 1.f }
+                },
+                up);
+        }
+    }
+    FixedArray<float, 3> bmin{ 20.f, 0.f, 0.f };
+    FixedArray<float, 3> bmax{ 28.f, 4.f, 36.f };
+    for (size_t axis = 0; axis < 3; ++axis) {
+        for (size_t side = 0; side < 2; ++side) {
+            size_t a1 = (axis + 1) % 3;
+            size_t a2 = (axis + 2) % 3;
+            FixedArray<float, 3> n = fixed_zeros<float, 3>();
+            n(axis) = side == 0 ? -1.f : 1.f;
+            FixedArray<FixedArray<float, 3>, 4> p = uninitialized;
+            const size_t uv[4][2] = { {0, 0}, {1, 0}, {1, 1}, {0, 1} };
+            for (size_t i = 0; i < 4; ++i) {
+                p(i)(axis) = side == 0 ? bmin(axis) : bmax(axis);
+                p(i)(a1) = uv[i][0] == 0 ? bmin(a1) : bmax(a1);
+                p(i)(a2) = uv[i][1] == 0 ? bmin(a2) : bmax(a2);
+            }
+            add_quad(result, p, n);
+        }
+    }
+    return result;
+}
+
+static float path_length(const std::list<FixedArray<float, 3>>& path) {
+    float result = 0.f;
+    const FixedArray<float, 3>* previous = nullptr;
+    for (const auto& p : path) {
+        if (previous != nullptr) {
+            result += std::sqrt(sum(squared(p - *previous)));
+        }
+        previous = &p;
+    }
+    return result;
+}
+
+static std::list<FixedArray<float, 3>> test_path(const INavigationMesh& navmesh) {
+    auto start = navmesh.closest_point_on_navmesh({ 8.f, 0.f, 8.f });
+    auto end = navmesh.closest_point_on_navmesh({ 40.f, 0.f, 8.f });
+    assert_true(start.has_value());
+    assert_true(end.has_value());
+    auto path = navmesh.shortest_path(*start, *end, 0.5f);
+    assert_true(path.size() >= 2);
+    return path;
+}
+
+void test_tiled_navmesh_matches_monolithic() {
+    StderrContext ctx;
+    InputGeom geom;
+    IndexedFaceSet<float, float, size_t> ifs{ test_scene() };
+    assert_true(geom.load(&ctx, ifs));
+
+    Sample_SoloMesh solo{ ctx, geom };
+    assert_true(solo.build());
+    Sample_TileMesh tiled{ ctx, geom };
+    tiled.m_tileSize = 32;
+    assert_true(tiled.build());
+    assert_true(tiled.nbuilt_tiles() > 1);
+
+    auto solo_path = test_path(solo);
+    auto tiled_path = test_path(tiled);
+
+    // The wall forces a detour around its end at z = 36.
+    float solo_length = path_length(solo_path);
+    float tiled_length = path_length(tiled_path);
+    assert_true(solo_length > 60.f);
+    assert_isclose(tiled_length, solo_length, 0.05f * solo_length);
+    assert_allclose(tiled_path.front(), solo_path.front(), 0.5f);
+    assert_allclose(tiled_path.back(), solo_path.back(), 0.5f);
+}
+
+void test_navmesh_tile_cache() {
+    auto cache_directory = std::filesystem::temp_directory_path() / "mlib_test_navmesh_cache";
+    std::filesystem::remove_all(cache_directory);
+
+    StderrContext ctx;
+    auto build = [&](float raised_cell_height) {
+        InputGeom geom;
+        IndexedFaceSet<float, float, size_t> ifs{ test_scene(raised_cell_height) };
+        assert_true(geom.load(&ctx, ifs));
+        auto result = std::make_unique<Sample_TileMesh>(ctx, geom);
+        result->m_tileSize = 32;
+        result->m_cacheDirectory = cache_directory.string();
+        assert_true(result->build());
+        return std::make_pair(result->nbuilt_tiles(), result->ncached_tiles());
+    };
+
+    // Cold cache, every tile is built.
+    auto [nbuilt0, ncached0] = build(0.f);
+    assert_true(nbuilt0 > 1);
+    assert_isequal<size_t>(ncached0, 0);
+
+    // Unchanged geometry, every tile is loaded.
+    auto [nbuilt1, ncached1] = build(0.f);
+    assert_isequal<size_t>(nbuilt1, 0);
+    assert_isequal<size_t>(ncached1, nbuilt0);
+
+    // Only the tiles near the raised cell are rebuilt.
+    auto [nbuilt2, ncached2] = build(0.2f);
+    assert_true(nbuilt2 > 0);
+    assert_true(ncached2 > 0);
+    assert_isequal<size_t>(nbuilt2 + ncached2, nbuilt0);
+
+    std::filesystem::remove_all(cache_directory);
+}
+
+int main(int argc, char** argv) {
+    enable_floating_point_exceptions();
+
+    try {
+        test_tiled_navmesh_matches_monolithic();
+        test_navmesh_tile_cache();
+    } catch (const std::runtime_error& e) {
+        lerr() << e.what();
+        return 1;
+    }
+    return 0;
+}
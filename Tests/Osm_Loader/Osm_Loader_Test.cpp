@@ -0,0 +1,610 @@
+#include <Mlib/Array/Fixed_Array.hpp>
+#include <Mlib/Assert.hpp>
+#include <Mlib/Floating_Point_Exceptions.hpp>
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Material/Aggregate_Mode.hpp>
+#include <Mlib/Geometry/Mesh/Triangle_List.hpp>
+#include <Mlib/Geometry/Physics_Material.hpp>
+#include <Mlib/Math/Interp.hpp>
+#include <Mlib/Math/Math.hpp>
+#include <Mlib/Os/Os.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Add_Grass_Inside_Triangles.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Draw_Streets.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Entrance_Type.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Node_Height_Binding.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Map_Resource_Helpers.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Resource_Config.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Osm_Triangle_Lists.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Racing_Line_Bvh.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Road_Type.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Scatter_Tiles.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Node_Heights.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Rectangle.hpp>
+#include <Mlib/Osm_Loader/Osm_Map_Resource/Street_Way_Point.hpp>
+#include <Mlib/Render/Input_Config.hpp>
+#include <Mlib/Render/Render.hpp>
+#include <Mlib/Render/Render_Config.hpp>
+#include <Mlib/Render/Render_Results.hpp>
+#include <Mlib/Render/Renderables/Triangle_Sampler/Resource_Name_Cycle.hpp>
+#include <Mlib/Render/Rendering_Context.hpp>
+#include <Mlib/Render/Resource_Managers/Particle_Resources.hpp>
+#include <Mlib/Render/Resource_Managers/Rendering_Resources.hpp>
+#include <Mlib/Render/Resource_Managers/Trail_Resources.hpp>
+#include <Mlib/Scene_Graph/Driving_Direction.hpp>
+#include <Mlib/Scene_Graph/Resources/Batch_Resource_Instantiator.hpp>
+#include <Mlib/Scene_Graph/Resources/Parsed_Resource_Name.hpp>
+#include <Mlib/Scene_Graph/Resources/Scene_Node_Resources.hpp>
+#include <Mlib/Scene_Graph/Way_Point_Sandbox.hpp>
+#include <Mlib/Stats/Fast_Random_Number_Generators.hpp>
+#include <Mlib/Threads/Realtime_Threads.hpp>
+#include <Mlib/Time/Fps/Set_Fps.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Mlib;
+
+struct TestWay {
+    std::vector<std::string> nd;
+    int layer;
+    double bridge_height;
+};
+
+struct TestNodeHeight {
+    double height;
+    double smooth_height;
+};
+
+using TestSampler = bool(*)(const FixedArray<double, 2>& position, double& height);
+
+// Heightmap covering x < 100.
+static bool sample_test_heightmap(const FixedArray<double, 2>& position, double& height) {
+    if (position(0) >= 100) {
+        return false;
+    }
+    height = 1 + 0.1 * position(0) + 0.05 * position(1);
+    return true;
+}
+
+static double edge_weight(
+    const std::map<std::string, FixedArray<double, 2>>& positions,
+    const std::string& a,
+    const std::string& b)
+{
+    return 1 / std::sqrt(sum(squared(positions.at(a) - positions.at(b))));
+}
+
+// Smoothing of the street node heights using maps keyed by the node IDs,
+// as implemented before the nodes were stored in a CSR graph.
+static std::map<std::string, TestNodeHeight> map_based_street_node_heights(
+    const std::map<std::string, FixedArray<double, 2>>& positions,
+    const std::list<TestWay>& ways,
+    const std::set<std::string>& fixed,
+    float smoothness,
+    size_t niterations,
+    const Interp<double>& layer_heights,
+    TestSampler sample_height)
+{
+    struct NeighborWeight {
+        std::string id;
+        double weight;
+        int layer;
+        double bridge_height;
+    };
+    std::map<std::string, TestNodeHeight> node_height;
+    std::map<std::string, std::list<NeighborWeight>> node_neighbors;
+    for (const auto& w : ways) {
+        for (auto it = w.nd.begin(); it != w.nd.end(); ++it) {
+            auto s = it;
+            ++s;
+            if (s != w.nd.end()) {
+                double weight = edge_weight(positions, *it, *s);
+                node_neighbors[*s].push_back({.id = *it, .weight = weight, .layer = w.layer, .bridge_height = w.bridge_height});
+                node_neighbors[*it].push_back({.id = *s, .weight = weight, .layer = w.layer, .bridge_height = w.bridge_height});
+            }
+        }
+    }
+    for (const auto& n : node_neighbors) {
+        double layer = 0;
+        for (const auto& nn : n.second) {
+            layer += (double)nn.layer;
+        }
+        layer /= (double)n.second.size();
+        size_t nbridge_heights = 0;
+        double bridge_height = 0;
+        for (const auto& nn : n.second) {
+            if (!std::isnan(nn.bridge_height)) {
+                bridge_height += nn.bridge_height;
+                ++nbridge_heights;
+            }
+        }
+        if (nbridge_heights != 0) {
+            bridge_height /= (double)nbridge_heights;
+        }
+        if (nbridge_heights != 0) {
+            node_height[n.first] = {
+                .height = layer_heights(layer) + bridge_height - layer_heights(0),
+                .smooth_height = layer_heights(layer) + bridge_height - layer_heights(0)};
+        } else {
+            if (layer == 0) {
+                double z;
+                if (sample_height(positions.at(n.first), z)) {
+                    node_height[n.first] = {.height = z, .smooth_height = z};
+                }
+            } else {
+                node_height[n.first] = {
+                    .height = layer_heights(layer),
+                    .smooth_height = layer_heights(layer)};
+            }
+        }
+    }
+    for (const auto& id : fixed) {
+        node_neighbors.erase(id);
+    }
+    for (size_t i = 0; i < niterations; ++i) {
+        for (const auto& n : node_neighbors) {
+            auto hit = node_height.find(n.first);
+            if (hit != node_height.end()) {
+                double mean_height = 0;
+                double sum_weights = 0;
+                for (const auto& b : n.second) {
+                    auto it = node_height.find(b.id);
+                    if (it != node_height.end()) {
+                        mean_height += b.weight * it->second.smooth_height;
+                        sum_weights += b.weight;
+                    }
+                }
+                if (sum_weights > 0) {
+                    mean_height /= sum_weights;
+                    hit->second.smooth_height = smoothness * mean_height + (1 - smoothness) * hit->second.height;
+                }
+            }
+        }
+    }
+    return node_height;
+}
+
+void test_street_node_heights() {
+    // The lexicographic order of the IDs differs from the numeric one,
+    // and from the order along the ways.
+    std::map<std::string, FixedArray<double, 2>> positions{
+        {"1", {0., 0.}},
+        {"12", {10., 0.}},
+        {"3", {20., 5.}},
+        {"40", {30., 5.}},
+        {"5", {40., 10.}},
+        {"61", {50., 10.}},
+        {"7", {60., 10.}},
+        {"8", {200., 0.}},
+        {"9", {5., 20.}}};
+    std::list<TestWay> ways{
+        {.nd = {"1", "12", "3", "40"}, .layer = 0, .bridge_height = NAN},
+        {.nd = {"3", "9", "1"}, .layer = 0, .bridge_height = NAN},
+        {.nd = {"40", "5", "61"}, .layer = 1, .bridge_height = 6.},
+        {.nd = {"61", "7"}, .layer = 1, .bridge_height = NAN},
+        // "8" is outside of the heightmap.
+        {.nd = {"7", "8"}, .layer = 0, .bridge_height = NAN}};
+    // "3" is on the ground, "7" is between a bridge and the ground.
+    std::set<std::string> fixed{"3", "7"};
+    float smoothness = 0.7f;
+    size_t niterations = 5;
+    Interp<double> layer_heights{ {-1., 0., 1., 2.}, {-4., 0., 4., 8.} };
+
+    auto expected = map_based_street_node_heights(
+        positions,
+        ways,
+        fixed,
+        smoothness,
+        niterations,
+        layer_heights,
+        sample_test_heightmap);
+
+    std::map<std::string, size_t> node_indices;
+    for (const auto& w : ways) {
+        for (const auto& id : w.nd) {
+            node_indices.try_emplace(id, 0);
+        }
+    }
+    std::vector<std::string> node_ids;
+    for (auto& [id, index] : node_indices) {
+        index = node_ids.size();
+        node_ids.push_back(id);
+    }
+    std::vector<StreetEdge> edges;
+    for (const auto& w : ways) {
+        for (size_t i = 1; i < w.nd.size(); ++i) {
+            edges.push_back({
+                .a = node_indices.at(w.nd[i - 1]),
+                .b = node_indices.at(w.nd[i]),
+                .weight = edge_weight(positions, w.nd[i - 1], w.nd[i]),
+                .layer = w.layer,
+                .bridge_height = w.bridge_height});
+        }
+    }
+    StreetNodeGraph graph{ node_ids.size(), edges };
+    auto heights = initial_street_node_heights(
+        graph,
+        layer_heights,
+        [&](size_t n, double& height){
+            return sample_test_heightmap(positions.at(node_ids[n]), height);
+        });
+    std::vector<uint8_t> fixed_nodes(node_ids.size());
+    for (size_t n = 0; n < node_ids.size(); ++n) {
+        fixed_nodes[n] = fixed.contains(node_ids[n]);
+    }
+    smooth_street_node_heights(graph, fixed_nodes, smoothness, niterations, heights);
+
+    assert_isequal<size_t>(expected.size(), node_ids.size() - 1);
+    for (size_t n = 0; n < node_ids.size(); ++n) {
+        auto it = expected.find(node_ids[n]);
+        assert_true(heights.has_height[n] == (it != expected.end()));
+        if (it == expected.end()) {
+            continue;
+        }
+        assert_isclose(heights.height[n], it->second.height, 1e-12);
+        assert_isclose(heights.smooth_height[n], it->second.smooth_height, 1e-12);
+    }
+    assert_true(!heights.has_height[node_indices.at("8")]);
+    // Fixed nodes keep their height, the others are smoothed.
+    for (const auto& id : fixed) {
+        size_t n = node_indices.at(id);
+        assert_isequal(heights.smooth_height[n], heights.height[n]);
+    }
+    for (const auto& id : {"12", "40", "5"}) {
+        size_t n = node_indices.at(id);
+        assert_true(std::abs(heights.smooth_height[n] - heights.height[n]) > 1e-3);
+    }
+    // Bridge node: layer 1 plus the bridge height.
+    assert_isclose(heights.height[node_indices.at("5")], 4. + 6., 1e-12);
+    // Node between layer 1 and the ground, without bridge height.
+    assert_isclose(heights.height[node_indices.at("7")], 2., 1e-12);
+}
+
+static ParsedResourceName test_resource_name(
+    const std::string& name,
+    float probability,
+    AggregateMode aggregate_mode)
+{
+    return ParsedResourceName{
+        .name = VariableAndHash<std::string>{ name },
+        .billboard_id = BILLBOARD_ID_NONE,
+        .yangle = 0.f,
+        .probability = probability,
+        .probability1 = 1.f,
+        .min_distance_to_bdry = 0.f,
+        .max_distance_to_bdry = INFINITY,
+        .aggregate_mode = aggregate_mode,
+        .create_imposter = false,
+        .max_imposter_texture_size = 0,
+        .hitbox = "",
+        .supplies = {},
+        .supplies_cooldown = 0.f};
+}
+
+static std::vector<FixedArray<CompressedScenePos, 3>> inserted_positions(BatchResourceInstantiator& bri) {
+    std::list<FixedArray<CompressedScenePos, 3>*> positions;
+    bri.insert_into(positions);
+    std::vector<FixedArray<CompressedScenePos, 3>> result;
+    result.reserve(positions.size());
+    for (const auto* p : positions) {
+        result.push_back(*p);
+    }
+    return result;
+}
+
+// Scatters resources around points of a grid that covers several tiles,
+// and returns the positions of the objects and instances, in the order
+// in which they are stored in the instantiator.
+static std::vector<FixedArray<CompressedScenePos, 3>> scatter_test_resources(int nthreads) {
+#ifdef _OPENMP
+    int old_nthreads = omp_get_max_threads();
+    omp_set_num_threads(nthreads);
+#endif
+    ResourceNameCycle rnc{ std::vector<ParsedResourceName>{
+        test_resource_name("grass", 1.f, AggregateMode::INSTANCES_ONCE),
+        test_resource_name("tree", 0.5f, AggregateMode::NONE)} };
+    BatchResourceInstantiator bri;
+    ScatterGrid<FixedArray<CompressedScenePos, 2>> grid{ (CompressedScenePos)10.f };
+    for (int x = -25; x < 25; x += 3) {
+        for (int y = -25; y < 25; y += 3) {
+            FixedArray<CompressedScenePos, 2> p{ (CompressedScenePos)(float)x, (CompressedScenePos)(float)y };
+            grid.add(p, p);
+        }
+    }
+    grid.scatter(bri, &rnc, scatter_map_seed("test_map"), [&](const std::vector<FixedArray<CompressedScenePos, 2>>& points, ScatterTile& tile){
+        FastUniformRandomNumberGenerator<float> offset_rng{ tile.seed(), -1.f, 1.f };
+        FastNormalRandomNumberGenerator<float> scale_rng{ tile.seed() + 1, 1.f, 0.2f };
+        for (const auto& p : points) {
+            for (size_t i = 0; i < 4; ++i) {
+                if (auto prn = tile.rnc().try_multiple_times(10); prn != nullptr) {
+                    FixedArray<CompressedScenePos, 2> q{
+                        p(0) + (CompressedScenePos)offset_rng(),
+                        p(1) + (CompressedScenePos)offset_rng() };
+                    tile.add(q, (CompressedScenePos)0.f, *prn, offset_rng(), scale_rng());
+                }
+            }
+        }
+    });
+#ifdef _OPENMP
+    omp_set_num_threads(old_nthreads);
+#endif
+    return inserted_positions(bri);
+}
+
+// Scatters grass on a triangulated square that covers several tiles.
+static std::vector<FixedArray<CompressedScenePos, 3>> scatter_test_grass(int nthreads) {
+#ifdef _OPENMP
+    int old_nthreads = omp_get_max_threads();
+    omp_set_num_threads(nthreads);
+#endif
+    ResourceNameCycle rnc{ std::vector<ParsedResourceName>{
+        test_resource_name("grass", 0.7f, AggregateMode::INSTANCES_ONCE),
+        test_resource_name("flower", 0.2f, AggregateMode::INSTANCES_ONCE)} };
+    TriangleList<CompressedScenePos> triangles{
+        "grass",
+        Material{},
+        Morphology{ .physics_material = PhysicsMaterial::ATTR_VISIBLE } };
+    auto p = [](int x, int y) {
+        return FixedArray<CompressedScenePos, 3>{ (CompressedScenePos)(float)x, (CompressedScenePos)(float)y, (CompressedScenePos)0.f };
+    };
+    for (int x = -30; x < 30; x += 6) {
+        for (int y = -30; y < 30; y += 6) {
+            triangles.draw_rectangle_wo_normals(p(x, y), p(x + 6, y), p(x + 6, y + 6), p(x, y + 6));
+        }
+    }
+    BatchResourceInstantiator bri;
+    add_grass_inside_triangles(
+        bri,
+        rnc,
+        triangles,
+        1.f,                        // scale
+        (CompressedScenePos)1.f,    // distance
+        (CompressedScenePos)10.f,   // tile_size
+        scatter_map_seed("test_map"));
+#ifdef _OPENMP
+    omp_set_num_threads(old_nthreads);
+#endif
+    return inserted_positions(bri);
+}
+
+void test_scatter_tiles() {
+    auto serial = scatter_test_resources(1);
+    auto parallel = scatter_test_resources(8);
+    assert_true(serial.size() > 500);
+    assert_isequal(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        assert_true(all(serial[i] == parallel[i]));
+    }
+    // Different maps get different random placements.
+    assert_true(scatter_tile_seed(scatter_map_seed("a"), 0) != scatter_tile_seed(scatter_map_seed("b"), 0));
+}
+
+void test_add_grass_inside_triangles() {
+    auto serial = scatter_test_grass(1);
+    auto parallel = scatter_test_grass(8);
+    assert_true(serial.size() > 1000);
+    assert_isequal(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        assert_true(all(serial[i] == parallel[i]));
+    }
+}
+
+using StreetTriangle = FixedArray<ColoredVertex<CompressedScenePos>, 3>;
+
+struct DrawnStreets {
+    std::vector<StreetTriangle> triangles;
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, std::string> height_bindings;
+    size_t nstreet_rectangles;
+    size_t nway_point_edges;
+    size_t nway_segments;
+};
+
+static void append_triangles(
+    std::vector<StreetTriangle>& result,
+    const std::list<std::shared_ptr<TriangleList<CompressedScenePos>>>& lists)
+{
+    for (const auto& l : lists) {
+        result.insert(result.end(), l->triangles.begin(), l->triangles.end());
+    }
+}
+
+static void append_triangles(
+    std::vector<StreetTriangle>& result,
+    const std::list<StreetTriangle>& triangles)
+{
+    result.insert(result.end(), triangles.begin(), triangles.end());
+}
+
+// Draws a cross junction, a T-junction and a bridge with curbs.
+// Requires an active rendering context.
+static DrawnStreets draw_test_streets(int nthreads) {
+#ifdef _OPENMP
+    int old_nthreads = omp_get_max_threads();
+    omp_set_num_threads(nthreads);
+#endif
+    OsmResourceConfig config;
+    config.street_materials[RoadType::STREET] = PhysicsMaterial::SURFACE_BASE_TARMAC;
+    config.street_texture[RoadProperties{ RoadType::STREET, 1 }] = RoadStyle{ .textures = {}, .uvx = 1.f };
+    config.street_crossing_textures[RoadType::STREET] = {};
+    config.curb_street_texture[RoadType::STREET] = VariableAndHash<std::string>{ "curb" };
+    config.curb2_street_texture[RoadType::STREET] = VariableAndHash<std::string>{ "curb2" };
+    config.uv_scales_street[RoadType::STREET] = 1.f;
+    config.curb_alpha = 0.8f;
+    config.curb2_alpha = 0.9f;
+    config.with_height_bindings = true;
+    config.driving_direction = DrivingDirection::RIGHT;
+    config.layer_heights = Interp<double>{ {-1., 0., 1.}, {-5., 0., 5.} };
+    config.use_terrain_holes = true;
+
+    auto node = [](float x, float y) {
+        return Node{
+            .position = { (CompressedScenePos)x, (CompressedScenePos)y },
+            .tags = {} };
+    };
+    std::map<std::string, Node> nodes{
+        {"c", node(0.f, 0.f)},
+        {"n", node(0.f, 40.f)},
+        {"n2", node(20.f, 75.f)},
+        {"e", node(40.f, 0.f)},
+        {"e2", node(90.f, 5.f)},
+        {"s", node(0.f, -40.f)},
+        {"w", node(-40.f, 0.f)},
+        {"ne", node(40.f, 40.f)},
+        {"ne2", node(40.f, 90.f)},
+        {"ne3", node(40.f, 140.f)}};
+    auto way = [](std::list<std::string> nd, Map<std::string, std::string> tags) {
+        return Way{ .nd = std::move(nd), .tags = std::move(tags) };
+    };
+    std::map<std::string, Way> ways{
+        {"w1", way({"w", "c", "e", "e2"}, {{"highway", "primary"}})},
+        {"w2", way({"s", "c", "n", "n2"}, {{"highway", "residential"}})},
+        {"w3", way({"e", "ne"}, {{"highway", "primary"}})},
+        {"w4", way({"ne", "ne2", "ne3"}, {{"highway", "primary"}, {"layer", "1"}, {"bridge", "yes"}})}};
+
+    SceneNodeResources scene_node_resources;
+    OsmTriangleLists ground_triangles{ config, "" };
+    OsmTriangleLists air_triangles{ config, "_air" };
+    BatchResourceInstantiator bri;
+    std::list<StreetRectangle> street_rectangles;
+    std::map<OrderableFixedArray<CompressedScenePos, 2>, NodeHeightBinding> node_height_bindings;
+    std::map<WayPointSandbox, std::list<std::pair<StreetWayPoint, StreetWayPoint>>> way_point_edge_descriptors;
+    UUVector<FixedArray<ColoredVertex<float>, 3>> tunnel_pipe_triangles;
+    UUVector<FixedArray<ColoredVertex<float>, 3>> tunnel_bdry_triangles;
+    std::list<FixedArray<CompressedScenePos, 2, 2>> way_segments;
+    RacingLineBvh racing_line_bvh;
+    ResourceNameCycle street_lights{ config.street_light_resource_names };
+    DrawStreets{DrawStreetsInput{
+        scene_node_resources,
+        ground_triangles,
+        air_triangles,
+        bri,
+        street_rectangles,
+        node_height_bindings,
+        way_point_edge_descriptors,
+        tunnel_pipe_triangles,
+        tunnel_bdry_triangles,
+        way_segments,
+        racing_line_bvh,
+        config.street_surface_central_resource_names,
+        config.street_surface_endpoint0_resource_names,
+        config.street_surface_endpoint1_resource_names,
+        config.street_bumps_central_resource_names,
+        config.street_bumps_endpoint0_resource_names,
+        config.street_bumps_endpoint1_resource_names,
+        nodes,
+        ways,
+        config.scale,
+        config.uv_scales_street,
+        config.uv_scale_crossings,
+        config.default_street_width,
+        config.default_lane_width,
+        config.default_tunnel_pipe_width,
+        config.default_tunnel_pipe_height,
+        config.only_raceways_and_walls,
+        config.highway_name_pattern,
+        config.excluded_highways,
+        config.path_tags,
+        config.included_aeroways,
+        config.curb_alpha,
+        config.curb2_alpha,
+        config.curb_uv,
+        config.curb2_uv,
+        config.curb_color,
+        config.racing_line_width_x,
+        config.racing_line_scale_y,
+        street_lights,
+        config.with_height_bindings,
+        config.driving_direction,
+        config.layer_heights,
+        config.use_terrain_holes
+    }};
+#ifdef _OPENMP
+    omp_set_num_threads(old_nthreads);
+#endif
+    DrawnStreets result;
+    for (const OsmTriangleLists* tls : { &ground_triangles, &air_triangles }) {
+        append_triangles(result.triangles, tls->street_triangles());
+        append_triangles(result.triangles, tls->tls_crossing_only());
+        append_triangles(result.triangles, tls->tls_curb_and_curb2());
+        append_triangles(result.triangles, tls->entrance_triangles());
+        append_triangles(result.triangles, { tls->tl_air_support });
+    }
+    for (const auto& [position, binding] : node_height_bindings) {
+        result.height_bindings.emplace(position, binding.str());
+    }
+    result.nstreet_rectangles = street_rectangles.size();
+    result.nway_point_edges = 0;
+    for (const auto& [_, edges] : way_point_edge_descriptors) {
+        result.nway_point_edges += edges.size();
+    }
+    result.nway_segments = way_segments.size();
+    return result;
+}
+
+void test_draw_streets() {
+    // The triangle lists fetch their textures from the rendering resources,
+    // so a hidden window provides the GL context, like in the Render test.
+    RenderConfig render_config;
+    InputConfig input_config;
+    RenderResults render_results;
+    RenderedSceneDescriptor rsd;
+    render_results.outputs[rsd] = {};
+    std::atomic_size_t num_renderings = SIZE_MAX;
+    SetFps set_fps{ nullptr };
+    Render render{ render_config, input_config, num_renderings, set_fps, [](){ return std::chrono::steady_clock::now(); }, &render_results };
+    SceneNodeResources scene_node_resources;
+    ParticleResources particle_resources;
+    TrailResources trail_resources;
+    RenderingResources rendering_resources{ "primary_rendering_resources", 16 };
+    RenderingContext primary_rendering_context{
+        .scene_node_resources = scene_node_resources,
+        .particle_resources = particle_resources,
+        .trail_resources = trail_resources,
+        .rendering_resources = rendering_resources,
+        .z_order = 0};
+    RenderingContextGuard rcg{ primary_rendering_context };
+
+    auto serial = draw_test_streets(1);
+    auto parallel = draw_test_streets(8);
+
+    assert_true(!serial.triangles.empty());
+    assert_isequal(serial.triangles.size(), parallel.triangles.size());
+    for (size_t i = 0; i < serial.triangles.size(); ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            const auto& a = serial.triangles[i](j);
+            const auto& b = parallel.triangles[i](j);
+            assert_true(all(a.position == b.position));
+            assert_true(all(a.color == b.color));
+            assert_true(all(a.uv == b.uv));
+        }
+    }
+    assert_true(!serial.height_bindings.empty());
+    assert_true(serial.height_bindings == parallel.height_bindings);
+    assert_isequal(serial.nstreet_rectangles, parallel.nstreet_rectangles);
+    assert_isequal(serial.nway_point_edges, parallel.nway_point_edges);
+    assert_isequal(serial.nway_segments, parallel.nway_segments);
+}
+
+int main(int argc, char** argv) {
+    reserve_realtime_threads(0);
+    enable_floating_point_exceptions();
+
+    try {
+        test_street_node_heights();
+        test_scatter_tiles();
+        test_add_grass_inside_triangles();
+        test_draw_streets();
+    } catch (const std::runtime_error& e) {
+        lerr() << e.what();
+        return 1;
+    }
+    return 0;
+}
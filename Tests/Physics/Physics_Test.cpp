@@ -1,4 +1,7 @@
 #include <Mlib/Floating_Point_Exceptions.hpp>
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
+#include <Mlib/Geometry/Physics_Material.hpp>
 #include <Mlib/Math/Fixed_Rodrigues.hpp>
 #include <Mlib/Math/Fixed_Scaled_Unit_Vector.hpp>
 #include <Mlib/Math/Fixed_Test.hpp>
@@ -10,13 +13,21 @@
 #include <Mlib/Physics/Misc/Beacon.hpp>
 #include <Mlib/Physics/Misc/Gravity_Efp.hpp>
 #include <Mlib/Physics/Misc/Track_Element.hpp>
+#include <Mlib/Physics/Collision/Collidable_Mode.hpp>
+#include <Mlib/Physics/Containers/Collision_Query.hpp>
+#include <Mlib/Physics/Containers/Visibility_Queries.hpp>
+#include <Mlib/Physics/Physics_Engine/Colliders/Sweep_Fast_Bodies.hpp>
 #include <Mlib/Physics/Physics_Engine/Physics_Engine.hpp>
+#include <Mlib/Physics/Physics_Engine/Physics_Engine_Batch.hpp>
 #include <Mlib/Physics/Physics_Engine/Physics_Phase.hpp>
 #include <Mlib/Physics/Rigid_Body/Rigid_Body_Vehicle.hpp>
 #include <Mlib/Physics/Rigid_Body/Rigid_Primitives.hpp>
+#include <Mlib/Physics/Smoke_Generation/Surface_Contact_Db.hpp>
 #include <Mlib/Scene_Graph/Instances/Static_World.hpp>
 #include <Mlib/Signal/Pid_Controller.hpp>
+#include <Mlib/Stats/Fast_Random_Number_Generators.hpp>
 #include <Mlib/Stats/Linspace.hpp>
+#include <chrono>
 
 using namespace Mlib;
 
@@ -197,6 +208,305 @@ void test_com() {
         r1->velocity_at_position(com1.casted<ScenePos>()));
 }
 
+static std::shared_ptr<ColoredVertexArray<float>> quad_mesh(
+    const std::string& name,
+    PhysicsMaterial physics_material,
+    UUVector<FixedArray<ColoredVertex<float>, 4>> quads)
+{
+    return std::make_shared<ColoredVertexArray<float>>(
+        name,
+        Material{},
+        Morphology{ .physics_material = physics_material },
+        ModifierBacklog{},
+        std::move(quads),
+        UUVector<FixedArray<ColoredVertex<float>, 3>>(),
+        UUVector<FixedArray<ColoredVertex<float>, 2>>(),
+        UUVector<FixedArray<std::vector<BoneWeight>, 3>>(),
+        UUVector<FixedArray<float, 3>>(),
+        UUVector<FixedArray<uint8_t, 3>>(),
+        std::vector<UUVector<FixedArray<float, 3, 2>>>(),
+        std::vector<UUVector<FixedArray<float, 3>>>(),
+        UUVector<FixedArray<float, 3>>());
+}
+
+// Axis-aligned box centered at the origin, with outward-facing quads.
+static UUVector<FixedArray<ColoredVertex<float>, 4>> box_quads(float half_size) {
+    const auto z2 = fixed_zeros<float, 2>();
+    UUVector<FixedArray<ColoredVertex<float>, 4>> result;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        for (float sign : { -1.f, 1.f }) {
+            size_t a1 = (axis + 1) % 3;
+            size_t a2 = (axis + 2) % 3;
+            FixedArray<float, 3> n = fixed_zeros<float, 3>();
+            n(axis) = sign;
+            FixedArray<FixedArray<float, 3>, 4> p = uninitialized;
+            const float uv[4][2] = { {-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f} };
+            for (size_t i = 0; i < 4; ++i) {
+                p(i)(axis) = sign * half_size;
+                p(i)(a1) = uv[i][0] * half_size;
+                p(i)(a2) = uv[i][1] * half_size;
+            }
+            if (dot0d(cross(p(1) - p(0), p(2) - p(0)), n) < 0.f) {
+                std::swap(p(1), p(3));
+            }
+            result.push_back(FixedArray<ColoredVertex<float>, 4>{
+                ColoredVertex<float>{p(0), Colors::WHITE, z2, n},
+                ColoredVertex<float>{p(1), Colors::WHITE, z2, n},
+                ColoredVertex<float>{p(2), Colors::WHITE, z2, n},
+                ColoredVertex<float>{p(3), Colors::WHITE, z2, n}});
+        }
+    }
+    return result;
+}
+
+void test_sweep_static_geometry() {
+    const auto identity = TransformationMatrix<double, double, 3>::identity();
+    const auto gravity = FixedScaledUnitVector<float, 3>{ { 0.f, -9.8f * meters / (seconds * seconds), 0.f } };
+    StaticWorld world{
+        .geographic_mapping = &identity,
+        .inverse_geographic_mapping = &identity,
+        .gravity = &gravity,
+        .wind = nullptr,
+        .time = std::chrono::steady_clock::now()
+    };
+    PhysicsEngineConfig static_cfg;
+    PhysicsEngine static_engine{ static_cfg };
+    auto wall = rigid_cuboid(global_object_pool, "wall", "wall_no_id", INFINITY, {1.f, 1.f, 1.f});
+    wall->rbp_.abs_com_ = 0;
+    wall->rbp_.rotation_ = fixed_identity_array<float, 3>();
+    // Infinitely thin wall in the plane x = 5.
+    const auto z2 = fixed_zeros<float, 2>();
+    const FixedArray<float, 3> n{ -1.f, 0.f, 0.f };
+    auto wall_mesh = quad_mesh(
+        "wall",
+        PhysicsMaterial::ATTR_COLLIDE | PhysicsMaterial::OBJ_CHASSIS | PhysicsMaterial::ATTR_CONCAVE,
+        UUVector<FixedArray<ColoredVertex<float>, 4>>{
+            FixedArray<ColoredVertex<float>, 4>{
+                ColoredVertex<float>{{5.f, -10.f, -10.f}, Colors::WHITE, z2, n},
+                ColoredVertex<float>{{5.f, -10.f, +10.f}, Colors::WHITE, z2, n},
+                ColoredVertex<float>{{5.f, +10.f, +10.f}, Colors::WHITE, z2, n},
+                ColoredVertex<float>{{5.f, +10.f, -10.f}, Colors::WHITE, z2, n}}});
+    static_engine.rigid_bodies_.add_rigid_body(*wall, { wall_mesh }, {}, {}, CollidableMode::STATIC);
+    const auto& rbs = static_engine.rigid_bodies_;
+
+    ScenePos toi;
+    FixedArray<SceneDir, 3> normal = uninitialized;
+    // The sphere touches the face.
+    assert_true(sweep_static_geometry(rbs, {0., 0., 0.}, {10., 0., 0.}, 0.1, toi, &normal));
+    assert_isclose<ScenePos>(toi, 0.49, 1e-6);
+    assert_allclose(normal, FixedArray<SceneDir, 3>{ -1.f, 0.f, 0.f });
+    assert_true(!sweep_static_geometry(rbs, {0., 0., 0.}, {4., 0., 0.}, 0.1, toi));
+    // The center passes 5cm above the edge at y = 10.
+    assert_true(sweep_static_geometry(rbs, {0., 10.05, 0.}, {10., 10.05, 0.}, 0.1, toi, &normal));
+    assert_isclose<ScenePos>(toi, (5. - std::sqrt(0.01 - 0.0025)) / 10., 1e-6);
+    assert_allclose(normal, FixedArray<SceneDir, 3>{ -std::sqrt(0.75f), 0.5f, 0.f }, 1e-5f);
+    // The center passes 5cm diagonally from the corner at y = z = 10.
+    auto c = 10. + 0.05 / std::sqrt(2.);
+    assert_true(sweep_static_geometry(rbs, {0., c, c}, {10., c, c}, 0.1, toi));
+    assert_isclose<ScenePos>(toi, (5. - std::sqrt(0.01 - 0.0025)) / 10., 1e-6);
+    assert_true(!sweep_static_geometry(rbs, {0., 10.2, 0.}, {10., 10.2, 0.}, 0.1, toi));
+
+    // A small projectile (half size 5cm, 300m/s) is shot at the wall
+    // from random positions, one projectile per world.
+    // Discrete detection requires one substep position to overlap the wall,
+    // the sweep tests the path between substeps.
+    // Grazing shots pass the top edge of the wall with less than
+    // the half size, i.e. the projectile overlaps the wall on its path.
+    const float velocity = 300.f * meters / seconds;
+    SurfaceContactDb surface_contact_db;
+    auto projectile_mesh = quad_mesh(
+        "projectile",
+        PhysicsMaterial::ATTR_COLLIDE | PhysicsMaterial::OBJ_CHASSIS | PhysicsMaterial::ATTR_CONVEX,
+        box_quads(0.05f));
+    for (size_t nsubsteps : { 20, 10, 5 }) {
+        for (bool grazing : { false, true })
+        for (bool continuous_collision : { false, true }) {
+            PhysicsEngineConfig cfg;
+            cfg.nsubsteps = nsubsteps;
+            cfg.continuous_collision = continuous_collision;
+            size_t nshots = 50;
+            PhysicsEngineBatch batch{ cfg, static_engine, surface_contact_db, nshots };
+            FastUniformRandomNumberGenerator<ScenePos> rng{ 0, -5., 5. };
+            std::vector<std::unique_ptr<RigidBodyVehicle, DeleteFromPool<RigidBodyVehicle>>> projectiles;
+            for (size_t i = 0; i < nshots; ++i) {
+                auto name = "projectile" + std::to_string(i);
+                projectiles.push_back(rigid_cuboid(global_object_pool, name, name + "_no_id", 0.1f * kg, {0.1f, 0.1f, 0.1f}));
+                auto& rbp = projectiles.back()->rbp_;
+                rbp.abs_com_ = { rng() - 5., grazing ? 10. + 0.004 * (rng() + 5.) : rng(), rng() };
+                rbp.rotation_ = fixed_identity_array<float, 3>();
+                rbp.v_ = { velocity, 0.f, 0.f };
+                batch[i].rigid_bodies_.add_rigid_body(*projectiles.back(), { projectile_mesh }, {}, {}, CollidableMode::MOVING);
+            }
+            auto time = world.time;
+            auto dt = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float>(cfg.dt / seconds));
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t f = 0; f < 5; ++f) {
+                time += dt;
+                batch.step(world, time);
+            }
+            auto elapsed = std::chrono::steady_clock::now() - t0;
+            size_t ntunneled = 0;
+            for (size_t i = 0; i < nshots; ++i) {
+                const auto& rbp = projectiles[i]->rbp_;
+                if ((rbp.abs_com_(0) > 5.) && (rbp.abs_com_(1) < 10. + 0.05)) {
+                    // Passed the wall without being deflected above its edge.
+                    ++ntunneled;
+                } else if (continuous_collision && !grazing) {
+                    // The velocity towards the wall was removed.
+                    assert_true(rbp.v_(0) <= 1e-3f * meters / seconds);
+                }
+                batch[i].rigid_bodies_.delete_rigid_body(*projectiles[i]);
+            }
+            linfo() <<
+                "nsubsteps: " << nsubsteps <<
+                ", grazing: " << (int)grazing <<
+                ", continuous collision: " << (int)continuous_collision <<
+                ", tunneled: " << ntunneled << " / " << nshots <<
+                ", time: " << std::chrono::duration<double>(elapsed).count() << " s";
+            if (continuous_collision) {
+                assert_isequal<size_t>(ntunneled, 0);
+            }
+        }
+    }
+    static_engine.rigid_bodies_.delete_rigid_body(*wall);
+}
+
+void test_physics_engine_batch() {
+    PhysicsEngineConfig cfg;
+    const auto identity = TransformationMatrix<double, double, 3>::identity();
+    const auto gravity = FixedScaledUnitVector<float, 3>{ { 0.f, -9.8f * meters / (seconds * seconds), 0.f } };
+    StaticWorld world{
+        .geographic_mapping = &identity,
+        .inverse_geographic_mapping = &identity,
+        .gravity = &gravity,
+        .wind = nullptr,
+        .time = std::chrono::steady_clock::now()
+    };
+
+    // Static engine holding the ground plane y = 0.
+    PhysicsEngine static_engine{ cfg };
+    auto ground = rigid_cuboid(global_object_pool, "ground", "ground_no_id", INFINITY, {1.f, 1.f, 1.f});
+    ground->rbp_.abs_com_ = 0;
+    ground->rbp_.rotation_ = fixed_identity_array<float, 3>();
+    const auto z2 = fixed_zeros<float, 2>();
+    const FixedArray<float, 3> up{ 0.f, 1.f, 0.f };
+    auto ground_mesh = quad_mesh(
+        "ground",
+        PhysicsMaterial::ATTR_COLLIDE | PhysicsMaterial::OBJ_CHASSIS | PhysicsMaterial::ATTR_CONCAVE,
+        UUVector<FixedArray<ColoredVertex<float>, 4>>{
+            FixedArray<ColoredVertex<float>, 4>{
+                ColoredVertex<float>{{-10.f, 0.f, -10.f}, Colors::WHITE, z2, up},
+                ColoredVertex<float>{{-10.f, 0.f, +10.f}, Colors::WHITE, z2, up},
+                ColoredVertex<float>{{+10.f, 0.f, +10.f}, Colors::WHITE, z2, up},
+                ColoredVertex<float>{{+10.f, 0.f, -10.f}, Colors::WHITE, z2, up}}});
+    static_engine.rigid_bodies_.add_rigid_body(*ground, { ground_mesh }, {}, {}, CollidableMode::STATIC);
+
+    // One box per world, dropped from different heights.
+    SurfaceContactDb surface_contact_db;
+    GravityEfp gravity_efp;
+    size_t nworlds = 4;
+    PhysicsEngineBatch batch{ cfg, static_engine, surface_contact_db, nworlds };
+    auto box_mesh = quad_mesh(
+        "box",
+        PhysicsMaterial::ATTR_COLLIDE | PhysicsMaterial::OBJ_CHASSIS | PhysicsMaterial::ATTR_CONVEX,
+        box_quads(0.5f));
+    std::vector<std::unique_ptr<RigidBodyVehicle, DeleteFromPool<RigidBodyVehicle>>> boxes;
+    for (size_t i = 0; i < nworlds; ++i) {
+        auto name = "box" + std::to_string(i);
+        boxes.push_back(rigid_cuboid(global_object_pool, name, name + "_no_id", 10.f * kg, {1.f, 1.f, 1.f}));
+        boxes.back()->rbp_.abs_com_ = { 0., 1. + 0.5 * (double)i, 0. };
+        boxes.back()->rbp_.rotation_ = fixed_identity_array<float, 3>();
+        batch[i].rigid_bodies_.add_rigid_body(*boxes.back(), { box_mesh }, {}, {}, CollidableMode::MOVING);
+        batch[i].add_external_force_provider(gravity_efp);
+    }
+    auto time = world.time;
+    auto dt = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(cfg.dt / seconds));
+    for (size_t f = 0; f < 200; ++f) {
+        time += dt;
+        batch.step(world, time);
+    }
+    // Every box collided with the shared ground and rests on it.
+    for (size_t i = 0; i < nworlds; ++i) {
+        const auto& rbp = boxes[i]->rbp_;
+        assert_isclose<ScenePos>(rbp.abs_com_(1), 0.5, 0.05);
+        assert_true(std::sqrt(sum(squared(rbp.v_))) < 0.1f * meters / seconds);
+    }
+    for (size_t i = 0; i < nworlds; ++i) {
+        batch[i].rigid_bodies_.delete_rigid_body(*boxes[i]);
+    }
+    static_engine.rigid_bodies_.delete_rigid_body(*ground);
+}
+
+void test_visibility_queries() {
+    PhysicsEngineConfig cfg;
+    PhysicsEngine engine{ cfg };
+    auto wall = rigid_cuboid(global_object_pool, "wall", "wall_no_id", INFINITY, {1.f, 1.f, 1.f});
+    wall->rbp_.abs_com_ = 0;
+    wall->rbp_.rotation_ = fixed_identity_array<float, 3>();
+    // Wall in the plane x = 5.
+    const auto z2 = fixed_zeros<float, 2>();
+    const FixedArray<float, 3> n{ -1.f, 0.f, 0.f };
+    auto wall_mesh = quad_mesh(
+        "wall",
+        PhysicsMaterial::ATTR_COLLIDE | PhysicsMaterial::OBJ_CHASSIS | PhysicsMaterial::ATTR_CONCAVE,
+        UUVector<FixedArray<ColoredVertex<float>, 4>>{
+            FixedArray<ColoredVertex<float>, 4>{
+                ColoredVertex<float>{{5.f, -10.f, -10.f}, Colors::WHITE, z2, n},
+                ColoredVertex<float>{{5.f, -10.f, +10.f}, Colors::WHITE, z2, n},
+                ColoredVertex<float>{{5.f, +10.f, +10.f}, Colors::WHITE, z2, n},
+                ColoredVertex<float>{{5.f, +10.f, -10.f}, Colors::WHITE, z2, n}}});
+    engine.rigid_bodies_.add_rigid_body(*wall, { wall_mesh }, {}, {}, CollidableMode::STATIC);
+
+    auto watcher = rigid_cuboid(global_object_pool, "watcher", "watcher_no_id", 1.f * kg, {1.f, 1.f, 1.f});
+    watcher->rbp_.abs_com_ = 0;
+    watcher->rbp_.rotation_ = fixed_identity_array<float, 3>();
+    auto watched = rigid_cuboid(global_object_pool, "watched", "watched_no_id", 1.f * kg, {1.f, 1.f, 1.f});
+    watched->rbp_.abs_com_ = { 10., 0., 0. };
+    watched->rbp_.rotation_ = fixed_identity_array<float, 3>();
+
+    CollisionQuery collision_query{ engine };
+    VisibilityQueries queries{ collision_query, 2., 2 };
+    FixedArray<ScenePos, 3> behind_wall{ 10., 0., 0. };
+    FixedArray<ScenePos, 3> in_front_of_wall{ -10., 0., 0. };
+
+    // Queries are enqueued once, and answered after "execute".
+    assert_true(!queries.can_see(*watcher, behind_wall).has_value());
+    assert_true(!queries.can_see(*watcher, behind_wall).has_value());
+    assert_true(!queries.can_see(*watcher, in_front_of_wall).has_value());
+    assert_isequal<size_t>(queries.npending(), 2);
+    queries.execute();
+    assert_isequal<size_t>(queries.npending(), 0);
+    assert_true(queries.can_see(*watcher, behind_wall) == false);
+    assert_true(queries.can_see(*watcher, in_front_of_wall) == true);
+    // Positions in the same cell hit the cache.
+    assert_true(queries.can_see(*watcher, FixedArray<ScenePos, 3>{ 10.5, 0.5, 0.5 }) == false);
+    assert_isequal<size_t>(queries.npending(), 0);
+
+    // The watched object is part of the key,
+    // even if it is located in a cached cell.
+    assert_true(!queries.can_see(*watcher, *watched).has_value());
+    assert_isequal<size_t>(queries.npending(), 1);
+    queries.execute();
+    assert_true(queries.can_see(*watcher, *watched) == false);
+
+    // The watcher's cell is part of the key.
+    watcher->rbp_.abs_com_ = { 8., 0., 0. };
+    assert_true(!queries.can_see(*watcher, behind_wall).has_value());
+    queries.execute();
+    assert_true(queries.can_see(*watcher, behind_wall) == true);
+    watcher->rbp_.abs_com_ = 0;
+    assert_true(queries.can_see(*watcher, behind_wall) == false);
+
+    // Results expire after "max_age" calls to "execute".
+    queries.execute();
+    queries.execute();
+    assert_true(!queries.can_see(*watcher, behind_wall).has_value());
+
+    engine.rigid_bodies_.delete_rigid_body(*wall);
+}
+
 void test_magic_formula() {
     {
         MagicFormulaArgmax<float> mf{MagicFormula<float>{}};
@@ -254,6 +564,9 @@ int main(int argc, char** argv) {
         // test_power_to_force_P_normal();
         // test_power_to_force_stiction_tangential();
         test_com();
+        test_sweep_static_geometry();
+        test_physics_engine_batch();
+        test_visibility_queries();
         test_magic_formula();
         test_track_element();
         test_pid();
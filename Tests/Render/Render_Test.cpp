@@ -1,9 +1,16 @@
+#include <Mlib/Assert.hpp>
 #include <Mlib/Cv/Render/Render_Data.hpp>
 #include <Mlib/Floating_Point_Exceptions.hpp>
+#include <Mlib/Geometry/Colored_Vertex.hpp>
+#include <Mlib/Geometry/Material.hpp>
+#include <Mlib/Geometry/Mesh/Colored_Vertex_Array.hpp>
+#include <Mlib/Geometry/Physics_Material.hpp>
 #include <Mlib/Images/Draw_Bmp.hpp>
 #include <Mlib/Math/Fixed_Cholesky.hpp>
 #include <Mlib/Math/Fixed_Math.hpp>
 #include <Mlib/Math/Fixed_Test.hpp>
+#include <Mlib/Math/Transformation/Transformation_Matrix.hpp>
+#include <Mlib/Render/Batch_Renderers/Aggregate_Cells.hpp>
 #include <Mlib/Render/Input_Config.hpp>
 #include <Mlib/Render/Render.hpp>
 #include <Mlib/Render/Render.hpp>
@@ -29,6 +36,96 @@ void test_scene_node() {
         inv(node.absolute_view_matrix().affine()).value());
 }
 
+static std::shared_ptr<ColoredVertexArray<CompressedScenePos>> triangle_array(
+    const std::string& name,
+    const std::vector<FixedArray<float, 3>>& centers,
+    const FixedArray<uint8_t, 4>& color)
+{
+    UUVector<FixedArray<ColoredVertex<CompressedScenePos>, 3>> triangles;
+    auto vertex = [&](const FixedArray<float, 3>& p) {
+        return ColoredVertex<CompressedScenePos>{ p.casted<CompressedScenePos>(), color };
+    };
+    for (const auto& c : centers) {
+        triangles.push_back(FixedArray<ColoredVertex<CompressedScenePos>, 3>{
+            vertex(c + FixedArray<float, 3>{ -0.1f, 0.f, 0.f }),
+            vertex(c + FixedArray<float, 3>{ 0.1f, 0.f, 0.f }),
+            vertex(c + FixedArray<float, 3>{ 0.f, 0.f, 0.1f })});
+    }
+    return std::make_shared<ColoredVertexArray<CompressedScenePos>>(
+        name,
+        Material{},
+        Morphology{ .physics_material = PhysicsMaterial::ATTR_VISIBLE },
+        ModifierBacklog{},
+        UUVector<FixedArray<ColoredVertex<CompressedScenePos>, 4>>(),
+        std::move(triangles),
+        UUVector<FixedArray<ColoredVertex<CompressedScenePos>, 2>>(),
+        UUVector<FixedArray<std::vector<BoneWeight>, 3>>(),
+        UUVector<FixedArray<float, 3>>(),
+        UUVector<FixedArray<uint8_t, 3>>(),
+        std::vector<UUVector<FixedArray<float, 3, 2>>>(),
+        std::vector<UUVector<FixedArray<float, 3>>>(),
+        UUVector<FixedArray<float, 3>>());
+}
+
+void test_aggregate_cells() {
+    using CellIndex = AggregateCells::CellIndex;
+    const CellIndex c0{ 0, 0, 0 };
+    const CellIndex c1{ 1, 0, 0 };
+    const auto identity = TransformationMatrix<float, ScenePos, 3>::identity();
+    AggregateCells cells{ 10. };
+    FixedArray<uint8_t, 4> red{ (uint8_t)255, (uint8_t)0, (uint8_t)0, (uint8_t)255 };
+    auto a = triangle_array("a", { FixedArray<float, 3>{ 1.f, 1.f, 1.f }, FixedArray<float, 3>{ 15.f, 1.f, 1.f } }, Colors::WHITE);
+    auto b = triangle_array("b", { FixedArray<float, 3>{ 2.f, 2.f, 2.f } }, Colors::WHITE);
+    FixedArray<ScenePos, 3> offset0{ 0., 0., 0. };
+    FixedArray<ScenePos, 3> offset1{ 3., 0., 4. };
+    auto r0 = cells.update(offset0, { { a, identity }, { b, identity } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 2);
+    assert_isequal<size_t>(r0.size(), 2);
+    assert_isequal<size_t>(r0.at(c0).triangles.size(), 2);
+    assert_isequal<size_t>(r0.at(c1).triangles.size(), 1);
+    // Same arrays, different offset: Nothing is partitioned, the cells are unchanged.
+    auto r1 = cells.update(offset1, { { a, identity }, { b, identity } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 0);
+    assert_true(r1.at(c0).sources == r0.at(c0).sources);
+    assert_true(r1.at(c1).sources == r0.at(c1).sources);
+    // A different array with the same number of triangles: Cell 0 changes, cell 1 does not.
+    auto b_red = triangle_array("b", { FixedArray<float, 3>{ 2.f, 2.f, 2.f } }, red);
+    auto r2 = cells.update(offset1, { { a, identity }, { b_red, identity } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 1);
+    assert_true(r2.at(c0).sources != r1.at(c0).sources);
+    assert_true(r2.at(c1).sources == r1.at(c1).sources);
+    // The same array with a different model matrix is partitioned separately.
+    TransformationMatrix<float, ScenePos, 3> shifted{ fixed_identity_array<float, 3>(), FixedArray<ScenePos, 3>{ 10., 0., 0. } };
+    auto r3 = cells.update(offset1, { { a, identity }, { b_red, identity }, { b_red, shifted } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 1);
+    assert_isequal<size_t>(r3.at(c1).triangles.size(), 2);
+    // An array leaves: Cell 1 is dropped.
+    auto r4 = cells.update(offset1, { { b_red, identity } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 0);
+    assert_isequal<size_t>(r4.size(), 1);
+    assert_isequal<size_t>(r4.at(c0).triangles.size(), 1);
+    // The array enters again and is not partitioned again, because it is still alive.
+    auto r5 = cells.update(offset0, { { a, identity }, { b_red, identity } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 0);
+    assert_true(r5.at(c0).sources == r2.at(c0).sources);
+    // Culling by "max_triangle_distance" drops the far cell.
+    a->morphology.max_triangle_distance = 1.f;
+    b_red->morphology.max_triangle_distance = 1.f;
+    auto r6 = cells.update(offset0, { { a, identity }, { b_red, identity } }, true);
+    assert_isequal<size_t>(cells.npartitioned(), 0);
+    assert_isequal<size_t>(r6.size(), 1);
+    assert_true(r6.at(c0).sources == r5.at(c0).sources);
+    // The partitions of deleted arrays are evicted.
+    assert_isequal<size_t>(cells.npartitions(), 4);
+    b.reset();
+    cells.update(offset0, { { a, identity }, { b_red, identity } }, false);
+    assert_isequal<size_t>(cells.npartitions(), 3);
+    // After "clear", every array is partitioned again.
+    cells.clear();
+    cells.update(offset0, { { a, identity }, { b_red, identity } }, false);
+    assert_isequal<size_t>(cells.npartitioned(), 2);
+}
+
 void test_render() {
     StbImage3 img = StbImage3::load_from_file("Data/Depth/vid001.png");
     Array<float> depth = Array<float>::load_binary("Data/Depth/masked-depth-0-0-388-0-190.array");
@@ -87,6 +184,7 @@ int main(int argc, char **argv) {
     enable_floating_point_exceptions();
 
     test_scene_node();
+    test_aggregate_cells();
     test_render();
     return 0;
 }
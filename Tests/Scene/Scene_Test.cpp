@@ -53,6 +53,7 @@
 #include <Mlib/Scene_Graph/Delete_Node_Mutex.hpp>
 #include <Mlib/Scene_Graph/Elements/Absolute_Movable_Setter.hpp>
 #include <Mlib/Scene_Graph/Elements/Light.hpp>
+#include <Mlib/Scene_Graph/Elements/Make_Scene_Node.hpp>
 #include <Mlib/Scene_Graph/Elements/Scene_Node.hpp>
 #include <Mlib/Scene_Graph/Focus.hpp>
 #include <Mlib/Scene_Graph/Instances/Dynamic_World.hpp>
@@ -71,6 +72,44 @@
 
 using namespace Mlib;
 
+void test_absolute_model_matrix_cache() {
+    auto root = make_unique_scene_node(
+        FixedArray<ScenePos, 3>{ 1., 2., 3. },
+        FixedArray<float, 3>{ 0.1f, 0.2f, 0.3f },
+        2.f);
+    auto child = make_unique_scene_node(
+        FixedArray<ScenePos, 3>{ 4., 5., 6. },
+        FixedArray<float, 3>{ 0.4f, 0.5f, 0.6f },
+        1.f);
+    auto grandchild = make_unique_scene_node(
+        FixedArray<ScenePos, 3>{ 7., 8., 9. },
+        FixedArray<float, 3>{ 0.7f, 0.8f, 0.9f },
+        0.5f);
+    DanglingRef<SceneNode> c = child.ref(DP_LOC);
+    DanglingRef<SceneNode> g = grandchild.ref(DP_LOC);
+    child->add_child("grandchild", std::move(grandchild));
+    root->add_child("child", std::move(child));
+    auto check = [&](){
+        auto expected =
+            root->relative_model_matrix() *
+            c->relative_model_matrix() *
+            g->relative_model_matrix();
+        auto m = g->absolute_model_matrix();
+        assert_allclose(m.R, expected.R, 1e-5f);
+        assert_allclose(m.t, expected.t, 1e-5);
+    };
+    check();
+    check();
+    root->set_position({ -1., -2., -3. }, std::nullopt);
+    check();
+    c->set_rotation({ -0.4f, 0.f, 0.6f }, std::nullopt);
+    check();
+    root->set_relative_pose({ 3., 2., 1. }, { 0.f, 0.3f, 0.f }, 1.5f, std::nullopt);
+    check();
+    g->set_scale(3.f);
+    check();
+}
+
 void test_physics_engine(unsigned int seed) {
     std::atomic_size_t num_renderings = getenv_default_size_t("NUM_RENDERINGS", SIZE_MAX);
     RenderResults render_results;
@@ -322,6 +361,7 @@ int main(int argc, char** argv) {
     enable_floating_point_exceptions();
 
     try {
+        test_absolute_model_matrix_cache();
         auto seed_min = getenv_default_uint("SEED_MIN", 0);
         auto seed_count = getenv_default_uint("SEED_COUNT", 1);
         for (auto seed = seed_min; seed < seed_min + seed_count; ++seed) {
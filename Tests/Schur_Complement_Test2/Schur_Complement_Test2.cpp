@@ -5,6 +5,7 @@
 #include <Mlib/Sfm/Marginalization/Regrid_Array.hpp>
 #include <Mlib/Sfm/Marginalization/Synthetic_Scene.hpp>
 #include <Mlib/Sfm/Marginalization/UUID.hpp>
+#include <Mlib/Sfm/Sparse_Bundle/Schur_Bundle_Solver.hpp>
 #include <Mlib/Stats/Mean.hpp>
 #include <Mlib/Stats/Random_Arrays.hpp>
 #include <chrono>
@@ -275,6 +276,43 @@ void test_schur_solver() {
     assert_allclose(sc.solve(0, 0), lstsq_chol_1d(a, b).value());
 }
 
+void test_schur_bundle_solver() {
+    // Two rows per observation, each depending on one point (3 columns),
+    // the intrinsics (4 columns) and one camera (6 columns).
+    size_t npoints = 30;
+    size_t ncameras = 4;
+    size_t npoint_columns = 3 * npoints;
+    SparseArrayCcs<float> J{ ArrayShape{ 2 * npoints * ncameras, npoint_columns + 4 + 6 * ncameras } };
+    Array<float> values = uniform_random_array<float>(ArrayShape{ J.shape(0), 13 }, 3);
+    size_t row = 0;
+    for (size_t p = 0; p < npoints; ++p) {
+        for (size_t c = 0; c < ncameras; ++c) {
+            if ((p + c) % 3 == 0) {
+                continue;
+            }
+            for (size_t d = 0; d < 2; ++d) {
+                for (size_t i = 0; i < 3; ++i) {
+                    J(row, 3 * p + i) = values(row, i) - 0.5f;
+                }
+                for (size_t i = 0; i < 4; ++i) {
+                    J(row, npoint_columns + i) = values(row, 3 + i) - 0.5f;
+                }
+                for (size_t i = 0; i < 6; ++i) {
+                    J(row, npoint_columns + 4 + 6 * c + i) = values(row, 7 + i) - 0.5f;
+                }
+                ++row;
+            }
+        }
+    }
+    Array<float> residual = uniform_random_array<float>(ArrayShape{ J.shape(0) }, 4) - 0.5f;
+    for (float damping : { 0.f, 1e-2f }) {
+        assert_allclose(
+            Sfm::schur_bundle_lstsq_1d(J, residual, npoint_columns, damping, damping).value(),
+            lstsq_chol_1d(J, residual, damping, damping).value(),
+            1e-3);
+    }
+}
+
 void test_fill_in() {
     UUIDGen<int, CameraVariable, FeaturePointVariable> uuid_gen;
 
@@ -350,6 +388,7 @@ int main(int argc, char** argv) {
         test_schur_complement2();
         test_schur_complement3();
         test_schur_solver();
+        test_schur_bundle_solver();
         test_fill_in();
     } catch (const std::runtime_error& e) {
         lerr() << "ERROR: " << e.what();
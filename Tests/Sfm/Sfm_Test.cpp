@@ -12,6 +12,8 @@
 #include <Mlib/Math/Power_Iteration/Svd.hpp>
 #include <Mlib/Math/Rodrigues.hpp>
 #include <Mlib/Math/Svd4.hpp>
+#include <Mlib/Sfm/Disparity/Descriptor_Kd_Tree.hpp>
+#include <Mlib/Sfm/Disparity/Traceable_Descriptor.hpp>
 #include <Mlib/Sfm/Disparity/Traceable_Patch.hpp>
 #include <Mlib/Sfm/Draw/Epilines.hpp>
 #include <Mlib/Sfm/Frames/Camera_Frame.hpp>
@@ -25,6 +27,8 @@
 #include <Mlib/Sfm/Rigid_Motion/Synthetic_Scene.hpp>
 #include <Mlib/Sfm/Sparse_Bundle/Marginalized_Map.hpp>
 #include <Mlib/Stats/Mean.hpp>
+#include <Mlib/Stats/Random_Arrays.hpp>
+#include <Mlib/Stats/Sort.hpp>
 #include <iostream>
 #include <map>
 #include <random>
@@ -393,6 +397,41 @@ void test_traceable_patch() {
         FixedArray<size_t, 2>{1u, 5u});
 }
 
+void test_descriptor_kd_tree() {
+    Array<float> descriptors1 = uniform_random_array<float>(ArrayShape{ 500, 16 }, 1);
+    Array<float> descriptors0 = uniform_random_array<float>(ArrayShape{ 100, 16 }, 2);
+    // Half of the queries are perturbed copies, which pass the ratio test.
+    for (size_t i = 0; i < 50; ++i) {
+        descriptors0[i] = descriptors1[3 * i] + 0.01f * descriptors0[i];
+    }
+    DescriptorKdTree tree{ descriptors1, 4 };
+    size_t nmatches = 0;
+    size_t nmatches_approx = 0;
+    for (size_t i = 0; i < descriptors0.shape(0); ++i) {
+        DescriptorNeighbors n = tree.nearest_two(&descriptors0(i, 0));
+        Array<float> dist2{ ArrayShape{ descriptors1.shape(0) } };
+        for (size_t j = 0; j < descriptors1.shape(0); ++j) {
+            dist2(j) = sum(squared(descriptors1[j] - descriptors0[i]));
+        }
+        Array<size_t> ids = argsort(dist2);
+        assert_true(n.best == ids(0));
+        assert_isclose(n.best_dist2, dist2(ids(0)), 1e-5f);
+        assert_isclose(n.second_best_dist2, dist2(ids(1)), 1e-5f);
+        size_t expected = TraceableDescriptor::descriptor_id_in_parameter_list(&descriptors0(i, 0), descriptors1);
+        assert_true(tree.ratio_match(&descriptors0(i, 0)) == expected);
+        if (i < 50) {
+            assert_true(expected == 3 * i);
+        }
+        nmatches += (expected != SIZE_MAX);
+        // Approximate search stops early and can only find farther neighbors.
+        DescriptorNeighbors a = tree.nearest_two(&descriptors0(i, 0), 20);
+        assert_true(a.best_dist2 >= n.best_dist2);
+        nmatches_approx += (i < 50) && (a.best == 3 * i);
+    }
+    assert_true(nmatches >= 50);
+    assert_true(nmatches_approx >= 40);
+}
+
 void test_traceable_patch_nan() {
     const Array<float> image = to_rgb(Array<float>{
         {1, 2, 3, 4, 5},
@@ -634,6 +673,7 @@ int main(int argc, char** argv) {
         test_svd_essential_matrix2();
         test_traceable_patch();
         test_traceable_patch_nan();
+        test_descriptor_kd_tree();
         test_known_ki_alignment();
         test_projection_to_TR();
         test_fundamental_from_TR();